@@ -0,0 +1,410 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "basic/ds/sequence.h"
+#include "basic/stream/byte_stream.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "client/ds/collection.h"
+#include "client/ds/object_meta.h"
+#include "common/util/env.h"
+#include "common/util/logging.h"
+
+#include "benchmark/benchmark.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+using benchmark::State;
+
+namespace {
+
+std::string ipc_socket, peer_ipc_socket, spill_ipc_socket;
+
+bool Connect(State& state, Client& client, std::string const& socket,
+             std::string const& flag) {
+  if (socket.empty()) {
+    state.SkipWithError(("'" + flag + "' is not specified").c_str());
+    return false;
+  }
+  auto status = client.Connect(socket);
+  if (!status.ok()) {
+    state.SkipWithError(
+        ("Failed to connect to '" + socket + "': " + status.ToString())
+            .c_str());
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<Object> CreateBlob(Client& client, const size_t size) {
+  std::unique_ptr<BlobWriter> writer;
+  VINEYARD_CHECK_OK(client.CreateBlob(size, writer));
+  memset(writer->data(), 0xab, size);
+  std::shared_ptr<Object> blob;
+  VINEYARD_CHECK_OK(writer->Seal(client, blob));
+  return blob;
+}
+
+std::shared_ptr<Object> CreateTree(Client& client, const int64_t depth,
+                                   const int64_t fanout, int64_t& nodes) {
+  nodes += 1;
+  if (depth == 0) {
+    return CreateBlob(client, 64);
+  }
+  SequenceBuilder builder(client, fanout);
+  for (int64_t index = 0; index < fanout; ++index) {
+    builder.SetValue(index, CreateTree(client, depth - 1, fanout, nodes));
+  }
+  return builder.Seal(client);
+}
+
+}  // namespace
+
+/**
+ * CreateBlob and Seal, arg: blob size.
+ */
+void BM_CreateBlobSeal(State& state) {
+  Client client;
+  if (!Connect(state, client, ipc_socket, "--socket")) {
+    return;
+  }
+  size_t size = state.range(0);
+  while (state.KeepRunning()) {
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(client.CreateBlob(size, writer));
+    writer->data()[0] = 'x';
+    std::shared_ptr<Object> blob;
+    VINEYARD_CHECK_OK(writer->Seal(client, blob));
+
+    state.PauseTiming();
+    VINEYARD_CHECK_OK(client.DelData(blob->id()));
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_CreateBlobSeal)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 26)
+    ->ThreadRange(1, 8);
+
+/**
+ * GetObject on a tree of sequences, args: depth, fanout.
+ */
+void BM_GetObjectDeepTree(State& state) {
+  Client client;
+  if (!Connect(state, client, ipc_socket, "--socket")) {
+    return;
+  }
+  int64_t nodes = 0;
+  auto tree = CreateTree(client, state.range(0), state.range(1), nodes);
+  while (state.KeepRunning()) {
+    std::shared_ptr<Object> object;
+    VINEYARD_CHECK_OK(client.GetObject(tree->id(), object));
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+  VINEYARD_DISCARD(client.DelData(tree->id(), true, true));
+}
+BENCHMARK(BM_GetObjectDeepTree)
+    ->Args({1, 16})
+    ->Args({2, 64})
+    ->Args({3, 16})
+    ->Args({4, 4})
+    ->Args({8, 2})
+    ->ThreadRange(1, 4);
+
+/**
+ * GetObject on a wide collection and visit every partition once, arg: number
+ * of partitions.
+ */
+void BM_GetObjectWideCollection(State& state) {
+  Client client;
+  if (!Connect(state, client, ipc_socket, "--socket")) {
+    return;
+  }
+  CollectionBuilder<Blob> builder(client);
+  for (int64_t index = 0; index < state.range(0); ++index) {
+    builder.AddMember(CreateBlob(client, 64));
+  }
+  std::shared_ptr<Object> collection;
+  VINEYARD_CHECK_OK(builder.Seal(client, collection));
+  while (state.KeepRunning()) {
+    auto object = client.GetObject<Collection<Blob>>(collection->id());
+    for (size_t index = 0; index < object->size(); ++index) {
+      std::shared_ptr<Blob> blob;
+      VINEYARD_CHECK_OK(object->GetMember(index, blob));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  VINEYARD_DISCARD(client.DelData(collection->id(), true, true));
+}
+BENCHMARK(BM_GetObjectWideCollection)->RangeMultiplier(8)->Range(16, 16384);
+
+/**
+ * GetBuffers of many blobs in one request, arg: number of blobs.
+ */
+void BM_GetBuffersFanout(State& state) {
+  Client client;
+  if (!Connect(state, client, ipc_socket, "--socket")) {
+    return;
+  }
+  std::set<ObjectID> ids;
+  for (int64_t index = 0; index < state.range(0); ++index) {
+    ids.emplace(CreateBlob(client, 4096)->id());
+  }
+  while (state.KeepRunning()) {
+    std::map<ObjectID, std::shared_ptr<Buffer>> buffers;
+    VINEYARD_CHECK_OK(client.GetBuffers(ids, buffers));
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+  VINEYARD_DISCARD(
+      client.DelData(std::vector<ObjectID>(ids.begin(), ids.end())));
+}
+BENCHMARK(BM_GetBuffersFanout)
+    ->RangeMultiplier(4)
+    ->Range(1, 4096)
+    ->ThreadRange(1, 4);
+
+/**
+ * Push and pull 64 chunks through a byte stream, arg: chunk size.
+ */
+void BM_StreamPushPull(State& state) {
+  constexpr int64_t chunks = 64;
+  Client writer_client, reader_client;
+  if (!Connect(state, writer_client, ipc_socket, "--socket") ||
+      !Connect(state, reader_client, ipc_socket, "--socket")) {
+    return;
+  }
+  size_t size = state.range(0);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "benchmark"}};
+    ObjectID stream_id = StreamBuilder<ByteStream>::Make(writer_client, params);
+    auto writer = writer_client.GetObject<ByteStream>(stream_id);
+    auto reader = reader_client.GetObject<ByteStream>(stream_id);
+    VINEYARD_CHECK_OK(writer->OpenWriter(&writer_client));
+    VINEYARD_CHECK_OK(reader->OpenReader(&reader_client));
+    state.ResumeTiming();
+
+    std::vector<ObjectID> received;
+    std::thread reader_thread([&]() {
+      while (true) {
+        std::shared_ptr<Blob> chunk;
+        if (!reader->Next(chunk).ok()) {
+          break;
+        }
+        received.emplace_back(chunk->id());
+      }
+    });
+    for (int64_t index = 0; index < chunks; ++index) {
+      std::unique_ptr<BlobWriter> chunk;
+      VINEYARD_CHECK_OK(writer_client.CreateBlob(size, chunk));
+      chunk->data()[0] = 'x';
+      VINEYARD_CHECK_OK(writer->Push(chunk->Seal(writer_client)));
+    }
+    VINEYARD_CHECK_OK(writer->Finish());
+    reader_thread.join();
+
+    state.PauseTiming();
+    CHECK_EQ(received.size(), static_cast<size_t>(chunks));
+    VINEYARD_DISCARD(writer_client.DelData(received));
+    VINEYARD_DISCARD(writer_client.DelData(stream_id));
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * chunks * size);
+}
+BENCHMARK(BM_StreamPushPull)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+/**
+ * Write lines into a byte stream and read them back as string views, arg:
+ * line length.
+ */
+void BM_ByteStreamLines(State& state) {
+  constexpr int64_t lines = 1 << 18;
+  Client writer_client, reader_client;
+  if (!Connect(state, writer_client, ipc_socket, "--socket") ||
+      !Connect(state, reader_client, ipc_socket, "--socket")) {
+    return;
+  }
+  std::string line(state.range(0), 'x');
+  line.back() = '\n';
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "benchmark"}};
+    ObjectID stream_id = StreamBuilder<ByteStream>::Make(writer_client, params);
+    auto writer = writer_client.GetObject<ByteStream>(stream_id);
+    auto reader = reader_client.GetObject<ByteStream>(stream_id);
+    VINEYARD_CHECK_OK(writer->OpenWriter(&writer_client));
+    VINEYARD_CHECK_OK(reader->OpenReader(&reader_client));
+    writer->SetBufferSizeLimit(4 * 1024 * 1024);
+    state.ResumeTiming();
+
+    int64_t received = 0;
+    std::thread reader_thread([&]() {
+      arrow_string_view view;
+      while (reader->ReadLine(view).ok()) {
+        received += 1;
+      }
+    });
+    for (int64_t index = 0; index < lines; ++index) {
+      VINEYARD_CHECK_OK(writer->WriteBytes(line.data(), line.size()));
+    }
+    VINEYARD_CHECK_OK(writer->FlushBuffer());
+    VINEYARD_CHECK_OK(writer->Finish());
+    reader_thread.join();
+
+    state.PauseTiming();
+    CHECK_EQ(received, lines);
+    VINEYARD_DISCARD(writer_client.DelData(stream_id));
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * lines);
+  state.SetBytesProcessed(state.iterations() * lines * line.size());
+}
+BENCHMARK(BM_ByteStreamLines)->Arg(16)->Arg(128)->Arg(1024);
+
+/**
+ * Migrate a blob from the peer instance (--peer_socket), arg: blob size.
+ */
+void BM_MigrateObject(State& state) {
+  Client client, peer_client;
+  if (!Connect(state, client, ipc_socket, "--socket") ||
+      !Connect(state, peer_client, peer_ipc_socket, "--peer_socket")) {
+    return;
+  }
+  size_t size = state.range(0);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto blob = CreateBlob(peer_client, size);
+    VINEYARD_CHECK_OK(peer_client.Persist(blob->id()));
+    state.ResumeTiming();
+
+    ObjectID migrated = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.MigrateObject(blob->id(), migrated));
+
+    state.PauseTiming();
+    VINEYARD_DISCARD(client.DelData(migrated, true, true));
+    VINEYARD_DISCARD(peer_client.DelData(blob->id(), true, true));
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_MigrateObject)->RangeMultiplier(8)->Range(1 << 10, 1 << 26);
+
+/**
+ * Reload spilled blobs from an instance that has spilling enabled
+ * (--spill_socket), arg: blob size. Twice the memory limit is allocated
+ * before hand, so every get reloads a blob and spills another one.
+ */
+void BM_SpillReload(State& state) {
+  Client client;
+  if (!Connect(state, client, spill_ipc_socket, "--spill_socket")) {
+    return;
+  }
+  std::shared_ptr<InstanceStatus> status;
+  VINEYARD_CHECK_OK(client.InstanceStatus(status));
+  size_t size = state.range(0);
+  size_t blob_num = std::max(static_cast<size_t>(2),
+                             status->memory_limit * 2 / size);
+  std::vector<ObjectID> ids;
+  for (size_t index = 0; index < blob_num; ++index) {
+    auto blob = CreateBlob(client, size);
+    VINEYARD_CHECK_OK(client.Release(blob->id()));
+    ids.emplace_back(blob->id());
+  }
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    ObjectID id = ids[index++ % ids.size()];
+    std::map<ObjectID, std::shared_ptr<Buffer>> buffers;
+    VINEYARD_CHECK_OK(client.GetBuffers({id}, buffers));
+    VINEYARD_CHECK_OK(client.Release(id));
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  VINEYARD_DISCARD(client.DelData(ids, true, true));
+}
+BENCHMARK(BM_SpillReload)->RangeMultiplier(16)->Range(1 << 16, 1 << 24);
+
+/**
+ * Checkpoint a blob to a container file and restore it, args: blob size,
+ * whether to compress the extents.
+ */
+void BM_CheckpointRestore(State& state) {
+  Client client;
+  if (!Connect(state, client, ipc_socket, "--socket")) {
+    return;
+  }
+  size_t size = state.range(0);
+  bool compress = state.range(1) != 0;
+  auto blob = CreateBlob(client, size);
+  std::string path =
+      "/tmp/vineyard-bench-" + std::to_string(getpid()) + ".ckpt";
+  while (state.KeepRunning()) {
+    VINEYARD_CHECK_OK(client.Checkpoint(blob->id(), path, compress));
+    ObjectID restored = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.Restore(path, restored));
+
+    state.PauseTiming();
+    VINEYARD_CHECK_OK(client.DelData(restored));
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * size * 2);
+  unlink(path.c_str());
+  VINEYARD_DISCARD(client.DelData(blob->id()));
+}
+BENCHMARK(BM_CheckpointRestore)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 26, 0})
+    ->Args({1 << 28, 0})
+    ->Args({1 << 26, 1})
+    ->Args({1 << 28, 1});
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  for (int index = 1; index < argc; ++index) {
+    std::string arg = argv[index];
+    std::string value = arg.substr(arg.find('=') + 1);
+    if (arg.find("--socket=") == 0) {
+      ipc_socket = value;
+    } else if (arg.find("--peer_socket=") == 0) {
+      peer_ipc_socket = value;
+    } else if (arg.find("--spill_socket=") == 0) {
+      spill_ipc_socket = value;
+    } else {
+      printf(
+          "usage: ./vineyard_client_benchmarks --socket=<ipc_socket> "
+          "[--peer_socket=<ipc_socket>] [--spill_socket=<ipc_socket>] "
+          "[--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>] "
+          "[--benchmark_repetitions=<n>] [--benchmark_out=<json>]\n");
+      return 1;
+    }
+  }
+  if (ipc_socket.empty()) {
+    ipc_socket = read_env("VINEYARD_IPC_SOCKET");
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,215 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+'''Runs the client data-path benchmarks against freshly launched vineyardd
+instances, and merges the C++ and python results into a single JSON report.
+
+Usage:
+
+.. code:: bash
+
+    python3 benchmark/client_bench/run_benchmarks.py \\
+        --build-dir build --out result.json [--baseline base.json]
+'''
+
+import argparse
+import contextlib
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+
+@contextlib.contextmanager
+def vineyardd(vineyardd_path, socket, size, *args):
+    command = [
+        vineyardd_path,
+        '--socket=%s' % socket,
+        '--size=%s' % size,
+    ] + list(args)
+    proc = subprocess.Popen(command)  # pylint: disable=consider-using-with
+    try:
+        for _ in range(300):
+            if os.path.exists(socket) or proc.poll() is not None:
+                break
+            time.sleep(0.1)
+        if proc.poll() is not None:
+            raise RuntimeError('vineyardd exited: %s' % ' '.join(command))
+        yield socket
+    finally:
+        proc.terminate()
+        proc.wait()
+
+
+def run_cpp_benchmarks(args, workdir, sockets):
+    binary = os.path.join(args.build_dir, 'bin', 'vineyard_client_benchmarks')
+    out = os.path.join(workdir, 'cpp.json')
+    command = [
+        binary,
+        '--socket=%s' % sockets['default'],
+        '--spill_socket=%s' % sockets['spill'],
+        '--benchmark_out=%s' % out,
+    ]
+    if 'peer' in sockets:
+        command.append('--peer_socket=%s' % sockets['peer'])
+    if args.filter:
+        command.append('--benchmark_filter=%s' % args.filter)
+    subprocess.check_call(command)
+    with open(out, 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+
+def run_python_benchmarks(args, workdir, sockets):
+    out = os.path.join(workdir, 'python.json')
+    command = [
+        sys.executable,
+        '-m',
+        'pytest',
+        '-s',
+        os.path.join(ROOT, 'python', 'vineyard', 'data', 'benchmarks'),
+        '--vineyard-ipc-socket=%s' % sockets['default'],
+        '--vineyard-endpoint=localhost:9600',
+        '--benchmark-json=%s' % out,
+    ]
+    if args.filter:
+        command.extend(['-k', args.filter])
+    subprocess.check_call(command)
+    with open(out, 'r', encoding='utf-8') as f:
+        report = json.load(f)
+    # normalize into the layout of the C++ report, in nanoseconds
+    benchmarks = []
+    for bench in report.get('benchmarks', []):
+        stats = bench['stats']
+        benchmarks.append(
+            {
+                'name': 'python/%s' % bench['name'],
+                'run_type': 'iteration',
+                'iterations': stats['rounds'],
+                'real_time': stats['mean'] * 1e9,
+                'cpu_time': stats['mean'] * 1e9,
+                'time_unit': 'ns',
+            }
+        )
+    return benchmarks
+
+
+def compare(baseline, result):
+    base = {b['name']: b for b in baseline.get('benchmarks', [])}
+    print(
+        '%-64s %14s %14s %9s' % ('benchmark', 'base (ns)', 'new (ns)', 'delta')
+    )
+    for bench in result['benchmarks']:
+        if bench['name'] not in base:
+            continue
+        old, new = base[bench['name']]['real_time'], bench['real_time']
+        delta = (new - old) / old if old else 0.0
+        print(
+            '%-64s %14.0f %14.0f %+8.2f%%'
+            % (bench['name'], old, new, delta * 100)
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--build-dir', default=os.path.join(ROOT, 'build'))
+    parser.add_argument('--vineyardd', default=None)
+    parser.add_argument('--size', default='8Gi')
+    parser.add_argument('--spill-size', default='256Mi')
+    parser.add_argument(
+        '--etcd-endpoint',
+        default=None,
+        help='launch a peer instance in the same cluster to benchmark migration',
+    )
+    parser.add_argument('--filter', default=None)
+    parser.add_argument('--skip-python', action='store_true')
+    parser.add_argument('--out', default='client_bench.json')
+    parser.add_argument('--baseline', default=None)
+    args = parser.parse_args()
+
+    vineyardd_path = args.vineyardd or os.path.join(
+        args.build_dir, 'bin', 'vineyardd'
+    )
+    workdir = tempfile.mkdtemp(prefix='vineyard-client-bench-')
+    spill_path = os.path.join(workdir, 'spill')
+    os.makedirs(spill_path)
+    if args.etcd_endpoint:
+        prefix = '/vineyard-client-bench-%d' % os.getpid()
+        meta = [
+            '--meta=etcd',
+            '--etcd_endpoint=%s' % args.etcd_endpoint,
+            '--etcd_prefix=%s' % prefix,
+        ]
+        peer_meta = meta + ['--rpc_socket_port=9601']
+    else:
+        meta = ['--meta=local']
+    try:
+        with contextlib.ExitStack() as stack:
+            sockets = {}
+            sockets['default'] = stack.enter_context(
+                vineyardd(
+                    vineyardd_path,
+                    os.path.join(workdir, 'vineyard.sock'),
+                    args.size,
+                    *meta,
+                )
+            )
+            if args.etcd_endpoint:
+                sockets['peer'] = stack.enter_context(
+                    vineyardd(
+                        vineyardd_path,
+                        os.path.join(workdir, 'vineyard-peer.sock'),
+                        args.size,
+                        *peer_meta,
+                    )
+                )
+            sockets['spill'] = stack.enter_context(
+                vineyardd(
+                    vineyardd_path,
+                    os.path.join(workdir, 'vineyard-spill.sock'),
+                    args.spill_size,
+                    '--meta=local',
+                    '--rpc=false',
+                    '--spill_path=%s' % spill_path,
+                    '--spill_lower_rate=0.3',
+                    '--spill_upper_rate=0.8',
+                )
+            )
+            result = run_cpp_benchmarks(args, workdir, sockets)
+            if not args.skip_python:
+                result['benchmarks'].extend(
+                    run_python_benchmarks(args, workdir, sockets)
+                )
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    with open(args.out, 'w', encoding='utf-8') as f:
+        json.dump(result, f, indent=2)
+    print('Benchmark report written to %s' % args.out)
+
+    if args.baseline:
+        with open(args.baseline, 'r', encoding='utf-8') as f:
+            compare(json.load(f), result)
+
+
+if __name__ == '__main__':
+    main()
@@ -1054,7 +1054,31 @@ RecordBatchBuilder::RecordBatchBuilder(
   this->batches_ = std::move(batches);
 }
 
+RecordBatchBuilder::RecordBatchBuilder(
+    Client& client, const std::shared_ptr<arrow::Schema> schema,
+    const int64_t num_rows,
+    const std::vector<std::shared_ptr<ObjectBuilder>>& columns)
+    : RecordBatchBaseBuilder(client),
+      arrow_schema_(schema),
+      num_rows_(num_rows),
+      column_builders_(columns) {
+  VINEYARD_ASSERT(schema->num_fields() == static_cast<int>(columns.size()),
+                  "the number of columns doesn't match the schema");
+}
+
 Status RecordBatchBuilder::Build(Client& client) {
+  if (batches_.empty()) {
+    this->set_schema_(
+        std::make_shared<SchemaProxyBuilder>(client, arrow_schema_));
+    this->set_row_num_(num_rows_);
+    this->set_column_num_(column_builders_.size());
+    for (auto const& column : column_builders_) {
+      this->add_columns_(column);
+    }
+    column_builders_.clear();  // release the reference
+    return Status::OK();
+  }
+
   int64_t num_rows = 0, num_columns = batches_[0]->num_columns();
   for (auto const& batch : batches_) {
     num_rows += batch->num_rows();
@@ -1380,6 +1404,46 @@ Status TableExtender::Build(Client& client) {
   return Status::OK();
 }
 
+TableAppender::TableAppender(Client& client, const std::shared_ptr<Table> table)
+    : TableBuilder(client, nullptr) {
+  row_num_ = table->num_rows();
+  column_num_ = table->num_columns();
+  schema_ = table->schema();
+  batches_ = table->batches();
+}
+
+Status TableAppender::AppendRows(const std::shared_ptr<arrow::Table> rows) {
+  // validate input
+  if (!rows->schema()->Equals(*schema_, false)) {
+    return Status::Invalid("The appended rows doesn't have a matched schema");
+  }
+  if (rows->num_rows() == 0) {
+    return Status::OK();
+  }
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  RETURN_ON_ERROR(TableToRecordBatches(rows, &batches));
+  appended_.emplace_back(std::move(batches));
+  row_num_ += rows->num_rows();
+  return Status::OK();
+}
+
+Status TableAppender::Build(Client& client) {
+  this->set_batch_num_(batches_.size() + appended_.size());
+  this->set_num_rows_(row_num_);
+  this->set_num_columns_(column_num_);
+  for (auto const& batch : batches_) {
+    this->AddMember(std::static_pointer_cast<Object>(batch));
+  }
+  for (auto const& batches : appended_) {
+    RETURN_ON_ERROR(
+        this->AddMember(std::make_shared<RecordBatchBuilder>(client, batches)));
+  }
+  appended_.clear();  // release the reference
+  RETURN_ON_ERROR(
+      this->set_schema_(std::make_shared<SchemaProxyBuilder>(client, schema_)));
+  return Status::OK();
+}
+
 TableConsolidator::TableConsolidator(Client& client,
                                      const std::shared_ptr<Table> table)
     : TableBuilder(client, nullptr) {
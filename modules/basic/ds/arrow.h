@@ -453,10 +453,24 @@ class RecordBatchBuilder : public RecordBatchBaseBuilder {
       Client& client,
       const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches);
 
+  /**
+   * @brief Build the batch from the columns that have already been written
+   * into vineyard builders (e.g., `FixedNumericArrayBuilder`), without copying
+   * them again.
+   */
+  RecordBatchBuilder(
+      Client& client, const std::shared_ptr<arrow::Schema> schema,
+      const int64_t num_rows,
+      const std::vector<std::shared_ptr<ObjectBuilder>>& columns);
+
   Status Build(Client& client) override;
 
  private:
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+
+  std::shared_ptr<arrow::Schema> arrow_schema_;
+  int64_t num_rows_ = 0;
+  std::vector<std::shared_ptr<ObjectBuilder>> column_builders_;
 };
 
 /**
@@ -569,6 +583,31 @@ class TableExtender : public TableBuilder {
   std::vector<std::shared_ptr<RecordBatchExtender>> record_batch_extenders_;
 };
 
+/**
+ * @brief TableAppender is used for appending rows to tables, the record
+ * batches of the existing table are reused as-is, and the appended rows
+ * become new batches.
+ *
+ */
+class TableAppender : public TableBuilder {
+ public:
+  TableAppender(Client& client, std::shared_ptr<Table> table);
+
+  /**
+   * NOTE: `rows` must have the same schema with `table`, and the rows of
+   * each call are merged into a single batch.
+   */
+  Status AppendRows(const std::shared_ptr<arrow::Table> rows);
+
+  Status Build(Client& client) override;
+
+ private:
+  size_t row_num_ = 0, column_num_ = 0;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<std::shared_ptr<RecordBatch>> batches_;
+  std::vector<std::vector<std::shared_ptr<arrow::RecordBatch>>> appended_;
+};
+
 class TableConsolidator : public TableBuilder {
  public:
   TableConsolidator(Client& client, std::shared_ptr<Table> table);
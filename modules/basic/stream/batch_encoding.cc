@@ -0,0 +1,1067 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "basic/stream/batch_encoding.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+#include "arrow/util/compression.h"
+#include "flat_hash_map/flat_hash_map.hpp"
+
+#include "basic/ds/arrow_utils.h"
+#include "basic/utils.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+
+const char* column_encoding_name(ColumnEncoding encoding) {
+  switch (encoding) {
+  case ColumnEncoding::kPlain:
+    return "plain";
+  case ColumnEncoding::kDictionary:
+    return "dictionary";
+  case ColumnEncoding::kRunLength:
+    return "run-length";
+  case ColumnEncoding::kFrameOfReference:
+    return "frame-of-reference";
+  case ColumnEncoding::kLZ4:
+    return "lz4";
+  case ColumnEncoding::kAuto:
+    return "auto";
+  default:
+    return "unknown";
+  }
+}
+
+namespace detail {
+
+/**
+ * The layout of an encoded chunk:
+ *
+ *    | header | column headers | schema | column payloads |
+ *
+ * where the schema and each payload starts at a 64-bytes aligned offset, thus
+ * the arrow IPC messages inside the payloads can be read without copying.
+ */
+static constexpr uint32_t kEncodedBatchMagic = 0x42455956;  // "VYEB"
+static constexpr uint32_t kEncodedBatchVersion = 1;
+static constexpr int64_t kPayloadAlignment = 64;
+
+struct EncodedBatchHeader {
+  uint32_t magic;
+  uint32_t version;
+  int64_t num_rows;
+  int64_t num_columns;
+  int64_t schema_offset;
+  int64_t schema_size;
+  int64_t total_size;
+};
+
+struct EncodedColumnHeader {
+  uint8_t encoding;
+  uint8_t reserved[7];
+  int64_t offset;
+  int64_t size;
+};
+
+inline int64_t align_up(int64_t size, int64_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+inline int bit_width(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+class PayloadWriter {
+ public:
+  template <typename T>
+  void Append(T const& value) {
+    Append(&value, sizeof(T));
+  }
+
+  void Append(const void* data, size_t size) {
+    data_.append(static_cast<const char*>(data), size);
+  }
+
+  void Align(int64_t alignment) {
+    data_.resize(align_up(data_.size(), alignment), '\0');
+  }
+
+  size_t size() const { return data_.size(); }
+
+  void Resize(size_t size) { data_.resize(size, '\0'); }
+
+  uint8_t* mutable_data() { return reinterpret_cast<uint8_t*>(&data_[0]); }
+
+  std::shared_ptr<arrow::Buffer> Finish() {
+    return arrow::Buffer::FromString(std::move(data_));
+  }
+
+ private:
+  std::string data_;
+};
+
+class PayloadReader {
+ public:
+  explicit PayloadReader(std::shared_ptr<arrow::Buffer> const& buffer)
+      : buffer_(buffer) {}
+
+  template <typename T>
+  Status Read(T& value) {
+    const uint8_t* data = nullptr;
+    RETURN_ON_ERROR(Read(sizeof(T), data));
+    memcpy(&value, data, sizeof(T));
+    return Status::OK();
+  }
+
+  Status Read(int64_t size, const uint8_t*& data) {
+    if (size < 0 || offset_ + size > buffer_->size()) {
+      return Status::Invalid("The encoded column is truncated");
+    }
+    data = buffer_->data() + offset_;
+    offset_ += size;
+    return Status::OK();
+  }
+
+  Status Slice(int64_t size, std::shared_ptr<arrow::Buffer>& slice) {
+    const uint8_t* data = nullptr;
+    RETURN_ON_ERROR(Read(size, data));
+    slice = arrow::SliceBuffer(buffer_, data - buffer_->data(), size);
+    return Status::OK();
+  }
+
+  void Align(int64_t alignment) { offset_ = align_up(offset_, alignment); }
+
+ private:
+  std::shared_ptr<arrow::Buffer> buffer_;
+  int64_t offset_ = 0;
+};
+
+/**
+ * Integer-like columns are encoded as order-preserving unsigned keys, i.e.,
+ * the signed values are shifted by 2^63, thus the deltas to the minimum key
+ * never overflow.
+ */
+struct IntegerLayout {
+  int width;
+  bool is_signed;
+};
+
+bool integer_layout(std::shared_ptr<arrow::DataType> const& type,
+                    IntegerLayout& layout) {
+  switch (type->id()) {
+  case arrow::Type::INT8:
+    layout = {1, true};
+    return true;
+  case arrow::Type::UINT8:
+    layout = {1, false};
+    return true;
+  case arrow::Type::INT16:
+    layout = {2, true};
+    return true;
+  case arrow::Type::UINT16:
+    layout = {2, false};
+    return true;
+  case arrow::Type::INT32:
+  case arrow::Type::DATE32:
+  case arrow::Type::TIME32:
+    layout = {4, true};
+    return true;
+  case arrow::Type::UINT32:
+    layout = {4, false};
+    return true;
+  case arrow::Type::INT64:
+  case arrow::Type::DATE64:
+  case arrow::Type::TIME64:
+  case arrow::Type::TIMESTAMP:
+  case arrow::Type::DURATION:
+    layout = {8, true};
+    return true;
+  case arrow::Type::UINT64:
+    layout = {8, false};
+    return true;
+  default:
+    return false;
+  }
+}
+
+static constexpr uint64_t kSignFlip = static_cast<uint64_t>(1) << 63;
+
+inline uint64_t load_key(const uint8_t* values, int64_t i,
+                         IntegerLayout const& layout) {
+  int64_t value = 0;
+  switch (layout.width) {
+  case 1:
+    value = layout.is_signed ? reinterpret_cast<const int8_t*>(values)[i]
+                             : values[i];
+    break;
+  case 2:
+    value = layout.is_signed ? reinterpret_cast<const int16_t*>(values)[i]
+                             : reinterpret_cast<const uint16_t*>(values)[i];
+    break;
+  case 4:
+    value = layout.is_signed ? reinterpret_cast<const int32_t*>(values)[i]
+                             : reinterpret_cast<const uint32_t*>(values)[i];
+    break;
+  default:
+    value = reinterpret_cast<const int64_t*>(values)[i];
+  }
+  return layout.is_signed ? static_cast<uint64_t>(value) ^ kSignFlip
+                          : static_cast<uint64_t>(value);
+}
+
+inline void store_key(uint8_t* values, int64_t i, IntegerLayout const& layout,
+                      uint64_t key) {
+  uint64_t value = layout.is_signed ? key ^ kSignFlip : key;
+  // little-endian: the low bytes hold the truncated value
+  memcpy(values + i * layout.width, &value, layout.width);
+}
+
+const uint8_t* integer_values(arrow::Array const& array,
+                              IntegerLayout const& layout) {
+  return array.data()->buffers[1]->data() + array.offset() * layout.width;
+}
+
+struct IntegerStats {
+  uint64_t min_key = std::numeric_limits<uint64_t>::max();
+  uint64_t max_key = 0;
+  int64_t runs = 0;
+};
+
+template <typename KEY_FN, typename VALID_FN>
+IntegerStats integer_stats(int64_t length, KEY_FN const& key,
+                           VALID_FN const& valid) {
+  IntegerStats stats;
+  uint64_t last = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!valid(i)) {
+      continue;
+    }
+    uint64_t k = key(i);
+    stats.min_key = std::min(stats.min_key, k);
+    stats.max_key = std::max(stats.max_key, k);
+    if (stats.runs == 0 || k != last) {
+      stats.runs += 1;
+    }
+    last = k;
+  }
+  if (stats.min_key > stats.max_key) {
+    stats.min_key = stats.max_key = 0;
+  }
+  return stats;
+}
+
+/**
+ * The frame-of-reference payload:
+ *
+ *    | min key | bit width | null count | validity bitmap | packed deltas |
+ */
+template <typename KEY_FN, typename VALID_FN>
+void write_frame_of_reference(int64_t length, int64_t null_count,
+                              KEY_FN const& key, VALID_FN const& valid,
+                              PayloadWriter& writer) {
+  IntegerStats stats = integer_stats(length, key, valid);
+  int width = bit_width(stats.max_key - stats.min_key);
+  writer.Append<uint64_t>(stats.min_key);
+  writer.Append<int64_t>(width);
+  writer.Append<int64_t>(null_count);
+  if (null_count > 0) {
+    size_t offset = writer.size();
+    writer.Resize(offset + align_up((length + 7) / 8, 8));
+    uint8_t* bitmap = writer.mutable_data() + offset;
+    for (int64_t i = 0; i < length; ++i) {
+      if (valid(i)) {
+        bitmap[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+      }
+    }
+  }
+  if (width == 0) {
+    return;
+  }
+  size_t offset = writer.size();
+  writer.Resize(offset + (length * width + 63) / 64 * sizeof(uint64_t));
+  uint64_t* words = reinterpret_cast<uint64_t*>(writer.mutable_data() + offset);
+  for (int64_t i = 0; i < length; ++i) {
+    uint64_t delta = valid(i) ? key(i) - stats.min_key : 0;
+    int64_t position = i * width;
+    int shift = position & 63;
+    words[position >> 6] |= delta << shift;
+    if (shift + width > 64) {
+      words[(position >> 6) + 1] |= delta >> (64 - shift);
+    }
+  }
+}
+
+template <typename STORE_FN>
+Status read_frame_of_reference(PayloadReader& reader, int64_t length,
+                               std::shared_ptr<arrow::Buffer>& validity,
+                               int64_t& null_count, STORE_FN const& store) {
+  uint64_t min_key = 0;
+  int64_t width = 0;
+  RETURN_ON_ERROR(reader.Read(min_key));
+  RETURN_ON_ERROR(reader.Read(width));
+  RETURN_ON_ERROR(reader.Read(null_count));
+  RETURN_ON_ASSERT(width >= 0 && width <= 64, "Invalid bit width");
+  validity = nullptr;
+  if (null_count > 0) {
+    const uint8_t* bitmap = nullptr;
+    RETURN_ON_ERROR(reader.Read(align_up((length + 7) / 8, 8), bitmap));
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(validity,
+                                     arrow::AllocateBuffer((length + 7) / 8));
+    memcpy(validity->mutable_data(), bitmap, (length + 7) / 8);
+  }
+  if (width == 0) {
+    for (int64_t i = 0; i < length; ++i) {
+      store(i, min_key);
+    }
+    return Status::OK();
+  }
+  const uint8_t* data = nullptr;
+  RETURN_ON_ERROR(
+      reader.Read((length * width + 63) / 64 * sizeof(uint64_t), data));
+  const uint64_t* words = reinterpret_cast<const uint64_t*>(data);
+  const uint64_t mask =
+      width == 64 ? ~static_cast<uint64_t>(0)
+                  : (static_cast<uint64_t>(1) << width) - 1;
+  for (int64_t i = 0; i < length; ++i) {
+    int64_t position = i * width;
+    int shift = position & 63;
+    uint64_t delta = words[position >> 6] >> shift;
+    if (shift + width > 64) {
+      delta |= words[(position >> 6) + 1] << (64 - shift);
+    }
+    store(i, min_key + (delta & mask));
+  }
+  return Status::OK();
+}
+
+Status serialize_column(std::shared_ptr<arrow::Field> const& field,
+                        std::shared_ptr<arrow::Array> const& array,
+                        std::shared_ptr<arrow::Buffer>& buffer) {
+  auto batch = arrow::RecordBatch::Make(arrow::schema({field}),
+                                        array->length(), {array});
+  return SerializeRecordBatch(batch, &buffer);
+}
+
+Status deserialize_column(std::shared_ptr<arrow::Buffer> const& buffer,
+                          std::shared_ptr<arrow::Array>& array) {
+  std::shared_ptr<arrow::RecordBatch> batch;
+  RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
+  RETURN_ON_ASSERT(batch != nullptr && batch->num_columns() == 1,
+                   "Invalid plain encoded column");
+  array = batch->column(0);
+  return Status::OK();
+}
+
+Status encode_frame_of_reference(std::shared_ptr<arrow::Array> const& array,
+                                 IntegerLayout const& layout,
+                                 PayloadWriter& writer) {
+  const uint8_t* values = integer_values(*array, layout);
+  write_frame_of_reference(
+      array->length(), array->null_count(),
+      [&](int64_t i) { return load_key(values, i, layout); },
+      [&](int64_t i) { return array->IsValid(i); }, writer);
+  return Status::OK();
+}
+
+Status decode_frame_of_reference(std::shared_ptr<arrow::DataType> const& type,
+                                 IntegerLayout const& layout,
+                                 PayloadReader& reader, int64_t length,
+                                 std::shared_ptr<arrow::Array>& array) {
+  std::shared_ptr<arrow::Buffer> validity, values;
+  int64_t null_count = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      values, arrow::AllocateBuffer(length * layout.width));
+  uint8_t* data = values->mutable_data();
+  RETURN_ON_ERROR(read_frame_of_reference(
+      reader, length, validity, null_count,
+      [&](int64_t i, uint64_t key) { store_key(data, i, layout, key); }));
+  array = arrow::MakeArray(
+      arrow::ArrayData::Make(type, length, {validity, values}, null_count));
+  return Status::OK();
+}
+
+/**
+ * The run-length payload:
+ *
+ *    | number of runs | run keys | run ends |
+ */
+Status encode_run_length(std::shared_ptr<arrow::Array> const& array,
+                         IntegerLayout const& layout, PayloadWriter& writer) {
+  const uint8_t* values = integer_values(*array, layout);
+  std::vector<uint64_t> keys;
+  std::vector<int64_t> ends;
+  for (int64_t i = 0; i < array->length(); ++i) {
+    uint64_t key = load_key(values, i, layout);
+    if (keys.empty() || keys.back() != key) {
+      keys.push_back(key);
+      ends.push_back(i + 1);
+    } else {
+      ends.back() = i + 1;
+    }
+  }
+  writer.Append<int64_t>(keys.size());
+  writer.Append(keys.data(), keys.size() * sizeof(uint64_t));
+  writer.Append(ends.data(), ends.size() * sizeof(int64_t));
+  return Status::OK();
+}
+
+Status decode_run_length(std::shared_ptr<arrow::DataType> const& type,
+                         IntegerLayout const& layout, PayloadReader& reader,
+                         int64_t length, std::shared_ptr<arrow::Array>& array) {
+  int64_t runs = 0;
+  const uint8_t *keys = nullptr, *ends = nullptr;
+  RETURN_ON_ERROR(reader.Read(runs));
+  RETURN_ON_ERROR(reader.Read(runs * sizeof(uint64_t), keys));
+  RETURN_ON_ERROR(reader.Read(runs * sizeof(int64_t), ends));
+  std::shared_ptr<arrow::Buffer> values;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      values, arrow::AllocateBuffer(length * layout.width));
+  uint8_t* data = values->mutable_data();
+  int64_t begin = 0;
+  for (int64_t run = 0; run < runs; ++run) {
+    uint64_t key = 0;
+    int64_t end = 0;
+    memcpy(&key, keys + run * sizeof(uint64_t), sizeof(uint64_t));
+    memcpy(&end, ends + run * sizeof(int64_t), sizeof(int64_t));
+    RETURN_ON_ASSERT(end >= begin && end <= length, "Invalid run end");
+    for (int64_t i = begin; i < end; ++i) {
+      store_key(data, i, layout, key);
+    }
+    begin = end;
+  }
+  RETURN_ON_ASSERT(begin == length, "The runs don't cover the column");
+  array = arrow::MakeArray(
+      arrow::ArrayData::Make(type, length, {nullptr, values}, 0));
+  return Status::OK();
+}
+
+/**
+ * The dictionary payload:
+ *
+ *    | dictionary size | dictionary (plain) | indices (frame-of-reference) |
+ */
+template <typename ArrowType>
+Status encode_dictionary(std::shared_ptr<arrow::Field> const& field,
+                         std::shared_ptr<arrow::Array> const& array,
+                         PayloadWriter& writer) {
+  using array_t = typename arrow::TypeTraits<ArrowType>::ArrayType;
+  using builder_t = typename arrow::TypeTraits<ArrowType>::BuilderType;
+  auto typed = std::dynamic_pointer_cast<array_t>(array);
+
+  ska::flat_hash_map<arrow_string_view, uint32_t> dictionary;
+  std::vector<uint32_t> indices(array->length(), 0);
+  builder_t builder(field->type(), arrow::default_memory_pool());
+  for (int64_t i = 0; i < array->length(); ++i) {
+    if (typed->IsNull(i)) {
+      continue;
+    }
+    auto value = typed->GetView(i);
+    auto iter = dictionary.find(value);
+    if (iter == dictionary.end()) {
+      uint32_t index = dictionary.size();
+      iter = dictionary.emplace(value, index).first;
+      RETURN_ON_ARROW_ERROR(builder.Append(value));
+    }
+    indices[i] = iter->second;
+  }
+  std::shared_ptr<arrow::Array> values;
+  std::shared_ptr<arrow::Buffer> plain;
+  RETURN_ON_ARROW_ERROR(builder.Finish(&values));
+  RETURN_ON_ERROR(serialize_column(field, values, plain));
+
+  writer.Append<int64_t>(plain->size());
+  writer.Append(plain->data(), plain->size());
+  writer.Align(8);
+  write_frame_of_reference(
+      array->length(), array->null_count(),
+      [&](int64_t i) { return static_cast<uint64_t>(indices[i]); },
+      [&](int64_t i) { return typed->IsValid(i); }, writer);
+  return Status::OK();
+}
+
+template <typename ArrowType>
+Status decode_dictionary(PayloadReader& reader, int64_t length,
+                         std::shared_ptr<arrow::Array>& array) {
+  using array_t = typename arrow::TypeTraits<ArrowType>::ArrayType;
+  using builder_t = typename arrow::TypeTraits<ArrowType>::BuilderType;
+
+  int64_t size = 0;
+  std::shared_ptr<arrow::Buffer> plain;
+  std::shared_ptr<arrow::Array> values;
+  RETURN_ON_ERROR(reader.Read(size));
+  RETURN_ON_ERROR(reader.Slice(size, plain));
+  RETURN_ON_ERROR(deserialize_column(plain, values));
+  reader.Align(8);
+  auto dictionary = std::dynamic_pointer_cast<array_t>(values);
+  RETURN_ON_ASSERT(dictionary != nullptr, "Invalid dictionary");
+
+  std::vector<uint32_t> indices(length);
+  std::shared_ptr<arrow::Buffer> validity;
+  int64_t null_count = 0;
+  RETURN_ON_ERROR(read_frame_of_reference(
+      reader, length, validity, null_count,
+      [&](int64_t i, uint64_t key) {
+        indices[i] = static_cast<uint32_t>(key);
+      }));
+
+  const uint8_t* bitmap = validity == nullptr ? nullptr : validity->data();
+  int64_t data_size = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (validity == nullptr || ((bitmap[i >> 3] >> (i & 7)) & 1)) {
+      RETURN_ON_ASSERT(indices[i] < dictionary->length(),
+                       "Dictionary index out of range");
+      data_size += dictionary->value_length(indices[i]);
+    }
+  }
+  builder_t builder(dictionary->type(), arrow::default_memory_pool());
+  RETURN_ON_ARROW_ERROR(builder.Reserve(length));
+  RETURN_ON_ARROW_ERROR(builder.ReserveData(data_size));
+  for (int64_t i = 0; i < length; ++i) {
+    if (validity == nullptr || ((bitmap[i >> 3] >> (i & 7)) & 1)) {
+      builder.UnsafeAppend(dictionary->GetView(indices[i]));
+    } else {
+      builder.UnsafeAppendNull();
+    }
+  }
+  RETURN_ON_ARROW_ERROR(builder.Finish(&array));
+  return Status::OK();
+}
+
+template <typename ArrowType>
+struct DictionaryEncoder {
+  static Status Visit(std::shared_ptr<arrow::Field> const& field,
+                      std::shared_ptr<arrow::Array> const& array,
+                      PayloadWriter& writer) {
+    return encode_dictionary<ArrowType>(field, array, writer);
+  }
+};
+
+template <typename ArrowType>
+struct DictionaryDecoder {
+  static Status Visit(PayloadReader& reader, int64_t length,
+                      std::shared_ptr<arrow::Array>& array) {
+    return decode_dictionary<ArrowType>(reader, length, array);
+  }
+};
+
+/**
+ * Counts the value bytes and checks whether the values repeat twice in
+ * average, i.e., whether the dictionary encoding pays off.
+ */
+template <typename ArrowType>
+struct RepetitionCounter {
+  static Status Visit(std::shared_ptr<arrow::Array> const& array,
+                      bool& repeated, int64_t& data_size) {
+    using array_t = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    auto typed = std::dynamic_pointer_cast<array_t>(array);
+    int64_t valid = array->length() - array->null_count();
+    ska::flat_hash_set<arrow_string_view> distinct;
+    repeated = false;
+    data_size = 0;
+    for (int64_t i = 0; i < array->length(); ++i) {
+      if (typed->IsValid(i)) {
+        distinct.emplace(typed->GetView(i));
+        data_size += typed->value_length(i);
+        if (static_cast<int64_t>(distinct.size()) * 2 > valid) {
+          return Status::OK();
+        }
+      }
+    }
+    repeated = true;
+    return Status::OK();
+  }
+};
+
+template <template <typename> class VISITOR, typename... Args>
+bool visit_binary_type(std::shared_ptr<arrow::DataType> const& type,
+                       Status& status, Args&&... args) {
+  switch (type->id()) {
+  case arrow::Type::BINARY:
+    status = VISITOR<arrow::BinaryType>::Visit(std::forward<Args>(args)...);
+    return true;
+  case arrow::Type::STRING:
+    status = VISITOR<arrow::StringType>::Visit(std::forward<Args>(args)...);
+    return true;
+  case arrow::Type::LARGE_BINARY:
+    status =
+        VISITOR<arrow::LargeBinaryType>::Visit(std::forward<Args>(args)...);
+    return true;
+  case arrow::Type::LARGE_STRING:
+    status =
+        VISITOR<arrow::LargeStringType>::Visit(std::forward<Args>(args)...);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * The LZ4 payload:
+ *
+ *    | plain size | LZ4 frame of the plain payload |
+ */
+Status encode_lz4(std::shared_ptr<arrow::Buffer> const& plain,
+                  PayloadWriter& writer, bool& applicable) {
+  auto codec = arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME);
+  if (!codec.ok()) {
+    // arrow is built without lz4
+    applicable = false;
+    return Status::OK();
+  }
+  auto const& compressor = codec.ValueOrDie();
+  int64_t bound = compressor->MaxCompressedLen(plain->size(), plain->data());
+  writer.Append<int64_t>(plain->size());
+  size_t offset = writer.size();
+  writer.Resize(offset + bound);
+  int64_t compressed = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      compressed, compressor->Compress(plain->size(), plain->data(), bound,
+                                       writer.mutable_data() + offset));
+  writer.Resize(offset + compressed);
+  applicable = static_cast<int64_t>(writer.size()) < plain->size();
+  return Status::OK();
+}
+
+Status decode_lz4(PayloadReader& reader, int64_t size,
+                  std::shared_ptr<arrow::Array>& array) {
+  int64_t plain_size = 0;
+  const uint8_t* data = nullptr;
+  RETURN_ON_ERROR(reader.Read(plain_size));
+  RETURN_ON_ERROR(reader.Read(size - sizeof(int64_t), data));
+  std::unique_ptr<arrow::util::Codec> codec;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      codec, arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME));
+  std::shared_ptr<arrow::Buffer> plain;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(plain, arrow::AllocateBuffer(plain_size));
+  int64_t decompressed = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      decompressed,
+      codec->Decompress(size - sizeof(int64_t), data, plain_size,
+                        plain->mutable_data()));
+  RETURN_ON_ASSERT(decompressed == plain_size, "Truncated LZ4 frame");
+  return deserialize_column(plain, array);
+}
+
+/**
+ * Chooses the encoding by the column statistics: the smallest one among the
+ * plain, run-length and frame-of-reference encodings for integers, and the
+ * dictionary encoding for strings whose values repeat twice in average, or
+ * else LZ4 for large string columns.
+ */
+ColumnEncoding choose_encoding(std::shared_ptr<arrow::Array> const& array) {
+  int64_t length = array->length();
+  if (length == 0) {
+    return ColumnEncoding::kPlain;
+  }
+  IntegerLayout layout = {0, false};
+  if (integer_layout(array->type(), layout)) {
+    const uint8_t* values = integer_values(*array, layout);
+    IntegerStats stats = integer_stats(
+        length, [&](int64_t i) { return load_key(values, i, layout); },
+        [&](int64_t i) { return array->IsValid(i); });
+    int64_t plain_size = length * layout.width;
+    int64_t for_size =
+        (length * bit_width(stats.max_key - stats.min_key) + 7) / 8 +
+        (array->null_count() > 0 ? length / 8 : 0);
+    int64_t rle_size = array->null_count() > 0
+                           ? std::numeric_limits<int64_t>::max()
+                           : stats.runs * 16;
+    if (rle_size < for_size && rle_size < plain_size) {
+      return ColumnEncoding::kRunLength;
+    }
+    if (for_size < plain_size) {
+      return ColumnEncoding::kFrameOfReference;
+    }
+    return ColumnEncoding::kPlain;
+  }
+
+  Status status;
+  bool repeated = false;
+  int64_t data_size = 0;
+  bool binary = visit_binary_type<RepetitionCounter>(
+      array->type(), status, array, repeated, data_size);
+  if (binary && repeated) {
+    return ColumnEncoding::kDictionary;
+  }
+  if (binary && data_size >= 4096) {
+    return ColumnEncoding::kLZ4;
+  }
+  return ColumnEncoding::kPlain;
+}
+
+Status encode_column(std::shared_ptr<arrow::Field> const& field,
+                     std::shared_ptr<arrow::Array> const& array,
+                     ColumnEncoding requested, ColumnEncoding& encoding,
+                     std::shared_ptr<arrow::Buffer>& payload) {
+  if (requested == ColumnEncoding::kAuto) {
+    requested = choose_encoding(array);
+  }
+  IntegerLayout layout = {0, false};
+  bool integer = integer_layout(array->type(), layout);
+  PayloadWriter writer;
+  if (requested == ColumnEncoding::kRunLength && array->null_count() > 0) {
+    // runs don't track nulls
+    requested = ColumnEncoding::kFrameOfReference;
+  }
+  switch (requested) {
+  case ColumnEncoding::kRunLength: {
+    if (integer) {
+      RETURN_ON_ERROR(encode_run_length(array, layout, writer));
+      encoding = requested;
+      payload = writer.Finish();
+      return Status::OK();
+    }
+    break;
+  }
+  case ColumnEncoding::kFrameOfReference: {
+    if (integer) {
+      RETURN_ON_ERROR(encode_frame_of_reference(array, layout, writer));
+      encoding = requested;
+      payload = writer.Finish();
+      return Status::OK();
+    }
+    break;
+  }
+  case ColumnEncoding::kDictionary: {
+    Status status;
+    if (visit_binary_type<DictionaryEncoder>(array->type(), status, field,
+                                             array, writer)) {
+      RETURN_ON_ERROR(status);
+      encoding = requested;
+      payload = writer.Finish();
+      return Status::OK();
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  std::shared_ptr<arrow::Buffer> plain;
+  RETURN_ON_ERROR(serialize_column(field, array, plain));
+  if (requested == ColumnEncoding::kLZ4) {
+    bool applicable = false;
+    RETURN_ON_ERROR(encode_lz4(plain, writer, applicable));
+    if (applicable) {
+      encoding = requested;
+      payload = writer.Finish();
+      return Status::OK();
+    }
+  }
+  encoding = ColumnEncoding::kPlain;
+  payload = plain;
+  return Status::OK();
+}
+
+Status decode_column(std::shared_ptr<arrow::Field> const& field,
+                     int64_t length, ColumnEncoding encoding,
+                     std::shared_ptr<arrow::Buffer> const& payload,
+                     std::shared_ptr<arrow::Array>& array) {
+  PayloadReader reader(payload);
+  IntegerLayout layout = {0, false};
+  bool integer = integer_layout(field->type(), layout);
+  switch (encoding) {
+  case ColumnEncoding::kPlain:
+    RETURN_ON_ERROR(deserialize_column(payload, array));
+    break;
+  case ColumnEncoding::kRunLength:
+    RETURN_ON_ASSERT(integer, "Run-length encoding requires integers");
+    RETURN_ON_ERROR(
+        decode_run_length(field->type(), layout, reader, length, array));
+    break;
+  case ColumnEncoding::kFrameOfReference:
+    RETURN_ON_ASSERT(integer, "Frame-of-reference encoding requires integers");
+    RETURN_ON_ERROR(decode_frame_of_reference(field->type(), layout, reader,
+                                              length, array));
+    break;
+  case ColumnEncoding::kDictionary: {
+    Status status;
+    bool binary = visit_binary_type<DictionaryDecoder>(field->type(), status,
+                                                       reader, length, array);
+    RETURN_ON_ASSERT(binary, "Dictionary encoding requires binaries");
+    RETURN_ON_ERROR(status);
+    break;
+  }
+  case ColumnEncoding::kLZ4:
+    RETURN_ON_ERROR(decode_lz4(reader, payload->size(), array));
+    break;
+  default:
+    return Status::Invalid("Unknown column encoding: " +
+                           std::to_string(static_cast<int>(encoding)));
+  }
+  RETURN_ON_ASSERT(array->length() == length,
+                   "The length of the decoded column doesn't match");
+  return Status::OK();
+}
+
+/**
+ * @brief The content of a retained stream chunk, which keeps the chunk alive.
+ */
+class StreamChunkBuffer : public arrow::Buffer {
+ public:
+  explicit StreamChunkBuffer(std::shared_ptr<Blob> const& chunk)
+      : arrow::Buffer(reinterpret_cast<const uint8_t*>(chunk->data()),
+                      chunk->allocated_size()),
+        chunk_(chunk) {}
+
+ private:
+  std::shared_ptr<Blob> chunk_;
+};
+
+}  // namespace detail
+
+Status EncodeRecordBatch(Client& client,
+                         std::shared_ptr<arrow::RecordBatch> const& batch,
+                         BatchEncodingOptions const& options,
+                         std::shared_ptr<Object>& chunk) {
+  auto schema = batch->schema();
+  int num_columns = batch->num_columns();
+  std::vector<ColumnEncoding> encodings(num_columns);
+  std::vector<std::shared_ptr<arrow::Buffer>> payloads(num_columns);
+  std::vector<Status> statuses(num_columns);
+  int concurrency = std::max(1, std::min(options.concurrency, num_columns));
+  parallel_for(
+      0, num_columns,
+      [&](int i) {
+        auto field = schema->field(i);
+        ColumnEncoding requested = options.encoding;
+        auto iter = options.column_encodings.find(field->name());
+        if (iter != options.column_encodings.end()) {
+          requested = iter->second;
+        }
+        statuses[i] = detail::encode_column(field, batch->column(i), requested,
+                                            encodings[i], payloads[i]);
+      },
+      concurrency, 1);
+  for (auto const& status : statuses) {
+    RETURN_ON_ERROR(status);
+  }
+
+  std::shared_ptr<arrow::Buffer> schema_buffer;
+  RETURN_ON_ERROR(SerializeSchema(*schema, &schema_buffer));
+
+  detail::EncodedBatchHeader header;
+  header.magic = detail::kEncodedBatchMagic;
+  header.version = detail::kEncodedBatchVersion;
+  header.num_rows = batch->num_rows();
+  header.num_columns = num_columns;
+  header.schema_offset = detail::align_up(
+      sizeof(detail::EncodedBatchHeader) +
+          num_columns * sizeof(detail::EncodedColumnHeader),
+      detail::kPayloadAlignment);
+  header.schema_size = schema_buffer->size();
+  std::vector<detail::EncodedColumnHeader> columns(num_columns);
+  int64_t offset = header.schema_offset + header.schema_size;
+  for (int i = 0; i < num_columns; ++i) {
+    memset(&columns[i], 0, sizeof(detail::EncodedColumnHeader));
+    columns[i].encoding = static_cast<uint8_t>(encodings[i]);
+    columns[i].offset = detail::align_up(offset, detail::kPayloadAlignment);
+    columns[i].size = payloads[i]->size();
+    offset = columns[i].offset + columns[i].size;
+  }
+  header.total_size = offset;
+
+  std::unique_ptr<BlobWriter> writer;
+  RETURN_ON_ERROR(client.CreateBlob(header.total_size, writer));
+  uint8_t* data = reinterpret_cast<uint8_t*>(writer->data());
+  memcpy(data, &header, sizeof(detail::EncodedBatchHeader));
+  memcpy(data + sizeof(detail::EncodedBatchHeader), columns.data(),
+         num_columns * sizeof(detail::EncodedColumnHeader));
+  memcpy(data + header.schema_offset, schema_buffer->data(),
+         schema_buffer->size());
+  parallel_for(
+      0, num_columns,
+      [&](int i) {
+        memcpy(data + columns[i].offset, payloads[i]->data(),
+               payloads[i]->size());
+      },
+      concurrency, 1);
+  return writer->Seal(client, chunk);
+}
+
+bool IsEncodedRecordBatch(std::shared_ptr<arrow::Buffer> const& buffer) {
+  uint32_t magic = 0;
+  if (buffer == nullptr ||
+      buffer->size() <
+          static_cast<int64_t>(sizeof(detail::EncodedBatchHeader))) {
+    return false;
+  }
+  memcpy(&magic, buffer->data(), sizeof(uint32_t));
+  return magic == detail::kEncodedBatchMagic;
+}
+
+Status EncodedRecordBatch::Make(std::shared_ptr<arrow::Buffer> const& buffer,
+                                std::shared_ptr<EncodedRecordBatch>& batch) {
+  RETURN_ON_ASSERT(IsEncodedRecordBatch(buffer),
+                   "Not an encoded record batch");
+  detail::EncodedBatchHeader header;
+  memcpy(&header, buffer->data(), sizeof(detail::EncodedBatchHeader));
+  if (header.version != detail::kEncodedBatchVersion) {
+    return Status::Invalid("Unsupported encoded record batch version: " +
+                           std::to_string(header.version));
+  }
+  int64_t columns_end =
+      sizeof(detail::EncodedBatchHeader) +
+      header.num_columns * sizeof(detail::EncodedColumnHeader);
+  RETURN_ON_ASSERT(header.num_columns >= 0 &&
+                       header.total_size <= buffer->size() &&
+                       columns_end <= header.schema_offset &&
+                       header.schema_offset + header.schema_size <=
+                           header.total_size,
+                   "The encoded record batch is truncated");
+
+  batch = std::shared_ptr<EncodedRecordBatch>(new EncodedRecordBatch());
+  batch->buffer_ = buffer;
+  batch->num_rows_ = header.num_rows;
+  RETURN_ON_ERROR(DeserializeSchema(
+      arrow::SliceBuffer(buffer, header.schema_offset, header.schema_size),
+      &batch->schema_));
+  RETURN_ON_ASSERT(batch->schema_->num_fields() == header.num_columns,
+                   "The schema doesn't match the columns");
+
+  const uint8_t* columns = buffer->data() + sizeof(detail::EncodedBatchHeader);
+  for (int64_t i = 0; i < header.num_columns; ++i) {
+    detail::EncodedColumnHeader column;
+    memcpy(&column, columns + i * sizeof(detail::EncodedColumnHeader),
+           sizeof(detail::EncodedColumnHeader));
+    RETURN_ON_ASSERT(column.offset >= 0 && column.size >= 0 &&
+                         column.offset + column.size <= header.total_size,
+                     "The encoded column is out of range");
+    batch->encodings_.emplace_back(
+        static_cast<ColumnEncoding>(column.encoding));
+    batch->payloads_.emplace_back(
+        arrow::SliceBuffer(buffer, column.offset, column.size));
+  }
+  batch->decoded_.reset(new std::once_flag[header.num_columns]);
+  batch->statuses_.resize(header.num_columns);
+  batch->columns_.resize(header.num_columns);
+  return Status::OK();
+}
+
+Status EncodedRecordBatch::column(int i, std::shared_ptr<arrow::Array>& array) {
+  RETURN_ON_ASSERT(i >= 0 && i < num_columns(), "Column index out of range");
+  std::call_once(decoded_[i], [this, i]() {
+    statuses_[i] =
+        detail::decode_column(schema_->field(i), num_rows_, encodings_[i],
+                              payloads_[i], columns_[i]);
+  });
+  RETURN_ON_ERROR(statuses_[i]);
+  array = columns_[i];
+  return Status::OK();
+}
+
+Status EncodedRecordBatch::ToRecordBatch(
+    std::shared_ptr<arrow::RecordBatch>& batch, int concurrency) {
+  std::vector<std::shared_ptr<arrow::Array>> columns(num_columns());
+  std::vector<Status> statuses(num_columns());
+  if (concurrency > 1 && num_columns() > 1) {
+    parallel_for(
+        0, num_columns(), [&](int i) { statuses[i] = column(i, columns[i]); },
+        std::min(concurrency, num_columns()), 1);
+  } else {
+    for (int i = 0; i < num_columns(); ++i) {
+      statuses[i] = column(i, columns[i]);
+    }
+  }
+  for (auto const& status : statuses) {
+    RETURN_ON_ERROR(status);
+  }
+  batch = arrow::RecordBatch::Make(schema_, num_rows_, columns);
+  return Status::OK();
+}
+
+Status PushEncodedRecordBatch(Client& client, ObjectID const stream_id,
+                              std::shared_ptr<arrow::RecordBatch> const& batch,
+                              BatchEncodingOptions const& options) {
+  std::shared_ptr<Object> chunk;
+  RETURN_ON_ERROR(EncodeRecordBatch(client, batch, options, chunk));
+  auto status = client.PushNextStreamChunk(stream_id, chunk->id(), true);
+  if (!status.ok()) {
+    VINEYARD_DISCARD(client.DelData(chunk->id()));
+    return status;
+  }
+  // the chunk is reclaimed once the reader releases it as well
+  return client.Release(chunk->id());
+}
+
+Status RetainedStreamChunks::Pull(Client& client, ObjectID const stream_id,
+                                  std::shared_ptr<Object>& chunk,
+                                  std::shared_ptr<arrow::Buffer>& buffer,
+                                  bool& retained) {
+  RETURN_ON_ERROR(Release(client));
+  ObjectID chunk_id = InvalidObjectID();
+  RETURN_ON_ERROR(client.PullNextStreamChunk(stream_id, chunk_id, retained));
+  RETURN_ON_ERROR(client.GetObject(chunk_id, chunk));
+  buffer = nullptr;
+  if (auto blob = std::dynamic_pointer_cast<Blob>(chunk)) {
+    if (retained) {
+      buffer = std::make_shared<detail::StreamChunkBuffer>(blob);
+      chunks_.emplace_back(chunk_id, buffer);
+    } else {
+      buffer = blob->ArrowBuffer();
+    }
+  } else if (retained) {
+    VINEYARD_DISCARD(client.Release(chunk_id));
+    retained = false;
+  }
+  return Status::OK();
+}
+
+Status RetainedStreamChunks::Release(Client& client) {
+  Status status;
+  auto iter = chunks_.begin();
+  while (iter != chunks_.end()) {
+    if (iter->second.expired()) {
+      status += client.Release(iter->first);
+      iter = chunks_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return status;
+}
+
+Status ReadRecordBatchFromChunk(std::shared_ptr<arrow::Buffer> const& buffer,
+                                bool const retained, bool const copy,
+                                std::shared_ptr<arrow::RecordBatch>& batch) {
+  if (IsEncodedRecordBatch(buffer)) {
+    std::shared_ptr<EncodedRecordBatch> encoded;
+    RETURN_ON_ERROR(EncodedRecordBatch::Make(buffer, encoded));
+    RETURN_ON_ERROR(
+        encoded->ToRecordBatch(batch, std::thread::hardware_concurrency()));
+  } else {
+    RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
+  }
+  if (!retained && copy && batch != nullptr) {
+    RETURN_ON_ERROR(detail::Copy(batch, batch, false));
+  }
+  return Status::OK();
+}
+
+}  // namespace vineyard
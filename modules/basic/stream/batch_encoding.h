@@ -0,0 +1,200 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_BASIC_STREAM_BATCH_ENCODING_H_
+#define MODULES_BASIC_STREAM_BATCH_ENCODING_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * @brief The lightweight encodings of a column inside an encoded record batch
+ * chunk.
+ *
+ *  - `kPlain`: the arrow IPC message of the column, decoded zero-copy.
+ *  - `kDictionary`: the distinct values and bit-packed indices, for string
+ *    and binary columns.
+ *  - `kRunLength`: the (value, run end) pairs, for integer columns without
+ *    nulls.
+ *  - `kFrameOfReference`: the minimum and the bit-packed deltas, for integer
+ *    columns (including dates, times, timestamps and durations).
+ *  - `kLZ4`: the LZ4 frame of the plain encoding, for any column.
+ *
+ * `kAuto` chooses the encoding by the statistics of each column. An encoding
+ * that doesn't apply to the column type falls back to `kPlain`.
+ */
+enum class ColumnEncoding : uint8_t {
+  kPlain = 0,
+  kDictionary = 1,
+  kRunLength = 2,
+  kFrameOfReference = 3,
+  kLZ4 = 4,
+  kAuto = 255,
+};
+
+const char* column_encoding_name(ColumnEncoding encoding);
+
+struct BatchEncodingOptions {
+  /// The encoding of the columns that are not listed in `column_encodings`.
+  ColumnEncoding encoding = ColumnEncoding::kAuto;
+  /// The encodings of specific columns, by field name.
+  std::unordered_map<std::string, ColumnEncoding> column_encodings;
+  /// The columns are encoded in parallel.
+  int concurrency = std::thread::hardware_concurrency();
+};
+
+/**
+ * @brief Encode the record batch into a single self-described blob, which can
+ * be pushed to a `RecordBatchStream` or `DataframeStream` as a chunk.
+ */
+Status EncodeRecordBatch(Client& client,
+                         std::shared_ptr<arrow::RecordBatch> const& batch,
+                         BatchEncodingOptions const& options,
+                         std::shared_ptr<Object>& chunk);
+
+/**
+ * @brief Whether the buffer holds an encoded record batch, rather than an
+ * arrow IPC message.
+ */
+bool IsEncodedRecordBatch(std::shared_ptr<arrow::Buffer> const& buffer);
+
+/**
+ * @brief EncodedRecordBatch is a view of an encoded record batch chunk, where
+ * the columns are decoded on the first access and then cached.
+ *
+ * Plain columns reference the chunk buffer without copying, the view (and
+ * the arrays it returns) keeps the buffer alive.
+ */
+class EncodedRecordBatch {
+ public:
+  static Status Make(std::shared_ptr<arrow::Buffer> const& buffer,
+                     std::shared_ptr<EncodedRecordBatch>& batch);
+
+  std::shared_ptr<arrow::Schema> const& schema() const { return schema_; }
+
+  int64_t num_rows() const { return num_rows_; }
+
+  int num_columns() const { return schema_->num_fields(); }
+
+  ColumnEncoding encoding(int i) const { return encodings_[i]; }
+
+  /**
+   * @brief The bytes of the i-th column inside the chunk.
+   */
+  int64_t encoded_size(int i) const { return payloads_[i]->size(); }
+
+  /**
+   * @brief The bytes of the whole chunk.
+   */
+  int64_t encoded_size() const { return buffer_->size(); }
+
+  /**
+   * @brief Decode the i-th column, which is safe to be called concurrently.
+   */
+  Status column(int i, std::shared_ptr<arrow::Array>& array);
+
+  /**
+   * @brief Decode all columns, in parallel.
+   */
+  Status ToRecordBatch(std::shared_ptr<arrow::RecordBatch>& batch,
+                       int concurrency = 1);
+
+ private:
+  EncodedRecordBatch() = default;
+
+  std::shared_ptr<arrow::Buffer> buffer_;
+  std::shared_ptr<arrow::Schema> schema_;
+  int64_t num_rows_ = 0;
+  std::vector<ColumnEncoding> encodings_;
+  std::vector<std::shared_ptr<arrow::Buffer>> payloads_;
+
+  std::unique_ptr<std::once_flag[]> decoded_;
+  std::vector<Status> statuses_;
+  std::vector<std::shared_ptr<arrow::Array>> columns_;
+};
+
+/**
+ * @brief Encode the record batch and push it to the stream as a retained
+ * chunk, see also `ClientBase::PushNextStreamChunk(id, chunk, retained)`.
+ *
+ * The writer's reference to the chunk is released once it has been pushed.
+ */
+Status PushEncodedRecordBatch(Client& client, ObjectID const stream_id,
+                              std::shared_ptr<arrow::RecordBatch> const& batch,
+                              BatchEncodingOptions const& options);
+
+/**
+ * @brief RetainedStreamChunks tracks the retained blob chunks that the reader
+ * pulled from a stream.
+ *
+ * A retained chunk is read through an arrow buffer that keeps it alive, while
+ * the reader's reference to the chunk is released explicitly by `Release()`
+ * once that buffer, and every buffer sliced from it (e.g., the columns of a
+ * batch read from it), has been destroyed. Neither of the buffers references
+ * the client, and the chunks that are still in use when the reader
+ * disconnects are reclaimed by the server then.
+ */
+class RetainedStreamChunks {
+ public:
+  /**
+   * @brief Pull the next chunk from the stream, after releasing the chunks
+   * that are no longer in use.
+   *
+   * For a blob chunk, `buffer` is its content, which retains the chunk if it
+   * was pushed as a retained chunk, and otherwise is only valid until the
+   * next pull.
+   */
+  Status Pull(Client& client, ObjectID const stream_id,
+              std::shared_ptr<Object>& chunk,
+              std::shared_ptr<arrow::Buffer>& buffer, bool& retained);
+
+  /**
+   * @brief Release the reader's reference to the retained chunks that are no
+   * longer in use.
+   */
+  Status Release(Client& client);
+
+ private:
+  std::vector<std::pair<ObjectID, std::weak_ptr<arrow::Buffer>>> chunks_;
+};
+
+/**
+ * @brief Read the record batch from the content of a blob chunk, which is
+ * either an arrow IPC message or an encoded record batch, whose columns are
+ * decoded in parallel.
+ *
+ * The batch references the buffer without copying, unless `copy` is requested
+ * for a chunk that isn't retained.
+ */
+Status ReadRecordBatchFromChunk(std::shared_ptr<arrow::Buffer> const& buffer,
+                                bool const retained, bool const copy,
+                                std::shared_ptr<arrow::RecordBatch>& batch);
+
+}  // namespace vineyard
+
+#endif  // MODULES_BASIC_STREAM_BATCH_ENCODING_H_
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "basic/stream/byte_stream.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -31,49 +33,138 @@ limitations under the License.
 
 namespace vineyard {
 
+ByteStream::~ByteStream() {
+  if (write_chunk_ != nullptr && this->client_ != nullptr) {
+    VINEYARD_DISCARD(write_chunk_->Abort(*this->client_));
+  }
+}
+
 Status ByteStream::WriteBytes(const char* ptr, size_t len) {
-  RETURN_ON_ARROW_ERROR(builder_.Append(ptr, len));
-  if (builder_.length() + len > buffer_size_limit_) {
-    RETURN_ON_ERROR(FlushBuffer());
+  while (len > 0) {
+    if (write_chunk_ == nullptr) {
+      RETURN_ON_ERROR(
+          this->client_->CreateBlob(buffer_size_limit_, write_chunk_));
+      write_offset_ = 0;
+    }
+    size_t size = std::min(len, write_chunk_->size() - write_offset_);
+    memcpy(write_chunk_->data() + write_offset_, ptr, size);
+    ptr += size;
+    len -= size;
+    write_offset_ += size;
+    if (write_offset_ == write_chunk_->size()) {
+      RETURN_ON_ERROR(FlushBuffer());
+    }
   }
   return Status::OK();
 }
 
 Status ByteStream::WriteLine(const std::string& line) {
-  RETURN_ON_ARROW_ERROR(builder_.Append(line.c_str(), line.size()));
-  if (builder_.length() + line.length() > buffer_size_limit_) {
+  return WriteBytes(line.data(), line.size());
+}
+
+Status ByteStream::Reserve(size_t size, char*& data) {
+  if (write_chunk_ != nullptr && write_offset_ + size > write_chunk_->size()) {
     RETURN_ON_ERROR(FlushBuffer());
   }
+  if (write_chunk_ == nullptr) {
+    RETURN_ON_ERROR(this->client_->CreateBlob(
+        std::max(size, buffer_size_limit_), write_chunk_));
+    write_offset_ = 0;
+  }
+  data = write_chunk_->data() + write_offset_;
   return Status::OK();
 }
 
-Status ByteStream::FlushBuffer() {
-  std::shared_ptr<arrow::Buffer> buf;
-  RETURN_ON_ARROW_ERROR(builder_.Finish(&buf));
-
-  if (buf->size() > 0) {
-    std::unique_ptr<BlobWriter> buffer;
-    RETURN_ON_ERROR(this->client_->CreateBlob(buf->size(), buffer));
-    memcpy(buffer->data(), buf->data(), buf->size());
+Status ByteStream::Commit(size_t size) {
+  RETURN_ON_ASSERT(
+      write_chunk_ != nullptr && write_offset_ + size <= write_chunk_->size(),
+      "The committed bytes exceed the reserved chunk");
+  write_offset_ += size;
+  if (write_offset_ == write_chunk_->size()) {
+    RETURN_ON_ERROR(FlushBuffer());
   }
   return Status::OK();
 }
 
-Status ByteStream::ReadLine(std::string& line) {
-  if (std::getline(ss_, line)) {
+Status ByteStream::FlushBuffer() {
+  if (write_chunk_ == nullptr) {
     return Status::OK();
   }
-
-  std::shared_ptr<Blob> buffer;
-  if (!this->Next(buffer).ok()) {
-    return Status::EndOfFile();
+  std::unique_ptr<BlobWriter> chunk = std::move(write_chunk_);
+  size_t size = write_offset_;
+  write_offset_ = 0;
+  if (size == 0) {
+    return chunk->Abort(*this->client_);
+  }
+  if (size < chunk->size()) {
+    RETURN_ON_ERROR(chunk->Shrink(*this->client_, size));
   }
-  std::string buf_str = std::string(
-      reinterpret_cast<const char*>(buffer->data()), buffer->size());
-  ss_.str(buf_str);
-  std::getline(ss_, line);
+  std::shared_ptr<Object> blob;
+  RETURN_ON_ERROR(chunk->Seal(*this->client_, blob));
+  return this->Push(blob);
+}
 
+Status ByteStream::Finish() {
+  RETURN_ON_ERROR(FlushBuffer());
+  return Stream<Blob>::Finish();
+}
+
+Status ByteStream::ReadLine(std::string& line) {
+  arrow_string_view view;
+  RETURN_ON_ERROR(ReadRecord('\n', view));
+  line.assign(view.data(), view.size());
   return Status::OK();
 }
 
+Status ByteStream::ReadLine(arrow_string_view& line) {
+  return ReadRecord('\n', line);
+}
+
+Status ByteStream::ReadRecord(const char delimiter, arrow_string_view& record) {
+  bool stitching = false;
+  read_pending_.clear();
+  while (true) {
+    if (read_chunk_ == nullptr || read_offset_ >= read_chunk_->size()) {
+      std::shared_ptr<Blob> chunk;
+      auto status = this->Next(chunk);
+      if (!status.ok()) {
+        read_chunk_ = nullptr;
+        if (!status.IsStreamDrained()) {
+          return status;
+        }
+        if (stitching) {
+          // the last record is not terminated by the delimiter
+          record = arrow_string_view(read_pending_);
+          return Status::OK();
+        }
+        return Status::EndOfFile();
+      }
+      read_chunk_ = chunk;
+      read_offset_ = 0;
+      continue;
+    }
+
+    const char* begin =
+        reinterpret_cast<const char*>(read_chunk_->data()) + read_offset_;
+    size_t remaining = read_chunk_->size() - read_offset_;
+    const char* end =
+        static_cast<const char*>(memchr(begin, delimiter, remaining));
+    if (end == nullptr) {
+      read_pending_.append(begin, remaining);
+      read_offset_ += remaining;
+      stitching = true;
+      continue;
+    }
+    size_t size = end - begin;
+    read_offset_ += size + 1;
+    if (stitching) {
+      read_pending_.append(begin, size);
+      record = arrow_string_view(read_pending_);
+    } else {
+      record = arrow_string_view(begin, size);
+    }
+    return Status::OK();
+  }
+}
+
 }  // namespace vineyard
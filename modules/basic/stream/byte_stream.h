@@ -28,6 +28,7 @@ limitations under the License.
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
 #include "client/ds/stream.h"
+#include "common/util/arrow.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
@@ -39,21 +40,77 @@ class ByteStream : public BareRegistered<ByteStream>, public Stream<Blob> {
         std::unique_ptr<ByteStream>{new ByteStream()});
   }
 
+  /**
+   * @brief The chunk that is still being written is aborted, i.e., bytes
+   * written after the last `FlushBuffer` or `Finish` are discarded.
+   */
+  ~ByteStream() override;
+
+  /**
+   * @brief Set the capacity of the chunks allocated by the writer.
+   */
   void SetBufferSizeLimit(size_t limit) { buffer_size_limit_ = limit; }
 
+  /**
+   * @brief Append bytes to the stream, the bytes are copied into the current
+   * chunk directly, and may span several chunks.
+   */
   Status WriteBytes(const char* ptr, size_t len);
 
   Status WriteLine(const std::string& line);
 
+  /**
+   * @brief Reserve `size` bytes in the current chunk to be filled in place,
+   * the filled bytes must be appended to the stream by `Commit`. Bytes that
+   * are reserved together never span chunks.
+   *
+   * The pointer is valid until the next write to the stream.
+   */
+  Status Reserve(size_t size, char*& data);
+
+  /**
+   * @brief Append the first `size` bytes filled after the last `Reserve`.
+   */
+  Status Commit(size_t size);
+
+  /**
+   * @brief Seal the current chunk and push it to the stream.
+   */
   Status FlushBuffer();
 
+  /**
+   * @brief Flush the current chunk and then stop the stream.
+   */
+  Status Finish() override;
+
   Status ReadLine(std::string& line);
 
+  /**
+   * @brief Read the next line (without the trailing '\n'). The line is a view
+   * over the mapped chunk, except for lines that span chunk boundaries, which
+   * are stitched into an internal buffer.
+   *
+   * The view is valid until the next read from the stream.
+   */
+  Status ReadLine(arrow_string_view& line);
+
+  /**
+   * @brief Read the next record that terminated by the `delimiter`, see also
+   * `ReadLine`.
+   */
+  Status ReadRecord(const char delimiter, arrow_string_view& record);
+
  protected:
-  size_t buffer_size_limit_ = 1024 * 1024 * 256;  // 256Mi
+  size_t buffer_size_limit_ = 1024 * 1024 * 64;  // 64Mi
+
+  // for write
+  std::unique_ptr<BlobWriter> write_chunk_;
+  size_t write_offset_ = 0;
 
-  arrow::BufferBuilder builder_;  // for write
-  std::stringstream ss_;          // for read
+  // for read
+  std::shared_ptr<Blob> read_chunk_;
+  size_t read_offset_ = 0;
+  std::string read_pending_;
 };
 
 template <>
@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "basic/ds/arrow_utils.h"
 #include "basic/ds/dataframe.h"
+#include "basic/stream/batch_encoding.h"
 #include "client/client.h"
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
@@ -49,6 +50,13 @@ Status DataframeStream::WriteBatch(std::shared_ptr<arrow::RecordBatch> batch) {
   return this->Push(chunk);
 }
 
+Status DataframeStream::WriteBatch(std::shared_ptr<arrow::RecordBatch> batch,
+                                   BatchEncodingOptions const& options) {
+  RETURN_ON_ASSERT(client_ != nullptr && this->readonly_ == false,
+                   "Expect a writeable stream");
+  return PushEncodedRecordBatch(*client_, this->id_, batch, options);
+}
+
 Status DataframeStream::WriteDataframe(std::shared_ptr<DataFrame> df) {
   return this->Push(df);
 }
@@ -86,17 +94,19 @@ Status DataframeStream::ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
   RETURN_ON_ASSERT(client_ != nullptr && this->readonly_ == true,
                    "Expect a readonly stream");
   std::shared_ptr<Object> result = nullptr;
-  RETURN_ON_ERROR(client_->ClientBase::PullNextStreamChunk(this->id_, result));
+  std::shared_ptr<arrow::Buffer> buffer;
+  bool retained = false;
+  RETURN_ON_ERROR(
+      retained_chunks_.Pull(*client_, this->id_, result, buffer, retained));
 
   if (auto chunk = std::dynamic_pointer_cast<DataFrame>(result)) {
     batch = chunk->AsBatch();
-  }
-  if (auto chunk = std::dynamic_pointer_cast<RecordBatch>(result)) {
+  } else if (auto chunk = std::dynamic_pointer_cast<RecordBatch>(result)) {
     batch = chunk->GetRecordBatch();
-  } else if (auto chunk = std::dynamic_pointer_cast<Blob>(result)) {
-    auto buffer = chunk->ArrowBuffer();
-    RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
+  } else if (buffer != nullptr) {
+    RETURN_ON_ERROR(ReadRecordBatchFromChunk(buffer, retained, copy, batch));
     batch = AddMetadataToRecordBatch(batch, params_);
+    return Status::OK();
   } else {
     return Status::Invalid("Failed to cast object with type '" +
                            result->meta().GetTypeName() + "' to type '" +
@@ -108,6 +118,22 @@ Status DataframeStream::ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
   return Status::OK();
 }
 
+Status DataframeStream::ReadEncodedBatch(
+    std::shared_ptr<EncodedRecordBatch>& batch) {
+  RETURN_ON_ASSERT(client_ != nullptr && this->readonly_ == true,
+                   "Expect a readonly stream");
+  std::shared_ptr<Object> result = nullptr;
+  std::shared_ptr<arrow::Buffer> buffer;
+  bool retained = false;
+  RETURN_ON_ERROR(
+      retained_chunks_.Pull(*client_, this->id_, result, buffer, retained));
+  if (buffer == nullptr) {
+    return Status::Invalid("Expect an encoded record batch, but got '" +
+                           result->meta().GetTypeName() + "'");
+  }
+  return EncodedRecordBatch::Make(buffer, batch);
+}
+
 Status DataframeStream::GetHeaderLine(bool& header_row,
                                       std::string& header_line) {
   auto params =
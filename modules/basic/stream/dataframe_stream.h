@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 
 #include "basic/ds/dataframe.h"
+#include "basic/stream/batch_encoding.h"
 #include "client/client.h"
 
 namespace vineyard {
@@ -38,6 +39,13 @@ class DataframeStream : public BareRegistered<DataframeStream>,
 
   Status WriteBatch(std::shared_ptr<arrow::RecordBatch> batch);
 
+  /**
+   * @brief Write the batch as an encoded chunk, see also
+   * `PushEncodedRecordBatch`.
+   */
+  Status WriteBatch(std::shared_ptr<arrow::RecordBatch> batch,
+                    BatchEncodingOptions const& options);
+
   Status WriteDataframe(std::shared_ptr<DataFrame> df);
 
   Status ReadRecordBatches(
@@ -45,9 +53,25 @@ class DataframeStream : public BareRegistered<DataframeStream>,
 
   Status ReadTable(std::shared_ptr<arrow::Table>& table);
 
+  /**
+   * @brief Read the next batch. The batch read from a chunk that is written by
+   * `WriteBatch(batch, options)` retains the chunk without copying, while
+   * other batches are only valid until the next read, unless `copy` is
+   * requested.
+   */
   Status ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch, const bool copy);
 
+  /**
+   * @brief Read the next encoded chunk, whose columns are decoded on the first
+   * access. The chunk is retained by the returned batch if it is written by
+   * `WriteBatch(batch, options)`.
+   */
+  Status ReadEncodedBatch(std::shared_ptr<EncodedRecordBatch>& batch);
+
   Status GetHeaderLine(bool& header_row, std::string& header_line);
+
+ private:
+  RetainedStreamChunks retained_chunks_;
 };
 
 template <>
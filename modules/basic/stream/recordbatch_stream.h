@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "basic/ds/arrow.h"
 #include "basic/ds/dataframe.h"
+#include "basic/stream/batch_encoding.h"
 #include "client/client.h"
 #include "client/ds/stream.h"
 
@@ -40,6 +41,13 @@ class RecordBatchStream : public BareRegistered<RecordBatchStream>,
 
   Status WriteBatch(std::shared_ptr<arrow::RecordBatch> const& batch);
 
+  /**
+   * @brief Write the batch as an encoded chunk, see also
+   * `PushEncodedRecordBatch`.
+   */
+  Status WriteBatch(std::shared_ptr<arrow::RecordBatch> const& batch,
+                    BatchEncodingOptions const& options);
+
   Status WriteDataframe(std::shared_ptr<DataFrame> const& df);
 
   Status ReadRecordBatches(
@@ -47,8 +55,24 @@ class RecordBatchStream : public BareRegistered<RecordBatchStream>,
 
   Status ReadTable(std::shared_ptr<arrow::Table>& table);
 
+  /**
+   * @brief Read the next batch. The batch read from a chunk that is written by
+   * `WriteBatch(batch, options)` retains the chunk without copying, while
+   * other batches are only valid until the next read, unless `copy` is
+   * requested.
+   */
   Status ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
                    bool const copy = false);
+
+  /**
+   * @brief Read the next encoded chunk, whose columns are decoded on the first
+   * access. The chunk is retained by the returned batch if it is written by
+   * `WriteBatch(batch, options)`.
+   */
+  Status ReadEncodedBatch(std::shared_ptr<EncodedRecordBatch>& batch);
+
+ private:
+  RetainedStreamChunks retained_chunks_;
 };
 
 template <>
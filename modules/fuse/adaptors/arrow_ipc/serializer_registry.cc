@@ -18,7 +18,9 @@ limitations under the License.
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "arrow/api.h"
@@ -131,5 +133,161 @@ void from_arrow_view(Client* client, std::string const& path,
   from_arrow_view(client, path, fp.get());
 }
 
+namespace {
+
+// assembles a table from the record batches that have already been sealed
+class SealedBatchesTableBuilder : public TableBuilder {
+ public:
+  SealedBatchesTableBuilder(
+      Client& client, const std::shared_ptr<arrow::Schema>& schema,
+      const std::vector<std::shared_ptr<Object>>& batches,
+      const size_t num_rows)
+      : TableBuilder(client, nullptr),
+        schema_(schema),
+        batches_(batches),
+        num_rows_(num_rows) {}
+
+  Status Build(Client& client) override {
+    this->set_batch_num_(batches_.size());
+    this->set_num_rows_(num_rows_);
+    this->set_num_columns_(schema_->num_fields());
+    for (auto const& batch : batches_) {
+      this->AddMember(batch);
+    }
+    return this->set_schema(schema_);
+  }
+
+ private:
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<std::shared_ptr<Object>> batches_;
+  size_t num_rows_ = 0;
+};
+
+}  // namespace
+
+class ArrowStreamConverter::Listener : public arrow::ipc::Listener {
+ public:
+  explicit Listener(ArrowStreamConverter* converter) : converter_(converter) {}
+
+  arrow::Status OnSchemaDecoded(
+      std::shared_ptr<arrow::Schema> schema) override {
+    std::lock_guard<std::mutex> guard(converter_->mutex_);
+    converter_->schema_ = schema;
+    return arrow::Status::OK();
+  }
+
+  arrow::Status OnRecordBatchDecoded(
+      std::shared_ptr<arrow::RecordBatch> batch) override {
+    converter_->queue_.Push(task_t(index_++, batch));
+    return arrow::Status::OK();
+  }
+
+ private:
+  ArrowStreamConverter* converter_;
+  size_t index_ = 0;
+};
+
+ArrowStreamConverter::ArrowStreamConverter(Client* client,
+                                           const size_t concurrency)
+    : client_(client),
+      buffer_(client, [this](const std::shared_ptr<arrow::Buffer>& buffer) {
+        return this->consume(buffer);
+      }) {
+  decoder_ = std::make_shared<arrow::ipc::StreamDecoder>(
+      std::make_shared<Listener>(this));
+  size_t parallelism = std::max(concurrency, static_cast<size_t>(1));
+  // bounds the memory held by the decoded but not yet sealed batches
+  queue_.SetLimit(parallelism * 2);
+  for (size_t i = 0; i < parallelism; ++i) {
+    workers_.emplace_back([this]() {
+      while (true) {
+        auto task = queue_.Pop();
+        if (task.second == nullptr) {
+          break;
+        }
+        this->seal(task.first, task.second);
+      }
+    });
+  }
+}
+
+ArrowStreamConverter::~ArrowStreamConverter() {
+  stopWorkers();
+  if (!finished_) {
+    // the file is abandoned, drop the batches that have been sealed
+    std::vector<ObjectID> ids;
+    for (auto const& batch : batches_) {
+      if (batch != nullptr) {
+        ids.emplace_back(batch->id());
+      }
+    }
+    VINEYARD_DISCARD(client_->DelData(ids, true, true));
+  }
+}
+
+Status ArrowStreamConverter::Write(const void* data, const int64_t nbytes,
+                                   const int64_t offset) {
+  return buffer_.WriteAt(offset, data, nbytes);
+}
+
+Status ArrowStreamConverter::Finish(std::string const& path) {
+  RETURN_ON_ERROR(buffer_.Finish());
+  stopWorkers();
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  RETURN_ON_ERROR(status_);
+  if (schema_ == nullptr) {
+    return Status::Invalid("No arrow schema has been written to '" + path +
+                           "'");
+  }
+  SealedBatchesTableBuilder builder(*client_, schema_, batches_, num_rows_);
+  std::shared_ptr<Object> table;
+  RETURN_ON_ERROR(builder.Seal(*client_, table));
+  finished_ = true;
+  RETURN_ON_ERROR(client_->Persist(table->id()));
+  DLOG(INFO) << table->meta().ToString();
+  return client_->PutName(table->id(),
+                          path.substr(1, path.length() - 6 /* .arrow */ - 1));
+}
+
+Status ArrowStreamConverter::consume(
+    const std::shared_ptr<arrow::Buffer>& buffer) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    RETURN_ON_ERROR(status_);
+  }
+  // decoding happens on the writing thread in the order of the stream
+  RETURN_ON_ARROW_ERROR(decoder_->Consume(buffer));
+  return Status::OK();
+}
+
+void ArrowStreamConverter::seal(
+    const size_t index, const std::shared_ptr<arrow::RecordBatch>& batch) {
+  RecordBatchBuilder builder(*client_, batch);
+  std::shared_ptr<Object> object;
+  Status status = builder.Seal(*client_, object);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!status.ok()) {
+    status_ += status;
+    return;
+  }
+  if (batches_.size() <= index) {
+    batches_.resize(index + 1);
+  }
+  batches_[index] = object;
+  num_rows_ += batch->num_rows();
+}
+
+void ArrowStreamConverter::stopWorkers() {
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    queue_.Push(task_t(0, nullptr));
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
 }  // namespace fuse
 }  // namespace vineyard
@@ -18,9 +18,18 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/ipc/api.h"
 
 #include "basic/ds/dataframe.h"
 #include "client/client.h"
+#include "common/util/blocking_queue.h"
+
+#include "fuse/adaptors/chunk_buffer/writable_chunk_buffer.h"
 
 namespace vineyard {
 namespace fuse {
@@ -39,6 +48,56 @@ void from_arrow_view(Client* client, std::string const& name,
 void from_arrow_view(Client* client, std::string const& path,
                      std::shared_ptr<arrow::Buffer> buffer);
 
+/**
+ * @brief ArrowStreamConverter converts the arrow IPC stream that is written
+ * to the mount into a vineyard table incrementally.
+ *
+ * Written bytes are staged in a WritableChunkBuffer, record batches are decoded
+ * as soon as the chunks that contain them are complete, and are sealed as
+ * vineyard record batches by a pool of workers in parallel. Closing the file
+ * only waits for the pending batches and seals the table metadata.
+ */
+class ArrowStreamConverter {
+ public:
+  explicit ArrowStreamConverter(
+      Client* client,
+      const size_t concurrency = std::thread::hardware_concurrency());
+
+  ~ArrowStreamConverter();
+
+  Status Write(const void* data, const int64_t nbytes, const int64_t offset);
+
+  int64_t size() const { return buffer_.size(); }
+
+  /**
+   * @brief Seal the table, persist it and name it after the path.
+   */
+  Status Finish(std::string const& path);
+
+ private:
+  class Listener;
+  using task_t = std::pair<size_t, std::shared_ptr<arrow::RecordBatch>>;
+
+  Status consume(const std::shared_ptr<arrow::Buffer>& buffer);
+  void seal(const size_t index,
+            const std::shared_ptr<arrow::RecordBatch>& batch);
+  void stopWorkers();
+
+  Client* client_;
+  internal::WritableChunkBuffer buffer_;
+  std::shared_ptr<arrow::ipc::StreamDecoder> decoder_;
+
+  std::vector<std::thread> workers_;
+  BlockingQueue<task_t> queue_;
+
+  std::mutex mutex_;  // protects the fields below
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<std::shared_ptr<Object>> batches_;
+  size_t num_rows_ = 0;
+  Status status_;
+  bool finished_ = false;
+};
+
 }  // namespace fuse
 }  // namespace vineyard
 
@@ -0,0 +1,156 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "fuse/adaptors/chunk_buffer/writable_chunk_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "client/ds/blob.h"
+#include "common/util/logging.h"
+
+namespace vineyard {
+namespace fuse {
+namespace internal {
+
+struct WritableChunkBuffer::Chunk {
+  Chunk(Client* client, std::unique_ptr<BlobWriter>&& writer)
+      : client(client), writer(std::move(writer)) {}
+
+  ~Chunk() {
+    // the chunk is a staging area, the blob is never sealed
+    VINEYARD_DISCARD(writer->Abort(*client));
+  }
+
+  Client* client;
+  std::unique_ptr<BlobWriter> writer;
+};
+
+namespace {
+
+// keeps the chunk (and its blob) alive as long as the buffer is referenced
+class ChunkSliceBuffer : public arrow::Buffer {
+ public:
+  ChunkSliceBuffer(const uint8_t* data, const int64_t size,
+                   std::shared_ptr<void> chunk)
+      : arrow::Buffer(data, size), chunk_(std::move(chunk)) {}
+
+ private:
+  std::shared_ptr<void> chunk_;
+};
+
+}  // namespace
+
+WritableChunkBuffer::WritableChunkBuffer(Client* client, sink_t sink,
+                                         const int64_t chunk_size)
+    : client_(client), sink_(std::move(sink)), chunk_size_(chunk_size) {}
+
+Status WritableChunkBuffer::WriteAt(const int64_t offset, const void* data,
+                                    const int64_t nbytes) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (nbytes == 0) {
+    return Status::OK();
+  }
+  if (offset < static_cast<int64_t>(fed_chunks_) * chunk_size_) {
+    return Status::Invalid(
+        "Cannot overwrite the bytes that have been converted, offset = " +
+        std::to_string(offset));
+  }
+
+  // allocate the chunks to cover the written range
+  size_t chunk_num = (offset + nbytes + chunk_size_ - 1) / chunk_size_;
+  while (chunks_.size() < chunk_num) {
+    std::unique_ptr<BlobWriter> writer;
+    RETURN_ON_ERROR(client_->CreateBlob(chunk_size_, writer));
+    chunks_.emplace_back(std::make_shared<Chunk>(client_, std::move(writer)));
+  }
+
+  const char* source = static_cast<const char*>(data);
+  int64_t position = offset, remaining = nbytes;
+  while (remaining > 0) {
+    size_t index = position / chunk_size_;
+    int64_t chunk_offset = position % chunk_size_;
+    int64_t length = std::min(remaining, chunk_size_ - chunk_offset);
+    memcpy(chunks_[index]->writer->data() + chunk_offset, source, length);
+    source += length;
+    position += length;
+    remaining -= length;
+  }
+  size_ = std::max(size_, offset + nbytes);
+
+  // merge the written range
+  int64_t begin = offset, end = offset + nbytes;
+  auto iter = written_.upper_bound(begin);
+  if (iter != written_.begin() && std::prev(iter)->second >= begin) {
+    --iter;
+    begin = iter->first;
+  }
+  while (iter != written_.end() && iter->first <= end) {
+    end = std::max(end, iter->second);
+    iter = written_.erase(iter);
+  }
+  written_.emplace(begin, end);
+  return feedCompleteChunks();
+}
+
+Status WritableChunkBuffer::Finish() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (size_ == 0) {
+    return Status::OK();
+  }
+  if (written_.size() != 1 || written_.begin()->first != 0) {
+    return Status::Invalid("The written file has holes");
+  }
+  RETURN_ON_ERROR(feedCompleteChunks());
+  if (fed_chunks_ < chunks_.size()) {
+    auto chunk = chunks_[fed_chunks_];
+    int64_t length = size_ - static_cast<int64_t>(fed_chunks_) * chunk_size_;
+    chunks_[fed_chunks_++].reset();
+    RETURN_ON_ERROR(sink_(std::make_shared<ChunkSliceBuffer>(
+        reinterpret_cast<const uint8_t*>(chunk->writer->data()), length,
+        chunk)));
+  }
+  return Status::OK();
+}
+
+int64_t WritableChunkBuffer::size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return size_;
+}
+
+Status WritableChunkBuffer::feedCompleteChunks() {
+  if (written_.empty() || written_.begin()->first != 0) {
+    return Status::OK();
+  }
+  int64_t prefix = written_.begin()->second;
+  while (fed_chunks_ < chunks_.size() &&
+         static_cast<int64_t>(fed_chunks_ + 1) * chunk_size_ <= prefix) {
+    auto chunk = chunks_[fed_chunks_];
+    // the sink decides the lifetime of the chunk from now on
+    chunks_[fed_chunks_++].reset();
+    RETURN_ON_ERROR(sink_(std::make_shared<ChunkSliceBuffer>(
+        reinterpret_cast<const uint8_t*>(chunk->writer->data()), chunk_size_,
+        chunk)));
+  }
+  return Status::OK();
+}
+
+}  // namespace internal
+}  // namespace fuse
+}  // namespace vineyard
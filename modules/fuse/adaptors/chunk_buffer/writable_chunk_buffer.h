@@ -0,0 +1,90 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_FUSE_ADAPTORS_CHUNK_BUFFER_WRITABLE_CHUNK_BUFFER_H_
+#define MODULES_FUSE_ADAPTORS_CHUNK_BUFFER_WRITABLE_CHUNK_BUFFER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "arrow/buffer.h"
+
+#include "client/client.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+namespace fuse {
+namespace internal {
+
+/**
+ * @brief WritableChunkBuffer backs a file that is being written through the
+ * mount with fixed-size chunks, each allocated as a vineyard blob, thus the
+ * file grows without reallocating and copying the written bytes.
+ *
+ * Once the contiguous written prefix of the file covers a whole chunk, the
+ * chunk is handed to the sink (zero-copy) for incremental conversion, and
+ * released as soon as the sink drops all references to it.
+ */
+class WritableChunkBuffer {
+ public:
+  using sink_t = std::function<Status(const std::shared_ptr<arrow::Buffer>&)>;
+
+  static constexpr int64_t kDefaultChunkSize = 16 << 20;  // 16MB
+
+  WritableChunkBuffer(Client* client, sink_t sink,
+                      const int64_t chunk_size = kDefaultChunkSize);
+
+  ~WritableChunkBuffer() = default;
+
+  /**
+   * @brief Write at the given offset, fails when overwriting bytes that have
+   * already been handed to the sink.
+   */
+  Status WriteAt(const int64_t offset, const void* data, const int64_t nbytes);
+
+  /**
+   * @brief Hand the remaining bytes to the sink, fails when there are holes
+   * in the file.
+   */
+  Status Finish();
+
+  int64_t size() const;
+
+ private:
+  struct Chunk;
+
+  Status feedCompleteChunks();
+
+  Client* client_;
+  sink_t sink_;
+  const int64_t chunk_size_;
+
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  // written ranges [begin, end), adjacent ranges are merged
+  std::map<int64_t, int64_t> written_;
+  int64_t size_ = 0;
+  // number of chunks that have been handed to the sink
+  size_t fed_chunks_ = 0;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace internal
+}  // namespace fuse
+}  // namespace vineyard
+
+#endif  // MODULES_FUSE_ADAPTORS_CHUNK_BUFFER_WRITABLE_CHUNK_BUFFER_H_
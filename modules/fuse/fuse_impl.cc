@@ -89,7 +89,7 @@ int fs::fuse_getattr(const char* path, struct stat* stbuf,
   {
     auto iter = state.mutable_views.find(path);
     if (iter != state.mutable_views.end()) {
-      stbuf->st_size = iter->second->length();
+      stbuf->st_size = iter->second->size();
       return 0;
     }
   }
@@ -199,23 +199,20 @@ int fs::fuse_write(const char* path, const char* buf, size_t size, off_t offset,
                    struct fuse_file_info* fi) {
   DLOG(INFO) << "fuse: write " << path << " from " << offset << ", expect "
              << size << " bytes";
-  std::unordered_map<std::string,
-                     std::shared_ptr<arrow::BufferBuilder>>::const_iterator loc;
-
+  std::shared_ptr<ArrowStreamConverter> converter;
   {
     std::lock_guard<std::mutex> guard(state.mtx_);
-
-    loc = state.mutable_views.find(path);
-  }
-  if (loc == state.mutable_views.end()) {
-    return -ENOENT;
+    auto loc = state.mutable_views.find(path);
+    if (loc == state.mutable_views.end()) {
+      return -ENOENT;
+    }
+    converter = loc->second;
   }
-  auto buffer = loc->second;
-  if (static_cast<int64_t>(offset + size) >= buffer->capacity()) {
-    VINEYARD_CHECK_OK(buffer->Reserve(offset + size));
+  auto status = converter->Write(buf, size, offset);
+  if (!status.ok()) {
+    LOG(ERROR) << "fuse: failed to write " << path << ": " << status;
+    return -EIO;
   }
-  memcpy(buffer->mutable_data() + offset, buf, size);
-  buffer->UnsafeAdvance(size);
   return size;
 }
 
@@ -243,11 +240,23 @@ int fs::fuse_release(const char* path, struct fuse_file_info*) {
   }
 
   {
-    auto loc = state.mutable_views.find(path);
-    if (loc != state.mutable_views.end()) {
-      fuse::from_arrow_view(state.client.get(), loc->first, loc->second);
-      loc->second->Reset();
-      state.mutable_views.erase(loc);
+    std::shared_ptr<ArrowStreamConverter> converter;
+    {
+      std::lock_guard<std::mutex> guard(state.mtx_);
+      auto loc = state.mutable_views.find(path);
+      if (loc != state.mutable_views.end()) {
+        converter = loc->second;
+        state.mutable_views.erase(loc);
+      }
+    }
+    if (converter != nullptr) {
+      // the batches have been converted while writing, only the table
+      // metadata is left
+      auto status = converter->Finish(path);
+      if (!status.ok()) {
+        LOG(ERROR) << "fuse: failed to convert " << path << ": " << status;
+        return -EIO;
+      }
       return 0;
     }
   }
@@ -334,7 +343,7 @@ int fs::fuse_create(const char* path, mode_t mode, struct fuse_file_info*) {
   }
   DLOG(INFO) << "creating " << path;
   state.mutable_views.emplace(
-      path, std::shared_ptr<arrow::BufferBuilder>(new arrow::BufferBuilder()));
+      path, std::make_shared<ArrowStreamConverter>(state.client.get()));
   return 0;
 }
 
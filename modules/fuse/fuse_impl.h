@@ -36,6 +36,7 @@ limitations under the License.
 #include "client/client.h"
 
 #include "adaptors/arrow_ipc/deserializer_registry.h"
+#include "adaptors/arrow_ipc/serializer_registry.h"
 #include "adaptors/chunk_buffer/chunk_buffer.h"
 namespace arrow {
 class Buffer;
@@ -53,7 +54,7 @@ struct fs {
     std::mutex mtx_;
     std::unordered_map<std::string, std::shared_ptr<internal::ChunkBuffer>>
         views;
-    std::unordered_map<std::string, std::shared_ptr<arrow::BufferBuilder>>
+    std::unordered_map<std::string, std::shared_ptr<ArrowStreamConverter>>
         mutable_views;
     std::unordered_map<std::string, vineyard::fuse::vineyard_deserializer_nt>
         ipc_desearilizer_registry;
@@ -158,3 +158,19 @@ def test_fuse_df(vineyard_client, vineyard_fuse_mount_dir):
         str(id)[11:28] + ".arrow", vineyard_fuse_mount_dir
     )
     assert_dataframe(data, extracted_data)
+
+
+def test_fuse_write_arrow_stream(vineyard_client, vineyard_fuse_mount_dir):
+    batches = [pa.RecordBatch.from_pandas(generate_dataframe((1024, 4)))]
+    batches += [pa.RecordBatch.from_pandas(generate_dataframe((1, 4)))] * 16
+    table = pa.Table.from_batches(batches)
+
+    name = 'fuse_write_arrow_stream_%d' % np.random.randint(0, 1 << 30)
+    path = os.path.join(vineyard_fuse_mount_dir, name + '.arrow')
+    with open(path, 'wb') as sink:
+        with pa.ipc.new_stream(sink, table.schema) as writer:
+            for batch in batches:
+                writer.write_batch(batch)
+
+    extracted_data = vineyard_client.get(vineyard_client.get_name(name))
+    assert extracted_data.equals(table), "written table unmatch"
@@ -188,6 +188,45 @@ class ArrowFragmentBase : public vineyard::Object {
     return vineyard::InvalidObjectID();
   }
 
+  /**
+   * @brief Delete vertices, identified by the oids in the first column of the
+   * tables, as well as the edges from and to them.
+   *
+   * The deletion is recorded as tombstone bitmaps in new blobs, and all other
+   * structures of the fragment are shared by the returned fragment.
+   */
+  virtual boost::leaf::result<ObjectID> DeleteVertices(
+      Client& client,
+      std::map<label_id_t, std::shared_ptr<arrow::Table>>&& vertex_tables_map,
+      const int concurrency = std::thread::hardware_concurrency()) {
+    VINEYARD_ASSERT(false, "Not implemented");
+    return vineyard::InvalidObjectID();
+  }
+
+  /**
+   * @brief Delete edges, identified by the (src oid, dst oid) in the first two
+   * columns of the tables, all parallel edges between the pair are deleted.
+   */
+  virtual boost::leaf::result<ObjectID> DeleteEdges(
+      Client& client,
+      std::map<label_id_t, std::shared_ptr<arrow::Table>>&& edge_tables_map,
+      const int concurrency = std::thread::hardware_concurrency()) {
+    VINEYARD_ASSERT(false, "Not implemented");
+    return vineyard::InvalidObjectID();
+  }
+
+  /**
+   * @brief Rebuild the nbr lists of the edge labels whose ratio of deleted
+   * edges exceeds the threshold, and drop their tombstones. Returns the
+   * fragment itself if no edge label needs to be consolidated.
+   */
+  virtual boost::leaf::result<ObjectID> ConsolidateTombstones(
+      Client& client, const double threshold = 0.2,
+      const int concurrency = std::thread::hardware_concurrency()) {
+    VINEYARD_ASSERT(false, "Not implemented");
+    return vineyard::InvalidObjectID();
+  }
+
   virtual vineyard::ObjectID vertex_map_id() const = 0;
 
   virtual bool local_vertex_map() const = 0;
@@ -17,7 +17,9 @@ limitations under the License.
 #define MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -29,6 +31,7 @@ limitations under the License.
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
+#include "arrow/util/bitmap_ops.h"
 
 #include "grape/fragment/fragment_base.h"
 #include "grape/graph/adj_list.h"
@@ -49,6 +52,7 @@ limitations under the License.
 #include "graph/fragment/property_graph_utils.h"
 #include "graph/utils/context_protocols.h"
 #include "graph/utils/error.h"
+#include "graph/utils/table_shuffler.h"
 #include "graph/utils/thread_group.h"
 #include "graph/vertex_map/arrow_vertex_map.h"
 
@@ -340,9 +344,8 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::TransformDirection(
   ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
   builder.set_directed_(!directed_);
 
-  std::vector<std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>>
-      oe_lists(vertex_label_num_);
-  std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>> oe_offsets_lists(
+  std::vector<std::vector<std::shared_ptr<Object>>> oe_lists(vertex_label_num_);
+  std::vector<std::vector<std::shared_ptr<Object>>> oe_offsets_lists(
       vertex_label_num_);
 
   for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
@@ -352,8 +355,8 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::TransformDirection(
 
   if (directed_) {
     bool is_multigraph = is_multigraph_;
-    directedCSR2Undirected(client, oe_lists, oe_offsets_lists, concurrency,
-                           is_multigraph);
+    BOOST_LEAF_CHECK(directedCSR2Undirected(client, oe_lists, oe_offsets_lists,
+                                            concurrency, is_multigraph));
 
     for (label_id_t i = 0; i < vertex_label_num_; ++i) {
       for (label_id_t j = 0; j < edge_label_num_; ++j) {
@@ -609,6 +612,38 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initPointers() {
     }
     ie_offsets_ptr_lists_ = oe_offsets_ptr_lists_;
   }
+
+  initTombstones();
+  initMirrors();
+  initTemporalIndex();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initTombstones() {
+  auto init = [](List<std::shared_ptr<UInt8Array>> const& arrays,
+                 const label_id_t label_num,
+                 std::vector<property_graph_utils::Tombstones>& bits) {
+    bits.clear();
+    bits.resize(label_num);
+    for (label_id_t i = 0;
+         i < label_num && static_cast<size_t>(i) < arrays.size(); ++i) {
+      auto array = arrays[i]->GetArray();
+      if (array->length() > 0) {
+        bits[i].bits = array->raw_values();
+        bits[i].size = array->length() * 8;
+      }
+    }
+  };
+  init(vertex_tombstones_, vertex_label_num_, vertex_tombstones_bits_);
+  init(edge_tombstones_, edge_label_num_, edge_tombstones_bits_);
+
+  // adjacent lists without deletion won't check the tombstones at all
+  edge_tombstones_ptr_.resize(edge_label_num_);
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    edge_tombstones_ptr_[i] = edge_tombstones_bits_[i].size > 0
+                                  ? &edge_tombstones_bits_[i]
+                                  : nullptr;
+  }
 }
 
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
@@ -692,59 +727,994 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initDestFidList(
 }
 
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
-void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::directedCSR2Undirected(
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::directedCSR2Undirected(
     vineyard::Client& client,
-    std::vector<std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>>&
-        oe_lists,
-    std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>&
-        oe_offsets_lists,
+    std::vector<std::vector<std::shared_ptr<Object>>>& oe_lists,
+    std::vector<std::vector<std::shared_ptr<Object>>>& oe_offsets_lists,
     const int concurrency, bool& is_multigraph) {
   // FIXME: varint encoding
-  VINEYARD_ASSERT(
-      !this->compact_edges_,
-      "Varint encoding is not implemented for adding vertices/edges");
+  if (this->compact_edges_) {
+    RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                    "Varint encoding is not implemented for transforming "
+                    "the direction");
+  }
+
+  auto vid_less = [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+    return lhs.vid < rhs.vid;
+  };
+  auto vid_equal = [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+    return lhs.vid == rhs.vid;
+  };
 
+  // one label pair at a time: the undirected list of each vertex is merged
+  // from its (sorted) incoming and outgoing lists into the output blob
+  // directly, and the blobs are sealed before moving to the next pair.
   for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
     for (label_id_t e_label = 0; e_label < edge_label_num_; ++e_label) {
+      const vid_t tvnum = tvnums_[v_label];
       const nbr_unit_t* ie = ie_ptr_lists_.at(v_label).at(e_label);
       const nbr_unit_t* oe = oe_ptr_lists_.at(v_label).at(e_label);
       const int64_t* ie_offset = ie_offsets_ptr_lists_.at(v_label).at(e_label);
       const int64_t* oe_offset = oe_offsets_ptr_lists_.at(v_label).at(e_label);
 
-      // Merge edges from two array into one
       auto edge_builder =
           std::make_shared<vineyard::PodArrayBuilder<nbr_unit_t>>(
-              client,
-              ie_offset[tvnums_[v_label]] + oe_offset[tvnums_[v_label]]);
+              client, ie_offset[tvnum] + oe_offset[tvnum]);
       auto offsets_builder =
-          std::make_shared<FixedInt64Builder>(client, tvnums_[v_label] + 1);
+          std::make_shared<FixedInt64Builder>(client, tvnum + 1);
 
       nbr_unit_t* data = edge_builder->MutablePointer(0);
       int64_t* offsets = offsets_builder->MutablePointer(0);
       offsets[0] = 0;
 
-      size_t edge_offset = 0;
-      for (size_t v = 0; v < static_cast<size_t>(tvnums_[v_label]); ++v) {
-        for (size_t k = ie_offset[v]; k < static_cast<size_t>(ie_offset[v + 1]);
-             ++k) {
-          data[edge_offset++] = ie[k];
+      // the degrees are known in advance, the offset of a vertex is the sum
+      // of its offsets in the incoming and outgoing lists
+      std::atomic<bool> has_parallel_edges(false);
+      parallel_for(
+          static_cast<vid_t>(0), tvnum,
+          [&](const vid_t v) {
+            offsets[v + 1] = ie_offset[v + 1] + oe_offset[v + 1];
+            const nbr_unit_t *ie_begin = ie + ie_offset[v],
+                             *ie_end = ie + ie_offset[v + 1];
+            const nbr_unit_t *oe_begin = oe + oe_offset[v],
+                             *oe_end = oe + oe_offset[v + 1];
+            nbr_unit_t* begin = data + ie_offset[v] + oe_offset[v];
+            nbr_unit_t* end;
+            if (std::is_sorted(ie_begin, ie_end, vid_less) &&
+                std::is_sorted(oe_begin, oe_end, vid_less)) {
+              end = std::merge(ie_begin, ie_end, oe_begin, oe_end, begin,
+                               vid_less);
+            } else {
+              end = std::copy(oe_begin, oe_end,
+                              std::copy(ie_begin, ie_end, begin));
+              std::sort(begin, end, vid_less);
+            }
+            if (!is_multigraph &&
+                !has_parallel_edges.load(std::memory_order_relaxed) &&
+                std::adjacent_find(begin, end, vid_equal) != end) {
+              has_parallel_edges.store(true, std::memory_order_relaxed);
+            }
+          },
+          concurrency, 1024);
+      is_multigraph = is_multigraph || has_parallel_edges.load();
+
+      std::shared_ptr<Object> object;
+      VY_OK_OR_RAISE(edge_builder->Seal(client, object));
+      oe_lists[v_label][e_label] = object;
+      VY_OK_OR_RAISE(offsets_builder->Seal(client, object));
+      oe_offsets_lists[v_label][e_label] = object;
+
+      VLOG(100) << "Transformed the direction of edges of [" << v_label << ", "
+                << e_label << "]: " << get_rss_pretty()
+                << ", peak = " << get_peak_rss_pretty();
+    }
+  }
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+size_t ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::GetDeletedEdgesNum(
+    label_id_t e_label) const {
+  auto const& tombstones = edge_tombstones_bits_[e_label];
+  if (tombstones.size == 0) {
+    return 0;
+  }
+  return arrow::internal::CountSetBits(tombstones.bits, 0, tombstones.size);
+}
+
+namespace detail {
+
+inline void set_tombstone(std::vector<uint8_t>& bits, int64_t index) {
+  __sync_fetch_and_or(&bits[index >> 3],
+                      static_cast<uint8_t>(1 << (index & 7)));
+}
+
+}  // namespace detail
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::copyTombstones(
+    std::vector<std::vector<uint8_t>>& vertex_bits,
+    std::vector<std::vector<uint8_t>>& edge_bits) const {
+  vertex_bits.resize(vertex_label_num_);
+  for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+    auto const& tombstones = vertex_tombstones_bits_[i];
+    vertex_bits[i].resize((ivnums_[i] + 7) / 8, 0);
+    std::copy(tombstones.bits,
+              tombstones.bits + std::min(vertex_bits[i].size(),
+                                         static_cast<size_t>(tombstones.size /
+                                                             8)),
+              vertex_bits[i].begin());
+  }
+  edge_bits.resize(edge_label_num_);
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    auto const& tombstones = edge_tombstones_bits_[i];
+    edge_bits[i].resize((edge_tables_[i]->num_rows() + 7) / 8, 0);
+    std::copy(tombstones.bits,
+              tombstones.bits + std::min(edge_bits[i].size(),
+                                         static_cast<size_t>(tombstones.size /
+                                                             8)),
+              edge_bits[i].begin());
+  }
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::sealTombstones(
+    vineyard::Client& client,
+    std::vector<std::vector<uint8_t>> const& vertex_bits,
+    std::vector<std::vector<uint8_t>> const& edge_bits,
+    std::vector<bool> const& vertex_dirty,
+    std::vector<bool> const& edge_dirty) {
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+
+  // only the modified bitmaps (and the missing ones) are sealed as new blobs,
+  // the others are shared with this fragment.
+  auto seal = [&client](std::vector<uint8_t> const& bits)
+      -> std::shared_ptr<FixedUInt8Builder> {
+    auto bits_builder =
+        std::make_shared<FixedUInt8Builder>(client, bits.size());
+    if (!bits.empty()) {
+      memcpy(bits_builder->data(), bits.data(), bits.size());
+    }
+    return bits_builder;
+  };
+  for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+    if (vertex_dirty[i] ||
+        static_cast<size_t>(i) >= vertex_tombstones_.size()) {
+      builder.set_vertex_tombstones_(i, seal(vertex_bits[i]));
+    }
+  }
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    if (edge_dirty[i] || static_cast<size_t>(i) >= edge_tombstones_.size()) {
+      builder.set_edge_tombstones_(i, seal(edge_bits[i]));
+    }
+  }
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::DeleteVertices(
+    vineyard::Client& client,
+    std::map<label_id_t, std::shared_ptr<arrow::Table>>&& vertex_tables_map,
+    const int concurrency) {
+  if (compact_edges_) {
+    RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                    "Deleting vertices from fragments with compacted edges is "
+                    "not supported");
+  }
+  std::vector<std::vector<uint8_t>> vertex_bits, edge_bits;
+  copyTombstones(vertex_bits, edge_bits);
+  std::vector<bool> vertex_dirty(vertex_label_num_, false);
+  std::vector<bool> edge_dirty(edge_label_num_, false);
+
+  for (auto const& pair : vertex_tables_map) {
+    label_id_t v_label = pair.first;
+    if (v_label < 0 || v_label >= vertex_label_num_) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Invalid vertex label: " + std::to_string(v_label));
+    }
+    vertex_dirty[v_label] = true;
+    for (auto const& chunk : pair.second->column(0)->chunks()) {
+      auto oids =
+          std::dynamic_pointer_cast<ArrowArrayType<internal_oid_t>>(chunk);
+      if (oids == nullptr) {
+        RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                        "The type of oids doesn't match the fragment: " +
+                            chunk->type()->ToString());
+      }
+      parallel_for(
+          static_cast<int64_t>(0), oids->length(),
+          [&](const int64_t index) {
+            vid_t gid;
+            vertex_t v;
+            if (!vm_ptr_->GetGid(v_label, oids->GetView(index), gid) ||
+                !Gid2Vertex(gid, v)) {
+              return;
+            }
+            int64_t v_offset = vid_parser_.GetOffset(v.GetValue());
+            if (IsInnerVertex(v)) {
+              detail::set_tombstone(vertex_bits[v_label], v_offset);
+            }
+            // both the outgoing and incoming lists of an outer vertex keep
+            // the edges between it and the inner vertices
+            for (label_id_t e_label = 0; e_label < edge_label_num_;
+                 ++e_label) {
+              const int64_t* offsets = oe_offsets_ptr_lists_[v_label][e_label];
+              const nbr_unit_t* oe = oe_ptr_lists_[v_label][e_label];
+              for (int64_t k = offsets[v_offset]; k < offsets[v_offset + 1];
+                   ++k) {
+                detail::set_tombstone(edge_bits[e_label], oe[k].eid);
+              }
+              if (directed_) {
+                offsets = ie_offsets_ptr_lists_[v_label][e_label];
+                const nbr_unit_t* ie = ie_ptr_lists_[v_label][e_label];
+                for (int64_t k = offsets[v_offset]; k < offsets[v_offset + 1];
+                     ++k) {
+                  detail::set_tombstone(edge_bits[e_label], ie[k].eid);
+                }
+              }
+            }
+          },
+          concurrency, 1024);
+    }
+    std::fill(edge_dirty.begin(), edge_dirty.end(), true);
+  }
+  return sealTombstones(client, vertex_bits, edge_bits, vertex_dirty,
+                        edge_dirty);
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::DeleteEdges(
+    vineyard::Client& client,
+    std::map<label_id_t, std::shared_ptr<arrow::Table>>&& edge_tables_map,
+    const int concurrency) {
+  if (compact_edges_) {
+    RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                    "Deleting edges from fragments with compacted edges is "
+                    "not supported");
+  }
+  std::vector<std::vector<uint8_t>> vertex_bits, edge_bits;
+  copyTombstones(vertex_bits, edge_bits);
+  std::vector<bool> vertex_dirty(vertex_label_num_, false);
+  std::vector<bool> edge_dirty(edge_label_num_, false);
+
+  // set the tombstones of edges in the nbr list of `u` that points to `v`
+  auto mark = [this, &edge_bits](label_id_t e_label, const vertex_t& u,
+                                 const vertex_t& v, const nbr_unit_t* nbrs,
+                                 const int64_t* offsets) {
+    int64_t u_offset = vid_parser_.GetOffset(u.GetValue());
+    for (int64_t k = offsets[u_offset]; k < offsets[u_offset + 1]; ++k) {
+      if (nbrs[k].vid == v.GetValue()) {
+        detail::set_tombstone(edge_bits[e_label], nbrs[k].eid);
+      }
+    }
+  };
+
+  for (auto const& pair : edge_tables_map) {
+    label_id_t e_label = pair.first;
+    if (e_label < 0 || e_label >= edge_label_num_) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Invalid edge label: " + std::to_string(e_label));
+    }
+    edge_dirty[e_label] = true;
+
+    std::vector<std::pair<label_id_t, label_id_t>> relations;
+    for (auto const& relation :
+         schema_.GetEntry(e_label, PropertyGraphSchema::EDGE_TYPE_NAME)
+             .relations) {
+      relations.emplace_back(schema_.GetVertexLabelId(relation.first),
+                             schema_.GetVertexLabelId(relation.second));
+    }
+
+    std::shared_ptr<arrow::Table> table;
+    ARROW_OK_ASSIGN_OR_RAISE(
+        table, pair.second->CombineChunks(arrow::default_memory_pool()));
+    if (table->num_columns() < 2 || table->num_rows() == 0) {
+      continue;
+    }
+    auto srcs = std::dynamic_pointer_cast<ArrowArrayType<internal_oid_t>>(
+        table->column(0)->chunk(0));
+    auto dsts = std::dynamic_pointer_cast<ArrowArrayType<internal_oid_t>>(
+        table->column(1)->chunk(0));
+    if (srcs == nullptr || dsts == nullptr) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "The type of src/dst oids doesn't match the fragment");
+    }
+    parallel_for(
+        static_cast<int64_t>(0), table->num_rows(),
+        [&](const int64_t index) {
+          for (auto const& relation : relations) {
+            vid_t src_gid, dst_gid;
+            vertex_t u, v;
+            if (!vm_ptr_->GetGid(relation.first, srcs->GetView(index),
+                                 src_gid) ||
+                !vm_ptr_->GetGid(relation.second, dsts->GetView(index),
+                                 dst_gid) ||
+                !Gid2Vertex(src_gid, u) || !Gid2Vertex(dst_gid, v)) {
+              continue;
+            }
+            mark(e_label, u, v, oe_ptr_lists_[relation.first][e_label],
+                 oe_offsets_ptr_lists_[relation.first][e_label]);
+            if (directed_) {
+              mark(e_label, v, u, ie_ptr_lists_[relation.second][e_label],
+                   ie_offsets_ptr_lists_[relation.second][e_label]);
+            } else {
+              mark(e_label, v, u, oe_ptr_lists_[relation.second][e_label],
+                   oe_offsets_ptr_lists_[relation.second][e_label]);
+            }
+          }
+        },
+        concurrency, 1024);
+  }
+  return sealTombstones(client, vertex_bits, edge_bits, vertex_dirty,
+                        edge_dirty);
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::consolidateNbrList(
+    vineyard::Client& client, const vid_t tvnum, const nbr_unit_t* nbrs,
+    const int64_t* offsets, const property_graph_utils::Tombstones& tombstones,
+    const int concurrency,
+    std::shared_ptr<PodArrayBuilder<nbr_unit_t>>& nbr_list,
+    std::shared_ptr<FixedInt64Builder>& offsets_list) {
+  offsets_list = std::make_shared<FixedInt64Builder>(client, tvnum + 1);
+  int64_t* new_offsets = offsets_list->data();
+
+  // count the alive edges of each vertex, then prefix-sum into offsets
+  new_offsets[0] = 0;
+  parallel_for(
+      static_cast<vid_t>(0), tvnum,
+      [&](const vid_t v) {
+        int64_t degree = 0;
+        for (int64_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+          degree += !tombstones.Contains(nbrs[k].eid);
         }
-        for (int k = oe_offset[v]; k < oe_offset[v + 1]; ++k) {
-          data[edge_offset++] = oe[k];
+        new_offsets[v + 1] = degree;
+      },
+      concurrency, 1024);
+  for (vid_t v = 0; v < tvnum; ++v) {
+    new_offsets[v + 1] += new_offsets[v];
+  }
+
+  nbr_list = std::make_shared<PodArrayBuilder<nbr_unit_t>>(
+      client, new_offsets[tvnum]);
+  nbr_unit_t* new_nbrs = nbr_list->MutablePointer(0);
+  parallel_for(
+      static_cast<vid_t>(0), tvnum,
+      [&](const vid_t v) {
+        int64_t cursor = new_offsets[v];
+        for (int64_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+          if (!tombstones.Contains(nbrs[k].eid)) {
+            new_nbrs[cursor++] = nbrs[k];
+          }
         }
-        offsets[v + 1 /* offsets array */] = edge_offset;
+      },
+      concurrency, 1024);
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::ConsolidateTombstones(
+    vineyard::Client& client, const double threshold, const int concurrency) {
+  if (compact_edges_) {
+    RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                    "Consolidating fragments with compacted edges is not "
+                    "supported");
+  }
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  bool consolidated = false;
+  for (label_id_t e_label = 0; e_label < edge_label_num_; ++e_label) {
+    if (edge_tombstones_ptr_[e_label] == nullptr) {
+      continue;
+    }
+    int64_t edge_num = edge_tables_[e_label]->num_rows();
+    if (edge_num == 0 || GetDeletedEdgesNum(e_label) <=
+                             threshold * static_cast<double>(edge_num)) {
+      continue;
+    }
+    auto const& tombstones = *edge_tombstones_ptr_[e_label];
+    for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+      std::shared_ptr<PodArrayBuilder<nbr_unit_t>> nbr_list;
+      std::shared_ptr<FixedInt64Builder> offsets_list;
+      consolidateNbrList(client, tvnums_[v_label],
+                         oe_ptr_lists_[v_label][e_label],
+                         oe_offsets_ptr_lists_[v_label][e_label], tombstones,
+                         concurrency, nbr_list, offsets_list);
+      builder.set_oe_lists_(v_label, e_label, nbr_list);
+      builder.set_oe_offsets_lists_(v_label, e_label, offsets_list);
+      if (directed_) {
+        consolidateNbrList(client, tvnums_[v_label],
+                           ie_ptr_lists_[v_label][e_label],
+                           ie_offsets_ptr_lists_[v_label][e_label], tombstones,
+                           concurrency, nbr_list, offsets_list);
+        builder.set_ie_lists_(v_label, e_label, nbr_list);
+        builder.set_ie_offsets_lists_(v_label, e_label, offsets_list);
       }
-      sort_edges_with_respect_to_vertex(*edge_builder, offsets_builder->data(),
-                                        tvnums_[v_label], concurrency);
-      if (!is_multigraph) {
-        check_is_multigraph(*edge_builder, offsets_builder->data(),
-                            tvnums_[v_label], concurrency, is_multigraph);
+    }
+    // the rows of deleted edges are left in the edge table, but no longer
+    // referenced by the nbr lists
+    builder.set_edge_tombstones_(
+        e_label, std::make_shared<FixedUInt8Builder>(client, 0));
+    consolidated = true;
+  }
+  if (!consolidated) {
+    return this->id();
+  }
+  for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+    if (static_cast<size_t>(i) >= vertex_tombstones_.size()) {
+      builder.set_vertex_tombstones_(
+          i, std::make_shared<FixedUInt8Builder>(client, 0));
+    }
+  }
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    if (static_cast<size_t>(i) >= edge_tombstones_.size()) {
+      builder.set_edge_tombstones_(
+          i, std::make_shared<FixedUInt8Builder>(client, 0));
+    }
+  }
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initMirrors() {
+  mirror_columns_.clear();
+  mirror_columns_.resize(vertex_label_num_);
+  mirror_chunk_offsets_.clear();
+  mirror_chunk_offsets_.resize(vertex_label_num_);
+  mirror_nums_.clear();
+  mirror_nums_.resize(vertex_label_num_, 0);
+  for (label_id_t i = 0;
+       i < vertex_label_num_ &&
+       static_cast<size_t>(i) < outer_vertex_mirrors_.size();
+       ++i) {
+    auto mirror = outer_vertex_mirrors_[i]->GetTable();
+    mirror_nums_[i] = mirror->num_rows();
+    mirror_columns_[i].resize(vertex_tables_[i]->num_columns());
+    if (mirror->num_rows() == 0) {
+      continue;
+    }
+    int64_t offset = 0;
+    for (auto const& chunk : mirror->column(0)->chunks()) {
+      mirror_chunk_offsets_[i].push_back(offset);
+      offset += chunk->length();
+    }
+    auto vertex_schema = vertex_tables_[i]->schema();
+    for (int j = 1; j < mirror->num_columns(); ++j) {
+      int prop_id = vertex_schema->GetFieldIndex(mirror->field(j)->name());
+      if (prop_id < 0) {
+        continue;
+      }
+      for (auto const& chunk : mirror->column(j)->chunks()) {
+        mirror_columns_[i][prop_id].push_back(get_arrow_array_data(chunk));
       }
+    }
+  }
+}
+
+namespace detail {
+
+// `CombineRecordBatches` yields no batch for empty tables
+inline Status table_as_record_batch(
+    const std::shared_ptr<arrow::Table>& table,
+    std::shared_ptr<arrow::RecordBatch>& batch) {
+  std::shared_ptr<arrow::Table> combined;
+  if (table->num_rows() == 0) {
+    RETURN_ON_ERROR(EmptyTableBuilder::Build(table->schema(), combined));
+  } else {
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        combined, table->CombineChunks(arrow::default_memory_pool()));
+  }
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (int i = 0; i < combined->num_columns(); ++i) {
+    columns.push_back(combined->column(i)->chunk(0));
+  }
+  batch = arrow::RecordBatch::Make(combined->schema(), combined->num_rows(),
+                                   columns);
+  return Status::OK();
+}
+
+}  // namespace detail
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::pullOuterVertexProperties(
+    vineyard::Client& client, const grape::CommSpec& comm_spec,
+    label_id_t v_label, const std::vector<prop_id_t>& props, const vid_t begin,
+    std::shared_ptr<arrow::Table>& rows) {
+  auto vertex_schema = vertex_tables_[v_label]->schema();
+  std::vector<std::shared_ptr<arrow::Field>> fields{
+      arrow::field("__gid__", ConvertToArrowType<vid_t>::TypeValue())};
+  for (auto prop_id : props) {
+    fields.push_back(vertex_schema->field(prop_id));
+  }
+  auto rows_schema = arrow::schema(fields);
+  if (props.empty()) {
+    // labels without mirrored properties are skipped by all fragments
+    VY_OK_OR_RAISE(EmptyTableBuilder::Build(rows_schema, rows));
+    return {};
+  }
+
+  // requests of the outer vertices in [begin, ovnum), grouped by the owner
+  const vid_t ovnum = ovnums_[v_label];
+  const vid_t* ovgid_list = ovgid_lists_ptr_[v_label];
+  std::vector<std::vector<std::vector<int64_t>>> request_offsets(
+      1, std::vector<std::vector<int64_t>>(fnum_));
+  for (vid_t index = begin; index < ovnum; ++index) {
+    request_offsets[0][vid_parser_.GetFid(ovgid_list[index])].push_back(
+        index - begin);
+  }
+  ArrowBuilderType<vid_t> gid_builder;
+  ArrowBuilderType<fid_t> fid_builder;
+  ARROW_OK_OR_RAISE(
+      gid_builder.AppendValues(ovgid_list + begin, ovnum - begin));
+  ARROW_OK_OR_RAISE(
+      fid_builder.AppendValues(std::vector<fid_t>(ovnum - begin, fid_)));
+  std::shared_ptr<arrow::Array> gid_array, fid_array;
+  ARROW_OK_OR_RAISE(gid_builder.Finish(&gid_array));
+  ARROW_OK_OR_RAISE(fid_builder.Finish(&fid_array));
+  auto requests_schema = arrow::schema(
+      {arrow::field("__gid__", ConvertToArrowType<vid_t>::TypeValue()),
+       arrow::field("__fid__", ConvertToArrowType<fid_t>::TypeValue())});
+  std::vector<std::shared_ptr<arrow::RecordBatch>> requests_send{
+      arrow::RecordBatch::Make(requests_schema, ovnum - begin,
+                               {gid_array, fid_array})},
+      requests;
+  BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(comm_spec, requests_schema,
+                                             requests_send, request_offsets,
+                                             requests, &client));
+
+  // respond the requested inner vertices with the selected properties
+  const vid_t ivnum = ivnums_[v_label];
+  std::vector<std::vector<std::vector<int64_t>>> response_offsets(
+      1, std::vector<std::vector<int64_t>>(fnum_));
+  for (auto const& request : requests) {
+    auto gids =
+        std::dynamic_pointer_cast<ArrowArrayType<vid_t>>(request->column(0));
+    auto fids =
+        std::dynamic_pointer_cast<ArrowArrayType<fid_t>>(request->column(1));
+    for (int64_t k = 0; k < request->num_rows(); ++k) {
+      response_offsets[0][fids->Value(k)].push_back(
+          vid_parser_.GetOffset(gids->Value(k)));
+    }
+  }
+  ArrowBuilderType<vid_t> inner_gid_builder;
+  ARROW_OK_OR_RAISE(inner_gid_builder.Reserve(ivnum));
+  for (vid_t offset = 0; offset < ivnum; ++offset) {
+    inner_gid_builder.UnsafeAppend(
+        vid_parser_.GenerateId(fid_, v_label, offset));
+  }
+  std::shared_ptr<arrow::Array> inner_gid_array;
+  ARROW_OK_OR_RAISE(inner_gid_builder.Finish(&inner_gid_array));
+  auto vertex_table = vertex_tables_[v_label]->GetTable();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns{
+      std::make_shared<arrow::ChunkedArray>(inner_gid_array)};
+  for (auto prop_id : props) {
+    columns.push_back(vertex_table->column(prop_id));
+  }
+  std::vector<std::shared_ptr<arrow::RecordBatch>> responses_send(1),
+      responses;
+  VY_OK_OR_RAISE(detail::table_as_record_batch(
+      arrow::Table::Make(rows_schema, columns, ivnum), responses_send[0]));
+  BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(comm_spec, rows_schema,
+                                             responses_send, response_offsets,
+                                             responses, &client));
+
+  // reorder the responses by the index of outer vertices
+  std::shared_ptr<arrow::Table> responses_table;
+  std::shared_ptr<arrow::RecordBatch> received, ordered;
+  VY_OK_OR_RAISE(
+      RecordBatchesToTable(rows_schema, responses, &responses_table));
+  VY_OK_OR_RAISE(detail::table_as_record_batch(responses_table, received));
+  if (received->num_rows() != static_cast<int64_t>(ovnum - begin)) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "Failed to pull the properties of all outer vertices");
+  }
+  std::vector<int64_t> order(ovnum - begin);
+  auto gids =
+      std::dynamic_pointer_cast<ArrowArrayType<vid_t>>(received->column(0));
+  for (int64_t k = 0; k < received->num_rows(); ++k) {
+    vertex_t v;
+    if (!OuterVertexGid2Vertex(gids->Value(k), v)) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Received the properties of an unknown outer vertex");
+    }
+    order[vid_parser_.GetOffset(v.GetValue()) - ivnum - begin] = k;
+  }
+  SelectRows(received, order, ordered);
+  VY_OK_OR_RAISE(RecordBatchesToTable(rows_schema, {ordered}, &rows));
+  return {};
+}
 
-      oe_lists[v_label][e_label] = edge_builder;
-      oe_offsets_lists[v_label][e_label] = offsets_builder;
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::MirrorOuterVertices(
+    vineyard::Client& client, const grape::CommSpec& comm_spec,
+    const std::map<label_id_t, std::vector<prop_id_t>>& columns) {
+  for (auto const& pair : columns) {
+    if (pair.first < 0 || pair.first >= vertex_label_num_) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Invalid vertex label: " + std::to_string(pair.first));
+    }
+    for (auto prop_id : pair.second) {
+      if (prop_id < 0 ||
+          static_cast<size_t>(prop_id) >=
+              vertex_tables_[pair.first]->num_columns()) {
+        RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                        "Invalid vertex property: " + std::to_string(prop_id));
+      }
     }
   }
+
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    std::vector<prop_id_t> props;
+    if (columns.find(v_label) != columns.end()) {
+      props = columns.at(v_label);
+    }
+    std::shared_ptr<arrow::Table> rows;
+    BOOST_LEAF_CHECK(
+        pullOuterVertexProperties(client, comm_spec, v_label, props, 0, rows));
+    builder.set_outer_vertex_mirrors_(
+        v_label, std::make_shared<TableBuilder>(client, std::move(rows),
+                                                true /* merge chunks */));
+  }
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::RefreshOuterVertexMirrors(
+    vineyard::Client& client, const grape::CommSpec& comm_spec) {
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  bool refreshed = false;
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    std::vector<prop_id_t> props;
+    std::shared_ptr<Table> mirror;
+    if (static_cast<size_t>(v_label) < outer_vertex_mirrors_.size()) {
+      mirror = outer_vertex_mirrors_[v_label];
+      auto mirror_schema = mirror->schema();
+      auto vertex_schema = vertex_tables_[v_label]->schema();
+      for (int j = 1; j < mirror_schema->num_fields(); ++j) {
+        auto const& name = mirror_schema->field(j)->name();
+        int prop_id = vertex_schema->GetFieldIndex(name);
+        if (prop_id < 0) {
+          RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                          "The mirrored vertex property '" + name +
+                              "' doesn't exist any more");
+        }
+        props.push_back(prop_id);
+      }
+    }
+    if (props.empty()) {
+      // new vertex labels, or labels without any mirrored property
+      if (mirror == nullptr) {
+        std::shared_ptr<arrow::Table> rows;
+        BOOST_LEAF_CHECK(pullOuterVertexProperties(
+            client, comm_spec, v_label, props, ovnums_[v_label], rows));
+        builder.set_outer_vertex_mirrors_(
+            v_label, std::make_shared<TableBuilder>(client, std::move(rows),
+                                                    true /* merge chunks */));
+        refreshed = true;
+      }
+      continue;
+    }
+
+    // all fragments join the exchange, even if no outer vertex is missing
+    std::shared_ptr<arrow::Table> rows;
+    BOOST_LEAF_CHECK(pullOuterVertexProperties(
+        client, comm_spec, v_label, props, mirror_nums_[v_label], rows));
+    if (rows->num_rows() == 0) {
+      continue;
+    }
+    // the existing rows are kept as-is, the pulled rows become a new chunk
+    auto appender = std::make_shared<TableAppender>(client, mirror);
+    VY_OK_OR_RAISE(appender->AppendRows(rows));
+    builder.set_outer_vertex_mirrors_(v_label, appender);
+    refreshed = true;
+  }
+  if (!refreshed) {
+    return this->id();
+  }
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initTemporalIndex() {
+  temporal_props_.clear();
+  temporal_props_.resize(edge_label_num_, -1);
+  auto reset = [this](auto& ptr_lists) {
+    ptr_lists.clear();
+    ptr_lists.resize(vertex_label_num_);
+    for (auto& ptr_list : ptr_lists) {
+      ptr_list.resize(edge_label_num_, nullptr);
+    }
+  };
+  reset(temporal_ie_ptr_lists_);
+  reset(temporal_oe_ptr_lists_);
+  reset(temporal_ie_times_ptr_lists_);
+  reset(temporal_oe_times_ptr_lists_);
+  if (compact_edges_ || !temporal_index_.is_array()) {
+    return;
+  }
+
+  // the index is valid only if it is built from the current nbr lists
+  auto built_from =
+      [this](const json& ids, const label_id_t e_label,
+             List<List<std::shared_ptr<FixedSizeBinaryArray>>> const& lists) {
+        if (!ids.is_array() ||
+            ids.size() != static_cast<size_t>(vertex_label_num_)) {
+          return false;
+        }
+        for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+          if (ids[i].get<ObjectID>() != lists[i][e_label]->id()) {
+            return false;
+          }
+        }
+        return true;
+      };
+  auto covered =
+      [this](const label_id_t e_label,
+             List<List<std::shared_ptr<FixedSizeBinaryArray>>> const& lists) {
+        if (lists.size() < static_cast<size_t>(vertex_label_num_)) {
+          return false;
+        }
+        for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+          if (lists[i].size() <= static_cast<size_t>(e_label)) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+  for (label_id_t j = 0;
+       j < edge_label_num_ && static_cast<size_t>(j) < temporal_index_.size();
+       ++j) {
+    const json& entry = temporal_index_[j];
+    if (!entry.is_object()) {
+      continue;
+    }
+    int prop_id = edge_tables_[j]->schema()->GetFieldIndex(
+        entry.value("property", std::string()));
+    if (prop_id < 0 || !covered(j, temporal_oe_lists_) ||
+        !built_from(entry.value("oe_lists", json()), j, oe_lists_)) {
+      continue;
+    }
+    if (directed_ &&
+        (!covered(j, temporal_ie_lists_) ||
+         !built_from(entry.value("ie_lists", json()), j, ie_lists_))) {
+      continue;
+    }
+    temporal_props_[j] = prop_id;
+    for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+      temporal_oe_ptr_lists_[i][j] = reinterpret_cast<const nbr_unit_t*>(
+          temporal_oe_lists_[i][j]->GetArray()->raw_values());
+      temporal_oe_times_ptr_lists_[i][j] =
+          temporal_oe_times_[i][j]->GetArray()->raw_values();
+      if (directed_) {
+        temporal_ie_ptr_lists_[i][j] = reinterpret_cast<const nbr_unit_t*>(
+            temporal_ie_lists_[i][j]->GetArray()->raw_values());
+        temporal_ie_times_ptr_lists_[i][j] =
+            temporal_ie_times_[i][j]->GetArray()->raw_values();
+      } else {
+        temporal_ie_ptr_lists_[i][j] = temporal_oe_ptr_lists_[i][j];
+        temporal_ie_times_ptr_lists_[i][j] = temporal_oe_times_ptr_lists_[i][j];
+      }
+    }
+  }
+}
+
+namespace detail {
+
+template <typename T>
+inline void fill_timestamps(const std::shared_ptr<arrow::Array>& chunk,
+                            int64_t* out) {
+  const T* values = chunk->data()->GetValues<T>(1);
+  for (int64_t i = 0; i < chunk->length(); ++i) {
+    out[i] = chunk->IsNull(i) ? std::numeric_limits<int64_t>::min()
+                              : static_cast<int64_t>(values[i]);
+  }
+}
+
+inline Status timestamps_as_int64(
+    const std::shared_ptr<arrow::ChunkedArray>& column,
+    std::vector<int64_t>& timestamps) {
+  timestamps.resize(column->length());
+  int64_t* out = timestamps.data();
+  for (auto const& chunk : column->chunks()) {
+    switch (chunk->type()->id()) {
+    case arrow::Type::INT8:
+      fill_timestamps<int8_t>(chunk, out);
+      break;
+    case arrow::Type::UINT8:
+      fill_timestamps<uint8_t>(chunk, out);
+      break;
+    case arrow::Type::INT16:
+      fill_timestamps<int16_t>(chunk, out);
+      break;
+    case arrow::Type::UINT16:
+      fill_timestamps<uint16_t>(chunk, out);
+      break;
+    case arrow::Type::INT32:
+    case arrow::Type::DATE32:
+    case arrow::Type::TIME32:
+      fill_timestamps<int32_t>(chunk, out);
+      break;
+    case arrow::Type::UINT32:
+      fill_timestamps<uint32_t>(chunk, out);
+      break;
+    case arrow::Type::INT64:
+    case arrow::Type::DATE64:
+    case arrow::Type::TIME64:
+    case arrow::Type::TIMESTAMP:
+    case arrow::Type::DURATION:
+      fill_timestamps<int64_t>(chunk, out);
+      break;
+    case arrow::Type::UINT64:
+      fill_timestamps<uint64_t>(chunk, out);
+      break;
+    default:
+      return Status::Invalid(
+          "The timestamp property must be of an integral, date or timestamp "
+          "type, but got " +
+          chunk->type()->ToString());
+    }
+    out += chunk->length();
+  }
+  return Status::OK();
+}
+
+}  // namespace detail
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::buildTemporalNbrList(
+    vineyard::Client& client, const vid_t tvnum, const nbr_unit_t* nbrs,
+    const int64_t* offsets, const std::vector<int64_t>& edge_times,
+    const int concurrency,
+    std::shared_ptr<PodArrayBuilder<nbr_unit_t>>& nbr_list,
+    std::shared_ptr<FixedInt64Builder>& times_list) {
+  nbr_list =
+      std::make_shared<PodArrayBuilder<nbr_unit_t>>(client, offsets[tvnum]);
+  times_list = std::make_shared<FixedInt64Builder>(client, offsets[tvnum]);
+  if (offsets[tvnum] == 0) {
+    return;
+  }
+  nbr_unit_t* sorted_nbrs = nbr_list->MutablePointer(0);
+  int64_t* times = times_list->data();
+
+  // stable, to keep the nbr units with the same timestamp ordered by vid
+  parallel_for(
+      static_cast<vid_t>(0), tvnum,
+      [&](const vid_t v) {
+        nbr_unit_t *begin = sorted_nbrs + offsets[v],
+                   *end = sorted_nbrs + offsets[v + 1];
+        std::copy(nbrs + offsets[v], nbrs + offsets[v + 1], begin);
+        std::stable_sort(begin, end,
+                         [&](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+                           return edge_times[lhs.eid] < edge_times[rhs.eid];
+                         });
+        for (int64_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+          times[k] = edge_times[sorted_nbrs[k].eid];
+        }
+      },
+      concurrency, 1024);
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::BuildTemporalIndex(
+    vineyard::Client& client, const std::map<label_id_t, prop_id_t>& timestamps,
+    const int concurrency) {
+  if (compact_edges_) {
+    RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                    "Temporal indexes of fragments with compacted edges are "
+                    "not supported");
+  }
+  std::map<label_id_t, std::vector<int64_t>> edge_times;
+  for (auto const& pair : timestamps) {
+    if (pair.first < 0 || pair.first >= edge_label_num_) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Invalid edge label: " + std::to_string(pair.first));
+    }
+    if (pair.second < 0 || static_cast<size_t>(pair.second) >=
+                                edge_tables_[pair.first]->num_columns()) {
+      RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                      "Invalid edge property: " + std::to_string(pair.second));
+    }
+    VY_OK_OR_RAISE(detail::timestamps_as_int64(
+        edge_tables_[pair.first]->GetTable()->column(pair.second),
+        edge_times[pair.first]));
+  }
+
+  using object_lists_t = std::vector<std::vector<std::shared_ptr<ObjectBase>>>;
+  object_lists_t ie_lists(vertex_label_num_), oe_lists(vertex_label_num_),
+      ie_times(vertex_label_num_), oe_times(vertex_label_num_);
+  json temporal_index = json::array();
+  for (label_id_t j = 0; j < edge_label_num_; ++j) {
+    auto iter = edge_times.find(j);
+    bool rebuild = iter != edge_times.end();
+    bool keep = !rebuild && HasTemporalIndex(j);
+    json entry;
+    if (rebuild || keep) {
+      prop_id_t prop_id = rebuild ? timestamps.at(j) : temporal_props_[j];
+      entry["property"] = edge_tables_[j]->schema()->field(prop_id)->name();
+      json oe_ids = json::array(), ie_ids = json::array();
+      for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+        oe_ids.push_back(oe_lists_[i][j]->id());
+        if (directed_) {
+          ie_ids.push_back(ie_lists_[i][j]->id());
+        }
+      }
+      entry["oe_lists"] = oe_ids;
+      if (directed_) {
+        entry["ie_lists"] = ie_ids;
+      }
+    }
+    temporal_index.push_back(entry);
+
+    for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+      std::shared_ptr<ObjectBase> oe_list, oe_time, ie_list, ie_time;
+      if (rebuild) {
+        std::shared_ptr<PodArrayBuilder<nbr_unit_t>> nbr_list;
+        std::shared_ptr<FixedInt64Builder> times_list;
+        buildTemporalNbrList(client, tvnums_[i], oe_ptr_lists_[i][j],
+                             oe_offsets_ptr_lists_[i][j], iter->second,
+                             concurrency, nbr_list, times_list);
+        oe_list = nbr_list;
+        oe_time = times_list;
+        if (directed_) {
+          buildTemporalNbrList(client, tvnums_[i], ie_ptr_lists_[i][j],
+                               ie_offsets_ptr_lists_[i][j], iter->second,
+                               concurrency, nbr_list, times_list);
+          ie_list = nbr_list;
+          ie_time = times_list;
+        }
+      } else if (keep) {
+        oe_list = temporal_oe_lists_[i][j];
+        oe_time = temporal_oe_times_[i][j];
+        if (directed_) {
+          ie_list = temporal_ie_lists_[i][j];
+          ie_time = temporal_ie_times_[i][j];
+        }
+      }
+      // empty placeholders for labels without index
+      auto empty_list = [&client]() {
+        return std::make_shared<PodArrayBuilder<nbr_unit_t>>(client, 0);
+      };
+      auto empty_times = [&client]() {
+        return std::make_shared<FixedInt64Builder>(client, 0);
+      };
+      oe_lists[i].push_back(oe_list ? oe_list : empty_list());
+      oe_times[i].push_back(oe_time ? oe_time : empty_times());
+      ie_lists[i].push_back(ie_list ? ie_list : empty_list());
+      ie_times[i].push_back(ie_time ? ie_time : empty_times());
+    }
+  }
+
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  builder.set_temporal_index_(temporal_index);
+  builder.set_temporal_ie_lists_(ie_lists);
+  builder.set_temporal_oe_lists_(oe_lists);
+  builder.set_temporal_ie_times_(ie_times);
+  builder.set_temporal_oe_times_(oe_times);
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
 }
 
 }  // namespace vineyard
@@ -0,0 +1,309 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_INTERSECTION_H_
+#define MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_INTERSECTION_H_
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "basic/utils.h"
+
+#include "graph/fragment/property_graph_types.h"
+#include "graph/utils/set_intersection.h"
+
+namespace vineyard {
+
+/**
+ * @brief Count the common neighbors of two adjacent lists, whose nbr units
+ * are sorted by vid (see `sort_edges_with_respect_to_vertex`).
+ *
+ * The merge runs over the interleaved `NbrUnit`s directly and gallops over
+ * the longer list when the lengths are skewed. Deleted edges are skipped on
+ * both sides before comparing the vids, and the live parallel edges are
+ * counted once per pair of matched units. Use
+ * `PackedAdjacency` for the SIMD kernels.
+ */
+template <typename VID_T, typename EID_T>
+size_t intersect_adj_list_count(
+    const property_graph_utils::AdjList<VID_T, EID_T>& lhs,
+    const property_graph_utils::AdjList<VID_T, EID_T>& rhs) {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+  using tombstones_t = property_graph_utils::Tombstones;
+  auto vid_less = [](const nbr_unit_t& unit, VID_T vid) {
+    return unit.vid < vid;
+  };
+  // the first unit from `unit` that is not deleted
+  auto alive = [](const nbr_unit_t* unit, const nbr_unit_t* end,
+                  const tombstones_t* tombstones) {
+    if (tombstones != nullptr) {
+      while (unit != end && tombstones->Contains(unit->eid)) {
+        ++unit;
+      }
+    }
+    return unit;
+  };
+  const nbr_unit_t *a = lhs.begin_unit(), *a_end = lhs.end_unit();
+  const nbr_unit_t *b = rhs.begin_unit(), *b_end = rhs.end_unit();
+  const tombstones_t *a_tombstones = lhs.tombstones(),
+                     *b_tombstones = rhs.tombstones();
+  if ((a_end - a) > (b_end - b)) {
+    std::swap(a, b);
+    std::swap(a_end, b_end);
+    std::swap(a_tombstones, b_tombstones);
+  }
+  const bool galloping = (a_end - a) * 32 < (b_end - b);
+
+  size_t count = 0;
+  a = alive(a, a_end, a_tombstones);
+  b = alive(b, b_end, b_tombstones);
+  while (a != a_end && b != b_end) {
+    if (a->vid < b->vid) {
+      a = alive(a + 1, a_end, a_tombstones);
+    } else if (b->vid < a->vid) {
+      b = alive(galloping ? std::lower_bound(b, b_end, a->vid, vid_less)
+                          : b + 1,
+                b_end, b_tombstones);
+    } else {
+      ++count;
+      a = alive(a + 1, a_end, a_tombstones);
+      b = alive(b + 1, b_end, b_tombstones);
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief PackedAdjacency is a vid-only mirror of the nbr lists of one vertex
+ * label and one edge label, on which the intersections run with the SIMD
+ * kernels in `graph/utils/set_intersection.h`.
+ *
+ * The mirror is an undirected view: the list of a vertex is the sorted union
+ * of its outgoing and incoming neighbors inside the same vertex label, with
+ * self-loops, parallel edges and deleted edges dropped. Vertices are indexed
+ * by their offsets inside the label, i.e., inner vertices come first and then
+ * the outer vertices, and the neighbors are stored as offsets as well.
+ *
+ * The mirror lives in the process memory and is not sealed into vineyard.
+ */
+template <typename FRAG_T>
+class PackedAdjacency {
+ public:
+  using fragment_t = FRAG_T;
+  using vid_t = typename fragment_t::vid_t;
+  using label_id_t = typename fragment_t::label_id_t;
+  using vertex_t = typename fragment_t::vertex_t;
+  using adj_list_t = typename fragment_t::adj_list_t;
+
+  static_assert(!fragment_t::compact_v,
+                "Packed adjacency requires non-compact edges");
+
+  PackedAdjacency(const std::shared_ptr<fragment_t>& fragment,
+                  label_id_t v_label, label_id_t e_label,
+                  const int concurrency = std::thread::hardware_concurrency())
+      : fragment_(fragment), v_label_(v_label), e_label_(e_label) {
+    begin_ = fragment_->Vertices(v_label_).begin_value();
+    ivnum_ = fragment_->GetInnerVerticesNum(v_label_);
+    tvnum_ = fragment_->GetVerticesNum(v_label_);
+
+    // first pass to count the (deduplicated) degrees, then fill the
+    // neighbors into the prefix-summed offsets.
+    offsets_.resize(tvnum_ + 1, 0);
+    parallel_for(
+        static_cast<vid_t>(0), tvnum_,
+        [&](const vid_t offset) {
+          thread_local std::vector<vid_t> neighbors;
+          collect(offset, neighbors);
+          offsets_[offset + 1] = neighbors.size();
+        },
+        concurrency, 1024);
+    for (vid_t offset = 0; offset < tvnum_; ++offset) {
+      offsets_[offset + 1] += offsets_[offset];
+    }
+    neighbors_.resize(offsets_[tvnum_]);
+    parallel_for(
+        static_cast<vid_t>(0), tvnum_,
+        [&](const vid_t offset) {
+          thread_local std::vector<vid_t> neighbors;
+          collect(offset, neighbors);
+          std::copy(neighbors.begin(), neighbors.end(),
+                    neighbors_.begin() + offsets_[offset]);
+        },
+        concurrency, 1024);
+  }
+
+  const std::shared_ptr<fragment_t>& fragment() const { return fragment_; }
+
+  label_id_t vertex_label() const { return v_label_; }
+
+  label_id_t edge_label() const { return e_label_; }
+
+  vid_t GetVerticesNum() const { return tvnum_; }
+
+  vid_t GetInnerVerticesNum() const { return ivnum_; }
+
+  /**
+   * @brief The vertex of the given offset.
+   */
+  vertex_t vertex(vid_t offset) const { return vertex_t(begin_ + offset); }
+
+  /**
+   * @brief The offset of the given vertex inside the vertex label.
+   */
+  vid_t offset(const vertex_t& v) const { return v.GetValue() - begin_; }
+
+  const vid_t* neighbors_begin(vid_t offset) const {
+    return neighbors_.data() + offsets_[offset];
+  }
+
+  const vid_t* neighbors_end(vid_t offset) const {
+    return neighbors_.data() + offsets_[offset + 1];
+  }
+
+  size_t degree(vid_t offset) const {
+    return offsets_[offset + 1] - offsets_[offset];
+  }
+
+  /**
+   * @brief Count the common neighbors of vertices at `u` and `v`.
+   */
+  size_t IntersectCount(
+      vid_t u, vid_t v,
+      IntersectionKernel kernel = IntersectionKernel::kAuto) const {
+    return intersect_sorted_count(neighbors_begin(u), degree(u),
+                                  neighbors_begin(v), degree(v), kernel);
+  }
+
+  /**
+   * @brief Write the common neighbors of vertices at `u` and `v` to `out`,
+   * which must have at least `min(degree(u), degree(v))` slots.
+   */
+  size_t Intersect(
+      vid_t u, vid_t v, vid_t* out,
+      IntersectionKernel kernel = IntersectionKernel::kAuto) const {
+    return intersect_sorted(neighbors_begin(u), degree(u), neighbors_begin(v),
+                            degree(v), out, kernel);
+  }
+
+ private:
+  void collect(vid_t offset, std::vector<vid_t>& neighbors) const {
+    neighbors.clear();
+    vertex_t u = vertex(offset);
+    auto append = [&](const adj_list_t& adj_list) {
+      for (auto& e : adj_list) {
+        vid_t v = e.neighbor().GetValue() - begin_;
+        if (v < tvnum_ && v != offset) {
+          neighbors.push_back(v);
+        }
+      }
+    };
+    append(fragment_->GetOutgoingAdjList(u, e_label_));
+    if (fragment_->directed()) {
+      append(fragment_->GetIncomingAdjList(u, e_label_));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+  }
+
+  std::shared_ptr<fragment_t> fragment_;
+  label_id_t v_label_, e_label_;
+  vid_t begin_, ivnum_, tvnum_;
+
+  std::vector<size_t> offsets_;
+  std::vector<vid_t> neighbors_;
+};
+
+/**
+ * @brief Count the triangles each vertex participates in, on the undirected
+ * view of the packed adjacency.
+ *
+ * Each triangle (u, v, w) with u < v < w is enumerated exactly once from
+ * `u` by intersecting the neighbors of `u` and `v` that are larger than `v`.
+ * Only the edges in the local fragment are visible, i.e., the result is exact
+ * when the graph is loaded as a single fragment.
+ */
+template <typename FRAG_T>
+std::vector<uint64_t> CountTriangles(
+    const PackedAdjacency<FRAG_T>& adjacency,
+    const int concurrency = std::thread::hardware_concurrency(),
+    IntersectionKernel kernel = IntersectionKernel::kAuto) {
+  using vid_t = typename PackedAdjacency<FRAG_T>::vid_t;
+  vid_t tvnum = adjacency.GetVerticesNum();
+  std::vector<uint64_t> triangles(tvnum, 0);
+  parallel_for(
+      static_cast<vid_t>(0), tvnum,
+      [&](const vid_t u) {
+        thread_local std::vector<vid_t> common;
+        const vid_t *u_begin = adjacency.neighbors_begin(u),
+                    *u_end = adjacency.neighbors_end(u);
+        uint64_t u_triangles = 0;
+        for (const vid_t* v = std::upper_bound(u_begin, u_end, u); v != u_end;
+             ++v) {
+          const vid_t *lhs = v + 1,
+                      *rhs = std::upper_bound(adjacency.neighbors_begin(*v),
+                                              adjacency.neighbors_end(*v), *v);
+          size_t lhs_size = u_end - lhs,
+                 rhs_size = adjacency.neighbors_end(*v) - rhs;
+          common.resize(std::min(lhs_size, rhs_size));
+          size_t count = intersect_sorted(lhs, lhs_size, rhs, rhs_size,
+                                          common.data(), kernel);
+          if (count == 0) {
+            continue;
+          }
+          u_triangles += count;
+          __sync_fetch_and_add(&triangles[*v], count);
+          for (size_t k = 0; k < count; ++k) {
+            __sync_fetch_and_add(&triangles[common[k]], 1);
+          }
+        }
+        __sync_fetch_and_add(&triangles[u], u_triangles);
+      },
+      concurrency, 64);
+  return triangles;
+}
+
+/**
+ * @brief The local clustering coefficient of each vertex, i.e., the ratio of
+ * the triangles to the pairs of its neighbors, on the undirected view of the
+ * packed adjacency.
+ */
+template <typename FRAG_T>
+std::vector<double> LocalClusteringCoefficient(
+    const PackedAdjacency<FRAG_T>& adjacency,
+    const int concurrency = std::thread::hardware_concurrency(),
+    IntersectionKernel kernel = IntersectionKernel::kAuto) {
+  using vid_t = typename PackedAdjacency<FRAG_T>::vid_t;
+  std::vector<uint64_t> triangles =
+      CountTriangles(adjacency, concurrency, kernel);
+  std::vector<double> coefficients(triangles.size(), 0.0);
+  parallel_for(
+      static_cast<vid_t>(0), adjacency.GetVerticesNum(),
+      [&](const vid_t v) {
+        double degree = adjacency.degree(v);
+        if (degree > 1) {
+          coefficients[v] = 2.0 * triangles[v] / (degree * (degree - 1));
+        }
+      },
+      concurrency, 1024);
+  return coefficients;
+}
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_INTERSECTION_H_
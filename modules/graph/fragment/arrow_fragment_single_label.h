@@ -0,0 +1,262 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_SINGLE_LABEL_H_
+#define MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_SINGLE_LABEL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boost/leaf.hpp"
+
+#include "grape/utils/vertex_array.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/property_graph_types.h"
+#include "graph/fragment/property_graph_utils.h"
+#include "graph/utils/error.h"
+
+namespace vineyard {
+
+/**
+ * @brief SingleLabelArrowFragment is a specialized accessor over an
+ * ArrowFragment that has exactly one vertex label and one edge label.
+ *
+ * The blobs of the underlying fragment are shared as-is. As the label id of
+ * every vertex is 0, the vertex value (lid) is exactly the offset inside the
+ * label, and all the per-label pointers are resolved once at construction.
+ * The accessors in the hot traversal loops thus get rid of the `IdParser` bit
+ * manipulation and the label-indexed indirections.
+ */
+template <typename FRAG_T>
+class SingleLabelArrowFragment {
+ public:
+  using fragment_t = FRAG_T;
+  using oid_t = typename fragment_t::oid_t;
+  using vid_t = typename fragment_t::vid_t;
+  using eid_t = typename fragment_t::eid_t;
+  using internal_oid_t = typename fragment_t::internal_oid_t;
+  using prop_id_t = typename fragment_t::prop_id_t;
+  using label_id_t = typename fragment_t::label_id_t;
+  using vertex_t = typename fragment_t::vertex_t;
+  using vertex_range_t = typename fragment_t::vertex_range_t;
+  using inner_vertices_t = typename fragment_t::inner_vertices_t;
+  using outer_vertices_t = typename fragment_t::outer_vertices_t;
+  using vertices_t = typename fragment_t::vertices_t;
+  using nbr_t = typename fragment_t::nbr_t;
+  using nbr_unit_t = typename fragment_t::nbr_unit_t;
+  using adj_list_t = typename fragment_t::adj_list_t;
+  using raw_adj_list_t = typename fragment_t::raw_adj_list_t;
+
+  template <typename DATA_T>
+  using vertex_array_t = grape::VertexArray<vertices_t, DATA_T>;
+
+  static_assert(!fragment_t::compact_v,
+                "Single label specialization requires non-compact edges");
+
+  /**
+   * @brief Specialize the fragment, fails when the fragment has more than one
+   * vertex label or edge label.
+   */
+  static boost::leaf::result<std::shared_ptr<SingleLabelArrowFragment>> Make(
+      const std::shared_ptr<fragment_t>& fragment) {
+    if (fragment->vertex_label_num() != 1 || fragment->edge_label_num() != 1) {
+      RETURN_GS_ERROR(
+          ErrorCode::kInvalidOperationError,
+          "Single label fragment requires exactly one vertex label and one "
+          "edge label, but got " +
+              std::to_string(fragment->vertex_label_num()) +
+              " vertex labels and " +
+              std::to_string(fragment->edge_label_num()) + " edge labels");
+    }
+    return std::shared_ptr<SingleLabelArrowFragment>(
+        new SingleLabelArrowFragment(fragment));
+  }
+
+  const std::shared_ptr<fragment_t>& fragment() const { return fragment_; }
+
+  fid_t fid() const { return fid_; }
+
+  fid_t fnum() const { return fnum_; }
+
+  bool directed() const { return directed_; }
+
+  inline vertices_t Vertices() const { return vertices_t(0, tvnum_); }
+
+  inline inner_vertices_t InnerVertices() const {
+    return inner_vertices_t(0, ivnum_);
+  }
+
+  inline outer_vertices_t OuterVertices() const {
+    return outer_vertices_t(ivnum_, tvnum_);
+  }
+
+  inline vid_t GetVerticesNum() const { return tvnum_; }
+
+  inline vid_t GetInnerVerticesNum() const { return ivnum_; }
+
+  inline vid_t GetOuterVerticesNum() const { return tvnum_ - ivnum_; }
+
+  inline bool IsInnerVertex(const vertex_t& v) const {
+    return v.GetValue() < ivnum_;
+  }
+
+  inline bool IsOuterVertex(const vertex_t& v) const {
+    return v.GetValue() >= ivnum_ && v.GetValue() < tvnum_;
+  }
+
+  template <typename T>
+  inline T GetData(const vertex_t& v, prop_id_t prop_id) const {
+    return property_graph_utils::ValueGetter<T>::Value(vdata_columns_[prop_id],
+                                                       v.GetValue());
+  }
+
+  inline adj_list_t GetOutgoingAdjList(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return adj_list_t(&oe_[oe_offsets_[offset]], &oe_[oe_offsets_[offset + 1]],
+                      edata_columns_, edge_tombstones_);
+  }
+
+  inline adj_list_t GetIncomingAdjList(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return adj_list_t(&ie_[ie_offsets_[offset]], &ie_[ie_offsets_[offset + 1]],
+                      edata_columns_, edge_tombstones_);
+  }
+
+  inline bool IsDeletedVertex(const vertex_t& v) const {
+    return vertex_tombstones_->Contains(v.GetValue());
+  }
+
+  inline raw_adj_list_t GetOutgoingRawAdjList(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return raw_adj_list_t(&oe_[oe_offsets_[offset]],
+                          &oe_[oe_offsets_[offset + 1]]);
+  }
+
+  inline raw_adj_list_t GetIncomingRawAdjList(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return raw_adj_list_t(&ie_[ie_offsets_[offset]],
+                          &ie_[ie_offsets_[offset + 1]]);
+  }
+
+  inline int GetLocalOutDegree(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return static_cast<int>(oe_offsets_[offset + 1] - oe_offsets_[offset]);
+  }
+
+  inline int GetLocalInDegree(const vertex_t& v) const {
+    vid_t offset = v.GetValue();
+    return static_cast<int>(ie_offsets_[offset + 1] - ie_offsets_[offset]);
+  }
+
+  inline vid_t GetInnerVertexGid(const vertex_t& v) const {
+    return vid_parser_.GenerateId(fid_, 0, v.GetValue());
+  }
+
+  inline vid_t GetOuterVertexGid(const vertex_t& v) const {
+    return ovgid_list_[v.GetValue() - ivnum_];
+  }
+
+  inline vid_t Vertex2Gid(const vertex_t& v) const {
+    return IsInnerVertex(v) ? GetInnerVertexGid(v) : GetOuterVertexGid(v);
+  }
+
+  inline bool InnerVertexGid2Vertex(const vid_t& gid, vertex_t& v) const {
+    v.SetValue(vid_parser_.GetLid(gid));
+    return true;
+  }
+
+  inline bool OuterVertexGid2Vertex(const vid_t& gid, vertex_t& v) const {
+    auto iter = ovg2l_map_->find(gid);
+    if (iter != ovg2l_map_->end()) {
+      v.SetValue(iter->second);
+      return true;
+    }
+    return false;
+  }
+
+  inline bool Gid2Vertex(const vid_t& gid, vertex_t& v) const {
+    return (vid_parser_.GetFid(gid) == fid_) ? InnerVertexGid2Vertex(gid, v)
+                                             : OuterVertexGid2Vertex(gid, v);
+  }
+
+  inline fid_t GetFragId(const vertex_t& v) const {
+    return IsInnerVertex(v) ? fid_ : vid_parser_.GetFid(GetOuterVertexGid(v));
+  }
+
+  oid_t GetId(const vertex_t& v) const { return fragment_->GetId(v); }
+
+  bool GetVertex(const oid_t& oid, vertex_t& v) const {
+    return fragment_->GetVertex(0, oid, v);
+  }
+
+ private:
+  explicit SingleLabelArrowFragment(const std::shared_ptr<fragment_t>& fragment)
+      : fragment_(fragment) {
+    fid_ = fragment->fid_;
+    fnum_ = fragment->fnum_;
+    directed_ = fragment->directed_;
+    vid_parser_.Init(fnum_, fragment->vertex_label_num_);
+
+    ivnum_ = fragment->ivnums_[0];
+    tvnum_ = fragment->tvnums_[0];
+
+    vdata_columns_ = fragment->vertex_tables_columns_[0].data();
+    edata_columns_ = fragment->flatten_edge_tables_columns_[0];
+
+    oe_ = fragment->oe_ptr_lists_[0][0];
+    oe_offsets_ = fragment->oe_offsets_ptr_lists_[0][0];
+    if (directed_) {
+      ie_ = fragment->ie_ptr_lists_[0][0];
+      ie_offsets_ = fragment->ie_offsets_ptr_lists_[0][0];
+    } else {
+      ie_ = oe_;
+      ie_offsets_ = oe_offsets_;
+    }
+
+    vertex_tombstones_ = &fragment->vertex_tombstones_bits_[0];
+    edge_tombstones_ = fragment->edge_tombstones_ptr_[0];
+
+    ovgid_list_ = fragment->ovgid_lists_ptr_[0];
+    ovg2l_map_ = fragment->ovg2l_maps_ptr_[0];
+  }
+
+  std::shared_ptr<fragment_t> fragment_;
+
+  fid_t fid_, fnum_;
+  bool directed_;
+  IdParser<vid_t> vid_parser_;
+
+  vid_t ivnum_, tvnum_;
+
+  const void* const* vdata_columns_;
+  const void** edata_columns_;
+
+  const nbr_unit_t* oe_;
+  const int64_t* oe_offsets_;
+  const nbr_unit_t* ie_;
+  const int64_t* ie_offsets_;
+
+  const property_graph_utils::Tombstones* vertex_tombstones_;
+  const property_graph_utils::Tombstones* edge_tombstones_;
+
+  const vid_t* ovgid_list_;
+  Hashmap<vid_t, vid_t>* ovg2l_map_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_FRAGMENT_ARROW_FRAGMENT_SINGLE_LABEL_H_
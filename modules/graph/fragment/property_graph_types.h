@@ -336,6 +336,20 @@ struct ValueGetter<std::string> {
   }
 };
 
+/**
+ * @brief Tombstones is a bitmap of the deleted entries, e.g., edges indexed by
+ * the edge id. Entries beyond `size` (i.e., added after the deletion) are
+ * alive.
+ */
+struct Tombstones {
+  const uint8_t* bits = nullptr;
+  int64_t size = 0;
+
+  inline bool Contains(int64_t index) const {
+    return index < size && ((bits[index >> 3] >> (index & 7)) & 1);
+  }
+};
+
 template <typename VID_T, typename EID_T>
 struct Nbr {
  private:
@@ -347,19 +361,40 @@ struct Nbr {
   Nbr() : nbr_(NULL), edata_arrays_(nullptr) {}
   Nbr(const NbrUnit<VID_T, EID_T>* nbr, const void** edata_arrays)
       : nbr_(nbr), edata_arrays_(edata_arrays) {}
-  Nbr(const Nbr& rhs) : nbr_(rhs.nbr_), edata_arrays_(rhs.edata_arrays_) {}
+  Nbr(const NbrUnit<VID_T, EID_T>* nbr, const void** edata_arrays,
+      const NbrUnit<VID_T, EID_T>* end, const Tombstones* tombstones)
+      : nbr_(nbr),
+        edata_arrays_(edata_arrays),
+        end_(end),
+        tombstones_(tombstones) {
+    if (tombstones_ != nullptr) {
+      skip();
+    }
+  }
+  Nbr(const Nbr& rhs)
+      : nbr_(rhs.nbr_),
+        edata_arrays_(rhs.edata_arrays_),
+        end_(rhs.end_),
+        tombstones_(rhs.tombstones_) {}
   Nbr(Nbr&& rhs)
-      : nbr_(std::move(rhs.nbr_)), edata_arrays_(rhs.edata_arrays_) {}
+      : nbr_(std::move(rhs.nbr_)),
+        edata_arrays_(rhs.edata_arrays_),
+        end_(rhs.end_),
+        tombstones_(rhs.tombstones_) {}
 
   Nbr& operator=(const Nbr& rhs) {
     nbr_ = rhs.nbr_;
     edata_arrays_ = rhs.edata_arrays_;
+    end_ = rhs.end_;
+    tombstones_ = rhs.tombstones_;
     return *this;
   }
 
   Nbr& operator=(Nbr&& rhs) {
     nbr_ = std::move(rhs.nbr_);
     edata_arrays_ = std::move(rhs.edata_arrays_);
+    end_ = rhs.end_;
+    tombstones_ = rhs.tombstones_;
     return *this;
   }
 
@@ -392,6 +427,9 @@ struct Nbr {
 
   inline const Nbr& operator++() const {
     ++nbr_;
+    if (tombstones_ != nullptr) {
+      skip();
+    }
     return *this;
   }
 
@@ -401,6 +439,7 @@ struct Nbr {
     return ret;
   }
 
+  // N.B.: decrement doesn't skip the tombstones.
   inline const Nbr& operator--() const {
     --nbr_;
     return *this;
@@ -420,8 +459,16 @@ struct Nbr {
   inline const Nbr& operator*() const { return *this; }
 
  private:
+  inline void skip() const {
+    while (nbr_ != end_ && tombstones_->Contains(nbr_->eid)) {
+      ++nbr_;
+    }
+  }
+
   const mutable NbrUnit<VID_T, EID_T>* nbr_;
   const void** edata_arrays_;
+  const NbrUnit<VID_T, EID_T>* end_ = nullptr;
+  const Tombstones* tombstones_ = nullptr;
 };
 
 template <typename VID_T, typename EID_T>
@@ -689,38 +736,61 @@ class RawAdjList {
 template <typename VID_T>
 using RawAdjListDefault = RawAdjList<VID_T, property_graph_types::EID_TYPE>;
 
+/**
+ * @brief AdjList iterates over the nbr units in [begin, end), skipping the
+ * entries whose edge id is in the tombstones (if any). The `begin_unit()` and
+ * `end_unit()` expose the physical range, including the deleted entries.
+ */
 template <typename VID_T, typename EID_T>
 class AdjList {
  public:
   AdjList() : begin_(NULL), end_(NULL), edata_arrays_(nullptr) {}
   AdjList(const NbrUnit<VID_T, EID_T>* begin, const NbrUnit<VID_T, EID_T>* end,
-          const void** edata_arrays)
-      : begin_(begin), end_(end), edata_arrays_(edata_arrays) {}
+          const void** edata_arrays, const Tombstones* tombstones = nullptr)
+      : begin_(begin),
+        end_(end),
+        edata_arrays_(edata_arrays),
+        tombstones_(tombstones) {}
 
   inline Nbr<VID_T, EID_T> begin() const {
-    return Nbr<VID_T, EID_T>(begin_, edata_arrays_);
+    if (tombstones_ == nullptr) {
+      return Nbr<VID_T, EID_T>(begin_, edata_arrays_);
+    }
+    return Nbr<VID_T, EID_T>(begin_, edata_arrays_, end_, tombstones_);
   }
 
   inline Nbr<VID_T, EID_T> end() const {
     return Nbr<VID_T, EID_T>(end_, edata_arrays_);
   }
 
-  inline size_t Size() const { return end_ - begin_; }
+  inline size_t Size() const {
+    if (tombstones_ == nullptr) {
+      return end_ - begin_;
+    }
+    size_t size = 0;
+    for (auto nbr = begin_; nbr != end_; ++nbr) {
+      size += !tombstones_->Contains(nbr->eid);
+    }
+    return size;
+  }
 
-  inline bool Empty() const { return end_ == begin_; }
+  inline bool Empty() const { return begin() == end(); }
 
-  inline bool NotEmpty() const { return end_ != begin_; }
+  inline bool NotEmpty() const { return begin() != end(); }
 
-  size_t size() const { return end_ - begin_; }
+  size_t size() const { return Size(); }
 
   inline const NbrUnit<VID_T, EID_T>* begin_unit() const { return begin_; }
 
   inline const NbrUnit<VID_T, EID_T>* end_unit() const { return end_; }
 
+  inline const Tombstones* tombstones() const { return tombstones_; }
+
  private:
   const NbrUnit<VID_T, EID_T>* begin_;
   const NbrUnit<VID_T, EID_T>* end_;
   const void** edata_arrays_;
+  const Tombstones* tombstones_ = nullptr;
 };
 
 template <typename VID_T, typename EID_T>
@@ -777,8 +777,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructVerticesImpl(
     // shuffle is to send the correct data to its worker by hash
     auto shuffle_procedure =
         [&]() -> boost::leaf::result<std::shared_ptr<arrow::Table>> {
-      BOOST_LEAF_AUTO(table, ShufflePropertyVertexTable<partitioner_t>(
-                                 comm_spec_, partitioner_, vertex_table));
+      BOOST_LEAF_AUTO(table,
+                      ShufflePropertyVertexTable<partitioner_t>(
+                          comm_spec_, partitioner_, vertex_table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled vertex table size for label " << v_label << ": "
                 << table->num_rows();
@@ -868,8 +869,9 @@ boost::leaf::result<void> BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::
     // shuffle is to send the correct data to its worker by hash
     auto shuffle_procedure =
         [&]() -> boost::leaf::result<std::shared_ptr<arrow::Table>> {
-      BOOST_LEAF_AUTO(table, ShufflePropertyVertexTable<partitioner_t>(
-                                 comm_spec_, partitioner_, vertex_table));
+      BOOST_LEAF_AUTO(table,
+                      ShufflePropertyVertexTable<partitioner_t>(
+                          comm_spec_, partitioner_, vertex_table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled vertex table size for label " << v_label << ": "
                 << table->num_rows();
@@ -952,7 +954,8 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructVerticesImplLocal(
   }
   local_vm_builder_ =
       std::make_shared<ArrowLocalVertexMapBuilder<internal_oid_t, vid_t>>(
-          client_, comm_spec_.fnum(), comm_spec_.fid(), vertex_label_num_);
+          client_, comm_spec_.fnum(), comm_spec_.fid(), vertex_label_num_,
+          use_perfect_hash_);
 
   std::vector<std::shared_ptr<arrow::ChunkedArray>> local_oid_array(
       vertex_label_num_);
@@ -960,8 +963,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructVerticesImplLocal(
     auto vertex_table = ordered_vertex_tables_[v_label];
     auto shuffle_procedure =
         [&]() -> boost::leaf::result<std::shared_ptr<arrow::Table>> {
-      BOOST_LEAF_AUTO(table, ShufflePropertyVertexTable<partitioner_t>(
-                                 comm_spec_, partitioner_, vertex_table));
+      BOOST_LEAF_AUTO(table,
+                      ShufflePropertyVertexTable<partitioner_t>(
+                          comm_spec_, partitioner_, vertex_table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled vertex table size for label " << v_label << ": "
                 << table->num_rows();
@@ -1021,8 +1025,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructEdgesImpl(
           std::make_shared<ConcatTablePipeline>(processed_table_list);
       // Shuffle the edge table with gid
       BOOST_LEAF_AUTO(
-          table_out, ShufflePropertyEdgeTable<vid_t>(
-                         comm_spec_, id_parser, src_column, dst_column, table));
+          table_out,
+          ShufflePropertyEdgeTable<vid_t>(comm_spec_, id_parser, src_column,
+                                          dst_column, table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled edge table size for label " << e_label << ": "
                 << table_out->num_rows();
@@ -1065,7 +1070,8 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructEdgesImplLocal(
         BOOST_LEAF_AUTO(
             table_out,
             ShufflePropertyEdgeTableByPartition<partitioner_t>(
-                comm_spec_, partitioner_, src_column, dst_column, item.second));
+                comm_spec_, partitioner_, src_column, dst_column, item.second,
+                &client_));
         VLOG(100) << "[worker-" << comm_spec_.worker_id()
                   << "] shuffled edge table size for label " << e_label << ": "
                   << table_out->num_rows();
@@ -0,0 +1,243 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using LoaderType = ArrowFragmentLoader<property_graph_types::OID_TYPE,
+                                       property_graph_types::VID_TYPE>;
+using vid_t = GraphType::vid_t;
+using prop_id_t = GraphType::prop_id_t;
+
+/**
+ * Split the edges into two halves, to extend the fragment with the second
+ * half later.
+ */
+void SplitEdges(std::string const& path, std::string const& first,
+                std::string const& second) {
+  std::ifstream input(path);
+  std::string header, line;
+  std::vector<std::string> lines;
+  CHECK(std::getline(input, header));
+  while (std::getline(input, line)) {
+    lines.push_back(line);
+  }
+  std::ofstream first_output(first), second_output(second);
+  first_output << header << "\n";
+  second_output << header << "\n";
+  for (size_t index = 0; index < lines.size(); ++index) {
+    (index < lines.size() / 2 ? first_output : second_output)
+        << lines[index] << "\n";
+  }
+}
+
+/**
+ * The mirror must agree with the vertex tables of the owner fragments, and
+ * returns the number of outer vertices that are covered by the mirror.
+ */
+size_t CheckMirror(Client& client, const grape::CommSpec& comm_spec,
+                   ObjectID fragment_group_id,
+                   std::vector<prop_id_t> const& props) {
+  auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+      client.GetObject(fragment_group_id));
+  std::vector<std::shared_ptr<GraphType>> owners(comm_spec.fnum());
+  for (fid_t fid = 0; fid < comm_spec.fnum(); ++fid) {
+    owners[fid] = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(fid)));
+  }
+  auto frag = owners[comm_spec.fid()];
+  auto mirror = frag->outer_vertex_mirror_table(0);
+  CHECK(mirror != nullptr);
+  CHECK_EQ(mirror->num_columns(), static_cast<int>(props.size() + 1));
+  CHECK_LE(static_cast<size_t>(mirror->num_rows()),
+           static_cast<size_t>(frag->GetOuterVerticesNum(0)));
+
+  int64_t row = 0;
+  for (auto v : frag->OuterVertices(0)) {
+    if (row == mirror->num_rows()) {
+      for (auto prop : props) {
+        CHECK(!frag->HasMirrorData(v, prop));
+      }
+      continue;
+    }
+    auto const& owner = owners[frag->GetFragId(v)];
+    GraphType::vertex_t u;
+    CHECK(owner->InnerVertexGid2Vertex(frag->GetOuterVertexGid(v), u));
+    auto owner_table = owner->vertex_data_table(0);
+    for (auto prop : props) {
+      CHECK(frag->HasMirrorData(v, prop));
+      auto expected =
+          owner_table->column(prop)->GetScalar(owner->vertex_offset(u));
+      auto actual = mirror->column(prop + 1)->GetScalar(row);
+      CHECK(expected.ok() && actual.ok());
+      CHECK(expected.ValueOrDie()->Equals(*actual.ValueOrDie()));
+      if (frag->vertex_property_type(0, prop)->Equals(arrow::int64())) {
+        CHECK_EQ(frag->GetMirrorData<int64_t>(v, prop),
+                 owner->GetData<int64_t>(u, prop));
+      }
+    }
+    row += 1;
+  }
+  return row;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_mirror_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string v_file_suffix = ".csv#header_row=true&label=person";
+  std::string e_file_suffix =
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    std::string e_file_path_1 = e_file_path + "_mirror_1";
+    std::string e_file_path_2 = e_file_path + "_mirror_2";
+    if (comm_spec.worker_id() == 0) {
+      SplitEdges(e_file_path + ".csv", e_file_path_1 + ".csv",
+                 e_file_path_2 + ".csv");
+    }
+    MPI_Barrier(comm_spec.comm());
+
+    auto loader = std::make_unique<LoaderType>(
+        client, comm_spec,
+        std::vector<std::string>{e_file_path_1 + e_file_suffix},
+        std::vector<std::string>{v_file_path + v_file_suffix},
+        /* directed */ 1);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+
+    std::vector<prop_id_t> props;
+    for (prop_id_t i = 0; i < frag->vertex_data_table(0)->num_columns(); ++i) {
+      props.push_back(i);
+    }
+
+    MPI_Barrier(comm_spec.comm());
+    double start = GetCurrentTime();
+    auto mirrored_id =
+        frag->MirrorOuterVertices(client, comm_spec, {{0, props}}).value();
+    double mirror_time = GetCurrentTime() - start;
+    auto mirrored =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(mirrored_id));
+    auto mirror = mirrored->outer_vertex_mirror_table(0);
+    CHECK_EQ(mirror->column(0)->num_chunks(), 1);
+    CHECK_EQ(CheckMirror(client, comm_spec,
+                         ConstructFragmentGroup(client, mirrored_id, comm_spec)
+                             .value(),
+                         props),
+             static_cast<size_t>(mirrored->GetOuterVerticesNum(0)));
+
+    // nothing to pull when the fragment is not extended
+    auto refreshed_id =
+        mirrored->RefreshOuterVertexMirrors(client, comm_spec).value();
+    CHECK_EQ(refreshed_id, mirrored_id);
+
+    LOG(INFO) << "Mirrored " << mirror->num_rows() << " outer vertices with "
+              << props.size() << " properties in " << mirror_time << "s";
+
+    // extend the fragment with the rest of edges: the mirror is kept, but
+    // doesn't cover the new outer vertices until refreshed
+    auto extend_loader = std::make_unique<LoaderType>(
+        client, comm_spec,
+        std::vector<std::string>{e_file_path_2 + e_file_suffix},
+        std::vector<std::string>{}, /* directed */ 1);
+    auto extended_id =
+        extend_loader->AddDataToExistedELabel(mirrored_id, 0).value();
+    auto extended =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(extended_id));
+    CHECK_EQ(CheckMirror(client, comm_spec,
+                         ConstructFragmentGroup(client, extended_id, comm_spec)
+                             .value(),
+                         props),
+             static_cast<size_t>(mirror->num_rows()));
+
+    MPI_Barrier(comm_spec.comm());
+    start = GetCurrentTime();
+    refreshed_id =
+        extended->RefreshOuterVertexMirrors(client, comm_spec).value();
+    double refresh_time = GetCurrentTime() - start;
+    auto refreshed =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(refreshed_id));
+    size_t added = extended->GetOuterVerticesNum(0) - mirror->num_rows();
+    if (added > 0) {
+      // the pulled rows are appended as a chunk, the existing rows are reused
+      CHECK_NE(refreshed_id, extended_id);
+      auto refreshed_mirror = refreshed->outer_vertex_mirror_table(0);
+      CHECK_EQ(refreshed_mirror->column(0)->num_chunks(), 2);
+      CHECK_EQ(refreshed_mirror->column(1)->chunk(0)->data()->buffers[1],
+               mirror->column(1)->chunk(0)->data()->buffers[1]);
+    }
+    CHECK_EQ(CheckMirror(client, comm_spec,
+                         ConstructFragmentGroup(client, refreshed_id, comm_spec)
+                             .value(),
+                         props),
+             static_cast<size_t>(refreshed->GetOuterVerticesNum(0)));
+
+    LOG(INFO) << "Refreshed " << added << " outer vertices in "
+              << refresh_time << "s";
+
+    MPI_Barrier(comm_spec.comm());
+    if (comm_spec.worker_id() == 0) {
+      std::remove((e_file_path_1 + ".csv").c_str());
+      std::remove((e_file_path_2 + ".csv").c_str());
+    }
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment mirror test...";
+
+  return 0;
+}
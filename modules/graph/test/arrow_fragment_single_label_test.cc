@@ -0,0 +1,249 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/fragment/arrow_fragment_single_label.h"
+#include "graph/loader/arrow_fragment_loader.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using SingleLabelGraphType = SingleLabelArrowFragment<GraphType>;
+using vertex_t = GraphType::vertex_t;
+using vid_t = GraphType::vid_t;
+
+/**
+ * Accessors that let the kernels below run on both the generic fragment and
+ * the single label specialization.
+ */
+struct GenericAccessor {
+  explicit GenericAccessor(const std::shared_ptr<GraphType>& frag)
+      : frag(frag) {}
+
+  GraphType::inner_vertices_t InnerVertices() const {
+    return frag->InnerVertices(0);
+  }
+  vid_t VerticesNum() const { return frag->GetVerticesNum(0); }
+  GraphType::adj_list_t OutgoingAdjList(const vertex_t& v) const {
+    return frag->GetOutgoingAdjList(v, 0);
+  }
+  int OutDegree(const vertex_t& v) const {
+    return frag->GetLocalOutDegree(v, 0);
+  }
+  int64_t VertexIndex(const vertex_t& v) const {
+    return frag->vertex_offset(v);
+  }
+  bool IsInnerVertex(const vertex_t& v) const {
+    return frag->IsInnerVertex(v);
+  }
+
+  std::shared_ptr<GraphType> frag;
+};
+
+struct SingleLabelAccessor {
+  explicit SingleLabelAccessor(
+      const std::shared_ptr<SingleLabelGraphType>& frag)
+      : frag(frag) {}
+
+  SingleLabelGraphType::inner_vertices_t InnerVertices() const {
+    return frag->InnerVertices();
+  }
+  vid_t VerticesNum() const { return frag->GetVerticesNum(); }
+  SingleLabelGraphType::adj_list_t OutgoingAdjList(const vertex_t& v) const {
+    return frag->GetOutgoingAdjList(v);
+  }
+  int OutDegree(const vertex_t& v) const { return frag->GetLocalOutDegree(v); }
+  int64_t VertexIndex(const vertex_t& v) const { return v.GetValue(); }
+  bool IsInnerVertex(const vertex_t& v) const {
+    return frag->IsInnerVertex(v);
+  }
+
+  std::shared_ptr<SingleLabelGraphType> frag;
+};
+
+template <typename ACCESSOR_T>
+std::vector<double> PageRank(const ACCESSOR_T& accessor, int rounds) {
+  const double delta = 0.85;
+  vid_t vnum = accessor.VerticesNum();
+  std::vector<double> rank(vnum, 1.0 / vnum), next(vnum, 0.0);
+  for (int round = 0; round < rounds; ++round) {
+    std::fill(next.begin(), next.end(), (1 - delta) / vnum);
+    for (auto v : accessor.InnerVertices()) {
+      int degree = accessor.OutDegree(v);
+      if (degree == 0) {
+        continue;
+      }
+      double contribution = delta * rank[accessor.VertexIndex(v)] / degree;
+      for (auto& e : accessor.OutgoingAdjList(v)) {
+        next[accessor.VertexIndex(e.neighbor())] += contribution;
+      }
+    }
+    std::swap(rank, next);
+  }
+  return rank;
+}
+
+template <typename ACCESSOR_T>
+std::vector<int64_t> BFS(const ACCESSOR_T& accessor, const vertex_t& source) {
+  std::vector<int64_t> depth(accessor.VerticesNum(),
+                             std::numeric_limits<int64_t>::max());
+  std::queue<vertex_t> queue;
+  depth[accessor.VertexIndex(source)] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    vertex_t u = queue.front();
+    queue.pop();
+    int64_t next_depth = depth[accessor.VertexIndex(u)] + 1;
+    for (auto& e : accessor.OutgoingAdjList(u)) {
+      vertex_t v = e.neighbor();
+      int64_t index = accessor.VertexIndex(v);
+      if (depth[index] == std::numeric_limits<int64_t>::max()) {
+        depth[index] = next_depth;
+        if (accessor.IsInnerVertex(v)) {
+          queue.push(v);
+        }
+      }
+    }
+  }
+  return depth;
+}
+
+template <typename ACCESSOR_T>
+std::vector<int64_t> SSSP(const ACCESSOR_T& accessor, const vertex_t& source) {
+  using item_t = std::pair<int64_t, vid_t>;
+  std::vector<int64_t> distance(accessor.VerticesNum(),
+                                std::numeric_limits<int64_t>::max());
+  std::priority_queue<item_t, std::vector<item_t>, std::greater<item_t>> heap;
+  distance[accessor.VertexIndex(source)] = 0;
+  heap.emplace(0, source.GetValue());
+  while (!heap.empty()) {
+    item_t item = heap.top();
+    heap.pop();
+    vertex_t u(item.second);
+    if (item.first > distance[accessor.VertexIndex(u)]) {
+      continue;
+    }
+    for (auto& e : accessor.OutgoingAdjList(u)) {
+      vertex_t v = e.neighbor();
+      int64_t index = accessor.VertexIndex(v);
+      int64_t weight = std::abs(e.template get_data<int64_t>(0));
+      if (item.first + weight < distance[index]) {
+        distance[index] = item.first + weight;
+        if (accessor.IsInnerVertex(v)) {
+          heap.emplace(distance[index], v.GetValue());
+        }
+      }
+    }
+  }
+  return distance;
+}
+
+template <typename ACCESSOR_T>
+void RunKernels(const std::string& name, const ACCESSOR_T& accessor,
+                std::vector<double>& ranks, std::vector<int64_t>& depths,
+                std::vector<int64_t>& distances) {
+  vertex_t source = *accessor.InnerVertices().begin();
+
+  double start = GetCurrentTime();
+  ranks = PageRank(accessor, 10);
+  double pagerank_time = GetCurrentTime() - start;
+
+  start = GetCurrentTime();
+  depths = BFS(accessor, source);
+  double bfs_time = GetCurrentTime() - start;
+
+  start = GetCurrentTime();
+  distances = SSSP(accessor, source);
+  double sssp_time = GetCurrentTime() - start;
+
+  LOG(INFO) << "[" << name << "] PageRank(10 rounds): " << pagerank_time
+            << "s, BFS: " << bfs_time << "s, SSSP: " << sssp_time << "s";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_single_label_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + ".csv#header_row=true&label=person";
+  std::string efile =
+      e_file_path +
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<
+        property_graph_types::OID_TYPE, property_graph_types::VID_TYPE>>(
+        client, comm_spec, std::vector<std::string>{efile},
+        std::vector<std::string>{vfile}, /* directed */ 1);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+    auto single_label_frag = SingleLabelGraphType::Make(frag).value();
+
+    std::vector<double> generic_ranks, single_label_ranks;
+    std::vector<int64_t> generic_depths, single_label_depths;
+    std::vector<int64_t> generic_distances, single_label_distances;
+    RunKernels("generic", GenericAccessor(frag), generic_ranks, generic_depths,
+               generic_distances);
+    RunKernels("single-label", SingleLabelAccessor(single_label_frag),
+               single_label_ranks, single_label_depths,
+               single_label_distances);
+
+    CHECK(generic_ranks == single_label_ranks);
+    CHECK(generic_depths == single_label_depths);
+    CHECK(generic_distances == single_label_distances);
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment single label test...";
+
+  return 0;
+}
@@ -0,0 +1,185 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/loader/arrow_fragment_loader.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using eid_t = GraphType::eid_t;
+using prop_id_t = GraphType::prop_id_t;
+
+/**
+ * Collect the outgoing edges inside [t0, t1) by filtering the full adjacent
+ * lists, returns the elapsed time.
+ */
+double FilterWindow(const std::shared_ptr<GraphType>& frag, prop_id_t prop,
+                    int64_t t0, int64_t t1, std::vector<eid_t>& edges) {
+  edges.clear();
+  double start = GetCurrentTime();
+  for (auto u : frag->InnerVertices(0)) {
+    for (auto& e : frag->GetOutgoingAdjList(u, 0)) {
+      int64_t t = e.get_data<int64_t>(prop);
+      if (t >= t0 && t < t1) {
+        edges.push_back(e.edge_id());
+      }
+    }
+  }
+  return GetCurrentTime() - start;
+}
+
+/**
+ * Collect the outgoing edges inside [t0, t1) using the temporal index,
+ * returns the elapsed time.
+ */
+double IndexWindow(const std::shared_ptr<GraphType>& frag, int64_t t0,
+                   int64_t t1, std::vector<eid_t>& edges) {
+  edges.clear();
+  double start = GetCurrentTime();
+  for (auto u : frag->InnerVertices(0)) {
+    for (auto& e : frag->GetOutgoingAdjListInWindow(u, 0, t0, t1)) {
+      edges.push_back(e.edge_id());
+    }
+  }
+  return GetCurrentTime() - start;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_temporal_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + ".csv#header_row=true&label=person";
+  std::string efile =
+      e_file_path +
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<
+        property_graph_types::OID_TYPE, property_graph_types::VID_TYPE>>(
+        client, comm_spec, std::vector<std::string>{efile},
+        std::vector<std::string>{vfile}, /* directed */ 1);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+
+    // use the edge property as the timestamps
+    prop_id_t prop = 0;
+    CHECK(frag->edge_property_type(0, prop)->Equals(arrow::int64()));
+    CHECK(!frag->HasTemporalIndex(0));
+
+    double start = GetCurrentTime();
+    auto indexed_id = frag->BuildTemporalIndex(client, {{0, prop}}).value();
+    double build_time = GetCurrentTime() - start;
+    auto indexed =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(indexed_id));
+    CHECK(indexed->HasTemporalIndex(0));
+    CHECK_EQ(indexed->temporal_property(0), prop);
+
+    auto column = std::dynamic_pointer_cast<arrow::Int64Array>(
+        indexed->edge_data_table(0)->column(prop)->chunk(0));
+    int64_t tmin = std::numeric_limits<int64_t>::max(),
+            tmax = std::numeric_limits<int64_t>::min();
+    for (int64_t i = 0; i < column->length(); ++i) {
+      tmin = std::min(tmin, column->Value(i));
+      tmax = std::max(tmax, column->Value(i));
+    }
+
+    // the whole range, and windows covering 1/2, 1/16 and 1/256 of it
+    std::vector<std::pair<int64_t, int64_t>> windows;
+    windows.emplace_back(tmin, tmax + 1);
+    for (int64_t ratio : {2, 16, 256}) {
+      int64_t width = std::max<int64_t>((tmax - tmin) / ratio, 1);
+      windows.emplace_back(tmin + width, tmin + 2 * width);
+    }
+    windows.emplace_back(tmax + 1, tmax + 1);
+
+    std::vector<eid_t> expected, edges;
+    for (auto const& window : windows) {
+      double filter_time =
+          FilterWindow(indexed, prop, window.first, window.second, expected);
+      double index_time =
+          IndexWindow(indexed, window.first, window.second, edges);
+      std::sort(expected.begin(), expected.end());
+      std::sort(edges.begin(), edges.end());
+      CHECK(edges == expected);
+      LOG(INFO) << "Window [" << window.first << ", " << window.second
+                << "): " << edges.size() << " edges, filtering "
+                << filter_time << "s, temporal index " << index_time << "s";
+    }
+
+    // the edges in the window are ordered by the timestamps
+    for (auto u : indexed->InnerVertices(0)) {
+      int64_t last = std::numeric_limits<int64_t>::min();
+      for (auto& e : indexed->GetIncomingAdjListInWindow(
+               u, 0, windows[1].first, windows[1].second)) {
+        int64_t t = e.get_data<int64_t>(prop);
+        CHECK(t >= last && t >= windows[1].first && t < windows[1].second);
+        last = t;
+      }
+    }
+
+    // the index is dropped once the nbr lists change
+    auto transformed_id = indexed->TransformDirection(client, 1).value();
+    auto transformed = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(transformed_id));
+    CHECK(!transformed->HasTemporalIndex(0));
+
+    LOG(INFO) << "Built temporal index in " << build_time << "s";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment temporal test...";
+
+  return 0;
+}
@@ -0,0 +1,185 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/loader/arrow_fragment_loader.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using oid_t = GraphType::oid_t;
+using label_id_t = GraphType::label_id_t;
+
+std::shared_ptr<arrow::Array> makeOidArray(const std::vector<oid_t>& oids) {
+  arrow::Int64Builder builder;
+  CHECK_ARROW_ERROR(builder.AppendValues(oids));
+  std::shared_ptr<arrow::Array> out;
+  CHECK_ARROW_ERROR(builder.Finish(&out));
+  return out;
+}
+
+/**
+ * Traverse all outgoing edges of inner vertices, returns the visited
+ * (src, dst) pairs and the traversal time.
+ */
+double Traverse(const std::shared_ptr<GraphType>& frag,
+                std::set<std::pair<oid_t, oid_t>>& edges) {
+  edges.clear();
+  double start = GetCurrentTime();
+  for (auto u : frag->InnerVertices(0)) {
+    for (auto& e : frag->GetOutgoingAdjList(u, 0)) {
+      edges.emplace(frag->GetId(u), frag->GetId(e.neighbor()));
+    }
+  }
+  return GetCurrentTime() - start;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_tombstone_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + ".csv#header_row=true&label=person";
+  std::string efile =
+      e_file_path +
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<
+        property_graph_types::OID_TYPE, property_graph_types::VID_TYPE>>(
+        client, comm_spec, std::vector<std::string>{efile},
+        std::vector<std::string>{vfile}, /* directed */ 1);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+
+    std::set<std::pair<oid_t, oid_t>> expected, edges;
+    double origin_time = Traverse(frag, expected);
+
+    // delete one of every three edges, and one of every ten vertices
+    std::vector<oid_t> srcs, dsts, vertices;
+    size_t count = 0;
+    for (auto const& edge : expected) {
+      if (count++ % 3 == 0) {
+        srcs.push_back(edge.first);
+        dsts.push_back(edge.second);
+      }
+    }
+    count = 0;
+    for (auto u : frag->InnerVertices(0)) {
+      if (count++ % 10 == 0) {
+        vertices.push_back(frag->GetId(u));
+      }
+    }
+
+    auto edge_schema = arrow::schema({arrow::field("src", arrow::int64()),
+                                      arrow::field("dst", arrow::int64())});
+    std::map<label_id_t, std::shared_ptr<arrow::Table>> edge_tables;
+    edge_tables[0] = arrow::Table::Make(
+        edge_schema, {makeOidArray(srcs), makeOidArray(dsts)});
+    auto vertex_schema = arrow::schema({arrow::field("id", arrow::int64())});
+    std::map<label_id_t, std::shared_ptr<arrow::Table>> vertex_tables;
+    vertex_tables[0] =
+        arrow::Table::Make(vertex_schema, {makeOidArray(vertices)});
+
+    double start = GetCurrentTime();
+    auto deleted_id = frag->DeleteEdges(client, std::move(edge_tables)).value();
+    auto deleted = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(deleted_id));
+    deleted_id =
+        deleted->DeleteVertices(client, std::move(vertex_tables)).value();
+    deleted =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(deleted_id));
+    double delete_time = GetCurrentTime() - start;
+
+    std::set<oid_t> deleted_vertices(vertices.begin(), vertices.end());
+    for (size_t i = 0; i < srcs.size(); ++i) {
+      expected.erase(std::make_pair(srcs[i], dsts[i]));
+    }
+    for (auto iter = expected.begin(); iter != expected.end();) {
+      if (deleted_vertices.count(iter->first) ||
+          deleted_vertices.count(iter->second)) {
+        iter = expected.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+
+    for (auto u : deleted->InnerVertices(0)) {
+      CHECK_EQ(deleted->IsDeletedVertex(u),
+               deleted_vertices.count(deleted->GetId(u)) > 0);
+    }
+    double tombstone_time = Traverse(deleted, edges);
+    CHECK(edges == expected);
+
+    start = GetCurrentTime();
+    auto consolidated_id =
+        deleted->ConsolidateTombstones(client, /* threshold */ 0.0).value();
+    double consolidate_time = GetCurrentTime() - start;
+    auto consolidated = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(consolidated_id));
+    CHECK_EQ(consolidated->GetDeletedEdgesNum(0), static_cast<size_t>(0));
+    double consolidated_time = Traverse(consolidated, edges);
+    CHECK(edges == expected);
+
+    LOG(INFO) << "Deleted " << deleted->GetDeletedEdgesNum(0) << " edges and "
+              << vertices.size() << " vertices in " << delete_time
+              << "s, consolidated in " << consolidate_time << "s";
+    LOG(INFO) << "Traverse time: origin " << origin_time
+              << "s, with tombstones " << tombstone_time
+              << "s, consolidated " << consolidated_time << "s";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment tombstone test...";
+
+  return 0;
+}
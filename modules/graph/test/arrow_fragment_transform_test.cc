@@ -0,0 +1,204 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/loader/arrow_fragment_loader.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using eid_t = GraphType::eid_t;
+using label_id_t = GraphType::label_id_t;
+
+constexpr int64_t kVertices = 1 << 16;
+constexpr int64_t kEdges = 1 << 20;
+const std::vector<std::string> kEdgeLabels = {"knows", "likes"};
+
+/**
+ * Reads the field (in kB) of /proc/self/status in bytes, or 0 if missing.
+ */
+size_t ReadStatus(std::string const& field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size(), field) == 0) {
+      std::istringstream value(line.substr(field.size()));
+      size_t kbytes = 0;
+      value >> kbytes;
+      return kbytes * 1024;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Reset the peak resident set size (VmHWM) to the current one, returns false
+ * if unsupported (requires Linux 4.0+).
+ */
+bool ResetPeakRSS() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.close();
+  return clear_refs.good() && ReadStatus("VmHWM:") > 0;
+}
+
+std::string WriteEdges(std::string const& prefix, const int64_t seed) {
+  std::string path = prefix + std::to_string(seed) + ".csv";
+  std::ofstream file(path);
+  file << "src,dst,weight\n";
+  for (int64_t i = 0; i < kEdges; ++i) {
+    int64_t src = (i * 2654435761LL + seed) % kVertices;
+    int64_t dst = (i * 40503LL + seed * 7) % kVertices;
+    file << src << "," << dst << "," << i << "\n";
+  }
+  CHECK(file.good());
+  return path;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage: ./arrow_fragment_transform_test <ipc_socket>\n");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  std::string prefix = "/tmp/arrow_fragment_transform_test_" +
+                       std::to_string(getpid()) + "_";
+  std::vector<std::string> paths, efiles;
+  for (size_t index = 0; index < kEdgeLabels.size(); ++index) {
+    paths.push_back(WriteEdges(prefix, index));
+    efiles.push_back(paths.back() + "#header_row=true&label=" +
+                     kEdgeLabels[index] + "&src_label=person&dst_label=person");
+  }
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<
+        property_graph_types::OID_TYPE, property_graph_types::VID_TYPE>>(
+        client, comm_spec, efiles, /* directed */ true);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+
+    // the bytes of the incoming and outgoing lists, the lists are visited to
+    // be resident before measuring the conversion, and every edge appears in
+    // both an outgoing and an incoming list
+    size_t adjacency_bytes = 0;
+    eid_t checksum = 0;
+    for (label_id_t e_label = 0; e_label < frag->edge_label_num(); ++e_label) {
+      for (auto u : frag->Vertices(0)) {
+        for (auto& e : frag->GetOutgoingAdjList(u, e_label)) {
+          checksum += e.edge_id();
+          adjacency_bytes += sizeof(GraphType::nbr_unit_t);
+        }
+        for (auto& e : frag->GetIncomingAdjList(u, e_label)) {
+          checksum -= e.edge_id();
+          adjacency_bytes += sizeof(GraphType::nbr_unit_t);
+        }
+      }
+    }
+
+    CHECK_EQ(checksum, static_cast<eid_t>(0));
+
+    bool peak_reset = ResetPeakRSS();
+    size_t rss_before = ReadStatus("VmRSS:");
+    double start = GetCurrentTime();
+    auto transformed_id =
+        frag->TransformDirection(client, std::thread::hardware_concurrency())
+            .value();
+    double transform_time = GetCurrentTime() - start;
+    size_t peak_after = ReadStatus("VmHWM:");
+    size_t peak_growth = peak_after > rss_before ? peak_after - rss_before : 0;
+    // the merged lists are as large as the incoming and outgoing lists, and
+    // are written into the shared memory directly, one label pair at a time,
+    // without intermediate copies. An extra copy of the lists of a label pair
+    // exceeds the bound.
+    if (peak_reset) {
+      CHECK_LE(peak_growth, adjacency_bytes + adjacency_bytes / 4);
+    } else {
+      LOG(INFO) << "Resetting the peak RSS is unsupported, skip the check";
+    }
+
+    auto transformed = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(transformed_id));
+    CHECK(!transformed->directed());
+
+    // the undirected lists are the sorted union of incoming and outgoing lists
+    std::vector<std::pair<GraphType::vid_t, eid_t>> undirected_edges,
+        directed_edges;
+    for (label_id_t e_label = 0; e_label < frag->edge_label_num(); ++e_label) {
+      for (auto u : frag->Vertices(0)) {
+        undirected_edges.clear();
+        directed_edges.clear();
+        GraphType::vid_t last = 0;
+        for (auto& e : transformed->GetOutgoingAdjList(u, e_label)) {
+          CHECK(e.neighbor().GetValue() >= last);
+          last = e.neighbor().GetValue();
+          undirected_edges.emplace_back(last, e.edge_id());
+        }
+        for (auto& e : frag->GetOutgoingAdjList(u, e_label)) {
+          directed_edges.emplace_back(e.neighbor().GetValue(), e.edge_id());
+        }
+        for (auto& e : frag->GetIncomingAdjList(u, e_label)) {
+          directed_edges.emplace_back(e.neighbor().GetValue(), e.edge_id());
+        }
+        std::sort(undirected_edges.begin(), undirected_edges.end());
+        std::sort(directed_edges.begin(), directed_edges.end());
+        CHECK(undirected_edges == directed_edges);
+      }
+    }
+    LOG(INFO) << "Transformed direction of " << adjacency_bytes
+              << " bytes of edges in " << transform_time
+              << "s, peak memory growth: " << peak_growth << " bytes";
+  }
+  grape::FinalizeMPIComm();
+
+  for (auto const& path : paths) {
+    std::remove(path.c_str());
+  }
+
+  LOG(INFO) << "Passed arrow fragment transform test...";
+
+  return 0;
+}
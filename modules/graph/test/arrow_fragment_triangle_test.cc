@@ -0,0 +1,223 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/fragment/arrow_fragment_intersection.h"
+#include "graph/loader/arrow_fragment_loader.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using vid_t = GraphType::vid_t;
+
+/**
+ * The reference triangle counting using `std::set_intersection`.
+ */
+std::vector<uint64_t> NaiveCountTriangles(
+    const PackedAdjacency<GraphType>& adjacency) {
+  std::vector<uint64_t> triangles(adjacency.GetVerticesNum(), 0);
+  std::vector<vid_t> common;
+  for (vid_t u = 0; u < adjacency.GetVerticesNum(); ++u) {
+    for (auto v = adjacency.neighbors_begin(u); v != adjacency.neighbors_end(u);
+         ++v) {
+      if (*v <= u) {
+        continue;
+      }
+      common.clear();
+      std::set_intersection(
+          v + 1, adjacency.neighbors_end(u),
+          std::upper_bound(adjacency.neighbors_begin(*v),
+                           adjacency.neighbors_end(*v), *v),
+          adjacency.neighbors_end(*v), std::back_inserter(common));
+      triangles[u] += common.size();
+      triangles[*v] += common.size();
+      for (auto w : common) {
+        triangles[w] += 1;
+      }
+    }
+  }
+  return triangles;
+}
+
+/**
+ * The deleted units are skipped before being matched, e.g., the deleted one
+ * of two parallel edges doesn't shadow the alive one.
+ */
+void CheckDeletedParallelEdges() {
+  using adj_list_t = property_graph_utils::AdjList<vid_t, GraphType::eid_t>;
+  using nbr_unit_t = property_graph_utils::NbrUnit<vid_t, GraphType::eid_t>;
+  // edge 0 and 1 are parallel edges to vertex 2, and edge 0 is deleted
+  std::vector<nbr_unit_t> lhs_units = {{2, 0}, {2, 1}, {5, 2}};
+  std::vector<nbr_unit_t> rhs_units = {{2, 3}, {5, 4}};
+  const uint8_t bits[] = {0x01};
+  property_graph_utils::Tombstones tombstones{bits, 8};
+  adj_list_t lhs(lhs_units.data(), lhs_units.data() + lhs_units.size(),
+                 nullptr, &tombstones);
+  adj_list_t rhs(rhs_units.data(), rhs_units.data() + rhs_units.size(),
+                 nullptr, nullptr);
+  CHECK_EQ(intersect_adj_list_count(lhs, rhs), 2UL);
+  CHECK_EQ(intersect_adj_list_count(rhs, lhs), 2UL);
+
+  // the galloping search lands on the deleted one of parallel edges 7 and 64
+  std::vector<nbr_unit_t> short_units = {{7, 100}};
+  std::vector<nbr_unit_t> long_units;
+  for (vid_t vid = 0; vid < 64; ++vid) {
+    long_units.emplace_back(vid, vid);
+    if (vid == 7) {
+      long_units.emplace_back(vid, 64);
+    }
+  }
+  const uint8_t long_bits[] = {0x80, 0x00, 0x00, 0x00,
+                               0x00, 0x00, 0x00, 0x00};
+  property_graph_utils::Tombstones long_tombstones{long_bits, 64};
+  adj_list_t short_list(short_units.data(),
+                        short_units.data() + short_units.size(), nullptr,
+                        nullptr);
+  adj_list_t long_list(long_units.data(),
+                       long_units.data() + long_units.size(), nullptr,
+                       &long_tombstones);
+  CHECK_EQ(intersect_adj_list_count(short_list, long_list), 1UL);
+  CHECK_EQ(intersect_adj_list_count(long_list, short_list), 1UL);
+  LOG(INFO) << "Passed the intersection with deleted parallel edges";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_triangle_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + ".csv#header_row=true&label=person";
+  std::string efile =
+      e_file_path +
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  CheckDeletedParallelEdges();
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<
+        property_graph_types::OID_TYPE, property_graph_types::VID_TYPE>>(
+        client, comm_spec, std::vector<std::string>{efile},
+        std::vector<std::string>{vfile}, /* directed */ 0);
+    ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+
+    auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+        client.GetObject(fragment_group_id));
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(fg->Fragments().at(comm_spec.fid())));
+
+    double start = GetCurrentTime();
+    PackedAdjacency<GraphType> adjacency(frag, 0, 0);
+    LOG(INFO) << "Built packed adjacency in " << GetCurrentTime() - start
+              << "s";
+
+    start = GetCurrentTime();
+    auto expected = NaiveCountTriangles(adjacency);
+    LOG(INFO) << "[naive] triangle counting: " << GetCurrentTime() - start
+              << "s, total triangles: "
+              << std::accumulate(expected.begin(), expected.end(),
+                                 static_cast<uint64_t>(0)) /
+                     3;
+
+    for (auto kernel :
+         {IntersectionKernel::kScalar, IntersectionKernel::kGalloping,
+          IntersectionKernel::kAVX2, IntersectionKernel::kAVX512,
+          IntersectionKernel::kAuto}) {
+      start = GetCurrentTime();
+      auto triangles = CountTriangles(adjacency, 1, kernel);
+      double sequential_time = GetCurrentTime() - start;
+      start = GetCurrentTime();
+      auto parallel_triangles = CountTriangles(
+          adjacency, std::thread::hardware_concurrency(), kernel);
+      double parallel_time = GetCurrentTime() - start;
+      CHECK(triangles == expected);
+      CHECK(parallel_triangles == expected);
+      LOG(INFO) << "[" << intersection_kernel_name(kernel)
+                << "] triangle counting: " << sequential_time
+                << "s (1 thread), " << parallel_time << "s ("
+                << std::thread::hardware_concurrency() << " threads)";
+    }
+    LOG(INFO) << "SIMD kernel of this CPU: "
+              << intersection_kernel_name(simd_intersection_kernel());
+
+    start = GetCurrentTime();
+    auto coefficients = LocalClusteringCoefficient(adjacency);
+    LOG(INFO) << "Local clustering coefficient: " << GetCurrentTime() - start
+              << "s";
+    for (vid_t v = 0; v < adjacency.GetVerticesNum(); ++v) {
+      CHECK(coefficients[v] >= 0 && coefficients[v] <= 1);
+    }
+
+    // the intersection over the interleaved nbr units
+    for (auto u : frag->InnerVertices(0)) {
+      auto lhs = frag->GetOutgoingAdjList(u, 0);
+      std::vector<vid_t> lhs_vids, rhs_vids, common;
+      for (auto& e : lhs) {
+        lhs_vids.push_back(e.neighbor().GetValue());
+      }
+      for (auto& e : lhs) {
+        auto rhs = frag->GetOutgoingAdjList(e.neighbor(), 0);
+        rhs_vids.clear();
+        common.clear();
+        for (auto& f : rhs) {
+          rhs_vids.push_back(f.neighbor().GetValue());
+        }
+        std::set_intersection(lhs_vids.begin(), lhs_vids.end(),
+                              rhs_vids.begin(), rhs_vids.end(),
+                              std::back_inserter(common));
+        CHECK_EQ(intersect_adj_list_count(lhs, rhs), common.size());
+      }
+      if (u.GetValue() >= 1024) {
+        break;
+      }
+    }
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment triangle test...";
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client/client.h"
+#include "common/util/env.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/arrow_fragment_group.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/vertex_map/arrow_local_vertex_map.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using vid_t = property_graph_types::VID_TYPE;
+
+template <typename OID_T>
+OID_T MissingOid() {
+  return std::numeric_limits<OID_T>::max();
+}
+
+template <>
+std::string MissingOid<std::string>() {
+  return "the-vertex-that-doesn't-exist";
+}
+
+template <typename OID_T>
+void TestLocalVertexMap(Client& client, const grape::CommSpec& comm_spec,
+                        const std::string& vfile, const std::string& efile,
+                        const bool use_perfect_hash) {
+  using internal_oid_t = typename InternalType<OID_T>::type;
+  using vertex_map_t = ArrowLocalVertexMap<internal_oid_t, vid_t>;
+  using fragment_t = ArrowFragment<OID_T, vid_t, vertex_map_t>;
+
+  MPI_Barrier(comm_spec.comm());
+  double start = GetCurrentTime();
+  auto loader = std::make_unique<ArrowFragmentLoader<OID_T, vid_t>>(
+      client, comm_spec, std::vector<std::string>{efile},
+      std::vector<std::string>{vfile}, /* directed */ 1,
+      /* generate_eid */ false, /* retain_oid */ false,
+      /* local_vertex_map */ true, /* compact_edges */ false, use_perfect_hash);
+  ObjectID fragment_group_id = loader->LoadFragmentAsFragmentGroup().value();
+  double load_time = GetCurrentTime() - start;
+
+  auto fg = std::dynamic_pointer_cast<ArrowFragmentGroup>(
+      client.GetObject(fragment_group_id));
+  auto frag = std::dynamic_pointer_cast<fragment_t>(
+      client.GetObject(fg->Fragments().at(comm_spec.fid())));
+  auto vm = frag->GetVertexMap();
+  CHECK_EQ(vm->use_perfect_hash(), use_perfect_hash);
+
+  // the oids known by the vertex map are the inner and outer vertices
+  std::vector<OID_T> oids;
+  std::vector<vid_t> gids;
+  for (auto v : frag->InnerVertices(0)) {
+    oids.push_back(frag->GetId(v));
+    gids.push_back(frag->Vertex2Gid(v));
+  }
+  for (auto v : frag->OuterVertices(0)) {
+    oids.push_back(frag->GetId(v));
+    gids.push_back(frag->Vertex2Gid(v));
+  }
+
+  start = GetCurrentTime();
+  for (size_t i = 0; i < oids.size(); ++i) {
+    vid_t gid;
+    CHECK(vm->GetGid(0, internal_oid_t(oids[i]), gid));
+    CHECK_EQ(gid, gids[i]);
+  }
+  double get_gid_time = GetCurrentTime() - start;
+
+  start = GetCurrentTime();
+  for (size_t i = 0; i < gids.size(); ++i) {
+    internal_oid_t oid;
+    CHECK(vm->GetOid(gids[i], oid));
+    CHECK(oid == internal_oid_t(oids[i]));
+  }
+  double get_oid_time = GetCurrentTime() - start;
+
+  // the perfect hash maps a missing oid to an arbitrary slot, which must not
+  // be taken as found
+  OID_T missing = MissingOid<OID_T>();
+  vid_t gid;
+  CHECK(!vm->GetGid(0, internal_oid_t(missing), gid));
+
+  size_t nbytes = vm->meta().GetNBytes();
+  LOG(INFO) << "[" << type_name<OID_T>() << ", "
+            << (use_perfect_hash ? "perfect hash" : "hashmap")
+            << "] loaded in " << load_time << "s, vertex map "
+            << prettyprint_memory_size(nbytes) << ", "
+            << static_cast<double>(nbytes) / oids.size()
+            << " bytes per vertex, GetGid "
+            << oids.size() / get_gid_time / 1000000 << "M/s, GetOid "
+            << gids.size() / get_oid_time / 1000000 << "M/s";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_local_vertex_map_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + ".csv#header_row=true&label=person";
+  std::string efile =
+      e_file_path +
+      ".csv#header_row=true&label=knows&src_label=person&dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    for (bool use_perfect_hash : {false, true}) {
+      TestLocalVertexMap<property_graph_types::OID_TYPE>(
+          client, comm_spec, vfile, efile, use_perfect_hash);
+      TestLocalVertexMap<std::string>(client, comm_spec, vfile, efile,
+                                      use_perfect_hash);
+    }
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow local vertex map test...";
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "grape/worker/comm_spec.h"
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+#include "graph/utils/table_shuffler.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+namespace {
+
+constexpr int64_t kRowsPerBatch = 1 << 16;
+constexpr int64_t kBatchesPerWorker = 16;
+
+std::shared_ptr<arrow::RecordBatch> MakeBatch(int worker_id, int64_t index) {
+  arrow::Int64Builder id_builder;
+  arrow::DoubleBuilder value_builder;
+  arrow::LargeStringBuilder name_builder;
+  for (int64_t i = 0; i < kRowsPerBatch; ++i) {
+    int64_t id = (worker_id * kBatchesPerWorker + index) * kRowsPerBatch + i;
+    CHECK_ARROW_ERROR(id_builder.Append(id));
+    CHECK_ARROW_ERROR(value_builder.Append(static_cast<double>(id) / 3));
+    CHECK_ARROW_ERROR(name_builder.Append("v-" + std::to_string(id)));
+  }
+  std::shared_ptr<arrow::Array> ids, values, names;
+  CHECK_ARROW_ERROR(id_builder.Finish(&ids));
+  CHECK_ARROW_ERROR(value_builder.Finish(&values));
+  CHECK_ARROW_ERROR(name_builder.Finish(&names));
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("value", arrow::float64()),
+                               arrow::field("name", arrow::large_utf8())});
+  return arrow::RecordBatch::Make(schema, kRowsPerBatch,
+                                  {ids, values, names});
+}
+
+// returns the number of received rows, and validates the partitioning
+int64_t Shuffle(const grape::CommSpec& comm_spec, Client* client,
+                const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+                double& elapsed) {
+  fid_t fnum = comm_spec.fnum();
+  std::vector<std::vector<std::vector<int64_t>>> offset_lists(batches.size());
+  for (size_t index = 0; index < batches.size(); ++index) {
+    auto ids =
+        std::dynamic_pointer_cast<arrow::Int64Array>(batches[index]->column(0));
+    offset_lists[index].resize(fnum);
+    for (int64_t row = 0; row < ids->length(); ++row) {
+      offset_lists[index][ids->Value(row) % fnum].push_back(row);
+    }
+  }
+
+  MPI_Barrier(comm_spec.comm());
+  double start = GetCurrentTime();
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
+  auto result =
+      ShuffleTableByOffsetLists(comm_spec, batches[0]->schema(), batches,
+                                offset_lists, batches_recv, client);
+  CHECK(result);
+  elapsed = GetCurrentTime() - start;
+
+  int64_t rows = 0;
+  for (auto const& batch : batches_recv) {
+    if (batch == nullptr) {
+      continue;
+    }
+    auto ids = std::dynamic_pointer_cast<arrow::Int64Array>(batch->column(0));
+    auto names =
+        std::dynamic_pointer_cast<arrow::LargeStringArray>(batch->column(2));
+    for (int64_t row = 0; row < batch->num_rows(); ++row) {
+      CHECK_EQ(static_cast<fid_t>(ids->Value(row) % fnum), comm_spec.fid());
+      CHECK_EQ(names->GetString(row), "v-" + std::to_string(ids->Value(row)));
+    }
+    rows += batch->num_rows();
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage: ./table_shuffler_test <ipc_socket>\n");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    Client client;
+    VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+    LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int64_t index = 0; index < kBatchesPerWorker; ++index) {
+      batches.emplace_back(MakeBatch(comm_spec.worker_id(), index));
+    }
+
+    double mpi_elapsed = 0, shared_elapsed = 0;
+    int64_t mpi_rows = Shuffle(comm_spec, nullptr, batches, mpi_elapsed);
+    int64_t shared_rows = Shuffle(comm_spec, &client, batches, shared_elapsed);
+    CHECK_EQ(mpi_rows, shared_rows);
+
+    int64_t total_rows = 0;
+    MPI_Allreduce(&shared_rows, &total_rows, 1, MPI_INT64_T, MPI_SUM,
+                  comm_spec.comm());
+    CHECK_EQ(total_rows,
+             comm_spec.worker_num() * kBatchesPerWorker * kRowsPerBatch);
+
+    double max_mpi_elapsed = 0, max_shared_elapsed = 0;
+    MPI_Reduce(&mpi_elapsed, &max_mpi_elapsed, 1, MPI_DOUBLE, MPI_MAX, 0,
+               comm_spec.comm());
+    MPI_Reduce(&shared_elapsed, &max_shared_elapsed, 1, MPI_DOUBLE, MPI_MAX, 0,
+               comm_spec.comm());
+    if (comm_spec.worker_id() == 0) {
+      LOG(INFO) << "Shuffled " << total_rows << " rows among "
+                << comm_spec.worker_num() << " workers: MPI "
+                << max_mpi_elapsed << "s, shared vineyard objects "
+                << max_shared_elapsed << "s";
+    }
+    LOG(INFO) << "Passed table shuffler test...";
+  }
+  grape::FinalizeMPIComm();
+  return 0;
+}
@@ -0,0 +1,328 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "graph/utils/set_intersection.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VINEYARD_SIMD_INTERSECTION 1
+#endif
+
+namespace vineyard {
+
+namespace detail {
+
+// the SIMD kernels only pay off when both arrays have a few blocks
+static constexpr size_t kSIMDMinimumSize = 16;
+
+// use galloping search when one array is this times larger than the other
+static constexpr size_t kGallopingRatio = 32;
+
+template <typename T>
+inline size_t emit(T value, T* out, size_t count) {
+  if (out != nullptr) {
+    out[count] = value;
+  }
+  return count + 1;
+}
+
+template <typename T>
+size_t scalar_intersect(const T* a, size_t na, const T* b, size_t nb, T* out,
+                        size_t count = 0) {
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      count = emit(a[i], out, count);
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+/**
+ * Probe every element of the smaller array `a` in the larger `b` by an
+ * exponential search starting from the last matched position.
+ */
+template <typename T>
+size_t galloping_intersect(const T* a, size_t na, const T* b, size_t nb,
+                           T* out) {
+  if (na > nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  size_t count = 0, low = 0;
+  for (size_t i = 0; i < na && low < nb; ++i) {
+    const T value = a[i];
+    size_t step = 1, high = low;
+    while (high < nb && b[high] < value) {
+      low = high + 1;
+      high += step;
+      step <<= 1;
+    }
+    high = std::min(high + 1, nb);
+    low = std::lower_bound(b + low, b + high, value) - b;
+    if (low < nb && b[low] == value) {
+      count = emit(value, out, count);
+      ++low;
+    }
+  }
+  return count;
+}
+
+#if defined(VINEYARD_SIMD_INTERSECTION)
+
+/**
+ * The SIMD kernels compare a block of `a` with all rotations of a block of
+ * `b`, the lanes of `a` that equal to any rotation are the common elements,
+ * then advance the block(s) with the smaller maximum. As both arrays are
+ * duplicate-free, an element of `a` matches at most one block of `b`.
+ */
+__attribute__((target("avx2"))) size_t avx2_intersect(const uint32_t* a,
+                                                      size_t na,
+                                                      const uint32_t* b,
+                                                      size_t nb,
+                                                      uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i matched = _mm256_cmpeq_epi32(va, vb);
+    for (int r = 1; r < 8; ++r) {
+      vb = _mm256_permutevar8x32_epi32(vb, rotate);
+      matched = _mm256_or_si256(matched, _mm256_cmpeq_epi32(va, vb));
+    }
+    unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(matched));
+    if (out == nullptr) {
+      count += __builtin_popcount(mask);
+    } else {
+      while (mask) {
+        out[count++] = a[i + __builtin_ctz(mask)];
+        mask &= mask - 1;
+      }
+    }
+    const uint32_t amax = a[i + 7], bmax = b[j + 7];
+    i += (amax <= bmax) ? 8 : 0;
+    j += (bmax <= amax) ? 8 : 0;
+  }
+  return scalar_intersect(a + i, na - i, b + j, nb - j, out, count);
+}
+
+__attribute__((target("avx2"))) size_t avx2_intersect(const uint64_t* a,
+                                                      size_t na,
+                                                      const uint64_t* b,
+                                                      size_t nb,
+                                                      uint64_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  while (i + 4 <= na && j + 4 <= nb) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i matched = _mm256_cmpeq_epi64(va, vb);
+    for (int r = 1; r < 4; ++r) {
+      vb = _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1));
+      matched = _mm256_or_si256(matched, _mm256_cmpeq_epi64(va, vb));
+    }
+    unsigned mask = _mm256_movemask_pd(_mm256_castsi256_pd(matched));
+    if (out == nullptr) {
+      count += __builtin_popcount(mask);
+    } else {
+      while (mask) {
+        out[count++] = a[i + __builtin_ctz(mask)];
+        mask &= mask - 1;
+      }
+    }
+    const uint64_t amax = a[i + 3], bmax = b[j + 3];
+    i += (amax <= bmax) ? 4 : 0;
+    j += (bmax <= amax) ? 4 : 0;
+  }
+  return scalar_intersect(a + i, na - i, b + j, nb - j, out, count);
+}
+
+__attribute__((target("avx512f"))) size_t avx512_intersect(const uint32_t* a,
+                                                          size_t na,
+                                                          const uint32_t* b,
+                                                          size_t nb,
+                                                          uint32_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  const __m512i rotate = _mm512_set_epi32(0, 15, 14, 13, 12, 11, 10, 9, 8, 7,
+                                          6, 5, 4, 3, 2, 1);
+  while (i + 16 <= na && j + 16 <= nb) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    __mmask16 matched = _mm512_cmpeq_epi32_mask(va, vb);
+    for (int r = 1; r < 16; ++r) {
+      vb = _mm512_permutexvar_epi32(rotate, vb);
+      matched |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    unsigned mask = matched;
+    if (out == nullptr) {
+      count += __builtin_popcount(mask);
+    } else {
+      while (mask) {
+        out[count++] = a[i + __builtin_ctz(mask)];
+        mask &= mask - 1;
+      }
+    }
+    const uint32_t amax = a[i + 15], bmax = b[j + 15];
+    i += (amax <= bmax) ? 16 : 0;
+    j += (bmax <= amax) ? 16 : 0;
+  }
+  return scalar_intersect(a + i, na - i, b + j, nb - j, out, count);
+}
+
+__attribute__((target("avx512f"))) size_t avx512_intersect(const uint64_t* a,
+                                                          size_t na,
+                                                          const uint64_t* b,
+                                                          size_t nb,
+                                                          uint64_t* out) {
+  size_t i = 0, j = 0, count = 0;
+  const __m512i rotate = _mm512_set_epi64(0, 7, 6, 5, 4, 3, 2, 1);
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    __mmask8 matched = _mm512_cmpeq_epi64_mask(va, vb);
+    for (int r = 1; r < 8; ++r) {
+      vb = _mm512_permutexvar_epi64(rotate, vb);
+      matched |= _mm512_cmpeq_epi64_mask(va, vb);
+    }
+    unsigned mask = matched;
+    if (out == nullptr) {
+      count += __builtin_popcount(mask);
+    } else {
+      while (mask) {
+        out[count++] = a[i + __builtin_ctz(mask)];
+        mask &= mask - 1;
+      }
+    }
+    const uint64_t amax = a[i + 7], bmax = b[j + 7];
+    i += (amax <= bmax) ? 8 : 0;
+    j += (bmax <= amax) ? 8 : 0;
+  }
+  return scalar_intersect(a + i, na - i, b + j, nb - j, out, count);
+}
+
+#endif  // VINEYARD_SIMD_INTERSECTION
+
+static IntersectionKernel detect_simd_intersection_kernel() {
+#if defined(VINEYARD_SIMD_INTERSECTION)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return IntersectionKernel::kAVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return IntersectionKernel::kAVX2;
+  }
+#endif
+  return IntersectionKernel::kScalar;
+}
+
+template <typename T>
+size_t intersect(const T* a, size_t na, const T* b, size_t nb, T* out,
+                 IntersectionKernel kernel) {
+  static const IntersectionKernel supported = simd_intersection_kernel();
+  if (na == 0 || nb == 0) {
+    return 0;
+  }
+  if (kernel == IntersectionKernel::kAuto) {
+    size_t smaller = std::min(na, nb), larger = std::max(na, nb);
+    if (smaller * kGallopingRatio < larger) {
+      kernel = IntersectionKernel::kGalloping;
+    } else if (smaller >= kSIMDMinimumSize) {
+      kernel = supported;
+    } else {
+      kernel = IntersectionKernel::kScalar;
+    }
+  }
+  switch (kernel) {
+  case IntersectionKernel::kGalloping:
+    return galloping_intersect(a, na, b, nb, out);
+#if defined(VINEYARD_SIMD_INTERSECTION)
+  case IntersectionKernel::kAVX512:
+    if (supported == IntersectionKernel::kAVX512) {
+      return avx512_intersect(a, na, b, nb, out);
+    }
+    return scalar_intersect(a, na, b, nb, out);
+  case IntersectionKernel::kAVX2:
+    if (supported != IntersectionKernel::kScalar) {
+      return avx2_intersect(a, na, b, nb, out);
+    }
+    return scalar_intersect(a, na, b, nb, out);
+#endif
+  default:
+    return scalar_intersect(a, na, b, nb, out);
+  }
+}
+
+}  // namespace detail
+
+IntersectionKernel simd_intersection_kernel() {
+  static const IntersectionKernel kernel =
+      detail::detect_simd_intersection_kernel();
+  return kernel;
+}
+
+std::string intersection_kernel_name(IntersectionKernel kernel) {
+  switch (kernel) {
+  case IntersectionKernel::kAuto:
+    return "auto";
+  case IntersectionKernel::kScalar:
+    return "scalar";
+  case IntersectionKernel::kGalloping:
+    return "galloping";
+  case IntersectionKernel::kAVX2:
+    return "avx2";
+  case IntersectionKernel::kAVX512:
+    return "avx512";
+  default:
+    return "unknown";
+  }
+}
+
+template <typename T>
+size_t intersect_sorted_count(const T* a, size_t na, const T* b, size_t nb,
+                              IntersectionKernel kernel) {
+  return detail::intersect<T>(a, na, b, nb, nullptr, kernel);
+}
+
+template <typename T>
+size_t intersect_sorted(const T* a, size_t na, const T* b, size_t nb, T* out,
+                        IntersectionKernel kernel) {
+  return detail::intersect<T>(a, na, b, nb, out, kernel);
+}
+
+template size_t intersect_sorted_count<uint32_t>(const uint32_t* a, size_t na,
+                                                 const uint32_t* b, size_t nb,
+                                                 IntersectionKernel kernel);
+template size_t intersect_sorted_count<uint64_t>(const uint64_t* a, size_t na,
+                                                 const uint64_t* b, size_t nb,
+                                                 IntersectionKernel kernel);
+template size_t intersect_sorted<uint32_t>(const uint32_t* a, size_t na,
+                                           const uint32_t* b, size_t nb,
+                                           uint32_t* out,
+                                           IntersectionKernel kernel);
+template size_t intersect_sorted<uint64_t>(const uint64_t* a, size_t na,
+                                           const uint64_t* b, size_t nb,
+                                           uint64_t* out,
+                                           IntersectionKernel kernel);
+
+}  // namespace vineyard
@@ -0,0 +1,73 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_UTILS_SET_INTERSECTION_H_
+#define MODULES_GRAPH_UTILS_SET_INTERSECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vineyard {
+
+/**
+ * @brief The kernels to intersect two sorted, duplicate-free arrays.
+ *
+ * `kAuto` picks galloping search when the sizes of two arrays are skewed, and
+ * the widest SIMD kernel supported by the running CPU otherwise. The SIMD
+ * kernels are selected at runtime, thus no `-mavx2`/`-march` flag is
+ * required to build vineyard. Requesting a SIMD kernel that is not supported
+ * falls back to the scalar merge.
+ */
+enum class IntersectionKernel {
+  kAuto = 0,
+  kScalar = 1,
+  kGalloping = 2,
+  kAVX2 = 3,
+  kAVX512 = 4,
+};
+
+/**
+ * @brief The widest SIMD kernel supported by the running CPU, or `kScalar`.
+ */
+IntersectionKernel simd_intersection_kernel();
+
+std::string intersection_kernel_name(IntersectionKernel kernel);
+
+/**
+ * @brief Count the common elements of the sorted and duplicate-free arrays
+ * `a` and `b`.
+ *
+ * Instantiated for `uint32_t` and `uint64_t`.
+ */
+template <typename T>
+size_t intersect_sorted_count(
+    const T* a, size_t na, const T* b, size_t nb,
+    IntersectionKernel kernel = IntersectionKernel::kAuto);
+
+/**
+ * @brief Write the common elements of the sorted and duplicate-free arrays
+ * `a` and `b` to `out`, which must have at least `min(na, nb)` slots, and
+ * return the number of them.
+ *
+ * Instantiated for `uint32_t` and `uint64_t`.
+ */
+template <typename T>
+size_t intersect_sorted(const T* a, size_t na, const T* b, size_t nb, T* out,
+                        IntersectionKernel kernel = IntersectionKernel::kAuto);
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_UTILS_SET_INTERSECTION_H_
@@ -32,7 +32,9 @@ limitations under the License.
 #include "grape/utils/concurrent_queue.h"
 #include "grape/worker/comm_spec.h"
 
+#include "basic/ds/arrow.h"
 #include "basic/ds/arrow_utils.h"
+#include "client/client.h"
 #include "common/util/functions.h"
 #include "common/util/status.h"
 #include "graph/fragment/property_graph_types.h"
@@ -763,12 +765,215 @@ void SelectRows(std::shared_ptr<arrow::RecordBatch> record_batch_in,
 #endif
 }
 
+namespace detail {
+
+/**
+ * @brief A view of a buffer that lives in vineyard memory, which holds the
+ * guard of the underlying vineyard object.
+ */
+class SharedObjectBuffer : public arrow::Buffer {
+ public:
+  SharedObjectBuffer(const std::shared_ptr<arrow::Buffer>& buffer,
+                     const std::shared_ptr<void>& guard)
+      : arrow::Buffer(buffer->data(), buffer->size()),
+        buffer_(buffer),
+        guard_(guard) {}
+
+ private:
+  std::shared_ptr<arrow::Buffer> buffer_;
+  std::shared_ptr<void> guard_;
+};
+
+static std::shared_ptr<arrow::ArrayData> attach_object_guard(
+    const std::shared_ptr<arrow::ArrayData>& data,
+    const std::shared_ptr<void>& guard) {
+  if (data == nullptr) {
+    return nullptr;
+  }
+  auto guarded = data->Copy();
+  for (auto& buffer : guarded->buffers) {
+    if (buffer != nullptr) {
+      buffer = std::make_shared<SharedObjectBuffer>(buffer, guard);
+    }
+  }
+  for (auto& child : guarded->child_data) {
+    child = attach_object_guard(child, guard);
+  }
+  guarded->dictionary = attach_object_guard(guarded->dictionary, guard);
+  return guarded;
+}
+
+template <typename T>
+static inline Status select_fixed_items(Client& client,
+                                        std::shared_ptr<arrow::Array> array,
+                                        const std::vector<int64_t>& offset,
+                                        std::shared_ptr<ObjectBuilder>& out) {
+  std::shared_ptr<FixedNumericArrayBuilder<T>> builder;
+  RETURN_ON_ERROR(
+      FixedNumericArrayBuilder<T>::Make(client, offset.size(), builder));
+  auto ptr = std::dynamic_pointer_cast<ArrowArrayType<T>>(array)->raw_values();
+  auto data = builder->data();
+  for (size_t i = 0; i < offset.size(); ++i) {
+    data[i] = ptr[offset[i]];
+  }
+  out = builder;
+  return Status::OK();
+}
+
+/**
+ * @brief Select the rows of the fixed-width column into the vineyard blob
+ * directly, other columns are selected into an arrow array first.
+ */
+static Status select_items_as_object(Client& client,
+                                     std::shared_ptr<arrow::Array> array,
+                                     const std::vector<int64_t>& offset,
+                                     std::shared_ptr<ObjectBuilder>& out) {
+  auto const& type = array->type();
+  if (type->Equals(arrow::float64())) {
+    return select_fixed_items<double>(client, array, offset, out);
+  } else if (type->Equals(arrow::float32())) {
+    return select_fixed_items<float>(client, array, offset, out);
+  } else if (type->Equals(arrow::int64())) {
+    return select_fixed_items<int64_t>(client, array, offset, out);
+  } else if (type->Equals(arrow::int32())) {
+    return select_fixed_items<int32_t>(client, array, offset, out);
+  } else if (type->Equals(arrow::uint64())) {
+    return select_fixed_items<uint64_t>(client, array, offset, out);
+  } else if (type->Equals(arrow::uint32())) {
+    return select_fixed_items<uint32_t>(client, array, offset, out);
+  } else if (type->Equals(arrow::date32())) {
+    return select_fixed_items<arrow::Date32Type>(client, array, offset, out);
+  } else if (type->Equals(arrow::date64())) {
+    return select_fixed_items<arrow::Date64Type>(client, array, offset, out);
+  }
+  std::unique_ptr<arrow::ArrayBuilder> builder;
+  RETURN_ON_ARROW_ERROR(
+      arrow::MakeBuilder(arrow::default_memory_pool(), type, &builder));
+  RETURN_ON_ARROW_ERROR(builder->Reserve(offset.size()));
+  SelectItems(array, offset, builder.get());
+  std::shared_ptr<arrow::Array> selected;
+  RETURN_ON_ARROW_ERROR(builder->Finish(&selected));
+  return BuildArray(client, selected, out);
+}
+
+}  // namespace detail
+
+std::vector<bool> DetectColocatedWorkers(const grape::CommSpec& comm_spec,
+                                         Client* client) {
+  int worker_num = comm_spec.worker_num();
+  std::vector<bool> colocated(worker_num, false);
+
+  // N.B.: all workers must join the allgather, even without a client.
+  InstanceID instance_id =
+      client == nullptr ? UnspecifiedInstanceID() : client->instance_id();
+  std::vector<InstanceID> instance_ids(worker_num);
+  MPI_Allgather(&instance_id, 1, MPI_UINT64_T, instance_ids.data(), 1,
+                MPI_UINT64_T, comm_spec.comm());
+  if (client == nullptr) {
+    return colocated;
+  }
+  for (int worker_id = 0; worker_id < worker_num; ++worker_id) {
+    colocated[worker_id] = worker_id != comm_spec.worker_id() &&
+                           instance_ids[worker_id] == instance_id;
+  }
+  return colocated;
+}
+
+Status SelectRowsAsObject(
+    Client& client, const std::shared_ptr<arrow::RecordBatch> record_batch,
+    const std::vector<int64_t>& offset, ObjectID& object_id) {
+  object_id = InvalidObjectID();
+  if (record_batch == nullptr || offset.empty()) {
+    return Status::OK();
+  }
+  std::vector<std::shared_ptr<ObjectBuilder>> columns;
+  for (int col_id = 0; col_id < record_batch->num_columns(); ++col_id) {
+    std::shared_ptr<ObjectBuilder> column;
+    RETURN_ON_ERROR(detail::select_items_as_object(
+        client, record_batch->column(col_id), offset, column));
+    columns.emplace_back(column);
+  }
+  RecordBatchBuilder builder(client, record_batch->schema(), offset.size(),
+                             columns);
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  object_id = object->id();
+  return Status::OK();
+}
+
+Status GetSharedRecordBatch(Client& client, const ObjectID object_id,
+                            std::shared_ptr<arrow::RecordBatch>& batch_out) {
+  if (object_id == InvalidObjectID()) {
+    batch_out = nullptr;
+    return Status::OK();
+  }
+  std::shared_ptr<RecordBatch> object;
+  RETURN_ON_ERROR(client.GetObject(object_id, object));
+  Client* client_ptr = &client;
+  // the object will be dropped once all buffers that refer to it are released
+  std::shared_ptr<void> guard(
+      nullptr, [client_ptr, object_id, object](void* pointer) mutable {
+        (void) pointer;
+        object.reset();
+        VINEYARD_DISCARD(client_ptr->DelData(object_id, true, true));
+      });
+  auto batch = object->GetRecordBatch();
+  std::vector<std::shared_ptr<arrow::ArrayData>> columns;
+  for (int i = 0; i < batch->num_columns(); ++i) {
+    columns.emplace_back(
+        detail::attach_object_guard(batch->column_data(i), guard));
+  }
+  batch_out = arrow::RecordBatch::Make(batch->schema(), batch->num_rows(),
+                                       std::move(columns));
+  return Status::OK();
+}
+
+/**
+ * @brief Fill the message for the destination worker: a leading flag tells
+ * whether the rows are shared as a vineyard object (for co-located workers),
+ * or serialized into the archive.
+ */
+static void PackSelectedRows(
+    grape::InArchive& arc, Client* client, const bool colocated,
+    const std::shared_ptr<arrow::RecordBatch>& record_batch,
+    const std::vector<int64_t>& offset) {
+  if (colocated) {
+    ObjectID object_id = InvalidObjectID();
+    auto status = SelectRowsAsObject(*client, record_batch, offset, object_id);
+    if (status.ok()) {
+      arc << true << object_id;
+      return;
+    }
+    LOG(WARNING) << "Failed to share the shuffled rows to co-located worker "
+                    "via vineyard, fallback to MPI: "
+                 << status.ToString();
+  }
+  arc << false;
+  SerializeSelectedRows(arc, record_batch, offset);
+}
+
+static Status UnpackSelectedRows(
+    grape::OutArchive& arc, Client* client,
+    const std::shared_ptr<arrow::Schema>& schema,
+    std::shared_ptr<arrow::RecordBatch>& batch_out) {
+  bool shared = false;
+  arc >> shared;
+  if (shared) {
+    ObjectID object_id = InvalidObjectID();
+    arc >> object_id;
+    return GetSharedRecordBatch(*client, object_id, batch_out);
+  }
+  DeserializeSelectedRows(arc, schema, batch_out);
+  return Status::OK();
+}
+
 boost::leaf::result<void> ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
     const std::shared_ptr<arrow::Schema> schema,
     const std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_send,
     const std::vector<std::vector<std::vector<int64_t>>>& offset_lists,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client) {
   int worker_id = comm_spec.worker_id();
   int worker_num = comm_spec.worker_num();
   size_t record_batches_out_num = record_batches_send.size();
@@ -788,6 +993,8 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
   msg_out.SetProducerNum(serialize_thread_num);
   msg_in.SetProducerNum(1);
 
+  const std::vector<bool> colocated = DetectColocatedWorkers(comm_spec, client);
+
   int64_t record_batches_to_send = static_cast<int64_t>(record_batches_out_num);
   int64_t total_record_batches;
   MPI_Allreduce(&record_batches_to_send, &total_record_batches, 1, MPI_INT64_T,
@@ -833,7 +1040,8 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
           grape::fid_t dst_fid = comm_spec.WorkerToFrag(dst_worker_id);
           std::pair<grape::fid_t, grape::InArchive> item;
           item.first = dst_fid;
-          SerializeSelectedRows(item.second, cur_rb, cur_offset_lists[dst_fid]);
+          PackSelectedRows(item.second, client, colocated[dst_worker_id],
+                           cur_rb, cur_offset_lists[dst_fid]);
           msg_out.Put(std::move(item));
         }
       }
@@ -843,12 +1051,16 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
 
   std::atomic<int64_t> cur_batch_in(0);
   record_batches_recv.resize(record_batches_to_recv);
+  // the failures are raised after all messages have been received, to keep
+  // the communication with other workers in step
+  std::vector<vineyard::Status> unpack_errors(deserialize_thread_num);
   for (int i = 0; i != deserialize_thread_num; ++i) {
-    deserialize_threads[i] = std::thread([&]() {
+    deserialize_threads[i] = std::thread([&, i]() {
       grape::OutArchive arc;
       while (msg_in.Get(arc)) {
         int64_t got_batch = cur_batch_in.fetch_add(1);
-        DeserializeSelectedRows(arc, schema, record_batches_recv[got_batch]);
+        unpack_errors[i] += UnpackSelectedRows(arc, client, schema,
+                                               record_batches_recv[got_batch]);
       }
     });
   }
@@ -868,7 +1080,12 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
                rb);
     record_batches_recv.emplace_back(std::move(rb));
   }
+  vineyard::Status error;
   MPI_Barrier(comm_spec.comm());
+  for (auto& err : unpack_errors) {
+    error += err;
+  }
+  VY_OK_OR_RAISE(error);
   return {};
 }
 
@@ -879,7 +1096,8 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
     std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
                        std::vector<std::vector<int64_t>>& offset_list)>
         genoffset,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client) {
   int worker_id = comm_spec.worker_id();
   int worker_num = comm_spec.worker_num();
   size_t record_batches_out_num = record_batches_send->num_batches();
@@ -902,6 +1120,8 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
   msg_out.SetProducerNum(serialize_thread_num);
   msg_in.SetProducerNum(1);
 
+  const std::vector<bool> colocated = DetectColocatedWorkers(comm_spec, client);
+
   int64_t record_batches_to_send = static_cast<int64_t>(record_batches_out_num);
   int64_t total_record_batches;
   MPI_Allreduce(&record_batches_to_send, &total_record_batches, 1, MPI_INT64_T,
@@ -974,7 +1194,8 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
               grape::fid_t dst_fid = comm_spec.WorkerToFrag(dst_worker_id);
               std::pair<grape::fid_t, grape::InArchive> item;
               item.first = dst_fid;
-              SerializeSelectedRows(item.second, batch, offset_lists[dst_fid]);
+              PackSelectedRows(item.second, client, colocated[dst_worker_id],
+                               batch, offset_lists[dst_fid]);
               msg_out.Put(std::move(item));
             }
 
@@ -989,12 +1210,14 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
   }
 
   std::atomic<int64_t> cur_batch_in(0);
+  std::vector<vineyard::Status> unpack_errors(deserialize_thread_num);
   for (int i = 0; i != deserialize_thread_num; ++i) {
-    deserialize_threads[i] = std::thread([&]() {
+    deserialize_threads[i] = std::thread([&, i]() {
       grape::OutArchive arc;
       while (msg_in.Get(arc)) {
         int64_t got_batch = cur_batch_in.fetch_add(1);
-        DeserializeSelectedRows(arc, schema, record_batches_recv[got_batch]);
+        unpack_errors[i] += UnpackSelectedRows(arc, client, schema,
+                                               record_batches_recv[got_batch]);
       }
     });
   }
@@ -1012,6 +1235,9 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
   for (auto& err : processing_errors) {
     error += err;
   }
+  for (auto& err : unpack_errors) {
+    error += err;
+  }
   VY_OK_OR_RAISE(error);
   return {};
 }
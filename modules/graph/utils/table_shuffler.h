@@ -28,6 +28,7 @@ limitations under the License.
 #include "arrow/io/api.h"
 #include "boost/leaf.hpp"
 
+#include "client/client.h"
 #include "common/util/status.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/table_pipeline.h"
@@ -269,12 +270,48 @@ void SelectRows(const std::shared_ptr<arrow::RecordBatch> record_batch_in,
                 const std::vector<int64_t>& offset,
                 std::shared_ptr<arrow::RecordBatch>& record_batch_out);
 
+/**
+ * @brief Find out the workers that are attached to the same vineyardd instance
+ * as the current worker. Shuffled slices for those workers could be exchanged
+ * as sealed vineyard objects rather than serialized MPI messages.
+ *
+ * When `client` is nullptr, no worker will be treated as co-located.
+ */
+std::vector<bool> DetectColocatedWorkers(const grape::CommSpec& comm_spec,
+                                         Client* client);
+
+/**
+ * @brief Select the given rows of the record batch into a sealed vineyard
+ * RecordBatch object. An empty selection yields `InvalidObjectID()`.
+ */
+Status SelectRowsAsObject(
+    Client& client, const std::shared_ptr<arrow::RecordBatch> record_batch,
+    const std::vector<int64_t>& offset, ObjectID& object_id);
+
+/**
+ * @brief Resolve a RecordBatch object produced by `SelectRowsAsObject` as a
+ * zero-copy arrow record batch. The object will be deleted from vineyard once
+ * the last buffer of the returned batch is released, thus the client must
+ * outlive the returned batch.
+ */
+Status GetSharedRecordBatch(Client& client, const ObjectID object_id,
+                            std::shared_ptr<arrow::RecordBatch>& batch_out);
+
+/**
+ * @brief Shuffle the selected rows of record batches to other workers.
+ *
+ * When `client` is given, slices for workers that are attached to the same
+ * vineyardd instance are passed as sealed RecordBatch objects and only the
+ * ObjectID goes through MPI, while workers on other hosts still receive the
+ * serialized rows.
+ */
 boost::leaf::result<void> ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
     const std::shared_ptr<arrow::Schema> schema,
     const std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_send,
     const std::vector<std::vector<std::vector<int64_t>>>& offset_lists,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv);
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client = nullptr);
 
 boost::leaf::result<void> ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
@@ -283,43 +320,47 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
     std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
                        std::vector<std::vector<int64_t>>& offset_list)>
         genoffset,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv);
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client = nullptr);
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client = nullptr);
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client = nullptr);
 
 template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client = nullptr);
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 }  // namespace vineyard
 
@@ -128,156 +128,176 @@ template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<int32_t>& partitioner, int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<int64_t>& partitioner, int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<std::string>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<int32_t>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<int64_t>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<std::string>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<int32_t>& partitioner, int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<int64_t>& partitioner, int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const HashPartitioner<std::string>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<int32_t>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<int64_t>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
     const SegmentedPartitioner<std::string>& partitioner, int src_col_id,
-    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTable<uint32_t>(
     const grape::CommSpec& comm_spec, IdParser<uint32_t>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTable<uint64_t>(
     const grape::CommSpec& comm_spec, IdParser<uint64_t>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send);
+    const std::shared_ptr<arrow::Table>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTable<uint32_t>(
     const grape::CommSpec& comm_spec, IdParser<uint32_t>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTable<uint64_t>(
     const grape::CommSpec& comm_spec, IdParser<uint64_t>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int32_t>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int64_t>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<std::string>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<int32_t>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<int64_t>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<std::string>& partitioner,
-                           const std::shared_ptr<arrow::Table>& table_send);
+                           const std::shared_ptr<arrow::Table>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int32_t>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int64_t>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<std::string>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<int32_t>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<int64_t>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<std::string>& partitioner,
-                           const std::shared_ptr<ITablePipeline>& table_send);
+                           const std::shared_ptr<ITablePipeline>& table_send,
+                           Client* client);
 
 }  // namespace vineyard
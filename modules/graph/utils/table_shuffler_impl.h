@@ -64,7 +64,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send) {
+    const std::shared_ptr<arrow::Table>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -117,7 +117,7 @@ ShufflePropertyEdgeTableByPartition(
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
                                              record_batches, offset_lists,
-                                             batches_recv));
+                                             batches_recv, client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -139,7 +139,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -181,7 +181,8 @@ ShufflePropertyEdgeTableByPartition(
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(
-      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv));
+      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv,
+      client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -201,7 +202,7 @@ ShufflePropertyEdgeTableByPartition(
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<arrow::Table>& table_send) {
+    const std::shared_ptr<arrow::Table>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -252,7 +253,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
 
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
                                              record_batches, offset_lists,
-                                             batches_recv));
+                                             batches_recv, client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -271,7 +272,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -302,7 +303,8 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(
-      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv));
+      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv,
+      client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -327,7 +329,7 @@ template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<arrow::Table>& table_send) {
+    const std::shared_ptr<arrow::Table>& table_send, Client* client) {
   VY_OK_OR_RAISE(CheckSchemaConsistency(*table_send->schema(), comm_spec));
 
   using vid_array_t = ArrowArrayType<VID_TYPE>;
@@ -381,7 +383,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
                                              record_batches, offset_lists,
-                                             batches_recv));
+                                             batches_recv, client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -402,7 +404,7 @@ template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   VY_OK_OR_RAISE(CheckSchemaConsistency(*table_send->schema(), comm_spec));
 
   using vid_array_t = ArrowArrayType<VID_TYPE>;
@@ -445,7 +447,8 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(
-      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv));
+      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv,
+      client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -56,13 +56,14 @@ class ArrowLocalVertexMap
                 "Expect arrow_string_view in local vertex map's OID_T");
 
  public:
-  ArrowLocalVertexMap() {}
+  explicit ArrowLocalVertexMap(const bool use_perfect_hash = false)
+      : use_perfect_hash_(use_perfect_hash) {}
   ~ArrowLocalVertexMap() {}
 
   static std::unique_ptr<vineyard::Object> Create() __attribute__((used)) {
     return std::static_pointer_cast<vineyard::Object>(
         std::unique_ptr<ArrowLocalVertexMap<OID_T, VID_T>>{
-            new ArrowLocalVertexMap<OID_T, VID_T>()});
+            new ArrowLocalVertexMap<OID_T, VID_T>(false)});
   }
 
   void Construct(const vineyard::ObjectMeta& meta);
@@ -80,7 +81,7 @@ class ArrowLocalVertexMap
 
   fid_t fnum() { return fnum_; }
 
-  bool use_perfect_hash() const { return false; }
+  bool use_perfect_hash() const { return use_perfect_hash_; }
 
   size_t GetTotalNodesNum() const;
 
@@ -113,8 +114,15 @@ class ArrowLocalVertexMap
           oid_arrays);
 
  private:
+  /**
+   * @brief Get the oid of the vertex at the given offset of the fragment,
+   * without checking the range of fid and label.
+   */
+  bool getOid(fid_t fid, label_id_t label, int64_t offset, oid_t& oid) const;
+
   fid_t fnum_, fid_;
   label_id_t label_num_;
+  bool use_perfect_hash_;
 
   vineyard::IdParser<vid_t> id_parser_;
 
@@ -125,6 +133,11 @@ class ArrowLocalVertexMap
 
   // frag->label->oid
   std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2i_;
+  // frag->label->oid, when using perfect hash
+  //
+  // the perfect hash maps an oid that doesn't exist to an arbitrary slot, the
+  // result must be verified with the oid of the found offset
+  std::vector<std::vector<vineyard::PerfectHashmap<oid_t, vid_t>>> o2i_p_;
 
   // for non-string_view oid type
   std::vector<std::vector<vineyard::Hashmap<vid_t, oid_t>>> i2o_;
@@ -152,7 +165,8 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
       : client(client) {}
 
   explicit ArrowLocalVertexMapBuilder(vineyard::Client& client, fid_t fnum,
-                                      fid_t fid, label_id_t label_num);
+                                      fid_t fid, label_id_t label_num,
+                                      const bool use_perfect_hash = false);
 
   vineyard::Status Build(vineyard::Client& client) override;
 
@@ -193,6 +207,7 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
   vineyard::Client& client;
   fid_t fnum_, fid_;
   label_id_t label_num_;
+  bool use_perfect_hash_ = false;
 
   vineyard::IdParser<vid_t> id_parser_;
 
@@ -203,6 +218,7 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
       oid_arrays_;
 
   std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2i_;
+  std::vector<std::vector<vineyard::PerfectHashmap<oid_t, vid_t>>> o2i_p_;
 
   // for non-string_view oid type
   std::vector<std::vector<vineyard::Hashmap<vid_t, oid_t>>> i2o_;
@@ -51,6 +51,11 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
   this->fnum_ = meta.GetKeyValue<fid_t>("fnum");
   this->fid_ = meta.GetKeyValue<fid_t>("fid");
   this->label_num_ = meta.GetKeyValue<label_id_t>("label_num");
+  if (meta.HasKey("use_perfect_hash_")) {
+    meta.GetKeyValue<bool>("use_perfect_hash_", this->use_perfect_hash_);
+  } else {
+    this->use_perfect_hash_ = false;
+  }
 
   id_parser_.Init(fnum_, label_num_);
 
@@ -59,13 +64,21 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
          o2i_bucket_count = 0, i2o_size = 0, i2o_bucket_count = 0;
 
   oid_arrays_.resize(fnum_);
-  o2i_.resize(fnum_);
+  if (!use_perfect_hash_) {
+    o2i_.resize(fnum_);
+  } else {
+    o2i_p_.resize(fnum_);
+  }
   i2o_.resize(fnum_);
   i2o_index_.resize(fnum_);
   vertices_num_.resize(fnum_);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     oid_arrays_[fid].resize(label_num_);
-    o2i_[fid].resize(label_num_);
+    if (!use_perfect_hash_) {
+      o2i_[fid].resize(label_num_);
+    } else {
+      o2i_p_[fid].resize(label_num_);
+    }
     i2o_[fid].resize(label_num_);
     i2o_index_[fid].resize(label_num_);
     vertices_num_[fid].resize(label_num_);
@@ -90,10 +103,17 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
         i2o_bucket_count += i2o_index_[fid][label].bucket_count();
       }
 
-      o2i_[fid][label].Construct(meta.GetMemberMeta("o2i_" + suffix));
-      o2i_size += o2i_[fid][label].size();
-      o2i_total_bytes += o2i_[fid][label].nbytes();
-      o2i_bucket_count += o2i_[fid][label].bucket_count();
+      if (!use_perfect_hash_) {
+        o2i_[fid][label].Construct(meta.GetMemberMeta("o2i_" + suffix));
+        o2i_size += o2i_[fid][label].size();
+        o2i_total_bytes += o2i_[fid][label].nbytes();
+        o2i_bucket_count += o2i_[fid][label].bucket_count();
+      } else {
+        o2i_p_[fid][label].Construct(meta.GetMemberMeta("o2i_p_" + suffix));
+        o2i_size += o2i_p_[fid][label].size();
+        o2i_total_bytes += o2i_p_[fid][label].nbytes();
+        o2i_bucket_count += o2i_p_[fid][label].bucket_count();
+      }
 
       vertices_num_[fid][label] =
           meta.GetKeyValue<vid_t>("vertices_num_" + suffix);
@@ -108,6 +128,7 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
                             : static_cast<size_t>(i2o_size) / i2o_bucket_count;
   VLOG(100) << type_name<ArrowLocalVertexMap<oid_t, vid_t>>()
             << "\n\tmemory: " << prettyprint_memory_size(nbytes)
+            << "\n\tuse perfect hash: " << use_perfect_hash_
             << "\n\to2i size: " << o2i_size
             << ", load factor: " << o2i_load_factor
             << "\n\to2i memory: " << prettyprint_memory_size(o2i_total_bytes)
@@ -122,28 +143,7 @@ bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
   label_id_t label = id_parser_.GetLabelId(gid);
   int64_t offset = id_parser_.GetOffset(gid);
   if (fid < fnum_ && label < label_num_ && label >= 0) {
-    if (fid == fid_) {
-      if (offset < oid_arrays_[fid][label]->length()) {
-        oid = oid_arrays_[fid][label]->GetView(offset);
-        return true;
-      }
-    } else {
-      if (!std::is_same<OID_T, arrow_string_view>::value) {
-        // non string_view oid
-        auto iter = i2o_[fid][label].find(offset);
-        if (iter != i2o_[fid][label].end()) {
-          oid = iter->second;
-          return true;
-        }
-      } else {
-        // string_view oid
-        auto iter = i2o_index_[fid][label].find(offset);
-        if (iter != i2o_index_[fid][label].end()) {
-          oid = oid_arrays_[fid][label]->GetView(iter->second);
-          return true;
-        }
-      }
-    }
+    return getOid(fid, label, offset, oid);
   }
   return false;
 }
@@ -151,6 +151,16 @@ bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
 template <typename OID_T, typename VID_T>
 bool ArrowLocalVertexMap<OID_T, VID_T>::GetGid(fid_t fid, label_id_t label_id,
                                                oid_t oid, vid_t& gid) const {
+  if (use_perfect_hash_) {
+    auto found = o2i_p_[fid][label_id].find(oid);
+    oid_t expected;
+    if (found != nullptr && getOid(fid, label_id, *found, expected) &&
+        expected == oid) {
+      gid = id_parser_.GenerateId(fid, label_id, *found);
+      return true;
+    }
+    return false;
+  }
   auto iter = o2i_[fid][label_id].find(oid);
   if (iter != o2i_[fid][label_id].end()) {
     gid = id_parser_.GenerateId(fid, label_id, iter->second);
@@ -267,17 +277,53 @@ ObjectID ArrowLocalVertexMap<OID_T, VID_T>::AddNewVertexLabels(
   return InvalidObjectID();
 }
 
+template <typename OID_T, typename VID_T>
+bool ArrowLocalVertexMap<OID_T, VID_T>::getOid(fid_t fid, label_id_t label,
+                                               int64_t offset,
+                                               oid_t& oid) const {
+  if (fid == fid_) {
+    if (offset < oid_arrays_[fid][label]->length()) {
+      oid = oid_arrays_[fid][label]->GetView(offset);
+      return true;
+    }
+  } else {
+    if (!std::is_same<OID_T, arrow_string_view>::value) {
+      // non string_view oid
+      auto iter = i2o_[fid][label].find(offset);
+      if (iter != i2o_[fid][label].end()) {
+        oid = iter->second;
+        return true;
+      }
+    } else {
+      // string_view oid
+      auto iter = i2o_index_[fid][label].find(offset);
+      if (iter != i2o_index_[fid][label].end()) {
+        oid = oid_arrays_[fid][label]->GetView(iter->second);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 template <typename OID_T, typename VID_T>
 ArrowLocalVertexMapBuilder<OID_T, VID_T>::ArrowLocalVertexMapBuilder(
-    vineyard::Client& client, fid_t fnum, fid_t fid, label_id_t label_num)
-    : client(client), fnum_(fnum), fid_(fid), label_num_(label_num) {
+    vineyard::Client& client, fid_t fnum, fid_t fid, label_id_t label_num,
+    const bool use_perfect_hash)
+    : client(client),
+      fnum_(fnum),
+      fid_(fid),
+      label_num_(label_num),
+      use_perfect_hash_(use_perfect_hash) {
   oid_arrays_.resize(fnum);
   o2i_.resize(fnum);
+  o2i_p_.resize(fnum);
   i2o_.resize(fnum);
   i2o_index_.resize(fnum);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     oid_arrays_[fid].resize(label_num_);
     o2i_[fid].resize(label_num_);
+    o2i_p_[fid].resize(label_num_);
     if (fid != fid_) {
       i2o_[fid].resize(label_num_);
       i2o_index_[fid].resize(label_num_);
@@ -307,10 +353,12 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
   // empty method
   // VINEYARD_CHECK_OK(this->Build(client));
 
-  auto vertex_map = std::make_shared<ArrowLocalVertexMap<oid_t, vid_t>>();
+  auto vertex_map =
+      std::make_shared<ArrowLocalVertexMap<oid_t, vid_t>>(use_perfect_hash_);
   object = vertex_map;
 
   vertex_map->fnum_ = fnum_;
+  vertex_map->fid_ = fid_;
   vertex_map->label_num_ = label_num_;
   vertex_map->id_parser_.Init(fnum_, label_num_);
 
@@ -323,7 +371,11 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
     }
   }
 
-  vertex_map->o2i_ = o2i_;
+  if (!use_perfect_hash_) {
+    vertex_map->o2i_ = o2i_;
+  } else {
+    vertex_map->o2i_p_ = o2i_p_;
+  }
   vertex_map->i2o_ = i2o_;
   vertex_map->i2o_index_ = i2o_index_;
   vertex_map->vertices_num_ = vertices_num_;
@@ -333,6 +385,7 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
   vertex_map->meta_.AddKeyValue("fnum", fnum_);
   vertex_map->meta_.AddKeyValue("fid", fid_);
   vertex_map->meta_.AddKeyValue("label_num", label_num_);
+  vertex_map->meta_.AddKeyValue("use_perfect_hash_", use_perfect_hash_);
 
   size_t nbytes = 0;
   for (fid_t fid = 0; fid < fnum_; ++fid) {
@@ -343,8 +396,14 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
                                   oid_arrays_[fid][label].meta());
       nbytes += oid_arrays_[fid][label].nbytes();
 
-      vertex_map->meta_.AddMember("o2i_" + suffix, o2i_[fid][label].meta());
-      nbytes += o2i_[fid][label].nbytes();
+      if (!use_perfect_hash_) {
+        vertex_map->meta_.AddMember("o2i_" + suffix, o2i_[fid][label].meta());
+        nbytes += o2i_[fid][label].nbytes();
+      } else {
+        vertex_map->meta_.AddMember("o2i_p_" + suffix,
+                                    o2i_p_[fid][label].meta());
+        nbytes += o2i_p_[fid][label].nbytes();
+      }
       if (fid != fid_) {
         vertex_map->meta_.AddMember("i2o_" + suffix, i2o_[fid][label].meta());
         nbytes += i2o_[fid][label].nbytes();
@@ -401,27 +460,38 @@ vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::addLocalVertices(
                                                                       arrays);
     std::shared_ptr<Object> object;
     RETURN_ON_ERROR(array_builder.Seal(client, object));
-    oid_arrays_[fid_][label] = *std::dynamic_pointer_cast<
+    auto varray = std::dynamic_pointer_cast<
         typename InternalType<oid_t>::vineyard_array_type>(object);
+    oid_arrays_[fid_][label] = *varray;
 
     // release the reference
     arrays.clear();
 
     // now use the array in vineyard memory
     auto array = oid_arrays_[fid_][label].GetArray();
-    vineyard::HashmapBuilder<oid_t, vid_t> builder(client);
     int64_t vnum = array->length();
-    builder.reserve(static_cast<size_t>(vnum));
-    for (int64_t i = 0; i < vnum; ++i) {
-      if (!builder.emplace(array->GetView(i), i)) {
-        LOG(WARNING)
-            << "The vertex '" << array->GetView(i) << "' has been added "
-            << "more than once, please double check your vertices data";
+    if (!use_perfect_hash_) {
+      vineyard::HashmapBuilder<oid_t, vid_t> builder(client);
+      builder.reserve(static_cast<size_t>(vnum));
+      for (int64_t i = 0; i < vnum; ++i) {
+        if (!builder.emplace(array->GetView(i), i)) {
+          LOG(WARNING)
+              << "The vertex '" << array->GetView(i) << "' has been added "
+              << "more than once, please double check your vertices data";
+        }
       }
+      RETURN_ON_ERROR(builder.Seal(client, object));
+      o2i_[fid_][label] =
+          *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
+    } else {
+      vineyard::PerfectHashmapBuilder<oid_t, vid_t> builder(client);
+      RETURN_ON_ERROR(builder.ComputeHash(client, varray, static_cast<vid_t>(0),
+                                          static_cast<size_t>(vnum)));
+      RETURN_ON_ERROR(builder.Seal(client, object));
+      o2i_p_[fid_][label] =
+          *std::dynamic_pointer_cast<vineyard::PerfectHashmap<oid_t, vid_t>>(
+              object);
     }
-    RETURN_ON_ERROR(builder.Seal(client, object));
-    o2i_[fid_][label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
 
     vertices_num_[fid_][label] = vnum;
     return Status::OK();
@@ -457,18 +527,30 @@ vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::GetIndexOfOids(
   index_list.resize(label_num_);
 
   for (label_id_t label_id = 0; label_id < label_num_; ++label_id) {
-    auto& o2i_map = o2i_[fid_][label_id];
     auto& current_oids = oids[label_id];
     auto& current_index_list = index_list[label_id];
     current_index_list.resize(current_oids->length());
 
-    parallel_for(
-        static_cast<int64_t>(0), current_oids->length(),
-        [&](const size_t& i) {
-          current_index_list[i] =
-              o2i_map.find(current_oids->GetView(i))->second;
-        },
-        std::thread::hardware_concurrency());
+    if (!use_perfect_hash_) {
+      auto& o2i_map = o2i_[fid_][label_id];
+      parallel_for(
+          static_cast<int64_t>(0), current_oids->length(),
+          [&](const size_t& i) {
+            current_index_list[i] =
+                o2i_map.find(current_oids->GetView(i))->second;
+          },
+          std::thread::hardware_concurrency());
+    } else {
+      // the requested oids are the outer vertices of other fragments, which
+      // must exist in this fragment
+      auto& o2i_map = o2i_p_[fid_][label_id];
+      parallel_for(
+          static_cast<int64_t>(0), current_oids->length(),
+          [&](const size_t& i) {
+            current_index_list[i] = *o2i_map.find(current_oids->GetView(i));
+          },
+          std::thread::hardware_concurrency());
+    }
   }
   return vineyard::Status::OK();
 }
@@ -497,23 +579,42 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
     vineyard::HashmapBuilder<oid_t, vid_t> o2i_builder(client);
     vineyard::HashmapBuilder<vid_t, oid_t> i2o_builder(client);
     vineyard::HashmapBuilder<vid_t, vid_t> i2o_index_builder(client);
-    o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
+    if (!use_perfect_hash_) {
+      o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
+    }
     i2o_builder.reserve(static_cast<size_t>(current_oid_array->length()));
     for (int64_t i = 0; i < current_oid_array->length(); i++) {
       auto oid = current_oid_array->GetView(i);
       auto& index = index_list[cur_fid][cur_label][i];
-      o2i_builder.emplace(oid, index);
+      if (!use_perfect_hash_) {
+        o2i_builder.emplace(oid, index);
+      }
       i2o_builder.emplace(index, oid);
     }
 
+    if (!use_perfect_hash_) {
+      RETURN_ON_ERROR(o2i_builder.Seal(client, object));
+      o2i_[cur_fid][cur_label] =
+          *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
+    } else {
+      // the outer oids are not kept in `oid_arrays_`, thus the keys are
+      // copied into the perfect hashmap
+      vineyard::PerfectHashmapBuilder<oid_t, vid_t> o2i_p_builder(client);
+      RETURN_ON_ERROR(o2i_p_builder.ComputeHash(
+          client, current_oid_array->raw_values(),
+          index_list[cur_fid][cur_label].data(),
+          static_cast<size_t>(current_oid_array->length())));
+      RETURN_ON_ERROR(o2i_p_builder.Seal(client, object));
+      o2i_p_[cur_fid][cur_label] =
+          *std::dynamic_pointer_cast<vineyard::PerfectHashmap<oid_t, vid_t>>(
+              object);
+    }
+
     // release the reference
     oids[cur_fid][cur_label].reset();
     index_list[cur_fid][cur_label].clear();
     index_list[cur_fid][cur_label].shrink_to_fit();
 
-    RETURN_ON_ERROR(o2i_builder.Seal(client, object));
-    o2i_[cur_fid][cur_label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
     RETURN_ON_ERROR(i2o_builder.Seal(client, object));
     i2o_[cur_fid][cur_label] =
         *std::dynamic_pointer_cast<vineyard::Hashmap<vid_t, oid_t>>(object);
@@ -551,8 +652,9 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
         client, oids[cur_fid][cur_label]);
     std::shared_ptr<Object> object;
     RETURN_ON_ERROR(outer_oid_builder.Seal(client, object));
-    oid_arrays_[cur_fid][cur_label] = *std::dynamic_pointer_cast<
+    auto varray = std::dynamic_pointer_cast<
         typename InternalType<oid_t>::vineyard_array_type>(object);
+    oid_arrays_[cur_fid][cur_label] = *varray;
 
     // release the reference
     oids[cur_fid][cur_label].reset();
@@ -563,25 +665,43 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
     vineyard::HashmapBuilder<oid_t, vid_t> o2i_builder(client);
     vineyard::HashmapBuilder<vid_t, oid_t> i2o_builder(client);
     vineyard::HashmapBuilder<vid_t, vid_t> i2o_index_builder(client);
-    o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
-    // n.b.
-    o2i_builder.AssociateDataBuffer(
-        oid_arrays_[cur_fid][cur_label].GetBuffer());
+    if (!use_perfect_hash_) {
+      o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
+      // n.b.
+      o2i_builder.AssociateDataBuffer(
+          oid_arrays_[cur_fid][cur_label].GetBuffer());
+    }
     i2o_index_builder.reserve(static_cast<size_t>(current_oid_array->length()));
     for (int64_t i = 0; i < current_oid_array->length(); i++) {
       auto oid = current_oid_array->GetView(i);
       auto& index = index_list[cur_fid][cur_label][i];
-      o2i_builder.emplace(oid, index);
+      if (!use_perfect_hash_) {
+        o2i_builder.emplace(oid, index);
+      }
       i2o_index_builder.emplace(index, static_cast<size_t>(i));
     }
 
+    if (!use_perfect_hash_) {
+      RETURN_ON_ERROR(o2i_builder.Seal(client, object));
+      o2i_[cur_fid][cur_label] =
+          *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
+    } else {
+      // the perfect hashmap fingerprints the strings in the sealed oid array
+      // rather than copying them
+      vineyard::PerfectHashmapBuilder<oid_t, vid_t> o2i_p_builder(client);
+      RETURN_ON_ERROR(o2i_p_builder.ComputeHash(
+          client, varray, index_list[cur_fid][cur_label].data(),
+          static_cast<size_t>(current_oid_array->length())));
+      RETURN_ON_ERROR(o2i_p_builder.Seal(client, object));
+      o2i_p_[cur_fid][cur_label] =
+          *std::dynamic_pointer_cast<vineyard::PerfectHashmap<oid_t, vid_t>>(
+              object);
+    }
+
     // release the reference
     index_list[cur_fid][cur_label].clear();
     index_list[cur_fid][cur_label].shrink_to_fit();
 
-    RETURN_ON_ERROR(o2i_builder.Seal(client, object));
-    o2i_[cur_fid][cur_label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
     RETURN_ON_ERROR(i2o_builder.Seal(client, object));
     i2o_[cur_fid][cur_label] =
         *std::dynamic_pointer_cast<vineyard::Hashmap<vid_t, oid_t>>(object);
@@ -20,22 +20,817 @@ limitations under the License.
 #include <sys/types.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
 #include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "arrow/api.h"
 #include "arrow/csv/api.h"
 #include "arrow/filesystem/api.h"
 #include "arrow/io/api.h"
+#include "arrow/util/compression.h"
 #include "arrow/util/uri.h"
 #include "boost/algorithm/string.hpp"
 
 #include "basic/ds/arrow_utils.h"
+#include "common/util/functions.h"
 #include "common/util/logging.h"
 
 namespace vineyard {
+
+namespace {
+
+bool ParseCompressionType(const std::string& name,
+                          arrow::Compression::type& compression) {
+  std::string value = boost::algorithm::to_lower_copy(name);
+  if (value == "gzip" || value == "gz") {
+    compression = arrow::Compression::GZIP;
+  } else if (value == "zstd" || value == "zst") {
+    compression = arrow::Compression::ZSTD;
+  } else if (value == "bz2" || value == "bzip2") {
+    compression = arrow::Compression::BZ2;
+  } else if (value == "none" || value == "uncompressed") {
+    compression = arrow::Compression::UNCOMPRESSED;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+arrow::Compression::type CompressionTypeFromSuffix(const std::string& path) {
+  std::string value = boost::algorithm::to_lower_copy(path);
+  if (boost::algorithm::ends_with(value, ".gz") ||
+      boost::algorithm::ends_with(value, ".gzip")) {
+    return arrow::Compression::GZIP;
+  }
+  if (boost::algorithm::ends_with(value, ".zst") ||
+      boost::algorithm::ends_with(value, ".zstd")) {
+    return arrow::Compression::ZSTD;
+  }
+  if (boost::algorithm::ends_with(value, ".bz2")) {
+    return arrow::Compression::BZ2;
+  }
+  return arrow::Compression::UNCOMPRESSED;
+}
+
+inline uint16_t ReadLE16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0]) | (static_cast<uint16_t>(p[1]) << 8);
+}
+
+inline uint32_t ReadLE32(const uint8_t* p) {
+  return static_cast<uint32_t>(ReadLE16(p)) |
+         (static_cast<uint32_t>(ReadLE16(p + 2)) << 16);
+}
+
+inline uint64_t ReadLE64(const uint8_t* p) {
+  return static_cast<uint64_t>(ReadLE32(p)) |
+         (static_cast<uint64_t>(ReadLE32(p + 4)) << 32);
+}
+
+/**
+ * An independently decompressible range of the compressed input, e.g., a
+ * gzip member, a zstd frame or a bzip2 stream, or several adjacent ones.
+ */
+struct CompressedMember {
+  int64_t offset = 0;
+  int64_t size = 0;
+  int64_t decompressed_offset = 0;
+  // -1 if unknown before decompressing
+  int64_t decompressed_size = -1;
+};
+
+constexpr int64_t kWindowSize = 16 * 1024 * 1024;
+
+/**
+ * Reads the compressed input through a bounded sliding window, to locate
+ * the members without loading the whole input into memory.
+ */
+class WindowedReader {
+ public:
+  WindowedReader(const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                 const int64_t size)
+      : file_(file), size_(size) {}
+
+  int64_t size() const { return size_; }
+
+  Status const& status() const { return status_; }
+
+  /**
+   * Returns the bytes in [offset, offset + length), or nullptr if the range
+   * is out of the input, the pointer is invalidated by the next `Get()`.
+   */
+  const uint8_t* Get(const int64_t offset, const int64_t length) {
+    if (offset < 0 || length > kWindowSize || offset + length > size_) {
+      return nullptr;
+    }
+    if (window_ == nullptr || offset < window_offset_ ||
+        offset + length > window_offset_ + window_->size()) {
+      auto window =
+          file_->ReadAt(offset, std::min(kWindowSize, size_ - offset));
+      if (!window.ok()) {
+        status_ = Status::ArrowError(window.status());
+        return nullptr;
+      }
+      window_ = window.ValueOrDie();
+      window_offset_ = offset;
+      if (offset + length > window_offset_ + window_->size()) {
+        return nullptr;
+      }
+    }
+    return window_->data() + (offset - window_offset_);
+  }
+
+ private:
+  std::shared_ptr<arrow::io::RandomAccessFile> file_;
+  int64_t size_;
+  std::shared_ptr<arrow::Buffer> window_;
+  int64_t window_offset_ = 0;
+  Status status_;
+};
+
+/**
+ * Locates the members of a BGZF file (as produced by `bgzip`), where every
+ * gzip member carries its compressed size in the "BC" extra subfield and
+ * its decompressed size (at most 64KB) in the trailing ISIZE.
+ */
+bool SplitGzipMembers(WindowedReader& reader,
+                      std::vector<CompressedMember>& members) {
+  const int64_t size = reader.size();
+  int64_t offset = 0;
+  while (offset < size) {
+    // ID1, ID2, CM, FLG, MTIME, XFL, OS, XLEN, then the extra subfields
+    const uint8_t* data = reader.Get(offset, 18);
+    if (data == nullptr || data[0] != 0x1f || data[1] != 0x8b ||
+        data[2] != 0x08 || !(data[3] & 0x04)) {
+      return false;
+    }
+    int64_t xlen = ReadLE16(data + 10);
+    data = reader.Get(offset, 12 + xlen);
+    if (data == nullptr) {
+      return false;
+    }
+    const uint8_t* extra = data + 12;
+    int64_t bsize = -1;
+    for (int64_t pos = 0; pos + 4 <= xlen;) {
+      int64_t slen = ReadLE16(extra + pos + 2);
+      if (extra[pos] == 'B' && extra[pos + 1] == 'C' && slen == 2 &&
+          pos + 6 <= xlen) {
+        bsize = ReadLE16(extra + pos + 4);
+        break;
+      }
+      pos += 4 + slen;
+    }
+    if (bsize < 0) {
+      return false;
+    }
+    const uint8_t* trailer = reader.Get(offset + bsize + 1 - 4, 4);
+    if (trailer == nullptr) {
+      return false;
+    }
+    CompressedMember member;
+    member.offset = offset;
+    member.size = bsize + 1;
+    member.decompressed_size = ReadLE32(trailer);
+    members.push_back(member);
+    offset += bsize + 1;
+  }
+  return offset == size;
+}
+
+/**
+ * Reads the members from the ".gzi" index side-file of `bgzip -i`: a
+ * little-endian uint64 count followed by (compressed, uncompressed) offset
+ * pairs, the first member at offset 0 is implicit.
+ */
+Status ReadGzipIndex(const std::shared_ptr<arrow::fs::FileSystem>& fs,
+                     const std::string& path, const int64_t size,
+                     std::vector<CompressedMember>& members) {
+  std::shared_ptr<arrow::io::RandomAccessFile> file;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(file, fs->OpenInputFile(path));
+  int64_t index_size = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(index_size, file->GetSize());
+  std::shared_ptr<arrow::Buffer> index;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(index, file->ReadAt(0, index_size));
+  RETURN_ON_ARROW_ERROR(file->Close());
+  if (index->size() < 8) {
+    return Status::IOError("Invalid gzip index file: " + path);
+  }
+  uint64_t entries = ReadLE64(index->data());
+  if (static_cast<uint64_t>(index->size()) != 8 + entries * 16) {
+    return Status::IOError("Invalid gzip index file: " + path);
+  }
+  members.emplace_back();
+  members.back().offset = 0;
+  members.back().decompressed_offset = 0;
+  for (uint64_t i = 0; i < entries; ++i) {
+    int64_t offset = ReadLE64(index->data() + 8 + i * 16);
+    int64_t decompressed_offset = ReadLE64(index->data() + 16 + i * 16);
+    CompressedMember& last = members.back();
+    if (offset <= last.offset || offset >= size ||
+        decompressed_offset < last.decompressed_offset) {
+      return Status::IOError("Invalid gzip index file: " + path);
+    }
+    last.size = offset - last.offset;
+    last.decompressed_size = decompressed_offset - last.decompressed_offset;
+    members.emplace_back();
+    members.back().offset = offset;
+    members.back().decompressed_offset = decompressed_offset;
+  }
+  // the size of the last entry (may span several gzip members) is unknown
+  members.back().size = size - members.back().offset;
+  return Status::OK();
+}
+
+/**
+ * Locates the frames of a zstd file by walking the frame and block headers,
+ * see also RFC 8878. Multi-frame inputs are produced by, e.g., `zstd -T0`,
+ * `pzstd` and `zstd --rsyncable`.
+ */
+bool SplitZstdFrames(WindowedReader& reader,
+                     std::vector<CompressedMember>& members) {
+  static const int dict_id_sizes[] = {0, 1, 2, 4};
+  static const int content_size_sizes[] = {0, 2, 4, 8};
+
+  const int64_t size = reader.size();
+  int64_t offset = 0;
+  while (offset < size) {
+    const uint8_t* data = reader.Get(offset, 8);
+    if (data == nullptr) {
+      return false;
+    }
+    uint32_t magic = ReadLE32(data);
+    if ((magic & 0xFFFFFFF0u) == 0x184D2A50u) {
+      // skippable frames are decompressed along with the previous frame
+      offset += 8 + static_cast<int64_t>(ReadLE32(data + 4));
+      if (!members.empty()) {
+        members.back().size = offset - members.back().offset;
+      }
+      continue;
+    }
+    if (magic != 0xFD2FB528u) {
+      return false;
+    }
+
+    uint8_t descriptor = data[4];
+    int content_size_flag = descriptor >> 6;
+    bool single_segment = (descriptor >> 5) & 1;
+    bool checksum = (descriptor >> 2) & 1;
+    int64_t content_size_pos =
+        5 + (single_segment ? 0 : 1) + dict_id_sizes[descriptor & 3];
+    int content_size_size = (content_size_flag == 0 && single_segment)
+                                ? 1
+                                : content_size_sizes[content_size_flag];
+    data = reader.Get(offset, content_size_pos + content_size_size);
+    if (data == nullptr) {
+      return false;
+    }
+    CompressedMember member;
+    // leading skippable frames belong to the first frame
+    member.offset = members.empty() ? 0 : offset;
+    const uint8_t* content_size = data + content_size_pos;
+    switch (content_size_size) {
+    case 1:
+      member.decompressed_size = content_size[0];
+      break;
+    case 2:
+      member.decompressed_size = ReadLE16(content_size) + 256;
+      break;
+    case 4:
+      member.decompressed_size = ReadLE32(content_size);
+      break;
+    case 8:
+      member.decompressed_size = ReadLE64(content_size);
+      break;
+    default:
+      break;
+    }
+
+    int64_t pos = offset + content_size_pos + content_size_size;
+    while (true) {
+      data = reader.Get(pos, 3);
+      if (data == nullptr) {
+        return false;
+      }
+      uint32_t header = static_cast<uint32_t>(data[0]) |
+                        (static_cast<uint32_t>(data[1]) << 8) |
+                        (static_cast<uint32_t>(data[2]) << 16);
+      pos += 3;
+      int block_type = (header >> 1) & 3;
+      if (block_type == 3) {
+        return false;
+      }
+      // RLE blocks keep a single byte
+      pos += block_type == 1 ? 1 : (header >> 3);
+      if (header & 1) {
+        break;
+      }
+    }
+    offset = pos + (checksum ? 4 : 0);
+    member.size = offset - member.offset;
+    members.push_back(member);
+  }
+  return offset == size;
+}
+
+/**
+ * Locates the streams of a multi-stream bzip2 file (as produced by `pbzip2`)
+ * by the stream header followed by the magic of its first block.
+ */
+bool SplitBzip2Streams(WindowedReader& reader,
+                       std::vector<CompressedMember>& members) {
+  static const uint8_t block_magic[] = {0x31, 0x41, 0x59, 0x26, 0x53, 0x59};
+  static const int64_t header_size = 4 + sizeof(block_magic);
+  auto is_stream_header = [&](const uint8_t* data) -> bool {
+    return data[0] == 'B' && data[1] == 'Z' && data[2] == 'h' &&
+           data[3] >= '1' && data[3] <= '9' &&
+           memcmp(data + 4, block_magic, sizeof(block_magic)) == 0;
+  };
+
+  const int64_t size = reader.size();
+  const uint8_t* data = reader.Get(0, header_size);
+  if (data == nullptr || !is_stream_header(data)) {
+    return false;
+  }
+  std::vector<int64_t> offsets = {0};
+  // scans the candidates in [begin, begin + step) of each window
+  const int64_t step = kWindowSize - header_size;
+  for (int64_t begin = 1; begin + header_size <= size; begin += step) {
+    int64_t candidates = std::min(step, size - header_size + 1 - begin);
+    data = reader.Get(begin, candidates + header_size - 1);
+    if (data == nullptr) {
+      return false;
+    }
+    for (int64_t pos = 0; pos < candidates; ++pos) {
+      const void* next = memchr(data + pos, 'B', candidates - pos);
+      if (next == nullptr) {
+        break;
+      }
+      pos = static_cast<const uint8_t*>(next) - data;
+      if (is_stream_header(data + pos)) {
+        offsets.push_back(begin + pos);
+      }
+    }
+  }
+  offsets.push_back(size);
+  for (size_t index = 0; index + 1 < offsets.size(); ++index) {
+    CompressedMember member;
+    member.offset = offsets[index];
+    member.size = offsets[index + 1] - offsets[index];
+    members.push_back(member);
+  }
+  return true;
+}
+
+/**
+ * Merges adjacent members into chunks of at least `chunk_size` compressed
+ * bytes, to amortize the cost of reading and decompressing small members.
+ * Empty members (e.g., the EOF marker of BGZF) always join the previous
+ * chunk.
+ */
+std::vector<CompressedMember> CoalesceMembers(
+    const std::vector<CompressedMember>& members, const int64_t chunk_size) {
+  std::vector<CompressedMember> chunks;
+  for (auto const& member : members) {
+    if (chunks.empty() || (chunks.back().size >= chunk_size &&
+                           member.decompressed_size != 0)) {
+      chunks.push_back(member);
+      continue;
+    }
+    CompressedMember& chunk = chunks.back();
+    chunk.size = member.offset + member.size - chunk.offset;
+    if (chunk.decompressed_size >= 0 && member.decompressed_size >= 0) {
+      chunk.decompressed_size += member.decompressed_size;
+    } else {
+      chunk.decompressed_size = -1;
+    }
+  }
+  return chunks;
+}
+
+/**
+ * Decompresses a chunk that consists of one or more complete members into
+ * `out` of `capacity` bytes, or only counts the decompressed bytes when
+ * `out` is nullptr.
+ */
+Status DecompressChunk(const arrow::Compression::type compression,
+                       const uint8_t* data, const int64_t size, uint8_t* out,
+                       const int64_t capacity, int64_t* decompressed_size) {
+  static const int64_t scratch_size = 1024 * 1024;
+
+  std::unique_ptr<arrow::util::Codec> codec;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(codec,
+                                   arrow::util::Codec::Create(compression));
+  std::shared_ptr<arrow::util::Decompressor> decompressor;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(decompressor, codec->MakeDecompressor());
+  // the scratch also receives the output that overflows `out`, e.g., when
+  // the trailing members are empty
+  std::vector<uint8_t> scratch(out == nullptr ? scratch_size : 64);
+
+  int64_t bytes_read = 0, bytes_written = 0;
+  while (bytes_read < size) {
+    bool overflow = out == nullptr || bytes_written >= capacity;
+    uint8_t* output = overflow ? scratch.data() : out + bytes_written;
+    int64_t output_size = overflow ? static_cast<int64_t>(scratch.size())
+                                   : capacity - bytes_written;
+    arrow::util::Decompressor::DecompressResult result;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        result, decompressor->Decompress(size - bytes_read, data + bytes_read,
+                                         output_size, output));
+    bytes_read += result.bytes_read;
+    bytes_written += result.bytes_written;
+    if (out != nullptr && bytes_written > capacity) {
+      return Status::IOError(
+          "The decompressed size exceeds the expected size " +
+          std::to_string(capacity));
+    }
+    if (decompressor->IsFinished()) {
+      // concatenated members
+      if (bytes_read < size) {
+        RETURN_ON_ARROW_ERROR(decompressor->Reset());
+      }
+    } else if (result.bytes_read == 0 && result.bytes_written == 0 &&
+               !result.need_more_output) {
+      break;
+    }
+  }
+  if (!decompressor->IsFinished()) {
+    return Status::IOError("Truncated compressed input");
+  }
+  *decompressed_size = bytes_written;
+  return Status::OK();
+}
+
+/**
+ * Serves the decompressed content of a compressed file as a random access
+ * file, where the members are decompressed on demand and the following
+ * members are decompressed ahead in parallel.
+ *
+ * Only a bounded number of decompressed members is cached, thus a worker
+ * that reads a part of the file only decompresses the members that overlap
+ * with the part.
+ */
+class DecompressedFile : public arrow::io::RandomAccessFile {
+ public:
+  DecompressedFile(const arrow::Compression::type compression,
+                   const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                   std::vector<CompressedMember>&& members,
+                   const size_t concurrency)
+      : compression_(compression),
+        file_(file),
+        members_(std::move(members)),
+        readahead_(concurrency),
+        capacity_(concurrency * 2 + 2) {
+    for (auto const& member : members_) {
+      size_ += member.decompressed_size;
+    }
+  }
+
+  ~DecompressedFile() override { clearCache(); }
+
+  arrow::Status Close() override {
+    clearCache();
+    closed_ = true;
+    if (file_) {
+      return file_->Close();
+    }
+    return arrow::Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  arrow::Result<int64_t> Tell() const override { return position_; }
+
+  arrow::Status Seek(int64_t position) override {
+    if (position < 0) {
+      return arrow::Status::IOError("Invalid seek position: ", position);
+    }
+    position_ = position;
+    return arrow::Status::OK();
+  }
+
+  arrow::Result<int64_t> GetSize() override { return size_; }
+
+  arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position_, nbytes, out));
+    position_ += bytes_read;
+    return bytes_read;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+    position_ += buffer->size();
+    return buffer;
+  }
+
+  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes,
+                                void* out) override {
+    if (position < 0 || nbytes < 0) {
+      return arrow::Status::IOError("Invalid read position: ", position);
+    }
+    const int64_t start = position;
+    const int64_t end =
+        position + std::max(static_cast<int64_t>(0),
+                            std::min(nbytes, size_ - position));
+    auto iter = std::upper_bound(
+        members_.begin(), members_.end(), position,
+        [](const int64_t value, CompressedMember const& member) {
+          return value < member.decompressed_offset;
+        });
+    for (size_t index = iter - members_.begin() - 1;
+         position < end && index < members_.size(); ++index) {
+      auto const& member = members_[index];
+      if (member.decompressed_size == 0) {
+        continue;
+      }
+      std::shared_ptr<arrow::Buffer> content;
+      ARROW_ASSIGN_OR_RAISE(content, getMember(index));
+      int64_t begin = position - member.decompressed_offset;
+      int64_t length =
+          std::min(end - position, member.decompressed_size - begin);
+      memcpy(out, content->data() + begin, length);
+      out = static_cast<uint8_t*>(out) + length;
+      position += length;
+    }
+    return position - start;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(
+      int64_t position, int64_t nbytes) override {
+    nbytes = std::max(static_cast<int64_t>(0),
+                      std::min(nbytes, size_ - position));
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::ResizableBuffer> buffer,
+                          arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(int64_t bytes_read,
+                          ReadAt(position, nbytes, buffer->mutable_data()));
+    ARROW_RETURN_NOT_OK(buffer->Resize(bytes_read, false));
+    return buffer;
+  }
+
+ private:
+  using future_t = std::shared_future<std::shared_ptr<arrow::Buffer>>;
+
+  void clearCache() {
+    // waits for the inflight decompression
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    lru_.clear();
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> getMember(const size_t index) {
+    future_t future;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t next = index;
+           next < std::min(members_.size(), index + readahead_ + 1); ++next) {
+        if (cache_.find(next) == cache_.end()) {
+          cache_.emplace(next, std::async(std::launch::async, [this, next]() {
+                                 return decompressMember(next);
+                               }).share());
+          lru_.push_front(next);
+        }
+      }
+      future = cache_[index];
+      lru_.remove(index);
+      lru_.push_front(index);
+      // evicts the least recently used members that have been decompressed
+      for (auto iter = lru_.end();
+           cache_.size() > capacity_ && iter != lru_.begin();) {
+        --iter;
+        auto& cached = cache_[*iter];
+        if (*iter != index && cached.wait_for(std::chrono::seconds(0)) ==
+                                  std::future_status::ready) {
+          cache_.erase(*iter);
+          iter = lru_.erase(iter);
+        }
+      }
+    }
+    std::shared_ptr<arrow::Buffer> content = future.get();
+    if (content == nullptr) {
+      return arrow::Status::IOError("Failed to decompress the member at ",
+                                    members_[index].offset);
+    }
+    return content;
+  }
+
+  std::shared_ptr<arrow::Buffer> decompressMember(const size_t index) {
+    auto const& member = members_[index];
+    auto compressed = file_->ReadAt(member.offset, member.size);
+    auto buffer = arrow::AllocateBuffer(member.decompressed_size);
+    if (!compressed.ok() || !buffer.ok()) {
+      return nullptr;
+    }
+    std::shared_ptr<arrow::Buffer> content = std::move(buffer).ValueOrDie();
+    int64_t decompressed_size = 0;
+    Status status = DecompressChunk(
+        compression_, compressed.ValueOrDie()->data(), member.size,
+        content->mutable_data(), content->size(), &decompressed_size);
+    if (!status.ok() || decompressed_size != member.decompressed_size) {
+      LOG(ERROR) << "Failed to decompress the member at " << member.offset
+                 << ": " << status;
+      return nullptr;
+    }
+    return content;
+  }
+
+  const arrow::Compression::type compression_;
+  std::shared_ptr<arrow::io::RandomAccessFile> file_;
+  const std::vector<CompressedMember> members_;
+  const size_t readahead_, capacity_;
+  int64_t size_ = 0, position_ = 0;
+  bool closed_ = false;
+
+  std::mutex mutex_;
+  std::list<size_t> lru_;
+  std::unordered_map<size_t, future_t> cache_;
+};
+
+/**
+ * Serves the decompressed content of a compressed input that cannot be split
+ * into members (e.g., a plain gzip file) as a random access file, by
+ * decompressing it as a stream.
+ *
+ * Only the latest piece (with a bounded tail of the previous one for short
+ * backward seeks) is kept in memory, reading before that restarts the stream
+ * from the beginning. The size is counted by a separate pass on the first
+ * request, which is only needed by partial reads.
+ */
+class StreamingDecompressedFile : public arrow::io::RandomAccessFile {
+ public:
+  StreamingDecompressedFile(const arrow::Compression::type compression,
+                            const std::shared_ptr<arrow::fs::FileSystem>& fs,
+                            const std::string& location)
+      : compression_(compression), fs_(fs), location_(location) {}
+
+  arrow::Status Close() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    piece_ = nullptr;
+    if (stream_) {
+      auto stream = std::move(stream_);
+      return stream->Close();
+    }
+    return arrow::Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  arrow::Result<int64_t> Tell() const override { return position_; }
+
+  arrow::Status Seek(int64_t position) override {
+    if (position < 0) {
+      return arrow::Status::IOError("Invalid seek position: ", position);
+    }
+    position_ = position;
+    return arrow::Status::OK();
+  }
+
+  arrow::Result<int64_t> GetSize() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size_ < 0) {
+      std::shared_ptr<arrow::io::InputStream> stream;
+      ARROW_ASSIGN_OR_RAISE(stream, openStream());
+      int64_t size = 0;
+      std::vector<uint8_t> scratch(kPieceSize);
+      while (true) {
+        ARROW_ASSIGN_OR_RAISE(int64_t bytes_read,
+                              stream->Read(kPieceSize, scratch.data()));
+        if (bytes_read == 0) {
+          break;
+        }
+        size += bytes_read;
+      }
+      ARROW_RETURN_NOT_OK(stream->Close());
+      size_ = size;
+    }
+    return size_;
+  }
+
+  arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    ARROW_ASSIGN_OR_RAISE(int64_t bytes_read, ReadAt(position_, nbytes, out));
+    position_ += bytes_read;
+    return bytes_read;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+    position_ += buffer->size();
+    return buffer;
+  }
+
+  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes,
+                                void* out) override {
+    if (position < 0 || nbytes < 0) {
+      return arrow::Status::IOError("Invalid read position: ", position);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stream_ == nullptr || position < piece_offset_) {
+      ARROW_RETURN_NOT_OK(restart());
+    }
+    const int64_t start = position;
+    while (nbytes > 0) {
+      const int64_t piece_end =
+          piece_offset_ + (piece_ == nullptr ? 0 : piece_->size());
+      if (position < piece_end) {
+        int64_t length = std::min(nbytes, piece_end - position);
+        memcpy(out, piece_->data() + (position - piece_offset_), length);
+        out = static_cast<uint8_t*>(out) + length;
+        position += length;
+        nbytes -= length;
+      } else if (finished_) {
+        break;
+      } else {
+        ARROW_RETURN_NOT_OK(advance());
+      }
+    }
+    return position - start;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(
+      int64_t position, int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::ResizableBuffer> buffer,
+                          arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(int64_t bytes_read,
+                          ReadAt(position, nbytes, buffer->mutable_data()));
+    ARROW_RETURN_NOT_OK(buffer->Resize(bytes_read, false));
+    return buffer;
+  }
+
+ private:
+  static constexpr int64_t kPieceSize = 4 * 1024 * 1024;
+  static constexpr int64_t kLookbehindSize = 1024 * 1024;
+
+  arrow::Result<std::shared_ptr<arrow::io::InputStream>> openStream() {
+    if (codec_ == nullptr) {
+      ARROW_ASSIGN_OR_RAISE(codec_, arrow::util::Codec::Create(compression_));
+    }
+    std::shared_ptr<arrow::io::InputStream> raw;
+    ARROW_ASSIGN_OR_RAISE(raw, fs_->OpenInputStream(location_));
+    std::shared_ptr<arrow::io::CompressedInputStream> stream;
+    ARROW_ASSIGN_OR_RAISE(
+        stream, arrow::io::CompressedInputStream::Make(codec_.get(), raw));
+    return stream;
+  }
+
+  // requires `mutex_`
+  arrow::Status restart() {
+    if (stream_) {
+      ARROW_RETURN_NOT_OK(stream_->Close());
+    }
+    ARROW_ASSIGN_OR_RAISE(stream_, openStream());
+    piece_ = nullptr;
+    piece_offset_ = 0;
+    finished_ = false;
+    return arrow::Status::OK();
+  }
+
+  // requires `mutex_`, decompresses the next piece and keeps the tail of the
+  // current one
+  arrow::Status advance() {
+    const int64_t piece_size = piece_ == nullptr ? 0 : piece_->size();
+    const int64_t tail = std::min(kLookbehindSize, piece_size);
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::ResizableBuffer> piece,
+                          arrow::AllocateResizableBuffer(tail + kPieceSize));
+    if (tail > 0) {
+      memcpy(piece->mutable_data(), piece_->data() + piece_size - tail, tail);
+    }
+    ARROW_ASSIGN_OR_RAISE(
+        int64_t bytes_read,
+        stream_->Read(kPieceSize, piece->mutable_data() + tail));
+    ARROW_RETURN_NOT_OK(piece->Resize(tail + bytes_read, false));
+    piece_offset_ += piece_size - tail;
+    piece_ = std::move(piece);
+    if (bytes_read == 0) {
+      finished_ = true;
+      size_ = piece_offset_ + piece_->size();
+    }
+    return arrow::Status::OK();
+  }
+
+  const arrow::Compression::type compression_;
+  std::shared_ptr<arrow::fs::FileSystem> fs_;
+  const std::string location_;
+  std::unique_ptr<arrow::util::Codec> codec_;
+  int64_t size_ = -1, position_ = 0;
+  bool closed_ = false;
+
+  std::mutex mutex_;
+  std::shared_ptr<arrow::io::InputStream> stream_;
+  std::shared_ptr<arrow::Buffer> piece_;
+  int64_t piece_offset_ = 0;
+  bool finished_ = false;
+};
+
+}  // namespace
 LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
     : location_(location),
       header_row_(false),
@@ -48,6 +843,7 @@ LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
   // process the args
   //
   // TODO: tidy with netlib for url parsing.
+  bool compression_specified = false;
   size_t arg_pos = location.find_first_of('#');
   if (arg_pos != std::string::npos) {
     // process arguments
@@ -89,6 +885,19 @@ LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
         meta_.emplace("block_size", kv_pair[1]);
       } else if (kv_pair[0] == "consolidate") {
         meta_.emplace("consolidate", kv_pair[1]);
+      } else if (kv_pair[0] == "compression") {
+        if (kv_pair.size() > 1 &&
+            ParseCompressionType(kv_pair[1], compression_)) {
+          compression_specified = true;
+          meta_.emplace("compression", kv_pair[1]);
+        } else {
+          LOG(WARNING) << "Unsupported compression type: " << iter;
+        }
+      } else if (kv_pair[0] == "decompression_threads") {
+        if (kv_pair.size() > 1) {
+          decompression_threads_ = std::atoi(kv_pair[1].c_str());
+          meta_.emplace("decompression_threads", kv_pair[1]);
+        }
       } else if (kv_pair.size() > 1) {
         meta_.emplace(kv_pair[0], kv_pair[1]);
       }
@@ -129,6 +938,10 @@ LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
   };
   location_ = urlDecode(location_);
 #endif
+
+  if (!compression_specified) {
+    compression_ = CompressionTypeFromSuffix(location_);
+  }
 }
 
 LocalIOAdaptor::~LocalIOAdaptor() {
@@ -162,7 +975,11 @@ Status LocalIOAdaptor::Open(const char* mode) {
     }
     return Status::OK();
   } else {
-    RETURN_ON_ARROW_ERROR_AND_ASSIGN(ifp_, fs_->OpenInputFile(location_));
+    if (compression_ != arrow::Compression::UNCOMPRESSED) {
+      RETURN_ON_ERROR(openCompressedInput());
+    } else {
+      RETURN_ON_ARROW_ERROR_AND_ASSIGN(ifp_, fs_->OpenInputFile(location_));
+    }
 
     // check the partial read flag
     if (enable_partial_read_) {
@@ -178,6 +995,102 @@ Status LocalIOAdaptor::Open(const char* mode) {
   }
 }
 
+Status LocalIOAdaptor::openCompressedInput() {
+  double start = GetCurrentTime();
+  std::shared_ptr<arrow::io::RandomAccessFile> file;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(file, fs_->OpenInputFile(location_));
+  int64_t size = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(size, file->GetSize());
+  size_t concurrency = decompression_threads_ > 0
+                           ? decompression_threads_
+                           : std::thread::hardware_concurrency();
+  concurrency = std::max(concurrency, static_cast<size_t>(1));
+
+  // locate the independently decompressible members
+  std::vector<CompressedMember> members;
+  WindowedReader reader(file, size);
+  bool splittable = false;
+  switch (compression_) {
+  case arrow::Compression::GZIP: {
+    // the index may live on remote filesystems as well
+    auto index_info = fs_->GetFileInfo(location_ + ".gzi");
+    if (index_info.ok() &&
+        index_info.ValueOrDie().type() == arrow::fs::FileType::File) {
+      RETURN_ON_ERROR(ReadGzipIndex(fs_, location_ + ".gzi", size, members));
+      splittable = true;
+    } else {
+      splittable = SplitGzipMembers(reader, members);
+    }
+  } break;
+  case arrow::Compression::ZSTD: {
+    splittable = SplitZstdFrames(reader, members);
+  } break;
+  case arrow::Compression::BZ2: {
+    splittable = SplitBzip2Streams(reader, members);
+  } break;
+  default:
+    break;
+  }
+  RETURN_ON_ERROR(reader.status());
+
+  // the members without a recorded decompressed size (e.g., bzip2 streams)
+  // would have to be decompressed once more to count the size, thus only a
+  // single one (i.e., the last entry of a ".gzi" index) is counted, and the
+  // others are streamed as a whole
+  size_t unknown_members = 0;
+  for (auto const& member : members) {
+    unknown_members += member.decompressed_size < 0 ? 1 : 0;
+  }
+  splittable &= members.size() > 1 && unknown_members <= 1;
+  for (auto& member : members) {
+    if (!splittable || member.decompressed_size >= 0) {
+      continue;
+    }
+    std::shared_ptr<arrow::Buffer> compressed;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(compressed,
+                                     file->ReadAt(member.offset, member.size));
+    Status status = DecompressChunk(compression_, compressed->data(),
+                                    member.size, nullptr, 0,
+                                    &member.decompressed_size);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to split '" << location_
+                   << "' into members, fallback to streaming: " << status;
+      splittable = false;
+    }
+  }
+
+  if (!splittable) {
+    ifp_ = std::make_shared<StreamingDecompressedFile>(compression_, fs_,
+                                                       location_);
+    RETURN_ON_ARROW_ERROR(file->Close());
+    VLOG(2) << "[file-" << location_ << "] streams " << size
+            << " bytes, uses " << (GetCurrentTime() - start) << " seconds";
+    return Status::OK();
+  }
+
+  static const int64_t min_chunk_size = 256 * 1024;
+  static const int64_t max_chunk_size = 4 * 1024 * 1024;
+  members = CoalesceMembers(
+      members,
+      std::min(max_chunk_size,
+               std::max(min_chunk_size,
+                        size / static_cast<int64_t>(concurrency * 4))));
+
+  int64_t decompressed_size = 0;
+  for (auto& member : members) {
+    member.decompressed_offset = decompressed_size;
+    decompressed_size += member.decompressed_size;
+  }
+  size_t member_num = members.size();
+  ifp_ = std::make_shared<DecompressedFile>(compression_, file,
+                                            std::move(members), concurrency);
+
+  VLOG(2) << "[file-" << location_ << "] indexed " << size << " bytes ("
+          << decompressed_size << " bytes decompressed) as " << member_num
+          << " members, uses " << (GetCurrentTime() - start) << " seconds";
+  return Status::OK();
+}
+
 Status LocalIOAdaptor::Configure(const std::string& key,
                                  const std::string& value) {
   return Status::OK();
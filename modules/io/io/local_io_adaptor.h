@@ -25,6 +25,7 @@ limitations under the License.
 #include "arrow/api.h"
 #include "arrow/filesystem/api.h"
 #include "arrow/io/api.h"
+#include "arrow/util/compression.h"
 
 #include "common/util/functions.h"
 #include "common/util/status.h"
@@ -42,6 +43,23 @@ enum FileLocation {
   kFileLocationEnd = 2,
 };
 
+/**
+ * @brief LocalIOAdaptor reads and writes files on local disk, HDFS and S3.
+ *
+ * Compressed inputs (gzip, zstd and bz2) are decompressed transparently when
+ * reading. The codec is selected by the file suffix (".gz", ".zst", ".bz2"),
+ * or by the "compression" option, e.g.,
+ *
+ *    file_path#compression=gzip&decompression_threads=8
+ *
+ * The input is split into independent members (BGZF blocks, or the offsets
+ * in a ".gzi" index side-file for gzip, frames for zstd and streams for bz2)
+ * and served as a random access file to the line and table readers: only
+ * the members that overlap with the requested range are decompressed (in
+ * parallel with readahead), and a bounded number of them are cached. Inputs
+ * that cannot be split (e.g., plain gzip files, or bzip2 streams that don't
+ * record their decompressed size) are decompressed as a stream instead.
+ */
 class LocalIOAdaptor : public IIOAdaptor {
  public:
   /** Constructor.
@@ -120,6 +138,7 @@ class LocalIOAdaptor : public IIOAdaptor {
   int64_t tell();
   Status seek(const int64_t offset, const FileLocation seek_from);
   Status setPartialReadImpl();
+  Status openCompressedInput();
   int64_t getDistanceToLineBreak(const int index);
 
   std::string trimBOM(const std::string& line);
@@ -134,6 +153,8 @@ class LocalIOAdaptor : public IIOAdaptor {
   std::vector<std::string> columns_;
   std::vector<std::string> column_types_;
   char delimiter_ = ',';
+  arrow::Compression::type compression_ = arrow::Compression::UNCOMPRESSED;
+  int decompression_threads_ = 0;
   bool header_row_ = false;
   std::string header_line_ = "";
   bool include_all_columns_ = false;
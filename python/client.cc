@@ -180,6 +180,12 @@ void bind_client(py::module& mod) {
           "rpc_connections",
           [](InstanceStatus* status) { return status->rpc_connections; },
           doc::InstanceStatus_rpc_connections)
+      .def_property_readonly(
+          "allocator_stats",
+          [](InstanceStatus* status) -> py::object {
+            return detail::from_json(status->allocator_stats);
+          },
+          doc::InstanceStatus_allocator_stats)
       .def("__repr__",
            [](InstanceStatus* status) {
              std::stringstream ss;
@@ -789,6 +795,27 @@ void bind_client(py::module& mod) {
             }
           },
           doc::IPCClient_find_shared_memory)
+      .def(
+          "checkpoint",
+          [](Client* self, const ObjectIDWrapper object_id,
+             std::string const& path, const bool compress,
+             const size_t concurrency) {
+            throw_on_error(
+                self->Checkpoint(object_id, path, compress, concurrency));
+          },
+          "object_id"_a, "path"_a, py::arg("compress") = false,
+          py::arg("concurrency") = 0, py::call_guard<py::gil_scoped_release>(),
+          doc::IPCClient_checkpoint)
+      .def(
+          "restore",
+          [](Client* self, std::string const& path,
+             const size_t concurrency) -> ObjectIDWrapper {
+            ObjectID object_id = InvalidObjectID();
+            throw_on_error(self->Restore(path, object_id, concurrency));
+            return object_id;
+          },
+          "path"_a, py::arg("concurrency") = 0,
+          py::call_guard<py::gil_scoped_release>(), doc::IPCClient_restore)
       .def(
           "close",
           [](Client* self) {
@@ -532,6 +532,12 @@ const char* InstanceStatus_rpc_connections = R"doc(
 Report number of alive RPC connections on the current vineyardd instance.
 )doc";
 
+const char* InstanceStatus_allocator_stats = R"doc(
+Report the statistics of the shared memory allocator of current vineyardd
+instance as a dict, including the used and free bytes, the largest free extent,
+the histogram of free extents and the block counts per size class.
+)doc";
+
 const char* ClientBase = R"doc(
 Base class for vineyard object builders.
 )doc";
@@ -1064,6 +1070,40 @@ Returns:
     ObjectID
 )doc";
 
+const char* IPCClient_checkpoint = R"doc(
+.. method:: checkpoint(object_id: ObjectID, path: str, compress: bool = False, concurrency: int = 0) -> None
+    :noindex:
+
+Checkpoint the object and all its blobs into a single container file, the
+blobs are written in parallel as aligned extents.
+
+Parameters:
+    object_id: ObjectID
+        The object to checkpoint.
+    path: str
+        The container file to write.
+    compress: bool
+        Whether to compress the extents with zstd, defaults to False.
+    concurrency: int
+        The number of IO threads, 0 means the number of hardware threads.
+)doc";
+
+const char* IPCClient_restore = R"doc(
+.. method:: restore(path: str, concurrency: int = 0) -> ObjectID
+    :noindex:
+
+Restore an object from the container file written by :meth:`checkpoint`.
+
+Parameters:
+    path: str
+        The container file to read.
+    concurrency: int
+        The number of IO threads, 0 means the number of hardware threads.
+
+Returns:
+    ObjectID: The id of the restored object.
+)doc";
+
 const char* IPCClient_close = R"doc(
 Close the client.
 )doc";
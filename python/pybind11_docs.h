@@ -88,6 +88,7 @@ extern const char* InstanceStatus_memory_limit;
 extern const char* InstanceStatus_deferred_requests;
 extern const char* InstanceStatus_ipc_connections;
 extern const char* InstanceStatus_rpc_connections;
+extern const char* InstanceStatus_allocator_stats;
 
 extern const char* ClientBase;
 extern const char* ClientBase_create_metadata;
@@ -127,6 +128,8 @@ extern const char* IPCClient_list_metadatas;
 extern const char* IPCClient_allocated_size;
 extern const char* IPCClient_is_shared_memory;
 extern const char* IPCClient_find_shared_memory;
+extern const char* IPCClient_checkpoint;
+extern const char* IPCClient_restore;
 extern const char* IPCClient_close;
 
 extern const char* RPCClient;
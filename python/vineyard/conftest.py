@@ -45,6 +45,14 @@ def pytest_addoption(parser):
         help='Location of vineyard IPC sockets, separated by ","',
     )
 
+    parser.addoption(
+        "--vineyard-tcp-ipc-sockets",
+        action="store",
+        default=None,
+        help='Location of vineyard IPC sockets of instances that migrate objects '
+        'through TCP, separated by ","',
+    )
+
     parser.addoption(
         "--vineyard-endpoints",
         action="store",
@@ -118,6 +126,13 @@ def vineyard_ipc_sockets(request):
     return None
 
 
+@pytest.fixture(scope='session')
+def vineyard_tcp_ipc_sockets(request):
+    if request.config.option.vineyard_tcp_ipc_sockets:
+        return request.config.option.vineyard_tcp_ipc_sockets.split(',')
+    return None
+
+
 @pytest.fixture(scope='session')
 def vineyard_endpoints(request):
     if request.config.option.vineyard_endpoints:
@@ -31,6 +31,25 @@ import vineyard
 from vineyard.core import context
 from vineyard.data.dataframe import make_global_dataframe
 from vineyard.data.tensor import make_global_tensor
+from vineyard.data.utils import from_json
+from vineyard.data.utils import normalize_dtype
+
+# the dask clients of schedulers, see `_dask_client()`
+_dask_clients = {}
+
+
+def _dask_client(dask_scheduler):
+    """Returns the dask client connected to the scheduler, which is set as the
+    default client when created to enforce the distributed scheduling.
+
+    The clients are kept alive here, as the collections returned by resolvers
+    are computed later, after the resolvers return.
+    """
+    dask_client = _dask_clients.get(dask_scheduler, None)
+    if dask_client is None or dask_client.status in ('closing', 'closed'):
+        dask_client = Client(dask_scheduler)
+        _dask_clients[dask_scheduler] = dask_client
+    return dask_client
 
 
 def dask_array_builder(client, value, builder, **kw):  # pylint: disable=unused-argument
@@ -40,8 +59,10 @@ def dask_array_builder(client, value, builder, **kw):  # pylint: disable=unused-
         client.persist(obj_id)
         return np.array([[int(obj_id)]])
 
-    _ = Client(kw['dask_scheduler'])  # enforce distributed scheduling
-    blocks = value.map_blocks(put_partition, dtype=int).compute().flatten()
+    dask_client = _dask_client(kw['dask_scheduler'])
+    blocks = dask_client.compute(
+        value.map_blocks(put_partition, dtype=int), sync=True
+    ).flatten()
     return make_global_tensor(client, blocks)
 
 
@@ -54,50 +75,94 @@ def dask_dataframe_builder(
         client.persist(obj_id)
         return pd.DataFrame([{'no': partition_info['number'], 'id': int(obj_id)}])
 
-    _ = Client(kw['dask_scheduler'])  # enforce distributed scheduling
-    res = value.map_partitions(put_partition, meta={'no': int, 'id': int}).compute()
+    dask_client = _dask_client(kw['dask_scheduler'])
+    res = dask_client.compute(
+        value.map_partitions(put_partition, meta={'no': int, 'id': int}), sync=True
+    )
     res = res.set_index('no')
     blocks = [res.loc[i] for i in range(len(res))]
     return make_global_dataframe(client, blocks)
 
 
-def dask_array_resolver(obj, resolver, **kw):  # pylint: disable=unused-argument
+def _resolve_partitions(meta, dask_workers):
+    """Build a delayed loader for every partition of the global object, which is
+    pinned to the dask worker co-located with the vineyard instance where the
+    partition lives.
+
+    Nothing is submitted to the cluster until the collection built from the
+    loaders is computed or persisted.
+    """
+
     def get_partition(obj_id):
         client = vineyard.connect()
-        np_value = client.get(obj_id)
-        return da.from_array(np_value)
+        return client.get(obj_id)
 
-    meta = obj.meta
     num = int(meta['partitions_-size'])
-    dask_client = Client(kw['dask_scheduler'])
-    futures = []
-    indices = []
-    with_index = True
+    partitions, loaders = [], []
     for i in range(num):
-        ts = meta.get_member('partitions_-%d' % i)
-        instance_id = int(ts.meta['instance_id'])
+        partition = meta.get_member('partitions_-%d' % i).meta
+        instance_id = int(partition['instance_id'])
+        partitions.append(partition)
+        # we require the 1-on-1 alignment of vineyard instances and dask workers.
+        # vineyard_sockets maps vineyard instance_ids into ipc_sockets, while
+        # dask_workers maps vineyard instance_ids into names of dask workers.
+        with dask.annotate(
+            workers=[dask_workers[instance_id]], allow_other_workers=False
+        ):
+            loaders.append(
+                dask.delayed(get_partition, pure=True)(
+                    partition.id,
+                    dask_key_name='vineyard-partition-%r' % partition.id,
+                )
+            )
+    return partitions, loaders
+
+
+def _empty_dataframe(partition):
+    """The empty frame that describes the schema of a vineyard::DataFrame, which
+    is built from the metadata without loading the partition.
+    """
+    columns = {}
+    for i in range(int(partition['__values_-size'])):
+        name = from_json(partition['__values_-key-%d' % i])
+        column = partition.get_member('__values_-value-%d' % i).meta
+        if 'value_type_meta_' in column:
+            dtype = np.dtype(column['value_type_meta_'])
+        elif 'value_type_' in column:
+            dtype = normalize_dtype(column['value_type_'])
+        else:
+            dtype = np.dtype('object')
+        columns[name] = pd.Series([], dtype=dtype)
+    return pd.DataFrame(columns, columns=list(columns.keys()))
+
 
-        partition_index = json.loads(ts.meta['partition_index_'])
+def dask_array_resolver(obj, resolver, **kw):  # pylint: disable=unused-argument
+    meta = obj.meta
+    _dask_client(kw['dask_scheduler'])
+    partitions, loaders = _resolve_partitions(meta, kw['dask_workers'])
+
+    arrays = []
+    indices = []
+    with_index = True
+    for i, (partition, loader) in enumerate(zip(partitions, loaders)):
+        partition_index = json.loads(partition['partition_index_'])
         if partition_index:
             indices.append((partition_index[0], partition_index[1], i))
         else:
             with_index = False
 
-        futures.append(
-            # we require the 1-on-1 alignment of vineyard instances and dask workers.
-            # vineyard_sockets maps vineyard instance_ids into ipc_sockets, while
-            # dask_workers maps vineyard instance_ids into names of dask workers.
-            dask_client.submit(
-                get_partition, ts.meta.id, workers={kw['dask_workers'][instance_id]}
-            )
-        )
+        if 'value_type_meta_' in partition:
+            dtype = np.dtype(partition['value_type_meta_'])
+        else:
+            dtype = np.dtype(partition['value_type_'])
+        shape = tuple(json.loads(partition['shape_']))
+        arrays.append(da.from_delayed(loader, shape=shape, dtype=dtype))
 
-    arrays = dask_client.gather(futures)
     if with_index:
         indices = list(sorted(indices))
         nx = indices[-1][0] + 1
         ny = indices[-1][1] + 1
-        assert nx * ny == num
+        assert nx * ny == len(arrays)
         rows = []
         for i in range(nx):
             cols = []
@@ -110,29 +175,12 @@ def dask_array_resolver(obj, resolver, **kw):  # pylint: disable=unused-argument
 
 
 def dask_dataframe_resolver(obj, resolver, **kw):  # pylint: disable=unused-argument
-    def get_partition(obj_id):
-        client = vineyard.connect()
-        df = client.get(obj_id)
-        return dd.from_pandas(df, npartitions=1)
-
     meta = obj.meta
-    num = int(meta['partitions_-size'])
-    dask_client = Client(kw['dask_scheduler'])
-    futures = []
-    for i in range(num):
-        df = meta.get_member('partitions_-%d' % i)
-        instance_id = int(df.meta['instance_id'])
-        futures.append(
-            # we require the 1-on-1 alignment of vineyard instances and dask workers.
-            # vineyard_sockets maps vineyard instance_ids into ipc_sockets, while
-            # dask_workers maps vineyard instance_ids into names of dask workers.
-            dask_client.submit(
-                get_partition, df.meta.id, workers={kw['dask_workers'][instance_id]}
-            )
-        )
-
-    dfs = dask_client.gather(futures)
-    return dd.concat(dfs, axis=0)
+    _dask_client(kw['dask_scheduler'])
+    partitions, loaders = _resolve_partitions(meta, kw['dask_workers'])
+    return dd.from_delayed(
+        loaders, meta=_empty_dataframe(partitions[0]), verify_meta=False
+    )
 
 
 def register_dask_types(builder_ctx=None, resolver_ctx=None):
@@ -24,6 +24,8 @@ import pandas as pd
 
 import dask.array as da
 import dask.dataframe as dd
+from dask.distributed import Client  # pylint: disable=no-name-in-module
+from dask.distributed import get_task_stream  # pylint: disable=no-name-in-module
 
 import pytest
 
@@ -134,6 +136,44 @@ def test_dask_dataframe_resolver(dask_cluster):
     assert ddf.sum().sum().compute() == 60
 
 
+def test_dask_resolver_locality(dask_cluster):
+    clients, dask_scheduler, dask_workers = dask_cluster
+
+    chunks, locations = [], {}
+    for i, client in enumerate(clients):
+        chunk = client.put(pd.DataFrame({'x': [i, i * 2], 'y': [i * 3, i * 4]}))
+        client.persist(chunk)
+        chunks.append(chunk)
+        locations['vineyard-partition-%r' % chunk] = dask_workers[client.instance_id]
+
+    gdf = make_global_dataframe(clients[0], chunks)
+    ddf = clients[0].get(
+        gdf.id, dask_scheduler=dask_scheduler, dask_workers=dask_workers
+    )
+    assert ddf.npartitions == len(clients)
+    assert list(ddf.columns) == ['x', 'y']
+    assert list(ddf.dtypes) == [np.dtype('int64'), np.dtype('int64')]
+
+    # resolving doesn't load any partition
+    dask_client = Client(dask_scheduler)
+    who_has = dask_client.who_has()
+    for key in locations:
+        assert not who_has.get(key)
+
+    # every partition is loaded by the worker co-located with its vineyard instance
+    names = {
+        address: worker['name']
+        for address, worker in dask_client.scheduler_info()['workers'].items()
+    }
+    with get_task_stream(client=dask_client) as stream:
+        assert ddf.sum().sum().compute() == 60
+    loaded = {}
+    for task in stream.data:
+        if task['key'] in locations:
+            loaded[task['key']] = names[task['worker']]
+    assert loaded == locations
+
+
 def test_dask_array_roundtrip(dask_cluster):
     clients, dask_scheduler, dask_workers = dask_cluster
     arr = da.ones((1024, 1024), chunks=(256, 256))
@@ -98,9 +98,8 @@ def tf_create_global_dataframe(
     pass
 
 
-def tf_tensor_resolver(obj):
+def _tensor_columns(obj):
     meta = obj.meta
-    _num = from_json(meta['num'])  # noqa: F841
     data_shape = from_json(meta['data_shape_'])
     label_shape = from_json(meta['label_shape_'])
     data_name = meta['data_type_']
@@ -113,64 +112,134 @@ def tf_tensor_resolver(obj):
     label = np.frombuffer(
         memoryview(obj.member('buffer_label_')), dtype=label_type
     ).reshape(label_shape)
-    data = tf.data.Dataset.from_tensor_slices((data, label))
-    return data
+    return data, label
 
 
-def tf_dataframe_resolver(obj, **kw):
+def _dataframe_columns(obj, **kw):
     with resolver_context(base=default_resolver_context) as resolver:
         df = resolver(obj, **kw)
-    labels = df.pop(kw.get('label', 'label'))
+    label = kw.get('label', 'label')
+    labels = df.pop(label).values if label in df.columns else None
     if 'data' in kw:
-        return tf.data.Dataset.from_tensor_slices(
-            (np.stack(df[kw['data']], axis=0), labels)
-        )
-    return tf.data.Dataset.from_tensor_slices((dict(df), labels))
+        return np.stack(df[kw['data']], axis=0), labels
+    return {name: df[name].values for name in df.columns}, labels
 
 
-def tf_record_batch_resolver(obj, **kw):
+def _record_batch_columns(obj, **kw):
+    """Numpy views over the column buffers of the record batch, only columns
+    with nulls or of non-primitive types are copied.
+    """
     with resolver_context(base=default_resolver_context) as resolver:
-        records = resolver(obj, **kw)
-    records = records.to_pandas()
-    labels = records.pop('label')
-    return tf.data.Dataset.from_tensor_slices((dict(records), labels))
+        batch = resolver(obj, **kw)
+    label = kw.get('label', 'label')
+    features, labels = {}, None
+    for name, column in zip(batch.schema.names, batch.columns):
+        if name == label:
+            labels = column.to_numpy(zero_copy_only=False)
+        else:
+            features[name] = column.to_numpy(zero_copy_only=False)
+    return features, labels
 
 
-def tf_table_resolver(obj, resolver):
+def _partitions(obj):
+    """Flatten the (global) object into the list of its local partitions, at
+    the granularity of tensors, dataframes and record batches.
+    """
     meta = obj.meta
-    batches = []
-    for idx in range(int(meta['__batches_-size'])):
-        batches.append(resolver(obj.member('__batches_-%d' % idx)))
-    tf_data = batches[0]
-    for i in range(1, len(batches)):
-        tf_data = tf_data.concatenate(batches[i])
-    return tf_data
+    if meta.typename == 'vineyard::Table':
+        return [
+            obj.member('partitions_-%d' % index)
+            for index in range(int(meta['batch_num_']))
+        ]
+    if meta.typename in ('vineyard::GlobalTensor', 'vineyard::GlobalDataFrame'):
+        partitions = []
+        for index in range(int(meta['partitions_-size'])):
+            if meta['partitions_-%d' % index].islocal:
+                partitions.extend(_partitions(obj.member('partitions_-%d' % index)))
+        return partitions
+    return [obj]
+
+
+def _partition_columns(obj, **kw):
+    typename = obj.meta.typename
+    if typename == 'vineyard::Tensor':
+        return _tensor_columns(obj)
+    if typename == 'vineyard::RecordBatch':
+        return _record_batch_columns(obj, **kw)
+    return _dataframe_columns(obj, **kw)
+
+
+def _slices(columns):
+    """The (features, labels) pairs, or the features only if the partition
+    has no label column.
+    """
+    features, labels = columns
+    return features if labels is None else (features, labels)
+
+
+def _num_rows(columns):
+    features, labels = columns
+    if labels is not None:
+        return len(labels)
+    if isinstance(features, dict):
+        return len(next(iter(features.values()))) if features else 0
+    return len(features)
+
+
+def _partitions_dataset(partitions, **kw):
+    """Expose the partitions as a single dataset, the rows of each partition
+    are sliced by `from_tensor_slices` and the partitions are visited in order
+    by `choose_from_datasets`, rather than chaining a `concatenate` per
+    partition.
+    """
+    if not partitions:
+        raise ValueError('No local partitions to build the dataset')
+
+    columns = [_partition_columns(partition, **kw) for partition in partitions]
+    if any((labels is None) != (columns[0][1] is None) for _, labels in columns):
+        raise ValueError('The label column is missing in some of the partitions')
+    datasets = [tf.data.Dataset.from_tensor_slices(_slices(c)) for c in columns]
+    if len(datasets) == 1:
+        return datasets[0]
+
+    rows = [_num_rows(c) for c in columns]
+    partition_rows = tf.constant(rows, dtype=tf.int64)
+    choices = tf.data.Dataset.range(len(datasets)).flat_map(
+        lambda index: tf.data.Dataset.from_tensors(index).repeat(
+            partition_rows[index]
+        )
+    )
+    dataset = tf.data.Dataset.choose_from_datasets(datasets, choices)
+    return dataset.apply(tf.data.experimental.assert_cardinality(sum(rows)))
 
 
-def tf_global_tensor_resolver(obj, resolver, **_kw):
-    meta = obj.meta
-    num = int(meta['partitions_-size'])
-    data = []
-    for i in range(num):
-        if meta[f'partitions_-{i}'].islocal:
-            data.append(resolver.run(obj.member(f'partitions_-{i}')))
-    tf_data = data[0]
-    for i in range(1, len(data)):
-        tf_data = tf_data.concatenate(data[i])
-    return tf_data
-
-
-def tf_global_dataframe_resolver(obj, resolver, **kw):
-    meta = obj.meta
-    num = int(meta['partitions_-size'])
-    data = []
-    for i in range(num):
-        if meta[f'partitions_-{i}'].islocal:
-            data.append(resolver(obj.member(f'partitions_-{i}'), **kw))
-    tf_data = data[0]
-    for i in range(1, len(data)):
-        tf_data = tf_data.concatenate(data[i])
-    return tf_data
+def tf_tensor_resolver(obj):
+    return tf.data.Dataset.from_tensor_slices(_slices(_tensor_columns(obj)))
+
+
+def tf_dataframe_resolver(obj, **kw):
+    return tf.data.Dataset.from_tensor_slices(_slices(_dataframe_columns(obj, **kw)))
+
+
+def tf_record_batch_resolver(obj, **kw):
+    return tf.data.Dataset.from_tensor_slices(
+        _slices(_record_batch_columns(obj, **kw))
+    )
+
+
+def tf_table_resolver(obj, **kw):
+    kw.pop('resolver', None)
+    return _partitions_dataset(_partitions(obj), **kw)
+
+
+def tf_global_tensor_resolver(obj, **kw):
+    kw.pop('resolver', None)
+    return _partitions_dataset(_partitions(obj), **kw)
+
+
+def tf_global_dataframe_resolver(obj, **kw):
+    kw.pop('resolver', None)
+    return _partitions_dataset(_partitions(obj), **kw)
 
 
 def register_tensorflow_types(builder_ctx, resolver_ctx):
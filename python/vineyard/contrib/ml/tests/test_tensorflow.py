@@ -29,6 +29,7 @@ from vineyard.conftest import vineyard_rpc_client
 from vineyard.contrib.ml.tensorflow import tensorflow_context
 from vineyard.core.builder import builder_context
 from vineyard.core.resolver import resolver_context
+from vineyard.data.dataframe import make_global_dataframe
 
 tf = lazy_import.lazy_module("tensorflow")
 
@@ -90,6 +91,17 @@ def test_tensorflow_record_batch(vineyard_client):
     assert len(dtrain) == 4
 
 
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_tensorflow_record_batch_without_label(vineyard_client):
+    arrays = [pa.array([1, 2, 3, 4]), pa.array([3.0, 4.0, 5.0, 6.0])]
+    batch = pa.RecordBatch.from_arrays(arrays, ['f0', 'f1'])
+    object_id = vineyard_client.put(pa.Table.from_batches([batch] * 2))
+    dtrain = vineyard_client.get(object_id)
+    assert len(dtrain) == 8
+    for x in dtrain.take(1):
+        assert sorted(x.keys()) == ['f0', 'f1']
+
+
 @pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
 def test_tensorflow_table(vineyard_client):
     arrays = [pa.array([1, 2]), pa.array([0, 1]), pa.array([0.1, 0.2])]
@@ -102,3 +114,46 @@ def test_tensorflow_table(vineyard_client):
         ncols = len(list(x.keys()))
     assert ncols == 2
     assert len(dtrain) == 8
+
+
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_tensorflow_table_values(vineyard_client):
+    batches = [
+        pa.RecordBatch.from_arrays(
+            [
+                pa.array(np.arange(i * 100, (i + 1) * 100)),
+                pa.array(np.arange(i * 100, (i + 1) * 100) % 2),
+            ],
+            ['f0', 'target'],
+        )
+        for i in range(8)
+    ]
+    object_id = vineyard_client.put(pa.Table.from_batches(batches))
+    dtrain = vineyard_client.get(object_id, label='target')
+    assert len(dtrain) == 800
+    features, labels = [], []
+    for x, y in dtrain.as_numpy_iterator():
+        features.append(x['f0'])
+        labels.append(y)
+    assert np.array_equal(features, np.arange(800))
+    assert np.array_equal(labels, np.arange(800) % 2)
+
+
+def test_tensorflow_global_dataframe(vineyard_client):
+    chunks = [
+        pd.DataFrame({'f0': np.arange(i * 100, (i + 1) * 100), 'target': i})
+        for i in range(4)
+    ]
+    meta = make_global_dataframe(
+        vineyard_client, [vineyard_client.put(chunk) for chunk in chunks]
+    )
+    dtrain = vineyard_client.get(meta.id, label='target')
+    # the cardinality is known from the rows of the dataframe chunks
+    assert dtrain.cardinality().numpy() == 400
+    assert len(dtrain) == 400
+    features, labels = [], []
+    for x, y in dtrain.as_numpy_iterator():
+        features.append(x['f0'])
+        labels.append(y)
+    assert np.array_equal(features, np.arange(400))
+    assert np.array_equal(labels, np.arange(400) // 100)
@@ -31,6 +31,7 @@ import pytest_cases
 
 from vineyard.conftest import vineyard_client
 from vineyard.conftest import vineyard_rpc_client
+from vineyard.contrib.ml.torch import VineyardAllocator
 from vineyard.contrib.ml.torch import torch_context
 from vineyard.data.dataframe import NDArrayArray
 
@@ -178,3 +179,44 @@ def test_torch_module(vineyard_client, model):
 
     # check the module's equality
     assert_torch_module_equal(model, result)
+
+
+def test_torch_allocator_tensor(vineyard_client):
+    allocator = VineyardAllocator(vineyard_client)
+    tensor = allocator.empty(5, 2, dtype=torch.float32)
+    tensor.copy_(torch.rand(5, 2))
+    object_id = vineyard_client.put(tensor)
+
+    # the tensor is sealed in place, thus the resolved value aliases it
+    value = vineyard_client.get(object_id)
+    assert value.data_ptr() == tensor.data_ptr()
+    assert torch.equal(value, tensor)
+
+    # putting the resolved tensor back is metadata-only
+    buffer_id = vineyard_client.get_meta(object_id)['buffer_'].id
+    object_id2 = vineyard_client.put(value)
+    assert object_id2 != object_id
+    assert vineyard_client.get_meta(object_id2)['buffer_'].id == buffer_id
+
+
+def test_torch_allocator_module(vineyard_client):
+    allocator = VineyardAllocator(vineyard_client)
+    model = allocator.adopt(Model())
+    object_id = vineyard_client.put(model)
+    value: Dict[str, Any] = vineyard_client.get(object_id)
+
+    for key, tensor in model.state_dict().items():
+        assert value[key].data_ptr() == tensor.data_ptr()
+
+    result = copy.deepcopy(model)
+    result.to(torch.device('meta'))
+    result.load_state_dict(value, assign=True)
+    assert_torch_module_equal(model, result)
+
+    # sealing the state_dict again reuses the blobs
+    meta = vineyard_client.get_meta(object_id)
+    object_id2 = vineyard_client.put(value)
+    meta2 = vineyard_client.get_meta(object_id2)
+    for key in value.keys():
+        key = 'tensor.%s' % key
+        assert meta[key]['buffer_'].id == meta2[key]['buffer_'].id
@@ -22,6 +22,7 @@ import pyarrow as pa
 
 import pytest
 import pytest_cases
+import xgboost as xgb
 
 from vineyard.conftest import vineyard_client
 from vineyard.conftest import vineyard_rpc_client
@@ -98,3 +99,78 @@ def test_table_xgb_resolver(vineyard_client):
     arr = np.array([0, 1, 0, 1, 0, 1])
     assert np.allclose(arr, dtrain.get_label())
     assert dtrain.feature_names == ['f0', 'f2']
+
+
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_record_batch_xgb_resolver_with_nulls(vineyard_client):
+    arrays = [
+        pa.array([1, None, 3, 4]),
+        pa.array([3.0, 4.0, None, 6.0]),
+        pa.array([0, 1, 0, 1]),
+    ]
+    batch = pa.RecordBatch.from_arrays(arrays, ['f0', 'f1', 'target'])
+    object_id = vineyard_client.put(batch)
+    dtrain = vineyard_client.get(object_id, label='target')
+    assert dtrain.num_col() == 2
+    assert dtrain.num_row() == 4
+    assert np.allclose(np.array([0, 1, 0, 1]), dtrain.get_label())
+    # nulls are treated as missing values
+    assert dtrain.num_nonmissing() == 6
+
+
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_table_xgb_resolver_with_nulls(vineyard_client):
+    arrays = [pa.array([1, None]), pa.array([0, 1]), pa.array([None, 0.2])]
+    batch = pa.RecordBatch.from_arrays(arrays, ['f0', 'label', 'f2'])
+    table = pa.Table.from_batches([batch] * 3)
+    object_id = vineyard_client.put(table)
+    dtrain = vineyard_client.get(object_id, label='label')
+    assert dtrain.num_col() == 2
+    assert dtrain.num_row() == 6
+    assert dtrain.num_nonmissing() == 6
+    assert dtrain.feature_names == ['f0', 'f2']
+
+
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_record_batch_xgb_resolver_uint64(vineyard_client):
+    arrays = [
+        pa.array([1, 2, 3, 2**33], type=pa.uint64()),
+        pa.array([1, None, 3, 4], type=pa.uint64()),
+        pa.array([0, 1, 0, 1], type=pa.uint64()),
+    ]
+    batch = pa.RecordBatch.from_arrays(arrays, ['f0', 'f1', 'target'])
+    object_id = vineyard_client.put(batch)
+    dtrain = vineyard_client.get(object_id, label='target')
+    assert dtrain.num_col() == 2
+    assert dtrain.num_row() == 4
+    assert dtrain.num_nonmissing() == 7
+    assert np.allclose(np.array([0, 1, 0, 1]), dtrain.get_label())
+    if hasattr(dtrain, 'get_data'):
+        data = dtrain.get_data().toarray()
+        assert np.allclose(data[:, 0], np.array([1, 2, 3, 2**33]))
+
+
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_pandas_dataframe_xgb_resolver_kwargs(vineyard_client):
+    df = pd.DataFrame({'a': [1, 2, 3, 4], 'b': [5, 6, 7, 8], 'c': [1.0, 2.0, 3.0, 4.0]})
+    object_id = vineyard_client.put(df)
+    dtrain = vineyard_client.get(object_id, label='a', missing=5.0)
+    assert dtrain.num_row() == 4
+    assert dtrain.num_nonmissing() == 7
+
+
+@pytest.mark.skipif(
+    not hasattr(xgb, 'QuantileDMatrix'), reason='requires xgboost >= 1.7'
+)
+@pytest_cases.parametrize("vineyard_client", [vineyard_client, vineyard_rpc_client])
+def test_table_xgb_resolver_quantile(vineyard_client):
+    arrays = [pa.array([1, None]), pa.array([0, 1]), pa.array([None, 0.2])]
+    batch = pa.RecordBatch.from_arrays(arrays, ['f0', 'label', 'f2'])
+    table = pa.Table.from_batches([batch] * 3)
+    object_id = vineyard_client.put(table)
+    dtrain = vineyard_client.get(object_id, label='label', quantile=True)
+    assert isinstance(dtrain, xgb.QuantileDMatrix)
+    assert dtrain.num_col() == 2
+    assert dtrain.num_row() == 6
+    assert np.allclose(np.array([0, 1, 0, 1, 0, 1]), dtrain.get_label())
+    assert dtrain.feature_names == ['f0', 'f2']
@@ -17,8 +17,10 @@
 #
 
 import contextlib
+import itertools
 import time
 import warnings
+import weakref
 from collections import OrderedDict
 from typing import Iterable
 from typing import Iterator
@@ -32,6 +34,8 @@ import pyarrow as pa
 import lazy_import
 
 import vineyard
+from vineyard._C import Blob
+from vineyard._C import BlobBuilder
 from vineyard._C import ObjectID
 from vineyard._C import ObjectMeta
 from vineyard._C import RemoteBlobBuilder
@@ -73,7 +77,112 @@ class WholeBatchSampler(torch.utils.data.Sampler[List[int]]):
         return 1
 
 
+class _VineyardStorage:
+    '''A tensor storage that lives inside a (sealed or unsealed) vineyard blob.'''
+
+    __slots__ = ['instance_id', 'blob', 'nbytes']
+
+    def __init__(self, instance_id, blob, nbytes):
+        self.instance_id = instance_id
+        self.blob = blob
+        self.nbytes = nbytes
+
+
+# tensor storages that alias vineyard blobs, keyed by the data address, the
+# entries are evicted once the backing numpy array is garbage collected.
+_vineyard_storages = dict()
+
+
+def _forget_vineyard_storage(address, storage):
+    if _vineyard_storages.get(address) is storage:
+        del _vineyard_storages[address]
+
+
+def _track_vineyard_storage(array: np.ndarray, instance_id, blob):
+    address = array.__array_interface__['data'][0]
+    storage = _VineyardStorage(instance_id, blob, array.nbytes)
+    _vineyard_storages[address] = storage
+    weakref.finalize(array, _forget_vineyard_storage, address, storage)
+
+
+def _seal_vineyard_storage(client, tensor) -> Union[Blob, None]:
+    '''Returns the sealed blob that backs the tensor if the whole tensor lives
+    in a blob of the instance that the client connects to, sealing the blob
+    first if it is still under construction. Returns None otherwise.
+    '''
+    if tensor.device.type != 'cpu' or not tensor.is_contiguous():
+        return None
+    storage = _vineyard_storages.get(tensor.data_ptr(), None)
+    if storage is None or storage.instance_id != client.instance_id:
+        return None
+    if storage.nbytes != tensor.numel() * tensor.element_size():
+        return None
+    if isinstance(storage.blob, BlobBuilder):
+        storage.blob = storage.blob.seal(client)
+    return storage.blob
+
+
+class VineyardAllocator:
+    '''Allocates CPU tensors directly inside vineyard blobs.
+
+    Putting such tensors (or modules and state_dicts made of them) to vineyard
+    seals the backing blobs in place and creates the metadata only, without
+    copying the payload. Note that the tensors still alias the blobs after
+    being put, thus in-place updates afterwards are visible to the readers.
+
+    e.g.,
+
+    .. code:: python
+
+        allocator = VineyardAllocator(client)
+        model = allocator.adopt(Model())
+        ... # training
+        object_id = client.put(model)
+    '''
+
+    def __init__(self, client: Client):
+        if not client.is_ipc:
+            raise ValueError('Vineyard allocator requires an IPC client')
+        self._client = client
+
+    def empty(self, *size, dtype=None) -> "torch.Tensor":
+        if len(size) == 1 and isinstance(size[0], (tuple, list, torch.Size)):
+            size = size[0]
+        shape = tuple(int(dim) for dim in size)
+        dtype = dtype or torch.get_default_dtype()
+        value_type = torch.empty((), dtype=dtype).numpy().dtype
+        nbytes = int(np.prod(shape, dtype=np.int64)) * value_type.itemsize
+        if nbytes == 0:
+            return torch.empty(shape, dtype=dtype)
+        blob = self._client.create_blob(nbytes)
+        array = np.frombuffer(memoryview(blob), dtype=value_type).reshape(shape)
+        _track_vineyard_storage(array, self._client.instance_id, blob)
+        return torch.from_numpy(array)
+
+    def zeros(self, *size, dtype=None) -> "torch.Tensor":
+        return self.empty(*size, dtype=dtype).zero_()
+
+    def copy(self, tensor: "torch.Tensor") -> "torch.Tensor":
+        '''Copy a tensor into vineyard memory, the result has the same shape
+        and dtype and it is always contiguous.'''
+        target = self.empty(tuple(tensor.shape), dtype=tensor.dtype)
+        if target.numel() > 0:
+            target.copy_(tensor.detach())
+        return target
+
+    def adopt(self, module: "torch.nn.Module") -> "torch.nn.Module":
+        '''Move the parameters and buffers of a module into vineyard memory
+        in place, and returns the module itself.'''
+        with torch.no_grad():
+            for tensor in itertools.chain(module.parameters(), module.buffers()):
+                if tensor.device.type == 'cpu':
+                    tensor.data = self.copy(tensor.data)
+        return module
+
+
 def torch_tensor_builder(client, value, builder, **kw):
+    if client.is_ipc and _seal_vineyard_storage(client, value) is not None:
+        return put_torch_tensors(client, [value])[0]
     return builder.run(client, value.numpy(), **kw)
 
 
@@ -104,6 +213,11 @@ def torch_dataset_builder(client, value, builder, **kw):
 
 def torch_tensor_resolver(obj, resolver, **kw):
     value = resolver.parent_context.run(obj, **kw)
+    # remember the blob behind the tensor, to make putting it back zero-copy
+    if isinstance(value, np.ndarray) and value.nbytes > 0:
+        blob = obj.member('buffer_')
+        if isinstance(blob, Blob) and blob.address == value.ctypes.data:
+            _track_vineyard_storage(value, obj.meta.instance_id, blob)
     with warnings.catch_warnings():
         warnings.simplefilter("ignore", UserWarning)
         return torch.from_numpy(value)
@@ -114,7 +228,7 @@ def torch_dataset_resolver(obj, resolver, **kw):
     if isinstance(value, pd.DataFrame):
         return torch.utils.data.TensorDataset(
             *[
-                torch.from_numpy(np.array(value[column].values))
+                torch.from_numpy(np.asarray(value[column].values))
                 for column in value.columns
             ]
         )
@@ -192,10 +306,15 @@ def put_torch_tensors(client, tensors) -> List[Union[ObjectID, ObjectMeta]]:
         sizes.append(tensor.numel() * tensor.element_size())
 
     if client.is_ipc:
-        blobs = client.create_blob(sizes)
-        for pointer, size, blob in zip(pointers, sizes, blobs):
-            vineyard.memory_copy(blob.address, size, pointer, size)
-        blobs = [blob.seal(client) for blob in blobs]
+        # tensors that already live in vineyard blobs are sealed in place
+        blobs = [_seal_vineyard_storage(client, tensor) for tensor in tensors]
+        pending = [index for index, blob in enumerate(blobs) if blob is None]
+        if pending:
+            builders = client.create_blob([sizes[index] for index in pending])
+            for index, blob in zip(pending, builders):
+                size = sizes[index]
+                vineyard.memory_copy(blob.address, size, pointers[index], size)
+                blobs[index] = blob.seal(client)
     else:
         blob_writers = []
         for pointer, size in zip(pointers, sizes):
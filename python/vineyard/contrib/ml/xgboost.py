@@ -17,8 +17,10 @@
 #
 
 import contextlib
+import inspect
 
 import numpy as np
+import pyarrow as pa
 
 import lazy_import
 
@@ -34,6 +36,88 @@ def xgb_builder(client, value, builder, **kw):  # pylint: disable=unused-argumen
     pass
 
 
+def _constructor_kwargs(constructor, kw):
+    """Select the keyword arguments that are accepted by the constructor, the
+    arguments of resolvers (e.g., `label` and `data`) are excluded.
+    """
+    try:
+        parameters = inspect.signature(constructor).parameters
+    except (TypeError, ValueError):
+        return {}
+    excluded = ('data', 'label', 'feature_names')
+    return {
+        key: value
+        for key, value in kw.items()
+        if key in parameters and key not in excluded
+    }
+
+
+def _dmatrix_type(**kw):
+    """The `DMatrix`, or the `QuantileDMatrix` (for the `hist` tree method)
+    when `quantile=True`.
+    """
+    if kw.get('quantile', False):
+        if not hasattr(xgb, 'QuantileDMatrix'):
+            raise RuntimeError('QuantileDMatrix requires xgboost >= 1.7')
+        return xgb.QuantileDMatrix
+    return xgb.DMatrix
+
+
+def _arrow_dmatrix(table, **kw):
+    """Build the DMatrix from the arrow columns directly, xgboost reads the
+    arrow buffers and takes the nulls as missing values, without a pandas
+    dataframe or a dense matrix in between.
+
+    The QuantileDMatrix is built batch by batch over the record batches of
+    the table, which are aligned to the chunks of all columns, and reference
+    the columns without copying.
+    """
+    label = kw.get('label', None)
+    if label is not None:
+        labels = table.column(label)
+        table = table.drop([label])
+    else:
+        labels = None
+    feature_names = list(table.schema.names)
+    dmatrix_type = _dmatrix_type(**kw)
+    options = {'missing': np.nan}
+    options.update(_constructor_kwargs(dmatrix_type, kw))
+
+    if dmatrix_type is xgb.DMatrix:
+        if labels is not None:
+            options['label'] = labels.to_numpy()
+        return xgb.DMatrix(table, feature_names=feature_names, **options)
+
+    class BatchIter(xgb.DataIter):
+        def __init__(self):
+            self._batches = table.to_batches()
+            self._offsets = np.cumsum([0] + [len(b) for b in self._batches])
+            self._index = 0
+            super().__init__()
+
+        def next(self, input_data):
+            if self._index == len(self._batches):
+                return 0
+            batch = self._batches[self._index]
+            if labels is not None:
+                start = int(self._offsets[self._index])
+                label = labels.slice(start, len(batch)).to_numpy()
+            else:
+                label = None
+            input_data(
+                data=pa.Table.from_batches([batch]),
+                label=label,
+                feature_names=feature_names,
+            )
+            self._index += 1
+            return 1
+
+        def reset(self):
+            self._index = 0
+
+    return xgb.QuantileDMatrix(BatchIter(), **options)
+
+
 def xgb_tensor_resolver(obj, **kw):
     with resolver_context(base=default_resolver_context) as resolver:
         array = resolver(obj, **kw)
@@ -43,36 +127,27 @@ def xgb_tensor_resolver(obj, **kw):
 def xgb_dataframe_resolver(obj, **kw):
     with resolver_context(base=default_resolver_context) as resolver:
         df = resolver(obj, **kw)
+    dmatrix_type = _dmatrix_type(**kw)
+    options = _constructor_kwargs(dmatrix_type, kw)
     if 'label' in kw:
         label = df.pop(kw['label'])
         # data column can only be specified if label column is specified
         if 'data' in kw:
             df = np.stack(df[kw['data']].values)
-        return xgb.DMatrix(df, label)
-    return xgb.DMatrix(df, feature_names=df.columns)
+        return dmatrix_type(df, label, **options)
+    return dmatrix_type(df, feature_names=df.columns, **options)
 
 
 def xgb_recordbatch_resolver(obj, **kw):
     with resolver_context(base=default_resolver_context) as resolver:
         rb = resolver(obj, **kw)
-    # FIXME to_pandas is not zero_copy guaranteed
-    df = rb.to_pandas()
-    if 'label' in kw:
-        label = df.pop(kw['label'])
-        return xgb.DMatrix(df, label, feature_names=df.columns)
-    return xgb.DMatrix(df, feature_names=df.columns)
+    return _arrow_dmatrix(pa.Table.from_batches([rb]), **kw)
 
 
 def xgb_table_resolver(obj, **kw):
     with resolver_context(base=default_resolver_context) as resolver:
         tb = resolver(obj, **kw)
-
-    # FIXME to_pandas is not zero_copy guaranteed
-    df = tb.to_pandas()
-    if 'label' in kw:
-        label = df.pop(kw['label'])
-        return xgb.DMatrix(df, label, feature_names=df.columns)
-    return xgb.DMatrix(df, feature_names=df.columns)
+    return _arrow_dmatrix(tb, **kw)
 
 
 def register_xgboost_types(builder_ctx, resolver_ctx):
@@ -31,11 +31,16 @@ import vineyard
 from vineyard.contrib.ray.actor import spread  # pylint: disable=unused-import
 from vineyard.contrib.ray.actor import spread_and_get  # pylint: disable=unused-import
 from vineyard.contrib.ray.actor import spread_to_all_nodes
+from vineyard.data.arrow import make_global_table
 from vineyard.data.dataframe import make_global_dataframe
 
 
-def _block_to_vineyard(block: Block):
+def _block_to_vineyard(block: Block, as_table: bool):
     client = vineyard.connect()
+    # arrow blocks are stored as vineyard::Table as-is, without the round-trip
+    # through pandas
+    if as_table:
+        return client.put(block)
     block = BlockAccessor.for_block(block)
     return client.put(block.to_pandas())
 
@@ -43,28 +48,46 @@ def _block_to_vineyard(block: Block):
 def to_vineyard(self):
     client = vineyard.connect()
     block_to_vineyard = cached_remote_fn(_block_to_vineyard, num_cpus=0.1)
-    blocks = ray.get([block_to_vineyard.remote(block) for block in self._blocks])
+    # arrow blocks are described by arrow schemas in the block metadata
+    as_table = all(
+        isinstance(metadata.schema, pa.Schema)
+        for metadata in self._blocks.get_metadata()
+    )
+    blocks = ray.get(
+        [block_to_vineyard.remote(block, as_table) for block in self._blocks]
+    )
+    if as_table:
+        return make_global_table(client, blocks).id
     return make_global_dataframe(client, blocks).id
 
 
 def _vineyard_to_block(object_id):
     client = vineyard.connect()
-    df = client.get(object_id)
-    block = pa.table(df)
+    value = client.get(object_id)
+    if isinstance(value, pa.RecordBatch):
+        # shares the blobs of the local vineyard instance
+        block = pa.Table.from_batches([value])
+    elif isinstance(value, pa.Table):
+        block = value
+    else:
+        block = pa.table(value)
     return (block, BlockAccessor.for_block(block).get_metadata(input_files=None))
 
 
 def _get_remote_chunks_map(object_id):
     client = vineyard.connect()
     meta = client.get_meta(object_id)
-    if meta.typename == "vineyard::DataFrame" or meta.typename.startswith(
-        "vineyard::Tensor"
-    ):
+    if meta.typename in (
+        "vineyard::DataFrame",
+        "vineyard::Table",
+        "vineyard::RecordBatch",
+    ) or meta.typename.startswith("vineyard::Tensor"):
         return {repr(object_id): meta.instance_id}
 
-    if (
-        meta.typename == "vineyard::GlobalDataFrame"
-        or meta.typename == "vineyard::GlobalTensor"
+    if meta.typename in (
+        "vineyard::GlobalDataFrame",
+        "vineyard::Collection<vineyard::Table>",
+        "vineyard::GlobalTensor",
     ):
         mapping = dict()
         for index in range(int(meta['partitions_-size'])):
@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+import pandas as pd
+import pyarrow as pa
+
+import pytest
+
+import vineyard
+
+ray = pytest.importorskip('ray')
+
+import vineyard.contrib.ray.dataset  # noqa: E402 pylint: disable=unused-import
+
+
+@pytest.fixture(scope="module", autouse=True)
+def ray_cluster(vineyard_ipc_socket):
+    ray.init(
+        num_cpus=2,
+        runtime_env={'env_vars': {'VINEYARD_IPC_SOCKET': vineyard_ipc_socket}},
+    )
+    yield
+    ray.shutdown()
+
+
+def test_ray_dataset_arrow_blocks(vineyard_ipc_socket):
+    table = pa.table(
+        {
+            'a': np.arange(1024, dtype=np.int64),
+            'b': np.random.rand(1024),
+            'c': pa.array(['x%d' % i for i in range(1024)]),
+        }
+    )
+    ds = ray.data.from_arrow([table.slice(0, 512), table.slice(512)])
+    object_id = ds.to_vineyard()
+
+    client = vineyard.connect(vineyard_ipc_socket)
+    meta = client.get_meta(object_id)
+    assert meta.typename == 'vineyard::Collection<vineyard::Table>'
+    assert int(meta['partitions_-size']) == 2
+    for index in range(2):
+        assert meta['partitions_-%d' % index].typename == 'vineyard::Table'
+    chunks = client.get(object_id)
+    assert pa.concat_tables(chunks).sort_by('a').equals(table)
+
+    ds = ray.data.from_vineyard(object_id)
+    result = pa.concat_tables(ray.get(ds.get_internal_block_refs()))
+    assert result.schema.equals(table.schema)
+    assert result.sort_by('a').equals(table)
+
+
+def test_ray_dataset_pandas_blocks(vineyard_ipc_socket):
+    df = pd.DataFrame({'a': np.arange(1024), 'b': np.random.rand(1024)})
+    ds = ray.data.from_pandas([df.iloc[:512], df.iloc[512:]])
+    object_id = ds.to_vineyard()
+
+    ds = ray.data.from_vineyard(object_id)
+    result = ds.to_pandas().sort_values('a').reset_index(drop=True)
+    pd.testing.assert_frame_equal(result, df)
+
+
+def test_ray_dataset_pandas_blocks_keep_index(vineyard_ipc_socket):
+    df = pd.DataFrame(
+        {'a': np.arange(1024), 'b': np.random.rand(1024)},
+        index=pd.Index(['r%d' % i for i in range(1024)], name='key'),
+    )
+    ds = ray.data.from_pandas([df.iloc[:512], df.iloc[512:]])
+    object_id = ds.to_vineyard()
+
+    client = vineyard.connect(vineyard_ipc_socket)
+    assert client.get_meta(object_id).typename == 'vineyard::GlobalDataFrame'
+
+    # the index of dataframe chunks is kept as a column of the arrow block
+    ds = ray.data.from_vineyard(object_id)
+    result = pa.concat_tables(ray.get(ds.get_internal_block_refs())).to_pandas()
+    result = result.sort_values('a')
+    pd.testing.assert_frame_equal(result, df)
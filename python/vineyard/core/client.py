@@ -452,6 +452,20 @@ class Client:
     def get_blobs(self, object_ids: List[ObjectID], unsafe: bool = False) -> List[Blob]:
         return self.ipc_client.get_blobs(object_ids, unsafe)
 
+    @_apply_docstring(IPCClient.checkpoint)
+    def checkpoint(
+        self,
+        object_id: ObjectID,
+        path: str,
+        compress: bool = False,
+        concurrency: int = 0,
+    ) -> None:
+        return self.ipc_client.checkpoint(object_id, path, compress, concurrency)
+
+    @_apply_docstring(IPCClient.restore)
+    def restore(self, path: str, concurrency: int = 0) -> ObjectID:
+        return self.ipc_client.restore(path, concurrency)
+
     @_apply_docstring(RPCClient.create_remote_blob)
     def create_remote_blob(
         self, blob_builder: Union[RemoteBlobBuilder, List[RemoteBlobBuilder]]
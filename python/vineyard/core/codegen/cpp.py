@@ -119,6 +119,10 @@ construct_meta_optional_tpl = '''
         meta.GetKeyValue("{name}", this->{name});
     }}'''
 
+construct_member_optional_tpl = '''
+    if ({condition}) {{{body}
+    }}'''
+
 construct_plain_tpl = '''
     this->{name}.Construct(meta.GetMemberMeta("{name}"));'''
 
@@ -212,15 +216,24 @@ def codegen_construct(
             key_type = None
             value_type = None
 
-        body.append(
-            tpl.format(
-                name=name,
-                element_type=spec.element_type,
-                key_type=key_type,
-                value_type=value_type,
-                deref=spec.deref,
-            )
+        code = tpl.format(
+            name=name,
+            element_type=spec.element_type,
+            key_type=key_type,
+            value_type=value_type,
+            deref=spec.deref,
         )
+        # optional members are absent from the metadata of objects that are
+        # sealed before the member is introduced
+        if spec.optional and not spec.is_meta:
+            if spec.is_plain:
+                condition = 'meta.HasKey("%s")' % name
+            else:
+                condition = 'meta.HasKey("__%s-size")' % name
+            code = construct_member_optional_tpl.format(
+                condition=condition, body=textwrap.indent(code, ' ' * 4)
+            )
+        body.append(code)
 
     if meth:
         function_tpl = construct_meth_tpl
@@ -36,6 +36,7 @@ from vineyard._C import RemoteBlob
 from vineyard.core.builder import BuilderContext
 from vineyard.core.resolver import ResolverContext
 from vineyard.data.utils import build_buffer
+from vineyard.data.utils import make_global_object
 from vineyard.data.utils import normalize_dtype
 
 
@@ -419,6 +420,26 @@ def table_resolver(obj: Union[Object, ObjectMeta], resolver: ResolverContext):
     return pa.Table.from_batches(batches)
 
 
+def make_global_table(client, blocks, extra_meta=None) -> ObjectMeta:
+    """Make a global table that refers to the (row-wise) chunks, where each
+    chunk is a `vineyard::Table`, as a `vineyard::Collection<vineyard::Table>`.
+    """
+    return make_global_object(
+        client, 'vineyard::Collection<vineyard::Table>', blocks, extra_meta
+    )
+
+
+def global_table_resolver(obj: Union[Object, ObjectMeta], resolver: ResolverContext):
+    """Return a list of the local chunks."""
+    meta = obj.meta
+    tables = []
+    for idx in range(int(meta['partitions_-size'])):
+        table = meta.get_member('partitions_-%d' % idx)
+        if table.meta.islocal:
+            tables.append(resolver.run(table))
+    return tables
+
+
 def polars_dataframe_resolver(
     obj: Union[Object, ObjectMeta], resolver: ResolverContext
 ):
@@ -464,6 +485,9 @@ def register_arrow_types(
         resolver_ctx.register('vineyard::SchemaProxy', schema_proxy_resolver)
         resolver_ctx.register('vineyard::RecordBatch', record_batch_resolver)
         resolver_ctx.register('vineyard::Table', table_resolver)
+        resolver_ctx.register(
+            'vineyard::Collection<vineyard::Table>', global_table_resolver
+        )
         resolver_ctx.register('vineyard::LargeListArray', list_array_resolver)
 
         if polars is not None:
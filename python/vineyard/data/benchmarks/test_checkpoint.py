@@ -0,0 +1,97 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import shutil
+import tempfile
+
+import numpy as np
+
+import pytest
+
+import vineyard
+import vineyard.io
+from vineyard.conftest import vineyard_client  # noqa: F401
+from vineyard.conftest import vineyard_endpoint  # noqa: F401
+from vineyard.conftest import vineyard_ipc_socket  # noqa: F401
+from vineyard.core import default_builder_context
+from vineyard.core import default_resolver_context
+from vineyard.data import register_builtin_types
+
+register_builtin_types(default_builder_context, default_resolver_context)
+
+# Round trips of an object to the local disk, via the container file of
+# `checkpoint/restore` and via the stream-based `vineyard.io.serialize`.
+
+SIZES = {
+    '16MB': 4 * 1024 * 1024,
+    '256MB': 64 * 1024 * 1024,
+}
+
+
+@pytest.fixture
+def workdir():
+    path = tempfile.mkdtemp(prefix='vineyard-checkpoint-bench-')
+    yield path
+    shutil.rmtree(path, ignore_errors=True)
+
+
+@pytest.mark.parametrize("compress", [False, True])
+@pytest.mark.parametrize("nbytes", list(SIZES.keys()))
+def test_bench_checkpoint(
+    benchmark, vineyard_client, workdir, nbytes, compress  # noqa: F811
+):
+    object_id = vineyard_client.put(np.random.rand(SIZES[nbytes]).astype(np.float32))
+    path = os.path.join(workdir, 'object.ckpt')
+
+    def bench_checkpoint(client, object_id):
+        client.checkpoint(object_id, path, compress=compress)
+        client.delete([client.restore(path)])
+
+    benchmark(bench_checkpoint, vineyard_client, object_id)
+    vineyard_client.delete([object_id])
+
+
+@pytest.mark.parametrize("nbytes", list(SIZES.keys()))
+def test_bench_serialize(
+    benchmark, vineyard_ipc_socket, vineyard_endpoint, workdir, nbytes  # noqa: F811
+):
+    if vineyard_endpoint is None:
+        pytest.skip('serialization requires the vineyard RPC endpoint')
+    client = vineyard.connect(vineyard_ipc_socket)
+    object_id = client.put(np.random.rand(SIZES[nbytes]).astype(np.float32))
+    client.persist(object_id)
+
+    def bench_serialize(object_id):
+        path = os.path.join(workdir, 'object')
+        shutil.rmtree(path, ignore_errors=True)
+        vineyard.io.serialize(
+            path,
+            object_id,
+            vineyard_ipc_socket=vineyard_ipc_socket,
+            vineyard_endpoint=vineyard_endpoint,
+        )
+        restored = vineyard.io.deserialize(
+            path,
+            vineyard_ipc_socket=vineyard_ipc_socket,
+            vineyard_endpoint=vineyard_endpoint,
+        )
+        client.delete([restored])
+
+    benchmark(bench_serialize, object_id)
+    client.delete([object_id])
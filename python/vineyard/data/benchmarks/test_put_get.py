@@ -0,0 +1,91 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+import pandas as pd
+import pyarrow as pa
+
+import pytest
+
+from vineyard.conftest import vineyard_client  # noqa: F401
+from vineyard.core import default_builder_context
+from vineyard.core import default_resolver_context
+from vineyard.data import register_builtin_types
+
+register_builtin_types(default_builder_context, default_resolver_context)
+
+# The data-path counterparts of benchmark/client_bench, sweeping over the
+# payload size of `put` and `get` of the common python objects.
+
+SIZES = {
+    '256': 64,
+    '256KB': 64 * 1024,
+    '16MB': 4 * 1024 * 1024,
+    '256MB': 64 * 1024 * 1024,
+}
+
+
+def make_ndarray(nbytes):
+    return np.random.rand(SIZES[nbytes]).astype(np.float32)
+
+
+def make_dataframe(nbytes):
+    rows = SIZES[nbytes] // 4
+    return pd.DataFrame(
+        {
+            'a': np.random.rand(rows).astype(np.float32),
+            'b': np.random.rand(rows).astype(np.float32),
+            'c': np.random.rand(rows).astype(np.float32),
+            'd': np.random.rand(rows).astype(np.float32),
+        }
+    )
+
+
+def make_table(nbytes):
+    return pa.Table.from_pandas(make_dataframe(nbytes), preserve_index=False)
+
+
+MAKERS = {
+    'ndarray': make_ndarray,
+    'dataframe': make_dataframe,
+    'arrow_table': make_table,
+}
+
+
+@pytest.mark.parametrize("kind", list(MAKERS.keys()))
+@pytest.mark.parametrize("nbytes", list(SIZES.keys()))
+def test_bench_put(benchmark, vineyard_client, kind, nbytes):  # noqa: F811
+    data = MAKERS[kind](nbytes)
+
+    def bench_put(client, data):
+        object_id = client.put(data)
+        client.delete([object_id])
+
+    benchmark(bench_put, vineyard_client, data)
+
+
+@pytest.mark.parametrize("kind", list(MAKERS.keys()))
+@pytest.mark.parametrize("nbytes", list(SIZES.keys()))
+def test_bench_get(benchmark, vineyard_client, kind, nbytes):  # noqa: F811
+    object_id = vineyard_client.put(MAKERS[kind](nbytes))
+
+    def bench_get(client, object_id):
+        return client.get(object_id)
+
+    benchmark(bench_get, vineyard_client, object_id)
+    vineyard_client.delete([object_id])
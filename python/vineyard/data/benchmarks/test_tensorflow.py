@@ -0,0 +1,71 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+import pyarrow as pa
+
+import pytest
+
+from vineyard.conftest import vineyard_client  # noqa: F401
+from vineyard.core import default_builder_context
+from vineyard.core import default_resolver_context
+from vineyard.data import register_builtin_types
+
+register_builtin_types(default_builder_context, default_resolver_context)
+
+tf = pytest.importorskip('tensorflow')
+
+from vineyard.contrib.ml.tensorflow import tensorflow_context  # noqa: E402
+
+# Throughput of the tf.data input pipeline over an arrow table in vineyard,
+# on CPU, i.e., resolving the dataset and draining it in batches.
+
+BATCHES = [1, 16, 64]
+
+
+def make_table(batches, rows=1024 * 1024):
+    rows = rows // batches
+    return pa.Table.from_batches(
+        [
+            pa.RecordBatch.from_arrays(
+                [
+                    pa.array(np.random.rand(rows)),
+                    pa.array(np.random.rand(rows)),
+                    pa.array(np.random.randint(0, 2, rows)),
+                ],
+                ['f0', 'f1', 'label'],
+            )
+            for _ in range(batches)
+        ]
+    )
+
+
+@pytest.mark.parametrize("batches", BATCHES)
+def test_bench_tf_table_pipeline(benchmark, vineyard_client, batches):  # noqa: F811
+    table = make_table(batches)
+    object_id = vineyard_client.put(table)
+
+    def bench_pipeline(client, object_id):
+        dataset = client.get(object_id).batch(4096).prefetch(tf.data.AUTOTUNE)
+        for _ in dataset:
+            pass
+
+    with tf.device('/CPU:0'), tensorflow_context():
+        benchmark(bench_pipeline, vineyard_client, object_id)
+    benchmark.extra_info['rows'] = table.num_rows
+    vineyard_client.delete([object_id])
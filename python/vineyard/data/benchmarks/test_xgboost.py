@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import resource
+
+import numpy as np
+import pyarrow as pa
+
+import pytest
+
+from vineyard.conftest import vineyard_client  # noqa: F401
+from vineyard.core import default_builder_context
+from vineyard.core import default_resolver_context
+from vineyard.data import register_builtin_types
+
+register_builtin_types(default_builder_context, default_resolver_context)
+
+xgboost = pytest.importorskip('xgboost')
+
+from vineyard.contrib.ml.xgboost import xgboost_context  # noqa: E402
+
+# Resolving arrow tables from vineyard into a DMatrix, the peak RSS (in KB)
+# is recorded in the extra info of the report.
+
+ROWS = {
+    '1M': 1024 * 1024,
+    '16M': 16 * 1024 * 1024,
+}
+
+
+def make_batch(rows, nulls):
+    arrays, names = [], []
+    for index in range(8):
+        values = np.random.rand(rows)
+        mask = np.random.rand(rows) < 0.01 if nulls else None
+        arrays.append(pa.array(values, mask=mask))
+        names.append('f%d' % index)
+    arrays.append(pa.array(np.random.randint(0, 2, rows)))
+    names.append('label')
+    return pa.RecordBatch.from_arrays(arrays, names)
+
+
+@pytest.mark.parametrize("quantile", [False, True])
+@pytest.mark.parametrize("nulls", [False, True])
+@pytest.mark.parametrize("rows", list(ROWS.keys()))
+def test_bench_resolve_dmatrix(
+    benchmark, vineyard_client, rows, nulls, quantile  # noqa: F811
+):
+    if quantile and not hasattr(xgboost, 'QuantileDMatrix'):
+        pytest.skip('requires xgboost >= 1.7')
+    object_id = vineyard_client.put(make_batch(ROWS[rows], nulls))
+
+    def bench_resolve(client, object_id):
+        return client.get(object_id, label='label', quantile=quantile)
+
+    with xgboost_context():
+        baseline = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        benchmark(bench_resolve, vineyard_client, object_id)
+        peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    benchmark.extra_info['peak_rss_kb'] = peak
+    benchmark.extra_info['peak_rss_growth_kb'] = peak - baseline
+    vineyard_client.delete([object_id])
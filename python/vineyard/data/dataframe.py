@@ -85,12 +85,11 @@ except ImportError:
     except ImportError:
         DatetimeArray = None
 
-from vineyard._C import Object
-from vineyard._C import ObjectID
 from vineyard._C import ObjectMeta
 from vineyard.data.tensor import ndarray
 from vineyard.data.utils import expand_slice
 from vineyard.data.utils import from_json
+from vineyard.data.utils import make_global_object
 from vineyard.data.utils import normalize_dtype
 from vineyard.data.utils import to_json
 
@@ -546,28 +545,15 @@ def pandas_sparse_array_resolver(obj, resolver):
 
 
 def make_global_dataframe(client, blocks, extra_meta=None) -> ObjectMeta:
-    meta = ObjectMeta()
-    meta['typename'] = 'vineyard::GlobalDataFrame'
-    meta.set_global(True)
-    meta['partitions_-size'] = len(blocks)
-    if extra_meta:
-        for k, v in extra_meta.items():
-            meta[k] = v
-
+    extra_meta = dict(extra_meta or {})
     # assume chunks are split over the row axis
-    if 'partition_shape_row_' not in meta:
-        meta['partition_shape_row_'] = len(blocks)
-    if 'partition_shape_column_' not in meta:
-        meta['partition_shape_column_'] = 1
-
-    for idx, block in enumerate(blocks):
-        if not isinstance(block, (ObjectMeta, ObjectID, Object)):
-            block = ObjectID(block)
-        meta.add_member('partitions_-%d' % idx, block)
-
-    gtensor_meta = client.create_metadata(meta)
-    client.persist(gtensor_meta)
-    return gtensor_meta
+    if 'partition_shape_row_' not in extra_meta:
+        extra_meta['partition_shape_row_'] = len(blocks)
+    if 'partition_shape_column_' not in extra_meta:
+        extra_meta['partition_shape_column_'] = 1
+    return make_global_object(
+        client, 'vineyard::GlobalDataFrame', blocks, extra_meta=extra_meta
+    )
 
 
 def global_dataframe_resolver(obj, resolver):
@@ -181,6 +181,28 @@ def build_numpy_buffer(client, array):
         return build_buffer(client, payload, len(payload))
 
 
+def make_global_object(client, typename, blocks, extra_meta=None) -> ObjectMeta:
+    """Make a global object of `typename` that refers to the blocks as the
+    partitions, i.e., `partitions_-<index>`, and persist it.
+    """
+    meta = ObjectMeta()
+    meta['typename'] = typename
+    meta.set_global(True)
+    meta['partitions_-size'] = len(blocks)
+    if extra_meta:
+        for k, v in extra_meta.items():
+            meta[k] = v
+
+    for idx, block in enumerate(blocks):
+        if not isinstance(block, (ObjectMeta, ObjectID, Object)):
+            block = ObjectID(block)
+        meta.add_member('partitions_-%d' % idx, block)
+
+    global_meta = client.create_metadata(meta)
+    client.persist(global_meta)
+    return global_meta
+
+
 def default_json_encoder(value):
     if isinstance(value, (np.integer, np.floating)):
         return value.item()
@@ -19,6 +19,7 @@
 import itertools
 import json
 import logging
+import time
 
 import numpy as np
 import pandas as pd
@@ -267,3 +268,49 @@ def test_migration_large_object(
     assert o1 != o2
     np.testing.assert_allclose(client1.get(o1), client2.get(o2))
     logger.info('------- finish migrate remote large object --------')
+
+
+def migrate_and_measure(vineyard_ipc_sockets, path):
+    vineyard_ipc_sockets = list(
+        itertools.islice(itertools.cycle(vineyard_ipc_sockets), 2)
+    )
+
+    client1 = vineyard.connect(vineyard_ipc_sockets[0])
+    client2 = vineyard.connect(vineyard_ipc_sockets[1])
+
+    for nbytes in [1 << 20, 64 << 20]:
+        data = np.random.randint(0, 255, nbytes, dtype=np.uint8)
+        o1 = client1.put(data)
+        client1.persist(o1)
+        client2.get_meta(o1, sync_remote=True)
+
+        start = time.time()
+        o2 = client2.migrate(o1)
+        elapsed = time.time() - start
+        assert o1 != o2
+        np.testing.assert_array_equal(client1.get(o1), client2.get(o2))
+        logger.info(
+            'migrated %d bytes through %s in %.3fs: %.2f GB/s',
+            nbytes,
+            path,
+            elapsed,
+            nbytes / elapsed / (1 << 30),
+        )
+
+        client1.delete(o1)
+        client2.delete(o2)
+
+
+@pytest.mark.skip_without_migration()
+def test_migration_throughput(vineyard_ipc_sockets):
+    # the instances on the same host transfer blobs through shared memory
+    migrate_and_measure(vineyard_ipc_sockets, 'IPC')
+
+
+@pytest.mark.skip_without_migration()
+def test_migration_throughput_tcp(vineyard_tcp_ipc_sockets):
+    # the instances are launched with `--local_migration=false`, thus transfer
+    # blobs through the loopback TCP
+    if not vineyard_tcp_ipc_sockets:
+        pytest.skip('Skip since no instances migrate through TCP')
+    migrate_and_measure(vineyard_tcp_ipc_sockets, 'TCP')
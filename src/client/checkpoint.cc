@@ -0,0 +1,464 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "client/ds/object_meta.h"
+#include "client/utils.h"
+#include "common/util/json.h"
+#include "common/util/status.h"
+#include "common/util/uuid.h"
+
+#include "zstd/lib/zstd.h"
+
+namespace vineyard {
+
+/**
+ * Layout of the checkpoint container:
+ *
+ *   | header (magic) | extent | extent | ... | footer (json) | trailer |
+ *
+ * The header and every extent start at a page-aligned offset. The trailer is
+ * made of the footer offset, the footer size, and the magic.
+ */
+namespace {
+
+constexpr char kCheckpointMagic[8] = {'V', '6', 'D', 'C', 'K', 'P', 'T', '1'};
+constexpr size_t kCheckpointAlignment = 4096;
+constexpr size_t kCheckpointExtentSize = 64 * 1024 * 1024;  // 64MB
+constexpr size_t kCheckpointTrailerSize = 2 * sizeof(uint64_t) + 8;
+constexpr int kCheckpointCompressionLevel = 1;
+
+struct Extent {
+  ObjectID blob_id;
+  size_t blob_offset;
+  size_t size;
+  size_t file_offset;
+  size_t length;
+  bool compressed;
+};
+
+inline size_t align_up(const size_t size) {
+  return (size + kCheckpointAlignment - 1) & ~(kCheckpointAlignment - 1);
+}
+
+Status errno_to_status(std::string const& op, std::string const& path) {
+  return Status::IOError(op + " '" + path + "' failed: " + strerror(errno));
+}
+
+Status write_fully(int fd, const uint8_t* data, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError(std::string("pwrite failed: ") + strerror(errno));
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+  return Status::OK();
+}
+
+Status read_fully(int fd, uint8_t* data, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t nread = pread(fd, data, size, offset);
+    if (nread < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError(std::string("pread failed: ") + strerror(errno));
+    }
+    if (nread == 0) {
+      return Status::IOError("Unexpected end of the checkpoint file");
+    }
+    data += nread;
+    size -= nread;
+    offset += nread;
+  }
+  return Status::OK();
+}
+
+/**
+ * Run `fn(index)` for every index in [0, size) on `concurrency` threads, and
+ * returns the first error.
+ */
+template <typename F>
+Status parallel_for_each(const size_t size, size_t concurrency, F const& fn) {
+  if (concurrency == 0) {
+    concurrency = std::max(1u, std::thread::hardware_concurrency());
+  }
+  concurrency = std::min(concurrency, size);
+  std::atomic<size_t> next(0);
+  std::mutex mutex;
+  Status status;
+  auto worker = [&]() {
+    while (true) {
+      size_t index = next.fetch_add(1);
+      if (index >= size) {
+        return;
+      }
+      Status s = fn(index);
+      if (!s.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        status += s;
+        next.store(size);
+        return;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t index = 1; index < concurrency; ++index) {
+    threads.emplace_back(worker);
+  }
+  if (concurrency > 0) {
+    worker();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return status;
+}
+
+class FileGuard {
+ public:
+  explicit FileGuard(int fd) : fd_(fd) {}
+  ~FileGuard() {
+    if (fd_ != -1) {
+      close(fd_);
+    }
+  }
+
+ private:
+  int fd_;
+};
+
+}  // namespace
+
+Status Client::Checkpoint(const ObjectID id, std::string const& path,
+                          const bool compress, const size_t concurrency) {
+  ENSURE_CONNECTED(this);
+  ObjectMeta meta;
+  RETURN_ON_ERROR(GetMetaData(id, meta, true));
+
+  std::vector<Extent> extents;
+  std::map<ObjectID, const uint8_t*> pointers;
+  json blobs = json::object();
+  for (auto const& item : meta.GetBufferSet()->AllBuffers()) {
+    if (IsEmptyBlobID(item.first)) {
+      continue;
+    }
+    if (item.second == nullptr) {
+      return Status::Invalid("Blob " + ObjectIDToString(item.first) +
+                             " is not available on the connected instance");
+    }
+    size_t size = item.second->size();
+    pointers[item.first] = item.second->data();
+    blobs[ObjectIDToString(item.first)] = json{{"size", size}};
+    for (size_t offset = 0; offset < size; offset += kCheckpointExtentSize) {
+      size_t extent_size = std::min(kCheckpointExtentSize, size - offset);
+      extents.emplace_back(
+          Extent{item.first, offset, extent_size, 0, 0, false});
+    }
+  }
+
+  int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+  if (fd == -1) {
+    return errno_to_status("open", path);
+  }
+  FileGuard guard(fd);
+
+  std::vector<uint8_t> header(kCheckpointAlignment, 0);
+  memcpy(header.data(), kCheckpointMagic, sizeof(kCheckpointMagic));
+  RETURN_ON_ERROR(write_fully(fd, header.data(), header.size(), 0));
+
+  // extents are placed in the order they are finished
+  std::atomic<size_t> cursor(kCheckpointAlignment);
+  RETURN_ON_ERROR(parallel_for_each(
+      extents.size(), concurrency, [&](const size_t index) -> Status {
+        Extent& extent = extents[index];
+        const uint8_t* data =
+            pointers.at(extent.blob_id) + extent.blob_offset;
+        std::unique_ptr<uint8_t[]> compressed;
+        extent.length = extent.size;
+        if (compress) {
+          size_t bound = ZSTD_compressBound(extent.size);
+          compressed.reset(new uint8_t[bound]);
+          size_t length =
+              ZSTD_compress(compressed.get(), bound, data, extent.size,
+                            kCheckpointCompressionLevel);
+          if (!ZSTD_isError(length) && length < extent.size) {
+            data = compressed.get();
+            extent.length = length;
+            extent.compressed = true;
+          }
+        }
+        extent.file_offset = cursor.fetch_add(align_up(extent.length));
+        return write_fully(fd, data, extent.length, extent.file_offset);
+      }));
+
+  for (auto const& extent : extents) {
+    blobs[ObjectIDToString(extent.blob_id)]["extents"].push_back(
+        json{extent.blob_offset, extent.size, extent.file_offset, extent.length,
+             extent.compressed});
+  }
+  json footer = json{{"root", meta.MetaData()}, {"blobs", blobs}};
+  std::string content = json_to_string(footer);
+
+  uint64_t trailer[2] = {cursor.load(), content.size()};
+  std::vector<uint8_t> buffer(content.size() + kCheckpointTrailerSize);
+  memcpy(buffer.data(), content.data(), content.size());
+  memcpy(buffer.data() + content.size(), trailer, sizeof(trailer));
+  memcpy(buffer.data() + content.size() + sizeof(trailer), kCheckpointMagic,
+         sizeof(kCheckpointMagic));
+  return write_fully(fd, buffer.data(), buffer.size(), trailer[0]);
+}
+
+namespace {
+
+Status rebuild_object_tree(Client& client, json const& tree,
+                           std::map<ObjectID, ObjectMeta>& restored,
+                           ObjectMeta& meta) {
+  ObjectID id = ObjectIDFromString(tree.at("id").get<std::string>());
+  auto iter = restored.find(id);
+  if (iter != restored.end()) {
+    meta = iter->second;
+    return Status::OK();
+  }
+  if (IsBlob(id)) {
+    if (!IsEmptyBlobID(id)) {
+      return Status::Invalid("Blob " + ObjectIDToString(id) +
+                             " is missing in the checkpoint file");
+    }
+    meta = Blob::MakeEmpty(client)->meta();
+    restored.emplace(id, meta);
+    return Status::OK();
+  }
+
+  static const std::set<std::string> reserved_keys = {
+      "id",     "signature", "instance_id", "transient",
+      "global", "typename",  "nbytes"};
+  bool global = tree.value("global", false);
+  ObjectMeta target;
+  for (auto const& item : tree.items()) {
+    if (item.value().is_object()) {
+      ObjectMeta member;
+      RETURN_ON_ERROR(
+          rebuild_object_tree(client, item.value(), restored, member));
+      if (global) {
+        RETURN_ON_ERROR(client.Persist(member.GetId()));
+      }
+      target.AddMember(item.key(), member);
+    } else if (reserved_keys.find(item.key()) == reserved_keys.end()) {
+      target.MutMetaData()[item.key()] = item.value();
+    }
+  }
+  target.SetTypeName(tree.at("typename").get<std::string>());
+  target.SetNBytes(tree.value("nbytes", static_cast<size_t>(0)));
+  if (global) {
+    target.SetGlobal(true);
+  }
+  ObjectID target_id = InvalidObjectID();
+  RETURN_ON_ERROR(client.CreateMetaData(target, target_id));
+  restored.emplace(id, target);
+  meta = target;
+  return Status::OK();
+}
+
+/**
+ * Collects the blobs and their extents from the footer, the extents must lie
+ * within their blobs and between the header and the footer.
+ */
+Status parse_footer(json const& footer, const size_t footer_offset,
+                    std::vector<ObjectID>& blob_ids,
+                    std::vector<size_t>& blob_sizes,
+                    std::vector<Extent>& extents,
+                    std::vector<size_t>& extent_blobs) {
+  for (auto const& item : footer.at("blobs").items()) {
+    blob_ids.emplace_back(ObjectIDFromString(item.key()));
+    blob_sizes.emplace_back(item.value().at("size").get<size_t>());
+    for (auto const& entry : item.value().value("extents", json::array())) {
+      Extent extent{blob_ids.back(),
+                    entry.at(0).get<size_t>(),
+                    entry.at(1).get<size_t>(),
+                    entry.at(2).get<size_t>(),
+                    entry.at(3).get<size_t>(),
+                    entry.at(4).get<bool>()};
+      // written in the forms that can't overflow
+      if (extent.size > blob_sizes.back() ||
+          extent.blob_offset > blob_sizes.back() - extent.size ||
+          extent.file_offset < kCheckpointAlignment ||
+          extent.length > footer_offset ||
+          extent.file_offset > footer_offset - extent.length ||
+          (!extent.compressed && extent.length != extent.size)) {
+        return Status::Invalid("Malformed extent in the checkpoint file");
+      }
+      extents.emplace_back(extent);
+      extent_blobs.emplace_back(blob_ids.size() - 1);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status Client::Restore(std::string const& path, ObjectID& id,
+                       const size_t concurrency) {
+  ENSURE_CONNECTED(this);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return errno_to_status("open", path);
+  }
+  FileGuard guard(fd);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return errno_to_status("stat", path);
+  }
+  size_t file_size = st.st_size;
+  if (file_size < kCheckpointAlignment + kCheckpointTrailerSize) {
+    return Status::Invalid("'" + path + "' is not a checkpoint file");
+  }
+
+  uint8_t trailer[kCheckpointTrailerSize];
+  RETURN_ON_ERROR(read_fully(fd, trailer, kCheckpointTrailerSize,
+                             file_size - kCheckpointTrailerSize));
+  uint64_t footer_location[2];
+  memcpy(footer_location, trailer, sizeof(footer_location));
+  // the footer ends at the trailer, checked without overflowing
+  if (memcmp(trailer + sizeof(footer_location), kCheckpointMagic,
+             sizeof(kCheckpointMagic)) != 0 ||
+      footer_location[1] > file_size - kCheckpointTrailerSize ||
+      footer_location[0] !=
+          file_size - kCheckpointTrailerSize - footer_location[1] ||
+      footer_location[0] < kCheckpointAlignment) {
+    return Status::Invalid("'" + path + "' is not a checkpoint file");
+  }
+  std::string content(footer_location[1], '\0');
+  RETURN_ON_ERROR(read_fully(fd, reinterpret_cast<uint8_t*>(&content[0]),
+                             content.size(), footer_location[0]));
+  json footer;
+  Status status;
+  CATCH_JSON_ERROR(footer, status, json::parse(content));
+  RETURN_ON_ERROR(status);
+
+  if (!footer.is_object() || !footer.contains("root") ||
+      !footer["root"].is_object()) {
+    return Status::Invalid("Malformed footer in the checkpoint file");
+  }
+
+  // collect the extents to read, and create the blobs
+  std::vector<ObjectID> blob_ids;
+  std::vector<size_t> blob_sizes;
+  std::vector<Extent> extents;
+  std::vector<size_t> extent_blobs;
+  CATCH_JSON_ERROR_STATEMENT(
+      status, status = parse_footer(footer, footer_location[0], blob_ids,
+                                    blob_sizes, extents, extent_blobs));
+  RETURN_ON_ERROR(status);
+  std::vector<std::unique_ptr<BlobWriter>> writers;
+  RETURN_ON_ERROR(CreateBlobs(blob_sizes, writers));
+  // abort the writers that haven't been sealed yet, starting from `from`
+  auto abort_writers = [&](const size_t from) {
+    for (size_t index = from; index < writers.size(); ++index) {
+      VINEYARD_DISCARD(writers[index]->Abort(*this));
+    }
+  };
+  std::vector<uint8_t*> targets;
+  for (size_t index = 0; index < extents.size(); ++index) {
+    targets.emplace_back(
+        reinterpret_cast<uint8_t*>(writers[extent_blobs[index]]->data()) +
+        extents[index].blob_offset);
+  }
+
+  status = parallel_for_each(
+      extents.size(), concurrency, [&](const size_t index) -> Status {
+        Extent const& extent = extents[index];
+        if (!extent.compressed) {
+          return read_fully(fd, targets[index], extent.size,
+                            extent.file_offset);
+        }
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[extent.length]);
+        RETURN_ON_ERROR(
+            read_fully(fd, buffer.get(), extent.length, extent.file_offset));
+        size_t size = ZSTD_decompress(targets[index], extent.size,
+                                      buffer.get(), extent.length);
+        if (ZSTD_isError(size) || size != extent.size) {
+          return Status::IOError(
+              "Failed to decompress the extent of blob " +
+              ObjectIDToString(extent.blob_id) + " at offset " +
+              std::to_string(extent.blob_offset));
+        }
+        return Status::OK();
+      });
+  if (!status.ok()) {
+    abort_writers(0);
+    return status;
+  }
+
+  std::map<ObjectID, ObjectMeta> restored;
+  size_t sealed = 0;
+  while (sealed < blob_ids.size()) {
+    std::shared_ptr<Object> blob;
+    status = writers[sealed]->Seal(*this, blob);
+    if (!status.ok()) {
+      break;
+    }
+    restored.emplace(blob_ids[sealed], blob->meta());
+    ++sealed;
+  }
+  ObjectMeta meta;
+  if (status.ok()) {
+    CATCH_JSON_ERROR_STATEMENT(
+        status,
+        status = rebuild_object_tree(*this, footer["root"], restored, meta));
+  }
+  if (!status.ok()) {
+    // abort the remaining writers, and delete the sealed blobs together with
+    // the objects that have been rebuilt so far
+    abort_writers(sealed);
+    std::vector<ObjectID> created;
+    for (auto const& item : restored) {
+      ObjectID restored_id = item.second.GetId();
+      if (restored_id != InvalidObjectID() && !IsEmptyBlobID(restored_id)) {
+        created.emplace_back(restored_id);
+      }
+    }
+    VINEYARD_DISCARD(DelData(created, true, false));
+    return status;
+  }
+  id = meta.GetId();
+  return Status::OK();
+}
+
+}  // namespace vineyard
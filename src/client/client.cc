@@ -237,6 +237,17 @@ Status Client::CreateBlob(size_t size, std::unique_ptr<BlobWriter>& blob) {
   return Status::OK();
 }
 
+Status Client::CreateBlob(size_t size, size_t capacity,
+                          std::unique_ptr<BlobWriter>& blob) {
+  ENSURE_CONNECTED(this);
+  ObjectID object_id = InvalidObjectID();
+  Payload object;
+  std::shared_ptr<MutableBuffer> buffer = nullptr;
+  RETURN_ON_ERROR(CreateBuffer(size, capacity, object_id, object, buffer));
+  blob.reset(new BlobWriter(object_id, object, buffer));
+  return Status::OK();
+}
+
 Status Client::CreateBlobs(const std::vector<size_t>& sizes,
                            std::vector<std::unique_ptr<BlobWriter>>& blobs) {
   ENSURE_CONNECTED(this);
@@ -609,9 +620,19 @@ Status Client::ReleaseArena(const int fd, std::vector<size_t> const& offsets,
 
 Status Client::CreateBuffer(const size_t size, ObjectID& id, Payload& payload,
                             std::shared_ptr<MutableBuffer>& buffer) {
+  return CreateBuffer(size, 0, id, payload, buffer);
+}
+
+Status Client::CreateBuffer(const size_t size, const size_t capacity,
+                            ObjectID& id, Payload& payload,
+                            std::shared_ptr<MutableBuffer>& buffer) {
   ENSURE_CONNECTED(this);
   std::string message_out;
-  WriteCreateBufferRequest(size, message_out);
+  if (capacity > size) {
+    WriteCreateBufferRequest(size, capacity, message_out);
+  } else {
+    WriteCreateBufferRequest(size, message_out);
+  }
   RETURN_ON_ERROR(doWrite(message_out));
   json message_in;
   int fd_sent = -1, fd_recv = -1;
@@ -1031,6 +1052,50 @@ Status Client::ShrinkBuffer(const ObjectID id, const size_t size) {
   return Status::OK();
 }
 
+Status Client::ExtendBuffer(const ObjectID id, const size_t size,
+                            ObjectID& new_id, Payload& payload,
+                            std::shared_ptr<MutableBuffer>& buffer) {
+  ENSURE_CONNECTED(this);
+
+  RETURN_ON_ASSERT(IsBlob(id));
+  std::string message_out;
+  WriteExtendBufferRequest(id, size, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  int fd_sent = -1, fd_recv = -1;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadExtendBufferReply(message_in, new_id, payload, fd_sent));
+  RETURN_ON_ASSERT(static_cast<size_t>(payload.data_size) == size);
+
+  uint8_t *shared = nullptr, *dist = nullptr;
+  if (payload.data_size > 0) {
+    fd_recv = shm_->PreMmap(payload.store_fd);
+    if (message_in.contains("fd") && fd_recv != fd_sent) {
+      json error = json::object();
+      error["error"] =
+          "ExtendBuffer: the fd is not matched between client and server";
+      error["fd_sent"] = fd_sent;
+      error["fd_recv"] = fd_recv;
+      error["response"] = message_in;
+      return Status::Invalid(error.dump());
+    }
+
+    RETURN_ON_ERROR(shm_->Mmap(
+        payload.store_fd, payload.object_id, payload.map_size,
+        payload.data_size, payload.data_offset,
+        payload.pointer - payload.data_offset, false, true, &shared));
+    dist = shared + payload.data_offset;
+  }
+  buffer = std::make_shared<MutableBuffer>(dist, payload.data_size);
+
+  if (new_id != id) {
+    // the old buffer has been dropped by the server after relocation
+    RETURN_ON_ERROR(DeleteUsage(id));
+    RETURN_ON_ERROR(AddUsage(new_id, payload));
+  }
+  return Status::OK();
+}
+
 Status Client::Seal(ObjectID const& object_id) {
   ENSURE_CONNECTED(this);
   std::string message_out;
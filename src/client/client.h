@@ -384,6 +384,22 @@ class Client final : public BasicIPCClient,
    */
   Status CreateBlob(size_t size, std::unique_ptr<BlobWriter>& blob);
 
+  /**
+   * @brief Create a growable blob in vineyard server, for builders that don't
+   * know the final size in advance. The server reserves `capacity` bytes for
+   * the blob, thus `BlobWriter::Extend` can grow the blob in place without
+   * copying. The whole `capacity` is accounted in the server's memory usage
+   * until the blob is deleted.
+   *
+   * @param size The initial size of requested blob.
+   * @param capacity The number of bytes to reserve for the blob.
+   * @param blob The result mutable blob will be set in `blob`.
+   *
+   * @return Status that indicates whether the create action has succeeded.
+   */
+  Status CreateBlob(size_t size, size_t capacity,
+                    std::unique_ptr<BlobWriter>& blob);
+
   /**
    * @brief Create blobs in vineyard server. When creating a blob, vineyard
    * server's bulk allocator will prepare a block of memory of the requested
@@ -757,6 +773,44 @@ class Client final : public BasicIPCClient,
   Status ShallowCopy(PlasmaID const plasma_id, ObjectID& target_id,
                      PlasmaClient& source_client);
 
+  /**
+   * @brief Checkpoint the object (and all its members) to a single container
+   * file.
+   *
+   * The blobs are written as page-aligned extents in parallel, followed by a
+   * footer that records the metadata tree and the location of every extent.
+   * Large blobs are split into several extents. All blobs of the object must
+   * be available on the connected instance.
+   *
+   * @param id The object to checkpoint.
+   * @param path The container file to write, it will be truncated if exists.
+   * @param compress Whether to compress each extent with zstd. Extents that
+   *        don't shrink are stored uncompressed.
+   * @param concurrency The number of IO threads, 0 means the number of
+   *        hardware threads.
+   *
+   * @return Status that indicates whether the checkpoint has succeeded.
+   */
+  Status Checkpoint(const ObjectID id, std::string const& path,
+                    const bool compress = false, const size_t concurrency = 0);
+
+  /**
+   * @brief Restore an object from the container file written by `Checkpoint`.
+   *
+   * The extents are read (and decompressed) in parallel directly into newly
+   * created blobs, then the metadata tree is recreated on top of the blobs.
+   * The restored object gets new object ids.
+   *
+   * @param path The container file to read.
+   * @param id The id of the restored object.
+   * @param concurrency The number of IO threads, 0 means the number of
+   *        hardware threads.
+   *
+   * @return Status that indicates whether the restore has succeeded.
+   */
+  Status Restore(std::string const& path, ObjectID& id,
+                 const size_t concurrency = 0);
+
   /**
    * @brief Decrease the reference count of the object. It will trigger
    * `OnRelease` behavior when reference count reaches zero. See UsageTracker.
@@ -859,6 +913,9 @@ class Client final : public BasicIPCClient,
   Status CreateBuffer(const size_t size, ObjectID& id, Payload& payload,
                       std::shared_ptr<MutableBuffer>& buffer);
 
+  Status CreateBuffer(const size_t size, const size_t capacity, ObjectID& id,
+                      Payload& payload, std::shared_ptr<MutableBuffer>& buffer);
+
   Status CreateBuffers(const std::vector<size_t>& sizes,
                        std::vector<ObjectID>& ids,
                        std::vector<Payload>& payloads,
@@ -917,6 +974,16 @@ class Client final : public BasicIPCClient,
    */
   Status ShrinkBuffer(const ObjectID id, const size_t size);
 
+  /**
+   * @brief An (unsafe) internal-usage method that grows the unsealed buffer
+   * to the given size. The buffer is extended in place when the space after
+   * it is free (e.g., reserved by `CreateBlob(size, capacity, blob)`),
+   * otherwise the server relocates the buffer into a new blob and drops the
+   * old one, in which case `new_id` differs from `id`.
+   */
+  Status ExtendBuffer(const ObjectID id, const size_t size, ObjectID& new_id,
+                      Payload& payload, std::shared_ptr<MutableBuffer>& buffer);
+
   /**
    * @brief mark the blob as sealed to control the visibility of a blob, client
    * can never `Get` an unsealed blob.
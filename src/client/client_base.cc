@@ -263,9 +263,14 @@ Status ClientBase::OpenStream(const ObjectID& id, StreamOpenMode mode) {
 
 Status ClientBase::PushNextStreamChunk(ObjectID const id,
                                        ObjectID const chunk) {
+  return PushNextStreamChunk(id, chunk, false);
+}
+
+Status ClientBase::PushNextStreamChunk(ObjectID const id, ObjectID const chunk,
+                                       bool const retained) {
   ENSURE_CONNECTED(this);
   std::string message_out;
-  WritePushNextStreamChunkRequest(id, chunk, message_out);
+  WritePushNextStreamChunkRequest(id, chunk, retained, message_out);
   RETURN_ON_ERROR(doWrite(message_out));
   json message_in;
   RETURN_ON_ERROR(doRead(message_in));
@@ -274,13 +279,19 @@ Status ClientBase::PushNextStreamChunk(ObjectID const id,
 }
 
 Status ClientBase::PullNextStreamChunk(ObjectID const id, ObjectID& chunk) {
+  bool retained = false;
+  return PullNextStreamChunk(id, chunk, retained);
+}
+
+Status ClientBase::PullNextStreamChunk(ObjectID const id, ObjectID& chunk,
+                                       bool& retained) {
   ENSURE_CONNECTED(this);
   std::string message_out;
   WritePullNextStreamChunkRequest(id, message_out);
   RETURN_ON_ERROR(doWrite(message_out));
   json message_in;
   RETURN_ON_ERROR(doRead(message_in));
-  RETURN_ON_ERROR(ReadPullNextStreamChunkReply(message_in, chunk));
+  RETURN_ON_ERROR(ReadPullNextStreamChunkReply(message_in, chunk, retained));
   return Status::OK();
 }
 
@@ -633,6 +644,7 @@ InstanceStatus::InstanceStatus(const json& tree)
       memory_limit(tree["memory_limit"].get<size_t>()),
       deferred_requests(tree["deferred_requests"].get<size_t>()),
       ipc_connections(tree["ipc_connections"].get<size_t>()),
-      rpc_connections(tree["rpc_connections"].get<size_t>()) {}
+      rpc_connections(tree["rpc_connections"].get<size_t>()),
+      allocator_stats(tree.value("allocator_stats", json::object())) {}
 
 }  // namespace vineyard
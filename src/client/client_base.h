@@ -261,6 +261,21 @@ class ClientBase {
    */
   Status PushNextStreamChunk(ObjectID const id, ObjectID const chunk);
 
+  /**
+   * @brief Push a chunk to a stream, see also `PushNextStreamChunk(id, chunk)`.
+   *
+   * A retained blob chunk is not deleted when the reader pulls the next chunk,
+   * but once both the writer and the reader have released it.
+   *
+   * @param id The id of the stream.
+   * @param chunk The immutable chunk generated by the writer of the stream.
+   * @param retained Whether the blob chunk may outlive the next pull.
+   *
+   * @return Status that indicates whether the polling has succeeded.
+   */
+  Status PushNextStreamChunk(ObjectID const id, ObjectID const chunk,
+                             bool const retained);
+
   /**
    * @brief Pull a chunk from a stream. When there's no more chunk available in
    * the stream, i.e., the stream has been stopped, a status code
@@ -274,6 +289,20 @@ class ClientBase {
    */
   Status PullNextStreamChunk(ObjectID const id, ObjectID& chunk);
 
+  /**
+   * @brief Pull a chunk from a stream, see also `PullNextStreamChunk(id,
+   * chunk)`.
+   *
+   * @param id The id of the stream.
+   * @param chunk The immutable chunk generated by the writer of the stream.
+   * @param retained Whether the chunk has been pushed as a retained chunk,
+   *                 which must be released by the reader with `Release()`.
+   *
+   * @return Status that indicates whether the polling has succeeded.
+   */
+  Status PullNextStreamChunk(ObjectID const id, ObjectID& chunk,
+                             bool& retained);
+
   /**
    * @brief Pull a chunk from a stream. When there's no more chunk available in
    * the stream, i.e., the stream has been stopped, a status code
@@ -660,6 +689,10 @@ struct InstanceStatus {
   const size_t ipc_connections;
   /// How many RPCClient connects to this vineyard server.
   const size_t rpc_connections;
+  /// Introspection of the shared memory allocator, including the used and
+  /// free bytes, the largest free extent, the histogram of free extents and
+  /// block counts per size class.
+  const json allocator_stats;
 
   /**
    * @brief Initialize the status value using a json returned from the vineyard
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "client/ds/blob.h"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -85,6 +89,7 @@ const char* Blob::data() const {
   if (size_ == 0) {
     return nullptr;
   }
+  LoadLazily();
   if (size_ > 0 && (buffer_ == nullptr || buffer_->size() == 0)) {
     throw std::invalid_argument(
         "Blob::data(): the object might be a (partially) remote object and the "
@@ -95,6 +100,7 @@ const char* Blob::data() const {
 }
 
 const std::shared_ptr<Buffer>& Blob::Buffer() const {
+  LoadLazily();
   if (size_ > 0 && (buffer_ == nullptr || buffer_->size() == 0)) {
     throw std::invalid_argument(
         "Blob::Buffer(): the object might be a (partially) remote object and "
@@ -130,6 +136,14 @@ void Blob::Construct(ObjectMeta const& meta) {
     return;
   }
   if (meta.GetBuffer(meta.GetId(), this->buffer_).ok()) {
+    auto const& loader = meta.GetBufferSet()->Loader();
+    if (this->buffer_ == nullptr && loader != nullptr) {
+      // a lazy remote blob, fetched on the first access
+      this->size_ = meta.GetNBytes();
+      this->loader_ = loader;
+      this->load_once_ = std::make_shared<std::once_flag>();
+      return;
+    }
     if (this->buffer_ == nullptr) {
       throw std::runtime_error(
           "Blob::Construct(): Invalid internal state: local blob found but it "
@@ -145,6 +159,22 @@ void Blob::Construct(ObjectMeta const& meta) {
   }
 }
 
+void Blob::LoadLazily() const {
+  if (load_once_ == nullptr) {
+    return;
+  }
+  std::call_once(*load_once_, [this]() {
+    std::shared_ptr<vineyard::Buffer> buffer;
+    auto status = loader_->Load(id_, buffer);
+    if (!status.ok()) {
+      throw std::runtime_error("Blob::LoadLazily(): failed to fetch blob " +
+                               ObjectIDToString(id_) + ": " +
+                               status.ToString());
+    }
+    buffer_ = buffer;
+  });
+}
+
 void Blob::Dump() const {
 #ifndef NDEBUG
   std::stringstream ss;
@@ -279,6 +309,21 @@ Status BlobWriter::Shrink(Client& client, const size_t size) {
   return Status::OK();
 }
 
+Status BlobWriter::Extend(Client& client, const size_t size) {
+  if (this->sealed()) {
+    return Status::ObjectSealed("Cannot extend a sealed buffer.");
+  }
+  ObjectID object_id = InvalidObjectID();
+  Payload payload;
+  std::shared_ptr<MutableBuffer> buffer;
+  RETURN_ON_ERROR(
+      client.ExtendBuffer(this->object_id_, size, object_id, payload, buffer));
+  this->object_id_ = object_id;
+  this->payload_ = payload;
+  this->buffer_ = buffer;
+  return Status::OK();
+}
+
 void BlobWriter::AddKeyValue(std::string const& key, std::string const& value) {
   this->metadata_.emplace(key, value);
 }
@@ -345,6 +390,17 @@ Status BlobWriter::_Seal(Client& client, std::shared_ptr<Object>& object) {
   return Status::OK();
 }
 
+Status BufferLoader::Load(
+    std::set<ObjectID> const& ids,
+    std::map<ObjectID, std::shared_ptr<Buffer>>& buffers) {
+  for (auto const& id : ids) {
+    std::shared_ptr<Buffer> buffer;
+    RETURN_ON_ERROR(Load(id, buffer));
+    buffers.emplace(id, buffer);
+  }
+  return Status::OK();
+}
+
 Status BufferSet::EmplaceBuffer(ObjectID const id) {
   auto p = buffers_.find(id);
   if (p != buffers_.end() && p->second != nullptr) {
@@ -381,6 +437,9 @@ void BufferSet::Extend(BufferSet const& others) {
   for (auto const& kv : others.buffers_) {
     buffers_.emplace(kv.first, kv.second);
   }
+  if (loader_ == nullptr) {
+    loader_ = others.loader_;
+  }
 }
 
 void BufferSet::Extend(std::shared_ptr<BufferSet> const& others) {
@@ -401,4 +460,68 @@ bool BufferSet::Get(ObjectID const id, std::shared_ptr<Buffer>& buffer) const {
   }
 }
 
+namespace detail {
+
+static void populate_pages(Buffer const& buffer) {
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = buffer.address() & ~(page_size - 1);
+  uintptr_t end = buffer.address() + buffer.size();
+#if defined(MADV_POPULATE_READ)
+  if (madvise(reinterpret_cast<void*>(begin), end - begin,
+              MADV_POPULATE_READ) == 0) {
+    return;
+  }
+#endif
+  // touch a byte per page, e.g., on kernels before 5.14
+  for (uintptr_t page = begin; page < end; page += page_size) {
+    (void) *reinterpret_cast<volatile const uint8_t*>(
+        std::max(page, buffer.address()));
+  }
+}
+
+}  // namespace detail
+
+Status BufferSet::Prefetch(
+    std::vector<std::shared_ptr<BufferSet>> const& sets) {
+  std::shared_ptr<BufferLoader> loader = nullptr;
+  std::set<ObjectID> absent;
+  for (auto const& set : sets) {
+    if (set->loader_ == nullptr) {
+      continue;
+    }
+    loader = set->loader_;
+    for (auto const& item : set->buffers_) {
+      if (item.second == nullptr && item.first != EmptyBlobID()) {
+        absent.emplace(item.first);
+      }
+    }
+  }
+
+  for (auto const& set : sets) {
+    for (auto const& item : set->buffers_) {
+      if (item.second != nullptr && item.second->is_cpu() &&
+          item.second->size() > 0) {
+        detail::populate_pages(*item.second);
+      }
+    }
+  }
+
+  if (absent.empty()) {
+    return Status::OK();
+  }
+  std::map<ObjectID, std::shared_ptr<Buffer>> buffers;
+  RETURN_ON_ERROR(loader->Load(absent, buffers));
+  for (auto const& set : sets) {
+    for (auto& item : set->buffers_) {
+      if (item.second == nullptr) {
+        auto buffer = buffers.find(item.first);
+        if (buffer != buffers.end()) {
+          item.second = buffer->second;
+        }
+      }
+    }
+  }
+  return Status::OK();
+}
+
 }  // namespace vineyard
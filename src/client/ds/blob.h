@@ -20,9 +20,11 @@ limitations under the License.
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "client/ds/i_object.h"
 #include "common/memory/payload.h"
@@ -181,6 +183,7 @@ class CUDABufferMirror {
 };
 
 class BlobWriter;
+class BufferLoader;
 class BufferSet;
 class Client;
 class PlasmaClient;
@@ -219,6 +222,10 @@ class Blob : public Registered<Blob> {
   /**
    * @brief Get the const data pointer of the data payload in the blob.
    *
+   * The payload of a blob of a lazy remote object is fetched on the first
+   * access, which throws `std::runtime_error` if the fetching fails, e.g., on
+   * network failures or after the RPC client has been destroyed.
+   *
    * @return The const data pointer.
    */
   const char* data() const;
@@ -226,6 +233,9 @@ class Blob : public Registered<Blob> {
   /**
    * @brief Get the buffer of the blob.
    *
+   * Throws `std::runtime_error` if fetching the payload of a lazy remote blob
+   * fails, see also `data()`.
+   *
    * @return The buffer which holds the data payload
    * of the blob.
    */
@@ -317,8 +327,14 @@ class Blob : public Registered<Blob> {
 
   const std::shared_ptr<vineyard::Buffer>& BufferUnsafe() const;
 
+  void LoadLazily() const;
+
   size_t size_ = 0;
-  std::shared_ptr<vineyard::Buffer> buffer_ = nullptr;
+  mutable std::shared_ptr<vineyard::Buffer> buffer_ = nullptr;
+
+  // fetches the payload on the first access, for lazy remote blobs
+  std::shared_ptr<BufferLoader> loader_ = nullptr;
+  std::shared_ptr<std::once_flag> load_once_ = nullptr;
 
   friend class Client;
   friend class PlasmaClient;
@@ -394,6 +410,17 @@ class BlobWriter : public ObjectBuilder {
    */
   Status Shrink(Client& client, const size_t size);
 
+  /**
+   * @brief Grow the blob builder to the given size, keeping the written
+   *        content.
+   *
+   * The blob grows in place when the space after it is still free, e.g., it
+   * is created with a reserved capacity. Otherwise the content is moved to a
+   * new blob, thus `id()`, `data()` and `Buffer()` must be re-read after
+   * extending.
+   */
+  Status Extend(Client& client, const size_t size);
+
   /**
    * @brief Add key-value metadata for the blob.
    *
@@ -438,6 +465,28 @@ class BlobWriter : public ObjectBuilder {
   friend class RPCClient;
 };
 
+/**
+ * @brief BufferLoader fetches the payloads of the blobs that are not available
+ * locally, on their first access.
+ *
+ * The loader is shared by the blobs of an object, and must be safe to be
+ * called concurrently.
+ */
+class BufferLoader {
+ public:
+  virtual ~BufferLoader() = default;
+
+  virtual Status Load(ObjectID const id, std::shared_ptr<Buffer>& buffer) = 0;
+
+  /**
+   * @brief Fetch the payloads of many blobs, which are fetched one by one by
+   * default. Loaders that are able to fetch them in a single request should
+   * override it.
+   */
+  virtual Status Load(std::set<ObjectID> const& ids,
+                      std::map<ObjectID, std::shared_ptr<Buffer>>& buffers);
+};
+
 /**
  * @brief A set of (readonly) buffers that been associated with an object and
  * its members (recursively).
@@ -463,10 +512,28 @@ class BufferSet {
 
   bool Get(ObjectID const id, std::shared_ptr<Buffer>& buffer) const;
 
+  /**
+   * @brief The loader of the blobs whose buffers are absent in the set.
+   */
+  const std::shared_ptr<BufferLoader>& Loader() const { return loader_; }
+
+  void SetLoader(std::shared_ptr<BufferLoader> const& loader) {
+    loader_ = loader;
+  }
+
+  /**
+   * @brief Make the buffers of the sets ready to be accessed: the absent
+   * buffers are fetched by the loader in one batch (e.g., for lazy remote
+   * objects), and the pages of the present buffers are populated, to avoid
+   * the page faults on the first access of the memory mapped buffers.
+   */
+  static Status Prefetch(std::vector<std::shared_ptr<BufferSet>> const& sets);
+
  private:
   // blob ids to buffer mapping: local blobs (not null) + remote blobs (null).
   std::set<ObjectID> buffer_ids_;
   std::map<ObjectID, std::shared_ptr<Buffer>> buffers_;
+  std::shared_ptr<BufferLoader> loader_ = nullptr;
 };
 
 }  // namespace vineyard
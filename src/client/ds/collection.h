@@ -17,9 +17,19 @@ limitations under the License.
 #define SRC_CLIENT_DS_COLLECTION_H_
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "client/client.h"
@@ -41,8 +51,17 @@ template <typename T>
 using collection_type_t = typename collection_type<T>::type;
 
 namespace detail {
-inline std::string index_to_key(const size_t index) {
-  return "partitions_-" + std::to_string(index);
+/**
+ * The keys are formatted once per thread and then reused, as collections of
+ * thousands of partitions look them up over and over again. The keys live in
+ * a deque, thus the returned references stay valid when it grows.
+ */
+inline std::string const& index_to_key(const size_t index) {
+  static thread_local std::deque<std::string> keys;
+  while (keys.size() <= index) {
+    keys.emplace_back("partitions_-" + std::to_string(keys.size()));
+  }
+  return keys[index];
 }
 
 inline int64_t index_from_key(const std::string& key) {
@@ -76,6 +95,10 @@ class Collection : public Registered<Collection<T>>, public GlobalObject {
     iterator(const Collection<T>& collection, const size_t index)
         : collection_(collection), index_(index) {}
 
+    iterator(const Collection<T>& collection, const size_t index,
+             const size_t prefetch)
+        : collection_(collection), index_(index), prefetch_(prefetch) {}
+
     iterator& operator++() {
       if (index_ >= collection_.size()) {
         throw std::out_of_range("index out of range");
@@ -141,9 +164,20 @@ class Collection : public Registered<Collection<T>>, public GlobalObject {
       if (index_ >= collection_.size()) {
         throw std::out_of_range("index out of range");
       }
+      // refill the window once half of it has been consumed, to prefetch
+      // the partitions in batches
+      if (prefetch_ > 0 && index_ + prefetch_ / 2 >= prefetched_) {
+        size_t begin = std::max(prefetched_, index_ + 1);
+        prefetched_ = index_ + 1 + prefetch_;
+        collection_.PrefetchAsync(begin, prefetched_);
+      }
+      // drop the partitions behind the window
+      if (prefetch_ > 0 && evicted_ < index_) {
+        collection_.evictPartitions(evicted_, index_);
+        evicted_ = index_;
+      }
       std::shared_ptr<T> result = nullptr;
-      auto s = this->collection_.meta_.template GetMember<T>(
-          detail::index_to_key(index_), result);
+      auto s = this->collection_.GetMember(index_, result);
       if (s.ok()) {
         return result;
       } else {
@@ -164,8 +198,23 @@ class Collection : public Registered<Collection<T>>, public GlobalObject {
     const Collection<T>& collection_;
     size_t index_;
     bool filter_local_ = false;
+
+    // the number of partitions to prefetch ahead, the end of the
+    // partitions that have been scheduled, and the end of the partitions
+    // that have been evicted
+    size_t prefetch_ = 0;
+    mutable size_t prefetched_ = 0;
+    mutable size_t evicted_ = 0;
   };
 
+  ~Collection() override {
+    for (auto const& prefetching : prefetching_) {
+      if (prefetching.second.valid()) {
+        prefetching.second.wait();
+      }
+    }
+  }
+
   void Construct(const ObjectMeta& meta) override {
     std::string __type_name = type_name<collection_type_t<T>>();
     VINEYARD_ASSERT(meta.GetTypeName() == __type_name,
@@ -197,17 +246,225 @@ class Collection : public Registered<Collection<T>>, public GlobalObject {
     return this->meta_.GetMember(key, object);
   }
 
+  /**
+   * @brief Get the partition at `index`. The partitions are constructed
+   * lazily on the first access, and the recently constructed ones (see
+   * `SetCacheCapacity()`) are reused by the following accesses.
+   *
+   * If the partition is being prefetched, it waits for the prefetching.
+   */
   Status GetMember(const size_t index, std::shared_ptr<Object>& object) const {
-    return this->meta_.GetMember(detail::index_to_key(index), object);
+    std::shared_future<Status> prefetching;
+    {
+      std::lock_guard<std::mutex> lock(partitions_mutex_);
+      if (lookupPartition(index, object)) {
+        return Status::OK();
+      }
+      auto iter = prefetching_.find(index);
+      if (iter != prefetching_.end()) {
+        prefetching = iter->second;
+      }
+    }
+    if (prefetching.valid()) {
+      // the failures are reported by resolving the partition again below
+      prefetching.wait();
+      std::lock_guard<std::mutex> lock(partitions_mutex_);
+      prefetching_.erase(index);
+      if (lookupPartition(index, object)) {
+        return Status::OK();
+      }
+    }
+    // construct outside of the lock, as it may fetch the blobs lazily
+    RETURN_ON_ERROR(this->meta_.GetMember(detail::index_to_key(index), object));
+    std::lock_guard<std::mutex> lock(partitions_mutex_);
+    // the partition may have been constructed by others in the meantime
+    std::shared_ptr<Object> constructed;
+    if (lookupPartition(index, constructed)) {
+      object = constructed;
+    } else {
+      cachePartition(index, object);
+    }
+    return Status::OK();
   }
 
   template <typename O>
   Status GetMember(const size_t index, std::shared_ptr<O>& object) const {
-    return this->meta_.GetMember(detail::index_to_key(index), object);
+    std::shared_ptr<Object> _object;
+    RETURN_ON_ERROR(GetMember(index, _object));
+    object = std::dynamic_pointer_cast<O>(_object);
+    if (object == nullptr) {
+      return Status::ObjectTypeError(
+          type_name<O>(),
+          this->meta_.GetMemberMeta(detail::index_to_key(index)).GetTypeName());
+    }
+    return Status::OK();
+  }
+
+  /**
+   * @brief Resolve the partitions in [begin, end) in one batch: the absent
+   * buffers of them (e.g., of lazy remote objects) are fetched together, the
+   * pages of the local buffers are populated, and the partitions are
+   * constructed for the following `GetMember(index)`.
+   */
+  Status Prefetch(const size_t begin, const size_t end) const {
+    std::vector<size_t> indices;
+    std::vector<ObjectMeta> metas;
+    {
+      std::lock_guard<std::mutex> lock(partitions_mutex_);
+      for (size_t index = begin; index < std::min(end, this->size());
+           ++index) {
+        auto const& key = detail::index_to_key(index);
+        if (partitions_.find(index) != partitions_.end() ||
+            !this->meta_.HasKey(key)) {
+          continue;
+        }
+        ObjectMeta meta;
+        RETURN_ON_ERROR(this->meta_.GetMemberMeta(key, meta));
+        indices.emplace_back(index);
+        metas.emplace_back(meta);
+      }
+    }
+    if (indices.empty()) {
+      return Status::OK();
+    }
+
+    std::vector<std::shared_ptr<BufferSet>> buffer_sets;
+    for (auto const& meta : metas) {
+      buffer_sets.emplace_back(meta.GetBufferSet());
+    }
+    RETURN_ON_ERROR(BufferSet::Prefetch(buffer_sets));
+
+    // the partitions of unregistered types are left to `GetMember(index)`
+    std::vector<std::shared_ptr<Object>> objects;
+    for (auto const& meta : metas) {
+      std::shared_ptr<Object> object =
+          ObjectFactory::Create(meta.GetTypeName());
+      if (object != nullptr) {
+        object->Construct(meta);
+      }
+      objects.emplace_back(object);
+    }
+
+    std::lock_guard<std::mutex> lock(partitions_mutex_);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (objects[i] != nullptr &&
+          partitions_.find(indices[i]) == partitions_.end()) {
+        cachePartition(indices[i], objects[i]);
+      }
+    }
+    return Status::OK();
+  }
+
+  /**
+   * @brief Resolve the partitions in [begin, end) in the background, see also
+   * `Prefetch(begin, end)`. The partitions that have been resolved or
+   * scheduled are skipped.
+   */
+  void PrefetchAsync(size_t begin, size_t end) const {
+    std::lock_guard<std::mutex> lock(partitions_mutex_);
+    end = std::min(end, this->size());
+    auto resolved = [&](const size_t index) {
+      return prefetching_.find(index) != prefetching_.end() ||
+             partitions_.find(index) != partitions_.end();
+    };
+    while (begin < end && resolved(begin)) {
+      ++begin;
+    }
+    while (end > begin && resolved(end - 1)) {
+      --end;
+    }
+    if (begin >= end) {
+      return;
+    }
+    std::shared_future<Status> prefetching =
+        std::async(std::launch::async, [this, begin, end]() {
+          return this->Prefetch(begin, end);
+        }).share();
+    for (size_t index = begin; index < end; ++index) {
+      if (!resolved(index)) {
+        prefetching_[index] = prefetching;
+      }
+    }
+  }
+
+  /**
+   * @brief Visit the existing partitions, where up to `concurrency`
+   * partitions are processed in parallel, and the following `prefetch`
+   * partitions are resolved in the background.
+   *
+   * The partitions are visited in order if `concurrency` is 1. The visiting
+   * stops on the first failure, which is returned. The visited partitions
+   * are dropped from the cache.
+   */
+  Status ForEach(std::function<Status(const size_t index,
+                                      std::shared_ptr<T> const& partition)>
+                     visitor,
+                 const size_t concurrency = 1,
+                 const size_t prefetch = 0) const {
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    size_t prefetched = 0;
+    Status status = Status::OK();
+
+    auto worker = [&]() {
+      while (true) {
+        size_t index = next.fetch_add(1);
+        if (index >= this->size()) {
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!status.ok()) {
+            return;
+          }
+          if (prefetch > 0 && index + prefetch / 2 >= prefetched) {
+            size_t begin = std::max(prefetched, index + 1);
+            prefetched = index + 1 + prefetch;
+            this->PrefetchAsync(begin, prefetched);
+          }
+        }
+        if (!this->meta_.HasKey(detail::index_to_key(index))) {
+          continue;
+        }
+        std::shared_ptr<T> partition;
+        Status s = this->GetMember(index, partition);
+        if (s.ok()) {
+          s = visitor(index, partition);
+        }
+        partition.reset();
+        this->evictPartitions(index, index + 1);
+        if (!s.ok()) {
+          std::lock_guard<std::mutex> lock(mutex);
+          status += s;
+          return;
+        }
+      }
+    };
+
+    if (concurrency <= 1) {
+      worker();
+    } else {
+      std::vector<std::thread> workers;
+      for (size_t i = 0; i < concurrency; ++i) {
+        workers.emplace_back(worker);
+      }
+      for (auto& thread : workers) {
+        thread.join();
+      }
+    }
+    return status;
   }
 
   const iterator Begin() const { return iterator(*this, 0); }
 
+  /**
+   * @brief The iterator that resolves the following `prefetch` partitions in
+   * the background during iterating.
+   */
+  const iterator Begin(const size_t prefetch) const {
+    return iterator(*this, 0, prefetch);
+  }
+
   const iterator End() const { return iterator(*this, this->size()); }
 
   /**
@@ -227,12 +484,95 @@ class Collection : public Registered<Collection<T>>, public GlobalObject {
 
   const iterator LocalEnd() const { return End(); }
 
+  /**
+   * @brief Set the maximum number of constructed partitions that are kept
+   * for the following accesses, the least recently used ones are dropped
+   * first, and 0 disables the caching. Defaults to `kDefaultCacheCapacity`.
+   *
+   * The capacity is expected to cover the prefetching window, otherwise the
+   * prefetched partitions may be dropped before being accessed.
+   */
+  void SetCacheCapacity(const size_t capacity) {
+    std::lock_guard<std::mutex> lock(partitions_mutex_);
+    cache_capacity_ = capacity;
+    shrinkPartitions();
+  }
+
+  static constexpr size_t kDefaultCacheCapacity = 64;
+
  protected:
   Client* client_ = nullptr;
   std::map<std::string, std::string> params_;
 
  private:
+  // requires `partitions_mutex_`
+  bool lookupPartition(const size_t index,
+                       std::shared_ptr<Object>& object) const {
+    auto iter = partitions_.find(index);
+    if (iter == partitions_.end()) {
+      return false;
+    }
+    partitions_order_.splice(partitions_order_.end(), partitions_order_,
+                             iter->second.second);
+    object = iter->second.first;
+    return true;
+  }
+
+  // requires `partitions_mutex_`
+  void cachePartition(const size_t index,
+                      std::shared_ptr<Object> const& object) const {
+    if (cache_capacity_ == 0) {
+      return;
+    }
+    partitions_order_.emplace_back(index);
+    partitions_[index] =
+        std::make_pair(object, std::prev(partitions_order_.end()));
+    shrinkPartitions();
+  }
+
+  // drops the partitions in [begin, end) that are behind the iterating
+  // window, the futures are released outside of the lock, as the last
+  // reference of an async future blocks until the prefetching finishes
+  void evictPartitions(const size_t begin, const size_t end) const {
+    std::vector<std::shared_future<Status>> evicted;
+    std::lock_guard<std::mutex> lock(partitions_mutex_);
+    auto iter = prefetching_.lower_bound(begin);
+    while (iter != prefetching_.end() && iter->first < end) {
+      evicted.emplace_back(std::move(iter->second));
+      iter = prefetching_.erase(iter);
+    }
+    for (size_t index = begin; index < end; ++index) {
+      auto partition = partitions_.find(index);
+      if (partition != partitions_.end()) {
+        partitions_order_.erase(partition->second.second);
+        partitions_.erase(partition);
+      }
+    }
+  }
+
+  // requires `partitions_mutex_`
+  void shrinkPartitions() const {
+    while (partitions_.size() > cache_capacity_) {
+      partitions_.erase(partitions_order_.front());
+      partitions_order_.pop_front();
+    }
+  }
+
   size_t chunk_size_ = 0;
+
+  // lazily constructed partitions, see `GetMember(index, object)`, with the
+  // least recently used ones in the front of `partitions_order_`
+  mutable std::unordered_map<
+      size_t,
+      std::pair<std::shared_ptr<Object>, std::list<size_t>::iterator>>
+      partitions_;
+  mutable std::list<size_t> partitions_order_;
+  size_t cache_capacity_ = kDefaultCacheCapacity;
+  mutable std::mutex partitions_mutex_;
+
+  // the partitions that are being prefetched, see `PrefetchAsync()`, which
+  // are dropped once accessed or evicted
+  mutable std::map<size_t, std::shared_future<Status>> prefetching_;
 };
 
 /**
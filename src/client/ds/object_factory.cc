@@ -32,21 +32,11 @@ limitations under the License.
 namespace vineyard {
 
 std::unique_ptr<Object> ObjectFactory::Create(std::string const& type_name) {
-  auto& known_types = getKnownTypes();
-  auto creator = known_types.find(type_name);
-  if (creator == known_types.end()) {
-#ifndef NDEBUG
-    static bool __trace = !read_env("VINEYARD_TRACE_REGISTRY").empty();
-    if (__trace) {
-      std::clog << "[debug] create an instance with the unknown typename: "
-                << type_name << std::endl;
-    }
-
-#endif
+  auto initializer = resolve(type_name);
+  if (initializer == nullptr) {
     return nullptr;
-  } else {
-    return (creator->second)();
   }
+  return initializer();
 }
 
 std::unique_ptr<Object> ObjectFactory::Create(ObjectMeta const& metadata) {
@@ -55,6 +45,41 @@ std::unique_ptr<Object> ObjectFactory::Create(ObjectMeta const& metadata) {
 
 std::unique_ptr<Object> ObjectFactory::Create(std::string const& type_name,
                                               ObjectMeta const& metadata) {
+  auto initializer = resolve(type_name);
+  if (initializer == nullptr) {
+    return nullptr;
+  }
+  auto target = initializer();
+  target->Construct(metadata);
+  return target;
+}
+
+ObjectFactory::object_initializer_t ObjectFactory::resolve(
+    std::string const& type_name) {
+  struct entry_t {
+    std::string type_name;
+    object_initializer_t initializer = nullptr;
+  };
+  static constexpr size_t kCacheSize = 8;
+  static thread_local entry_t cache[kCacheSize];
+  static thread_local size_t cache_cursor = 0;
+  static thread_local size_t cache_generation = 0;
+
+  // a registration (by loading more libraries) may add or replace types,
+  // flush the memoized entries when that happens
+  const size_t generation = getGeneration().load(std::memory_order_acquire);
+  if (cache_generation != generation) {
+    for (auto& entry : cache) {
+      entry.initializer = nullptr;
+    }
+    cache_generation = generation;
+  }
+  for (auto const& entry : cache) {
+    if (entry.initializer != nullptr && entry.type_name == type_name) {
+      return entry.initializer;
+    }
+  }
+
   auto& known_types = getKnownTypes();
   auto creator = known_types.find(type_name);
   if (creator == known_types.end()) {
@@ -66,11 +91,11 @@ std::unique_ptr<Object> ObjectFactory::Create(std::string const& type_name,
     }
 #endif
     return nullptr;
-  } else {
-    auto target = (creator->second)();
-    target->Construct(metadata);
-    return target;
   }
+  auto& entry = cache[cache_cursor++ % kCacheSize];
+  entry.type_name = type_name;
+  entry.initializer = creator->second;
+  return creator->second;
 }
 
 const std::unordered_map<std::string, ObjectFactory::object_initializer_t>&
@@ -247,6 +272,11 @@ ObjectFactory::getKnownTypes() {
   return *__internal__registry;
 }
 
+std::atomic<size_t>& ObjectFactory::getGeneration() {
+  static std::atomic<size_t> generation{0};
+  return generation;
+}
+
 vineyard_registry_handler_t ObjectFactory::__registry_handle = nullptr;
 vineyard_registry_getter_t ObjectFactory::__GetGlobalRegistry = nullptr;
 
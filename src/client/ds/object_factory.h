@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <dlfcn.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -80,6 +81,7 @@ class ObjectFactory {
     auto& known_types = getKnownTypes();
     // the explicit `static_cast` is used to help overloading resolution.
     known_types[name] = static_cast<object_initializer_t>(&T::Create);
+    getGeneration().fetch_add(1, std::memory_order_release);
     return true;
   }
 
@@ -123,6 +125,18 @@ class ObjectFactory {
   // https://isocpp.org/wiki/faq/ctors#static-init-order-on-first-use
   static std::unordered_map<std::string, object_initializer_t>& getKnownTypes();
 
+  // bumped on every registration, to flush the memoized typenames
+  static std::atomic<size_t>& getGeneration();
+
+  /**
+   * @brief Resolve the initializer of `type_name`, or nullptr if unknown.
+   *
+   * The members of an object tree usually share a handful of (long, templated)
+   * typenames, e.g., the columns of a table, the recently resolved ones are
+   * memoized per thread to skip the hashing against the registry.
+   */
+  static object_initializer_t resolve(std::string const& type_name);
+
   static vineyard_registry_handler_t __registry_handle;
   static vineyard_registry_getter_t __GetGlobalRegistry;
 };
@@ -216,15 +216,10 @@ Status ObjectMeta::GetMemberMeta(const std::string& name,
                    "Failed to get member '" + name + "'");
 
   meta.Reset();
-  meta.SetMetaData(this->client_, child_meta);
-  auto const& all_blobs = buffer_set_->AllBuffers();
-  for (auto const& blob : meta.buffer_set_->AllBuffers()) {
-    auto iter = all_blobs.find(blob.first);
-    // for remote object, the blob may not present here
-    if (iter != all_blobs.end()) {
-      meta.SetBuffer(blob.first, iter->second);
-    }
-  }
+  meta.client_ = this->client_;
+  meta.meta_ = child_meta;
+  meta.findAllBlobs(meta.meta_, buffer_set_.get());
+  meta.buffer_set_->SetLoader(buffer_set_->Loader());
   if (this->force_local_) {
     meta.ForceLocal();
   }
@@ -339,34 +334,42 @@ json& ObjectMeta::MutMetaData() { return meta_; }
 void ObjectMeta::SetMetaData(ClientBase* client, const json& meta) {
   this->client_ = client;
   this->meta_ = meta;
+  findAllBlobs(this->meta_, nullptr);
+}
 
-  std::function<void(const json&)> traverse = [this,
-                                               &traverse](const json& tree) {
-    if (!tree.is_object() || tree.empty()) {
-      return;
-    }
-    ObjectID member_id =
-        ObjectIDFromString(tree["id"].get_ref<std::string const&>());
-    if (IsBlob(member_id)) {
-      if (client_ == nullptr) {
-        VINEYARD_CHECK_OK(buffer_set_->EmplaceBuffer(member_id));
-      } else {
-        InstanceID instance_id = tree["instance_id"].get<InstanceID>();
-        if ((client_->IsIPC() && instance_id == client_->instance_id()) ||
+void ObjectMeta::findAllBlobs(const json& tree, const BufferSet* parent) {
+  if (!tree.is_object() || tree.empty()) {
+    return;
+  }
+  ObjectID member_id =
+      ObjectIDFromString(tree["id"].get_ref<std::string const&>());
+  if (IsBlob(member_id)) {
+    if (client_ != nullptr) {
+      InstanceID instance_id = tree["instance_id"].get<InstanceID>();
+      if (!((client_->IsIPC() && instance_id == client_->instance_id()) ||
             (client_->IsRPC() &&
-             instance_id == client_->remote_instance_id())) {
-          VINEYARD_CHECK_OK(buffer_set_->EmplaceBuffer(member_id));
-        }
+             instance_id == client_->remote_instance_id()))) {
+        return;
       }
-    } else {
-      for (auto& item : tree) {
-        if (item.is_object()) {
-          traverse(item);
-        }
+    }
+    // the same blob may be referred by more than one member
+    if (buffer_set_->Contains(member_id)) {
+      return;
+    }
+    VINEYARD_CHECK_OK(buffer_set_->EmplaceBuffer(member_id));
+    std::shared_ptr<Buffer> buffer;
+    // for remote object, the blob may not present in the parent
+    if (parent != nullptr && parent->Get(member_id, buffer) &&
+        buffer != nullptr) {
+      VINEYARD_CHECK_OK(buffer_set_->EmplaceBuffer(member_id, buffer));
+    }
+  } else {
+    for (auto& item : tree) {
+      if (item.is_object()) {
+        findAllBlobs(item, parent);
       }
     }
-  };
-  traverse(this->meta_);
+  }
 }
 
 std::unique_ptr<ObjectMeta> ObjectMeta::Unsafe(std::string meta,
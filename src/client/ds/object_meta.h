@@ -773,6 +773,10 @@ class ObjectMeta {
  private:
   void SetInstanceId(const InstanceID instance_id);
 
+  // Collect the (local) blobs inside `tree` into the buffer set, and fill the
+  // buffers from `parent` when given, in a single pass.
+  void findAllBlobs(const json& tree, const BufferSet* parent);
+
   void SetSignature(const Signature signature);
 
   // hold a client_ reference, since we already hold blobs in metadata, which,
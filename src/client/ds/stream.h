@@ -92,7 +92,7 @@ class Stream : public Object {
     return client_->ClientBase::StopStream(this->id_, true);
   }
 
-  Status Finish() {
+  virtual Status Finish() {
     RETURN_ON_ASSERT(client_ != nullptr && readonly_ == false,
                      "Expect a writeable stream");
     if (stopped_) {
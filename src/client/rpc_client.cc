@@ -37,7 +37,70 @@ limitations under the License.
 
 namespace vineyard {
 
-RPCClient::~RPCClient() { Disconnect(); }
+namespace detail {
+
+/**
+ * @brief Fetches the blobs of a lazy remote object on their first access.
+ *
+ * The loader may outlive the client: it is detached when the client is
+ * destroyed, after which loading fails with a connection error.
+ */
+class RemoteBlobLoader : public BufferLoader {
+ public:
+  explicit RemoteBlobLoader(RPCClient* client) : client_(client) {}
+
+  Status Load(ObjectID const id, std::shared_ptr<Buffer>& buffer) override {
+    std::lock_guard<std::mutex> __guard(this->mutex_);
+    RETURN_ON_ERROR(ensureAttached());
+    std::shared_ptr<RemoteBlob> remote_blob;
+    RETURN_ON_ERROR(client_->GetRemoteBlob(id, remote_blob));
+    buffer = remote_blob->Buffer();
+    return Status::OK();
+  }
+
+  Status Load(std::set<ObjectID> const& ids,
+              std::map<ObjectID, std::shared_ptr<Buffer>>& buffers) override {
+    std::lock_guard<std::mutex> __guard(this->mutex_);
+    RETURN_ON_ERROR(ensureAttached());
+    std::map<ObjectID, std::shared_ptr<RemoteBlob>> remote_blobs;
+    RETURN_ON_ERROR(client_->GetRemoteBlobs(ids, remote_blobs));
+    for (auto const& item : remote_blobs) {
+      if (item.second != nullptr) {
+        buffers.emplace(item.first, item.second->Buffer());
+      }
+    }
+    return Status::OK();
+  }
+
+  /**
+   * @brief Detach the loader from the client, waiting for the ongoing loads.
+   */
+  void Detach() {
+    std::lock_guard<std::mutex> __guard(this->mutex_);
+    client_ = nullptr;
+  }
+
+ private:
+  Status ensureAttached() const {
+    if (client_ == nullptr) {
+      return Status::ConnectionError(
+          "The RPC client of the lazy remote object has been destroyed");
+    }
+    return Status::OK();
+  }
+
+  std::mutex mutex_;
+  RPCClient* client_;
+};
+
+}  // namespace detail
+
+RPCClient::~RPCClient() {
+  if (remote_blob_loader_ != nullptr) {
+    remote_blob_loader_->Detach();
+  }
+  Disconnect();
+}
 
 Status RPCClient::Connect() {
   auto ep = read_env("VINEYARD_RPC_ENDPOINT");
@@ -205,6 +268,91 @@ Status RPCClient::GetObject(const ObjectID id,
   return Status::OK();
 }
 
+Status RPCClient::GetObject(const ObjectID id, std::shared_ptr<Object>& object,
+                            const bool lazy) {
+  if (!lazy) {
+    return this->GetObject(id, object);
+  }
+  ObjectMeta meta;
+  RETURN_ON_ERROR(this->GetMetaData(id, meta, true));
+  RETURN_ON_ASSERT(!meta.MetaData().empty());
+
+  meta.buffer_set_->SetLoader(remoteBlobLoader());
+  meta.ForceLocal();
+
+  object = ObjectFactory::Create(meta.GetTypeName());
+  if (object == nullptr) {
+    object = std::unique_ptr<Object>(new Object());
+  }
+  object->Construct(meta);
+  return Status::OK();
+}
+
+std::shared_ptr<detail::RemoteBlobLoader> RPCClient::remoteBlobLoader() {
+  std::lock_guard<std::recursive_mutex> __guard(this->client_mutex_);
+  if (remote_blob_loader_ == nullptr) {
+    remote_blob_loader_ = std::make_shared<detail::RemoteBlobLoader>(this);
+  }
+  return remote_blob_loader_;
+}
+
+Status RPCClient::GetObjectMembers(
+    const ObjectID id, std::vector<std::string> const& paths,
+    std::vector<std::shared_ptr<Object>>& members) {
+  ObjectMeta meta;
+  RETURN_ON_ERROR(this->GetMetaData(id, meta, true));
+  RETURN_ON_ASSERT(!meta.MetaData().empty());
+
+  // resolve the members, and collect the blobs they require
+  std::vector<ObjectMeta> metas(paths.size());
+  std::set<ObjectID> blobs;
+  for (size_t index = 0; index < paths.size(); ++index) {
+    ObjectMeta current = meta;
+    size_t begin = 0;
+    while (begin <= paths[index].size()) {
+      size_t end = paths[index].find('/', begin);
+      if (end == std::string::npos) {
+        end = paths[index].size();
+      }
+      if (end > begin) {
+        ObjectMeta member;
+        RETURN_ON_ERROR(current.GetMemberMeta(
+            paths[index].substr(begin, end - begin), member));
+        current = member;
+      }
+      begin = end + 1;
+    }
+    metas[index] = current;
+    auto const& ids = current.buffer_set_->AllBufferIds();
+    blobs.insert(ids.begin(), ids.end());
+  }
+
+  std::map<ObjectID, std::shared_ptr<RemoteBlob>> remote_blobs;
+  RETURN_ON_ERROR(GetRemoteBlobs(blobs, remote_blobs));
+
+  auto loader = remoteBlobLoader();
+  members.clear();
+  for (auto& member_meta : metas) {
+    for (auto const& item : remote_blobs) {
+      if (item.second != nullptr &&
+          member_meta.buffer_set_->Contains(item.first)) {
+        RETURN_ON_ERROR(member_meta.buffer_set_->EmplaceBuffer(
+            item.first, item.second->Buffer()));
+      }
+    }
+    member_meta.buffer_set_->SetLoader(loader);
+    member_meta.ForceLocal();
+
+    auto object = ObjectFactory::Create(member_meta.GetTypeName());
+    if (object == nullptr) {
+      object = std::unique_ptr<Object>(new Object());
+    }
+    object->Construct(member_meta);
+    members.emplace_back(std::shared_ptr<Object>(object.release()));
+  }
+  return Status::OK();
+}
+
 std::vector<std::shared_ptr<Object>> RPCClient::GetObjects(
     const std::vector<ObjectID>& ids) {
   std::vector<std::shared_ptr<Object>> objects(ids.size());
@@ -503,6 +651,42 @@ Status RPCClient::GetRemoteBlob(const ObjectID& id, const bool unsafe,
   return Status::OK();
 }
 
+Status RPCClient::GetRemoteBlob(const ObjectID& id, const size_t offset,
+                                const size_t length,
+                                std::shared_ptr<RemoteBlob>& buffer) {
+  ENSURE_CONNECTED(this);
+  std::shared_ptr<Decompressor> decompressor;
+  if (compression_enabled()) {
+    decompressor = std::make_shared<Decompressor>();
+  }
+
+  std::vector<Payload> payloads;
+  std::vector<int> fd_sent;
+
+  std::string message_out;
+  WriteGetRemoteBuffersRequest(std::vector<ObjectID>{id},
+                               {std::make_pair(offset, length)}, false,
+                               !!decompressor, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadGetBuffersReply(message_in, payloads, fd_sent));
+  RETURN_ON_ASSERT(payloads.size() == 1, "Expects only one payload");
+
+  // read the actual payload
+  buffer = std::shared_ptr<RemoteBlob>(new RemoteBlob(
+      payloads[0].object_id, remote_instance_id_, payloads[0].data_size));
+  if (decompressor && payloads[0].data_size > 0) {
+    RETURN_ON_ERROR(detail::recv_and_decompress(decompressor, vineyard_conn_,
+                                                buffer->mutable_data(),
+                                                payloads[0].data_size));
+  } else if (payloads[0].data_size > 0) {
+    RETURN_ON_ERROR(recv_bytes(vineyard_conn_, buffer->mutable_data(),
+                               payloads[0].data_size));
+  }
+  return Status::OK();
+}
+
 Status RPCClient::GetRemoteBlobs(
     std::vector<ObjectID> const& ids,
     std::vector<std::shared_ptr<RemoteBlob>>& remote_blobs) {
@@ -34,6 +34,10 @@ namespace vineyard {
 class Blob;
 class BlobWriter;
 
+namespace detail {
+class RemoteBlobLoader;
+}  // namespace detail
+
 class RPCClient final : public ClientBase {
  public:
   ~RPCClient() override;
@@ -184,6 +188,49 @@ class RPCClient final : public ClientBase {
    */
   Status GetObject(const ObjectID id, std::shared_ptr<Object>& object);
 
+  /**
+   * @brief Get an object from vineyard, and optionally defer fetching the
+   * payloads of its blobs.
+   *
+   * When `lazy` is true, no blob is transferred before the object is
+   * constructed, each blob is fetched from the remote server on its first
+   * access instead. Note that objects that access all their blobs during
+   * `Construct()` still fetch them all, in that case use `GetObjectMembers`
+   * to construct the required members only.
+   *
+   * A blob that fails to be fetched on its first access, e.g., on network
+   * failures or after the client has been destroyed, throws
+   * `std::runtime_error` from `Blob::data()` and `Blob::Buffer()`.
+   *
+   * @param id The object id to get.
+   * @param object The result object will be set in parameter `object`.
+   * @param lazy Whether to fetch the blobs on their first access.
+   *
+   * @return When errors occur during the request, this method won't throw
+   * exceptions, rather, it results a status to represents the error.
+   */
+  Status GetObject(const ObjectID id, std::shared_ptr<Object>& object,
+                   const bool lazy);
+
+  /**
+   * @brief Get some members of an object from vineyard, only the blobs of
+   * the requested members are transferred, in a single request.
+   *
+   * A member path is a sequence of member names that are separated by `/`,
+   * e.g., `__values_-value-0` (the first column of a dataframe), or
+   * `partitions_-1/buffer_` (a blob in the second member of a global object).
+   *
+   * @param id The object id.
+   * @param paths The paths of the members to get.
+   * @param members The result members, in the order of `paths`.
+   *
+   * @return When errors occur during the request, this method won't throw
+   * exceptions, rather, it results a status to represents the error.
+   */
+  Status GetObjectMembers(const ObjectID id,
+                          std::vector<std::string> const& paths,
+                          std::vector<std::shared_ptr<Object>>& members);
+
   /**
    * @brief Get multiple objects from vineyard.
    *
@@ -334,6 +381,17 @@ class RPCClient final : public ClientBase {
   Status GetRemoteBlob(const ObjectID& id, const bool unsafe,
                        std::shared_ptr<RemoteBlob>& buffer);
 
+  /**
+   * @brief Get the [offset, offset + length) byte range of the remote blob of
+   * the connected vineyard server, using the RPC socket.
+   *
+   * The range is clipped at the end of the blob, i.e., the result blob may
+   * be shorter than `length`.
+   */
+  Status GetRemoteBlob(const ObjectID& id, const size_t offset,
+                       const size_t length,
+                       std::shared_ptr<RemoteBlob>& buffer);
+
   /**
    * @brief Get the remote blobs of the connected vineyard server, using the RPC
    * socket.
@@ -361,8 +419,13 @@ class RPCClient final : public ClientBase {
       std::map<ObjectID, std::shared_ptr<RemoteBlob>>& remote_blobs);
 
  private:
+  std::shared_ptr<detail::RemoteBlobLoader> remoteBlobLoader();
+
   InstanceID remote_instance_id_;
 
+  // shared by the lazy remote objects, see also `GetObject(id, object, lazy)`
+  std::shared_ptr<detail::RemoteBlobLoader> remote_blob_loader_;
+
   friend class Client;
 };
 
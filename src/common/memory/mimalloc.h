@@ -100,6 +100,12 @@ class Mimalloc {
     return mi_heap_realloc(heap, pointer, size);
   }
 
+  /**
+   * @brief Grow the block in place, within the slack of its size class, or
+   * returns nullptr.
+   */
+  void* Expand(void* pointer, size_t size) { return mi_expand(pointer, size); }
+
   void Free(void* pointer, size_t size = 0) {
     if (likely(pointer)) {
       if (unlikely(size)) {
@@ -112,6 +118,14 @@ class Mimalloc {
 
   size_t GetAllocatedSize(void* pointer) { return mi_usable_size(pointer); }
 
+  /**
+   * @brief Visit the areas (pages of the same block size) of the heap, the
+   * blocks inside the areas won't be visited.
+   */
+  bool VisitAreas(mi_block_visit_fun* visitor, void* arg) const {
+    return mi_heap_visit_blocks(heap, false, visitor, arg);
+  }
+
  private:
   void* aligned_address = nullptr;
   size_t aligned_size = 0;
@@ -70,6 +70,8 @@ const std::string command_t::DROP_BUFFER_REQUEST = "drop_buffer_request";
 const std::string command_t::DROP_BUFFER_REPLY = "drop_buffer_reply";
 const std::string command_t::SHRINK_BUFFER_REQUEST = "shrink_buffer_request";
 const std::string command_t::SHRINK_BUFFER_REPLY = "shrink_buffer_reply";
+const std::string command_t::EXTEND_BUFFER_REQUEST = "extend_buffer_request";
+const std::string command_t::EXTEND_BUFFER_REPLY = "extend_buffer_reply";
 
 const std::string command_t::REQUEST_FD_REQUEST = "request_fd_request";
 const std::string command_t::REQUEST_FD_REPLY = "request_fd_reply";
@@ -322,6 +324,24 @@ Status ReadCreateBufferRequest(const json& root, size_t& size) {
   return Status::OK();
 }
 
+void WriteCreateBufferRequest(const size_t size, const size_t capacity,
+                              std::string& msg) {
+  json root;
+  root["type"] = command_t::CREATE_BUFFER_REQUEST;
+  root["size"] = size;
+  root["capacity"] = capacity;
+
+  encode_msg(root, msg);
+}
+
+Status ReadCreateBufferRequest(const json& root, size_t& size,
+                               size_t& capacity) {
+  CHECK_IPC_ERROR(root, command_t::CREATE_BUFFER_REQUEST);
+  size = root["size"].get<size_t>();
+  capacity = root.value("capacity", static_cast<size_t>(0));
+  return Status::OK();
+}
+
 void WriteCreateBufferReply(const ObjectID id,
                             const std::shared_ptr<Payload>& object,
                             const int fd_to_send, std::string& msg) {
@@ -710,6 +730,47 @@ Status ReadShrinkBufferReply(const json& root) {
   return Status::OK();
 }
 
+void WriteExtendBufferRequest(const ObjectID id, const size_t size,
+                              std::string& msg) {
+  json root;
+  root["type"] = command_t::EXTEND_BUFFER_REQUEST;
+  root["id"] = id;
+  root["size"] = size;
+
+  encode_msg(root, msg);
+}
+
+Status ReadExtendBufferRequest(const json& root, ObjectID& id, size_t& size) {
+  CHECK_IPC_ERROR(root, command_t::EXTEND_BUFFER_REQUEST);
+  id = root["id"].get<ObjectID>();
+  size = root["size"].get<size_t>();
+  return Status::OK();
+}
+
+void WriteExtendBufferReply(const ObjectID id,
+                            const std::shared_ptr<Payload>& object,
+                            const int fd_to_send, std::string& msg) {
+  json root;
+  root["type"] = command_t::EXTEND_BUFFER_REPLY;
+  root["id"] = id;
+  root["fd"] = fd_to_send;
+  json tree;
+  object->ToJSON(tree);
+  root["extended"] = tree;
+
+  encode_msg(root, msg);
+}
+
+Status ReadExtendBufferReply(const json& root, ObjectID& id, Payload& object,
+                             int& fd_sent) {
+  CHECK_IPC_ERROR(root, command_t::EXTEND_BUFFER_REPLY);
+  json tree = root["extended"];
+  id = root["id"].get<ObjectID>();
+  object.FromJSON(tree);
+  fd_sent = root.value("fd", -1);
+  return Status::OK();
+}
+
 void WriteCreateRemoteBufferRequest(const size_t size, std::string& msg) {
   WriteCreateRemoteBufferRequest(size, false, msg);
 }
@@ -794,6 +855,24 @@ void WriteGetRemoteBuffersRequest(const std::unordered_set<ObjectID>& ids,
   encode_msg(root, msg);
 }
 
+void WriteGetRemoteBuffersRequest(
+    const std::vector<ObjectID>& ids,
+    const std::vector<std::pair<size_t, size_t>>& ranges, const bool unsafe,
+    const bool compress, std::string& msg) {
+  json root;
+  root["type"] = command_t::GET_REMOTE_BUFFERS_REQUEST;
+  int idx = 0;
+  for (auto const& id : ids) {
+    root[std::to_string(idx++)] = id;
+  }
+  root["num"] = ids.size();
+  root["ranges"] = ranges;
+  root["unsafe"] = unsafe;
+  root["compress"] = compress;
+
+  encode_msg(root, msg);
+}
+
 Status ReadGetRemoteBuffersRequest(const json& root, std::vector<ObjectID>& ids,
                                    bool& unsafe, bool& compress) {
   CHECK_IPC_ERROR(root, command_t::GET_REMOTE_BUFFERS_REQUEST);
@@ -806,6 +885,17 @@ Status ReadGetRemoteBuffersRequest(const json& root, std::vector<ObjectID>& ids,
   return Status::OK();
 }
 
+Status ReadGetRemoteBuffersRequest(
+    const json& root, std::vector<ObjectID>& ids,
+    std::vector<std::pair<size_t, size_t>>& ranges, bool& unsafe,
+    bool& compress) {
+  RETURN_ON_ERROR(ReadGetRemoteBuffersRequest(root, ids, unsafe, compress));
+  if (root.contains("ranges")) {
+    root["ranges"].get_to(ranges);
+  }
+  return Status::OK();
+}
+
 void WriteIncreaseReferenceCountRequest(const std::vector<ObjectID>& ids,
                                         std::string& msg) {
   json root;
@@ -1543,20 +1633,23 @@ Status ReadGetNextStreamChunkReply(const json& root, Payload& object,
 }
 
 void WritePushNextStreamChunkRequest(const ObjectID stream_id,
-                                     const ObjectID chunk, std::string& msg) {
+                                     const ObjectID chunk, const bool retained,
+                                     std::string& msg) {
   json root;
   root["type"] = command_t::PUSH_NEXT_STREAM_CHUNK_REQUEST;
   root["id"] = stream_id;
   root["chunk"] = chunk;
+  root["retained"] = retained;
 
   encode_msg(root, msg);
 }
 
 Status ReadPushNextStreamChunkRequest(const json& root, ObjectID& stream_id,
-                                      ObjectID& chunk) {
+                                      ObjectID& chunk, bool& retained) {
   CHECK_IPC_ERROR(root, command_t::PUSH_NEXT_STREAM_CHUNK_REQUEST);
   stream_id = root["id"].get<ObjectID>();
   chunk = root["chunk"].get<ObjectID>();
+  retained = root.value("retained", false);
   return Status::OK();
 }
 
@@ -1586,17 +1679,21 @@ Status ReadPullNextStreamChunkRequest(const json& root, ObjectID& stream_id) {
   return Status::OK();
 }
 
-void WritePullNextStreamChunkReply(ObjectID const chunk, std::string& msg) {
+void WritePullNextStreamChunkReply(ObjectID const chunk, const bool retained,
+                                   std::string& msg) {
   json root;
   root["type"] = command_t::PULL_NEXT_STREAM_CHUNK_REPLY;
   root["chunk"] = chunk;
+  root["retained"] = retained;
 
   encode_msg(root, msg);
 }
 
-Status ReadPullNextStreamChunkReply(const json& root, ObjectID& chunk) {
+Status ReadPullNextStreamChunkReply(const json& root, ObjectID& chunk,
+                                   bool& retained) {
   CHECK_IPC_ERROR(root, command_t::PULL_NEXT_STREAM_CHUNK_REPLY);
   chunk = root["chunk"].get<ObjectID>();
+  retained = root.value("retained", false);
   return Status::OK();
 }
 
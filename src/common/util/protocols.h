@@ -22,6 +22,7 @@ limitations under the License.
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/memory/payload.h"
@@ -57,6 +58,8 @@ struct command_t {
   static const std::string DROP_BUFFER_REPLY;
   static const std::string SHRINK_BUFFER_REQUEST;
   static const std::string SHRINK_BUFFER_REPLY;
+  static const std::string EXTEND_BUFFER_REQUEST;
+  static const std::string EXTEND_BUFFER_REPLY;
 
   static const std::string REQUEST_FD_REQUEST;
   static const std::string REQUEST_FD_REPLY;
@@ -210,6 +213,12 @@ void WriteCreateBufferRequest(const size_t size, std::string& msg);
 
 Status ReadCreateBufferRequest(const json& root, size_t& size);
 
+void WriteCreateBufferRequest(const size_t size, const size_t capacity,
+                              std::string& msg);
+
+Status ReadCreateBufferRequest(const json& root, size_t& size,
+                               size_t& capacity);
+
 void WriteCreateBufferReply(const ObjectID id,
                             const std::shared_ptr<Payload>& object,
                             const int fd_to_send, std::string& msg);
@@ -313,6 +322,18 @@ void WriteShrinkBufferReply(std::string& msg);
 
 Status ReadShrinkBufferReply(const json& root);
 
+void WriteExtendBufferRequest(const ObjectID id, const size_t size,
+                              std::string& msg);
+
+Status ReadExtendBufferRequest(const json& root, ObjectID& id, size_t& size);
+
+void WriteExtendBufferReply(const ObjectID id,
+                            const std::shared_ptr<Payload>& object,
+                            const int fd_to_send, std::string& msg);
+
+Status ReadExtendBufferReply(const json& root, ObjectID& id, Payload& object,
+                             int& fd_sent);
+
 void WriteRequestFDRequest(std::vector<int> fds, std::string& msg);
 
 Status ReadRequestFDRequest(const json& root, size_t& size, bool& skip_fd);
@@ -353,9 +374,19 @@ void WriteGetRemoteBuffersRequest(const std::unordered_set<ObjectID>& ids,
                                   const bool unsafe, const bool compress,
                                   std::string& msg);
 
+void WriteGetRemoteBuffersRequest(
+    const std::vector<ObjectID>& ids,
+    const std::vector<std::pair<size_t, size_t>>& ranges, const bool unsafe,
+    const bool compress, std::string& msg);
+
 Status ReadGetRemoteBuffersRequest(const json& root, std::vector<ObjectID>& ids,
                                    bool& unsafe, bool& compress);
 
+Status ReadGetRemoteBuffersRequest(
+    const json& root, std::vector<ObjectID>& ids,
+    std::vector<std::pair<size_t, size_t>>& ranges, bool& unsafe,
+    bool& compress);
+
 void WriteIncreaseReferenceCountRequest(const std::vector<ObjectID>& ids,
                                         std::string& msg);
 
@@ -597,10 +628,11 @@ Status ReadGetNextStreamChunkReply(const json& root, Payload& object,
                                    int& fd_sent);
 
 void WritePushNextStreamChunkRequest(const ObjectID stream_id,
-                                     const ObjectID chunk, std::string& msg);
+                                     const ObjectID chunk, const bool retained,
+                                     std::string& msg);
 
 Status ReadPushNextStreamChunkRequest(const json& root, ObjectID& stream_id,
-                                      ObjectID& chunk);
+                                      ObjectID& chunk, bool& retained);
 
 void WritePushNextStreamChunkReply(std::string& msg);
 
@@ -611,9 +643,11 @@ void WritePullNextStreamChunkRequest(const ObjectID stream_id,
 
 Status ReadPullNextStreamChunkRequest(const json& root, ObjectID& stream_id);
 
-void WritePullNextStreamChunkReply(ObjectID const chunk, std::string& msg);
+void WritePullNextStreamChunkReply(ObjectID const chunk, const bool retained,
+                                   std::string& msg);
 
-Status ReadPullNextStreamChunkReply(const json& root, ObjectID& chunk);
+Status ReadPullNextStreamChunkReply(const json& root, ObjectID& chunk,
+                                   bool& retained);
 
 void WriteStopStreamRequest(const ObjectID stream_id, const bool failed,
                             std::string& msg);
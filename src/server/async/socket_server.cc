@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "server/async/socket_server.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <memory>
@@ -263,6 +264,8 @@ bool SocketConnection::processMessage(const std::string& message_in) {
     return doDropBuffer(root);
   } else if (cmd == command_t::SHRINK_BUFFER_REQUEST) {
     return doShrinkBuffer(root);
+  } else if (cmd == command_t::EXTEND_BUFFER_REQUEST) {
+    return doExtendBuffer(root);
   } else if (cmd == command_t::CREATE_REMOTE_BUFFER_REQUEST) {
     return doCreateRemoteBuffer(root);
   } else if (cmd == command_t::CREATE_REMOTE_BUFFERS_REQUEST) {
@@ -402,13 +405,17 @@ bool SocketConnection::doRegister(const json& root) {
 
 bool SocketConnection::doCreateBuffer(const json& root) {
   auto self(shared_from_this());
-  size_t size;
+  size_t size, capacity;
   std::shared_ptr<Payload> object;
   std::string message_out;
 
-  TRY_READ_REQUEST(ReadCreateBufferRequest, root, size);
+  TRY_READ_REQUEST(ReadCreateBufferRequest, root, size, capacity);
   ObjectID object_id;
-  RESPONSE_ON_ERROR(bulk_store_->Create(size, object_id, object));
+  if (capacity > size) {
+    RESPONSE_ON_ERROR(bulk_store_->Create(size, capacity, object_id, object));
+  } else {
+    RESPONSE_ON_ERROR(bulk_store_->Create(size, object_id, object));
+  }
 
   int fd_to_send = -1;
   if (object->data_size > 0 &&
@@ -661,6 +668,38 @@ bool SocketConnection::doShrinkBuffer(const json& root) {
   return false;
 }
 
+bool SocketConnection::doExtendBuffer(const json& root) {
+  auto self(shared_from_this());
+  ObjectID object_id = InvalidObjectID();
+  size_t size = 0;
+  std::shared_ptr<Payload> object;
+  std::string message_out;
+
+  TRY_READ_REQUEST(ReadExtendBufferRequest, root, object_id, size);
+  // the blob may be relocated if it cannot grow in place
+  ObjectID extended_id = InvalidObjectID();
+  RESPONSE_ON_ERROR(bulk_store_->Extend(object_id, size, extended_id, object));
+
+  int fd_to_send = -1;
+  if (object->data_size > 0 &&
+      self->used_fds_.find(object->store_fd) == self->used_fds_.end()) {
+    this->used_fds_.emplace(object->store_fd);
+    fd_to_send = object->store_fd;
+  }
+
+  WriteExtendBufferReply(extended_id, object, fd_to_send, message_out);
+
+  this->doWrite(message_out, [this, self, fd_to_send](const Status& status) {
+    if (fd_to_send != -1) {
+      send_fd(self->nativeHandle(), fd_to_send);
+    }
+    LOG_SUMMARY("instances_memory_usage_bytes", server_ptr_->instance_id(),
+                bulk_store_->Footprint());
+    return Status::OK();
+  });
+  return false;
+}
+
 bool SocketConnection::doCreateRemoteBuffer(const json& root) {
   auto self(shared_from_this());
   size_t size;
@@ -753,13 +792,19 @@ bool SocketConnection::doCreateRemoteBuffers(const json& root) {
 bool SocketConnection::doGetRemoteBuffers(const json& root) {
   auto self(shared_from_this());
   std::vector<ObjectID> ids;
+  std::vector<std::pair<size_t, size_t>> ranges;
   bool unsafe = false;
   bool compress = false;
   std::vector<std::shared_ptr<Payload>> objects;
   std::string message_out;
 
-  TRY_READ_REQUEST(ReadGetRemoteBuffersRequest, root, ids, unsafe, compress);
+  TRY_READ_REQUEST(ReadGetRemoteBuffersRequest, root, ids, ranges, unsafe,
+                   compress);
   RESPONSE_ON_ERROR(bulk_store_->GetUnsafe(ids, unsafe, objects));
+  if (!ranges.empty()) {
+    // byte-range reads: send the [offset, offset + length) part of each blob
+    RESPONSE_ON_ERROR(sliceRemoteBuffers(ranges, objects));
+  }
   RESPONSE_ON_ERROR(bulk_store_->AddDependency(
       std::unordered_set<ObjectID>(ids.begin(), ids.end()), this->getConnId()));
   WriteGetBuffersReply(objects, {}, compress, message_out);
@@ -778,6 +823,36 @@ bool SocketConnection::doGetRemoteBuffers(const json& root) {
   return false;
 }
 
+Status SocketConnection::sliceRemoteBuffers(
+    std::vector<std::pair<size_t, size_t>> const& ranges,
+    std::vector<std::shared_ptr<Payload>>& objects) {
+  RETURN_ON_ASSERT(ranges.size() == objects.size(),
+                   "The number of ranges doesn't match with the blobs: " +
+                       std::to_string(ranges.size()) + " vs. " +
+                       std::to_string(objects.size()));
+  for (size_t i = 0; i < objects.size(); ++i) {
+    size_t data_size = static_cast<size_t>(objects[i]->data_size);
+    size_t offset = ranges[i].first;
+    if (offset > data_size) {
+      return Status::Invalid(
+          "The range offset " + std::to_string(offset) +
+          " is out of the bound of blob " +
+          ObjectIDToString(objects[i]->object_id) + " (" +
+          std::to_string(data_size) + " bytes)");
+    }
+    size_t length = std::min(ranges[i].second, data_size - offset);
+    if (offset == 0 && length == data_size) {
+      continue;
+    }
+    auto slice = std::make_shared<Payload>(*objects[i]);
+    slice->pointer = length == 0 ? nullptr : slice->pointer + offset;
+    slice->data_offset += offset;
+    slice->data_size = length;
+    objects[i] = slice;
+  }
+  return Status::OK();
+}
+
 bool SocketConnection::doIncreaseReferenceCount(json const& root) {
   auto self(shared_from_this());
   std::vector<ObjectID> ids;
@@ -1288,9 +1363,11 @@ bool SocketConnection::doGetNextStreamChunk(const json& root) {
 bool SocketConnection::doPushNextStreamChunk(const json& root) {
   auto self(shared_from_this());
   ObjectID stream_id, chunk;
-  TRY_READ_REQUEST(ReadPushNextStreamChunkRequest, root, stream_id, chunk);
+  bool retained = false;
+  TRY_READ_REQUEST(ReadPushNextStreamChunkRequest, root, stream_id, chunk,
+                   retained);
   RESPONSE_ON_ERROR(server_ptr_->GetStreamStore()->Push(
-      stream_id, chunk, [self](const Status& status, const ObjectID) {
+      stream_id, chunk, retained, [self](const Status& status, const ObjectID) {
         std::string message_out;
         if (status.ok()) {
           WritePushNextStreamChunkReply(message_out);
@@ -1310,10 +1387,13 @@ bool SocketConnection::doPullNextStreamChunk(const json& root) {
   TRY_READ_REQUEST(ReadPullNextStreamChunkRequest, root, stream_id);
   this->associated_streams_.emplace(stream_id);
   RESPONSE_ON_ERROR(server_ptr_->GetStreamStore()->Pull(
-      stream_id, [self](const Status& status, const ObjectID chunk) {
+      stream_id, [self, stream_id](const Status& status, const ObjectID chunk) {
         std::string message_out;
         if (status.ok()) {
-          WritePullNextStreamChunkReply(chunk, message_out);
+          WritePullNextStreamChunkReply(
+              chunk,
+              self->server_ptr_->GetStreamStore()->IsRetained(stream_id, chunk),
+              message_out);
         } else {
           if (!status.IsStreamDrained()) {
             VLOG(100) << "Error: " << status.ToString();
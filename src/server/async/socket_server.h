@@ -24,6 +24,8 @@ limitations under the License.
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "common/memory/payload.h"
 #include "common/util/asio.h"  // IWYU pragma: keep
@@ -73,6 +75,7 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
   bool doGetGPUBuffers(json const& root);
   bool doDropBuffer(json const& root);
   bool doShrinkBuffer(json const& root);
+  bool doExtendBuffer(json const& root);
 
   /**
    * @brief doCreateBuffer differs from doCreateRemoteBuffer, that the content
@@ -160,6 +163,14 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
    */
   bool processMessage(const std::string& message_in);
 
+  /**
+   * @brief Narrow the payloads to the requested [offset, offset + length)
+   * byte ranges, the length is clipped at the end of the blob.
+   */
+  Status sliceRemoteBuffers(
+      std::vector<std::pair<size_t, size_t>> const& ranges,
+      std::vector<std::shared_ptr<Payload>>& objects);
+
   void doReadHeader();
 
   void doReadBody();
@@ -33,13 +33,18 @@ https://github.com/apache/arrow/blob/master/cpp/src/plasma/plasma_allocator.cc
 #include <sys/mount.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 #include "server/memory/allocator.h"
 
+#include "common/util/functions.h"
 #include "common/util/logging.h"
 #include "server/memory/dlmalloc.h"
 #include "server/memory/mimalloc.h"
@@ -50,6 +55,34 @@ bool BulkAllocator::use_mimalloc_ = false;
 int64_t BulkAllocator::footprint_limit_ = 0;
 int64_t BulkAllocator::allocated_ = 0;
 
+namespace {
+// the unused tails of the blocks that have been reserved by Reserve(), which
+// are accounted as allocated
+std::mutex reserved_tails_mutex;
+std::unordered_map<void*, size_t> reserved_tails;
+
+size_t take_reserved_tail(void* mem, const size_t bytes) {
+  std::lock_guard<std::mutex> lock(reserved_tails_mutex);
+  auto iter = reserved_tails.find(mem);
+  if (iter == reserved_tails.end()) {
+    return 0;
+  }
+  size_t taken = std::min(bytes, iter->second);
+  iter->second -= taken;
+  if (iter->second == 0) {
+    reserved_tails.erase(iter);
+  }
+  return taken;
+}
+
+void restore_reserved_tail(void* mem, const size_t tail) {
+  if (tail > 0) {
+    std::lock_guard<std::mutex> lock(reserved_tails_mutex);
+    reserved_tails[mem] += tail;
+  }
+}
+}  // namespace
+
 void* BulkAllocator::Init(const size_t size, std::string const& allocator) {
   if (allocator == "dlmalloc") {
     use_mimalloc_ = false;
@@ -90,12 +123,65 @@ void* BulkAllocator::Memalign(const size_t bytes, const size_t alignment) {
 }
 
 void BulkAllocator::Free(void* mem, size_t bytes) {
+  size_t tail = take_reserved_tail(mem, std::numeric_limits<size_t>::max());
   if (use_mimalloc_) {
-    MimallocAllocator::Free(mem, bytes);
+    MimallocAllocator::Free(mem, bytes + tail);
+  } else {
+    DLmallocAllocator::Free(mem, bytes + tail);
+  }
+  allocated_ -= bytes + tail;
+}
+
+void* BulkAllocator::Reserve(const size_t bytes, const size_t capacity,
+                             const size_t alignment) {
+  size_t reserved = std::max(bytes, capacity);
+  if (allocated_ + static_cast<int64_t>(reserved) > footprint_limit_) {
+    return nullptr;
+  }
+  void* mem = nullptr;
+  if (use_mimalloc_) {
+    mem = MimallocAllocator::Allocate(reserved, alignment);
+  } else {
+    mem = DLmallocAllocator::Allocate(reserved, alignment);
+  }
+  if (mem != nullptr) {
+    allocated_ += reserved;
+    if (reserved > bytes) {
+      std::lock_guard<std::mutex> lock(reserved_tails_mutex);
+      reserved_tails[mem] = reserved - bytes;
+    }
+    // the reserved tail stays untouched until the block grows
+    madvise(mem, bytes, MADV_WILLNEED);
+  }
+  return mem;
+}
+
+bool BulkAllocator::Expand(void* mem, const size_t old_bytes,
+                           const size_t new_bytes) {
+  if (new_bytes <= old_bytes) {
+    return true;
+  }
+  // the reserved tail has been accounted already
+  size_t tail = take_reserved_tail(mem, new_bytes - old_bytes);
+  int64_t delta = static_cast<int64_t>(new_bytes - old_bytes - tail);
+  if (allocated_ + delta > footprint_limit_) {
+    restore_reserved_tail(mem, tail);
+    return false;
+  }
+  bool expanded = true;
+  if (delta > 0) {
+    if (use_mimalloc_) {
+      expanded = MimallocAllocator::Expand(mem, new_bytes);
+    } else {
+      expanded = DLmallocAllocator::Expand(mem, new_bytes);
+    }
+  }
+  if (expanded) {
+    allocated_ += delta;
   } else {
-    DLmallocAllocator::Free(mem, bytes);
+    restore_reserved_tail(mem, tail);
   }
-  allocated_ -= bytes;
+  return expanded;
 }
 
 void BulkAllocator::SetFootprintLimit(size_t bytes) {
@@ -106,4 +192,93 @@ int64_t BulkAllocator::GetFootprintLimit() { return footprint_limit_; }
 
 int64_t BulkAllocator::Allocated() { return allocated_; }
 
+namespace {
+std::mutex cached_stats_mutex;
+AllocatorStats cached_stats;
+double cached_stats_time = 0;
+}  // namespace
+
+void BulkAllocator::GetStats(AllocatorStats& stats) {
+  stats = AllocatorStats();
+  if (use_mimalloc_) {
+    stats.allocator = "mimalloc";
+    MimallocAllocator::GetStats(stats);
+  } else {
+    stats.allocator = "dlmalloc";
+    DLmallocAllocator::GetStats(stats);
+  }
+  stats.allocated_bytes = static_cast<size_t>(allocated_);
+  stats.footprint_limit = static_cast<size_t>(footprint_limit_);
+
+  std::lock_guard<std::mutex> lock(cached_stats_mutex);
+  cached_stats = stats;
+  cached_stats_time = GetCurrentTime();
+}
+
+void BulkAllocator::GetCachedStats(AllocatorStats& stats,
+                                   const double max_age) {
+  {
+    std::lock_guard<std::mutex> lock(cached_stats_mutex);
+    if (cached_stats_time > 0 &&
+        GetCurrentTime() - cached_stats_time <= max_age) {
+      stats = cached_stats;
+      // the accounted bytes are always up-to-date
+      stats.allocated_bytes = static_cast<size_t>(allocated_);
+      return;
+    }
+  }
+  GetStats(stats);
+}
+
+void AllocatorStats::AddFreeExtent(const size_t size, const size_t count) {
+  if (size == 0 || count == 0) {
+    return;
+  }
+  free_extents += count;
+  largest_free_extent = std::max(largest_free_extent, size);
+  free_extents_histogram[SizeClassOf(size)] += count;
+}
+
+double AllocatorStats::Fragmentation() const {
+  if (free_bytes == 0) {
+    return 0.0;
+  }
+  return 1.0 - static_cast<double>(std::min(largest_free_extent, free_bytes)) /
+                   static_cast<double>(free_bytes);
+}
+
+json AllocatorStats::ToJSON() const {
+  json tree;
+  tree["allocator"] = allocator;
+  tree["allocated_bytes"] = allocated_bytes;
+  tree["footprint_limit"] = footprint_limit;
+  tree["mapped_bytes"] = mapped_bytes;
+  tree["used_bytes"] = used_bytes;
+  tree["free_bytes"] = free_bytes;
+  tree["free_extents"] = free_extents;
+  tree["largest_free_extent"] = largest_free_extent;
+  tree["fragmentation"] = Fragmentation();
+  json histogram = json::object();
+  for (auto const& item : free_extents_histogram) {
+    histogram[std::to_string(item.first)] = item.second;
+  }
+  tree["free_extents_histogram"] = histogram;
+  json classes = json::object();
+  for (auto const& item : size_classes) {
+    classes[std::to_string(item.first)] = {
+        {"used_blocks", item.second.used_blocks},
+        {"free_blocks", item.second.free_blocks}};
+  }
+  tree["size_classes"] = classes;
+  return tree;
+}
+
+size_t AllocatorStats::SizeClassOf(const size_t size) {
+  size_t size_class = 1;
+  while (size_class < size) {
+    size_class <<= 1;
+  }
+  return size_class;
+}
+
 }  // namespace vineyard
@@ -31,8 +31,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <string>
 
+#include "common/util/json.h"
 #include "common/util/macros.h"
 
 namespace vineyard {
@@ -42,6 +44,51 @@ class DLmallocAllocator;
 class MimallocAllocator;
 }  // namespace memory
 
+/**
+ * @brief Introspection of the allocator behind the BulkAllocator, which tells
+ * whether a failed allocation is caused by exhaustion or by fragmentation.
+ */
+struct AllocatorStats {
+  struct SizeClass {
+    size_t used_blocks = 0;
+    size_t free_blocks = 0;
+  };
+
+  std::string allocator;
+
+  /// Bytes accounted by BulkAllocator, and its footprint limit.
+  size_t allocated_bytes = 0;
+  size_t footprint_limit = 0;
+
+  /// Bytes that the allocator manages (mapped), that are occupied by live
+  /// blocks including the allocator overhead (used), and the rest (free).
+  size_t mapped_bytes = 0;
+  size_t used_bytes = 0;
+  size_t free_bytes = 0;
+
+  /// Number of free extents and the largest one, i.e., the largest request
+  /// that could be satisfied without growing or compacting the heap.
+  size_t free_extents = 0;
+  size_t largest_free_extent = 0;
+
+  /// Free extents counted by the power-of-two ceiling of their sizes.
+  std::map<size_t, size_t> free_extents_histogram;
+
+  /// Block counts per size class. For mimalloc the key is the exact block
+  /// size of the pages, for dlmalloc chunks are bucketed by the power-of-two
+  /// ceiling of their sizes.
+  std::map<size_t, SizeClass> size_classes;
+
+  void AddFreeExtent(const size_t size, const size_t count = 1);
+
+  /// 1 - largest_free_extent / free_bytes, 0 means no fragmentation at all.
+  double Fragmentation() const;
+
+  json ToJSON() const;
+
+  static size_t SizeClassOf(const size_t size);
+};
+
 class BulkAllocator {
  public:
   static void* Init(
@@ -68,6 +115,24 @@ class BulkAllocator {
   /// \param bytes Number of bytes to be freed.
   static void Free(void* mem, size_t bytes);
 
+  /// Allocates `capacity` bytes, of which only the first `bytes` bytes are
+  /// pre-faulted, the rest is reserved for growing the block in place by
+  /// Expand(). The whole capacity is accounted against the footprint limit,
+  /// and is released by Free().
+  ///
+  /// \param bytes Number of bytes in use.
+  /// \param capacity Number of bytes to reserve.
+  /// \param alignment Memory alignment.
+  /// \return Pointer to allocated memory.
+  static void* Reserve(size_t bytes, size_t capacity, size_t alignment);
+
+  /// Grows the block pointed to by mem from `old_bytes` to `new_bytes` in
+  /// place, using its reserved tail or the adjacent free space. Only the
+  /// growth beyond the reserved tail is newly accounted.
+  ///
+  /// \return False if the block cannot grow without being relocated.
+  static bool Expand(void* mem, size_t old_bytes, size_t new_bytes);
+
   /// Sets the memory footprint limit for Plasma.
   ///
   /// \param bytes Plasma memory footprint limit in bytes.
@@ -82,6 +147,20 @@ class BulkAllocator {
   /// \return Number of bytes allocated by Plasma so far.
   static int64_t Allocated();
 
+  /// Walk the allocator to collect the free extents and size classes. The
+  /// allocator is locked during the walk, so don't call it on the hot path.
+  ///
+  /// \param stats The collected statistics.
+  static void GetStats(AllocatorStats& stats);
+
+  /// Get the statistics collected by the last walk if it is no older than
+  /// `max_age` seconds, otherwise walk the allocator again. For the periodic
+  /// reporting only, the status queries walk the allocator on each request.
+  ///
+  /// \param stats The collected statistics.
+  /// \param max_age The maximum age (in seconds) of the cached statistics.
+  static void GetCachedStats(AllocatorStats& stats, const double max_age = 5.0);
+
   using DLmallocAllocator = vineyard::memory::DLmallocAllocator;
   using MimallocAllocator = vineyard::memory::MimallocAllocator;
 
@@ -29,9 +29,11 @@
 #if defined(WITH_DLMALLOC)
 
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 
 #include "common/util/logging.h"  // IWYU pragma: keep
+#include "server/memory/allocator.h"
 #include "server/memory/dlmalloc.h"
 #include "server/memory/malloc.h"
 
@@ -51,6 +53,7 @@ int fake_munmap(void*, int64_t);
 #define DEFAULT_MMAP_THRESHOLD MAX_SIZE_T
 #define DEFAULT_GRANULARITY ((size_t) 128U * 1024U)
 #define USE_LOCKS 1 /* makes the dlmalloc thread safe (but is not scalable) */
+#define MALLOC_INSPECT_ALL 1 /* walk the chunks for allocator statistics */
 
 #include "dlmalloc/dlmalloc.c"  // NOLINT
 
@@ -62,6 +65,7 @@ int fake_munmap(void*, int64_t);
 #undef HAVE_MORECORE
 #undef DEFAULT_GRANULARITY
 #undef USE_LOCKS
+#undef MALLOC_INSPECT_ALL
 
 // dlmalloc.c defined DEBUG which will conflict with ARROW_LOG(DEBUG).
 #ifdef DEBUG
@@ -105,6 +109,36 @@ void* DLmallocAllocator::Allocate(const size_t bytes, const size_t alignment) {
 
 void DLmallocAllocator::Free(void* pointer, size_t) { dlfree(pointer); }
 
+bool DLmallocAllocator::Expand(void* pointer, const size_t bytes) {
+  if (bytes <= dlmalloc_usable_size(pointer)) {
+    return true;
+  }
+  // grows into the free chunk (or the top) that follows
+  return dlrealloc_in_place(pointer, bytes) != nullptr;
+}
+
+static void inspect_chunk(void* start, void* end, size_t used_bytes,
+                          void* arg) {
+  auto stats = static_cast<AllocatorStats*>(arg);
+  size_t size = reinterpret_cast<uintptr_t>(end) -
+                reinterpret_cast<uintptr_t>(start);
+  auto& size_class = stats->size_classes[AllocatorStats::SizeClassOf(size)];
+  if (used_bytes == 0) {
+    size_class.free_blocks += 1;
+    stats->AddFreeExtent(size);
+  } else {
+    size_class.used_blocks += 1;
+  }
+}
+
+void DLmallocAllocator::GetStats(AllocatorStats& stats) {
+  struct mallinfo info = dlmallinfo();
+  stats.mapped_bytes = info.arena + info.hblkhd;
+  stats.used_bytes = info.uordblks;
+  stats.free_bytes = info.fordblks;
+  dlmalloc_inspect_all(inspect_chunk, &stats);
+}
+
 void DLmallocAllocator::SetMallocGranularity(int value) {
   change_mparam(M_GRANULARITY, value);
 }
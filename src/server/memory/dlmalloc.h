@@ -20,6 +20,8 @@ limitations under the License.
 
 namespace vineyard {
 
+struct AllocatorStats;
+
 namespace memory {
 
 class DLmallocAllocator {
@@ -30,6 +32,10 @@ class DLmallocAllocator {
 
   static void Free(void* pointer, size_t = 0);
 
+  static bool Expand(void* pointer, const size_t bytes);
+
+  static void GetStats(AllocatorStats& stats);
+
   static void SetMallocGranularity(int value);
 
  private:
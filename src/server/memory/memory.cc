@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <memory>
@@ -634,6 +635,31 @@ Status BulkStore::Create(const size_t data_size, ObjectID& object_id,
   return Status::OK();
 }
 
+Status BulkStore::Create(const size_t data_size, const size_t capacity,
+                         ObjectID& object_id,
+                         std::shared_ptr<Payload>& object) {
+  if (data_size == 0 || capacity <= data_size) {
+    return Create(data_size, object_id, object);
+  }
+  uint8_t* pointer = reinterpret_cast<uint8_t*>(
+      BulkAllocator::Reserve(data_size, capacity, kBlockSize));
+  if (pointer == nullptr) {
+    // not enough space to reserve, fallback to a fixed-size blob
+    return Create(data_size, object_id, object);
+  }
+  int fd = -1;
+  int64_t map_size = 0;
+  ptrdiff_t offset = 0;
+  GetMallocMapInfo(pointer, &fd, &map_size, &offset);
+  object_id = GenerateBlobID<ObjectID>(pointer);
+  object = std::make_shared<Payload>(object_id, data_size, pointer, fd,
+                                     map_size, offset);
+  objects_.insert(object_id, object);
+  DVLOG(10) << "after reserve: " << IDToString<ObjectID>(object_id) << ": "
+            << Footprint() << "(" << FootprintLimit() << ")";
+  return Status::OK();
+}
+
 Status BulkStore::OnRelease(ObjectID const& id) {
   Status status;
   objects_.find_fn(id,
@@ -688,6 +714,64 @@ Status BulkStore::Shrink(ObjectID const& id, size_t const& size) {
   return status;
 }
 
+Status BulkStore::Extend(ObjectID const& id, size_t const& size,
+                         ObjectID& object_id,
+                         std::shared_ptr<Payload>& object) {
+  if (id == EmptyBlobID<ObjectID>()) {
+    return Create(size, object_id, object);
+  }
+  Status status;
+  std::shared_ptr<Payload> target = nullptr;
+  bool expanded = false;
+  bool found = objects_.update_fn(
+      id, [&](std::shared_ptr<Payload>& payload) -> void {
+        if (payload->is_sealed) {
+          status = Status::ObjectSealed(
+              "cannot extend as the blob has already been sealed");
+        } else if (static_cast<size_t>(payload->data_size) > size) {
+          status =
+              Status::Invalid("cannot extend to size " + std::to_string(size) +
+                              " since the current size is " +
+                              std::to_string(payload->data_size));
+        } else if (payload->kind != Payload::Kind::kMalloc ||
+                   payload->arena_fd != -1 || payload->is_gpu ||
+                   payload->is_spilled) {
+          status = Status::NotImplemented(
+              "only blobs allocated from the shared memory can be extended");
+        } else {
+          expanded = BulkAllocator::Expand(payload->pointer,
+                                           payload->data_size, size);
+          if (expanded) {
+            payload->data_size = size;
+          }
+          target = payload;
+        }
+      });
+  if (!found) {
+    return Status::ObjectNotExists("blob '" + IDToString(id) + "' not found");
+  }
+  RETURN_ON_ERROR(status);
+  if (expanded) {
+    object_id = id;
+    object = target;
+    return Status::OK();
+  }
+
+  // relocate, and reserve twice of the space to amortize the following
+  // extensions
+  size_t capacity = std::max(size, 2 * static_cast<size_t>(target->data_size));
+  RETURN_ON_ERROR(Create(size, capacity, object_id, object));
+  memcpy(object->pointer, target->pointer, target->data_size);
+  auto s = OnDelete(id);
+  if (!s.ok()) {
+    VINEYARD_DISCARD(OnDelete(object_id));
+    return s;
+  }
+  DVLOG(10) << "relocated " << IDToString(id) << " to "
+            << IDToString(object_id) << " to extend to " << size << " bytes";
+  return Status::OK();
+}
+
 Status BulkStore::CreateGPU(const size_t data_size, ObjectID& object_id,
                             std::shared_ptr<Payload>& object) {
 #ifndef ENABLE_CUDA
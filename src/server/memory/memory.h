@@ -151,6 +151,14 @@ class BulkStore
   Status Create(const size_t size, ObjectID& object_id,
                 std::shared_ptr<Payload>& object);
 
+  /*
+   * @brief Allocate space for a new growable blob, which reserves `capacity`
+   * bytes to let `Extend` grow the blob in place. The whole `capacity` is
+   * accounted in the footprint.
+   */
+  Status Create(const size_t size, const size_t capacity, ObjectID& object_id,
+                std::shared_ptr<Payload>& object);
+
   /*
    * @brief Decrease the reference count of a blob, when its reference count
    * reaches zero. It will trigger `OnRelease` behavior. See ColdObjectTracker
@@ -199,6 +207,16 @@ class BulkStore
    */
   Status Shrink(ObjectID const& id, size_t const& size);
 
+  /**
+   * @brief Grow the unsealed blob to the given size.
+   *
+   * The blob is extended in place when possible, otherwise it is relocated to
+   * a new blob (with a doubled reservation), and `object_id` is set to the id
+   * of the new blob.
+   */
+  Status Extend(ObjectID const& id, size_t const& size, ObjectID& object_id,
+                std::shared_ptr<Payload>& object);
+
  private:
   inline std::shared_ptr<BulkStore> shared_from_self() override {
     return shared_from_this();
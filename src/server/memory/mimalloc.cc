@@ -15,8 +15,10 @@ limitations under the License.
 
 #include "server/memory/mimalloc.h"
 
+#include <algorithm>
 #include <mutex>
 
+#include "server/memory/allocator.h"
 #include "server/memory/malloc.h"
 
 #if defined(WITH_MIMALLOC)
@@ -56,6 +58,45 @@ void MimallocAllocator::Free(void* pointer, size_t) {
   allocator_->Free(pointer);
 }
 
+bool MimallocAllocator::Expand(void* pointer, const size_t bytes) {
+  return allocator_->Expand(pointer, bytes) != nullptr;
+}
+
+static bool visit_area(const mi_heap_t*, const mi_heap_area_t* area,
+                       void* block, size_t, void* arg) {
+  if (block != nullptr || area->block_size == 0) {
+    return true;
+  }
+  auto stats = static_cast<AllocatorStats*>(arg);
+  size_t total_blocks = area->reserved / area->block_size;
+  size_t used_blocks = std::min(area->used, total_blocks);
+  auto& size_class = stats->size_classes[area->block_size];
+  size_class.used_blocks += used_blocks;
+  size_class.free_blocks += total_blocks - used_blocks;
+  stats->used_bytes += area->reserved;
+  stats->free_bytes += (total_blocks - used_blocks) * area->block_size;
+  stats->AddFreeExtent(area->block_size, total_blocks - used_blocks);
+  return true;
+}
+
+void MimallocAllocator::GetStats(AllocatorStats& stats) {
+  if (allocator_ == nullptr) {
+    return;
+  }
+  stats.mapped_bytes = allocator_->AlignedSize();
+  allocator_->VisitAreas(visit_area, &stats);
+  // the reserved pages are counted as used above, and the free blocks inside
+  // are only usable for requests of the same size class.
+  stats.used_bytes -= stats.free_bytes;
+  // mimalloc doesn't expose the free ranges of the arena, the unreserved
+  // remainder is reported as a single extent and is thus an upper bound.
+  size_t reserved = stats.used_bytes + stats.free_bytes;
+  if (stats.mapped_bytes > reserved) {
+    stats.free_bytes += stats.mapped_bytes - reserved;
+    stats.AddFreeExtent(stats.mapped_bytes - reserved);
+  }
+}
+
 }  // namespace memory
 
 }  // namespace vineyard
@@ -22,6 +22,8 @@ limitations under the License.
 
 namespace vineyard {
 
+struct AllocatorStats;
+
 namespace memory {
 
 class MimallocAllocator {
@@ -32,6 +34,10 @@ class MimallocAllocator {
 
   static void Free(void* pointer, size_t = 0);
 
+  static bool Expand(void* pointer, const size_t bytes);
+
+  static void GetStats(AllocatorStats& stats);
+
  private:
   static std::shared_ptr<Mimalloc> allocator_;
 };
@@ -117,6 +117,7 @@ Status StreamStore::Get(ObjectID const stream_id, size_t const size,
 // for producer: return the next chunk to write, and make current chunk
 // available for consumer to read
 Status StreamStore::Push(ObjectID const stream_id, ObjectID const chunk,
+                         bool const retained,
                          callback_t<const ObjectID> callback) {
   std::lock_guard<std::recursive_mutex> __guard(this->mutex_);
   if (streams_.find(stream_id) == streams_.end()) {
@@ -131,6 +132,9 @@ Status StreamStore::Push(ObjectID const stream_id, ObjectID const chunk,
 
   // seal current chunk
   stream->ready_chunks_.push(chunk);
+  if (retained && IsBlob(chunk)) {
+    stream->retained_chunks_.emplace(chunk);
+  }
 
   // weak up the pending reader
   if (stream->reader_) {
@@ -166,7 +170,10 @@ Status StreamStore::Pull(ObjectID const stream_id,
   if (stream->current_reading_) {
     auto target = stream->current_reading_.get();
     Status status;
-    if (IsBlob(target)) {
+    if (stream->retained_chunks_.erase(target)) {
+      // defer the deletion until the reader releases the chunk
+      status = store_->PreDelete(target);
+    } else if (IsBlob(target)) {
       status = store_->Delete(target);
     } else {
       status = server_->DelData(
@@ -221,6 +228,16 @@ Status StreamStore::Pull(ObjectID const stream_id,
   }
 }
 
+bool StreamStore::IsRetained(ObjectID const stream_id, ObjectID const chunk) {
+  std::lock_guard<std::recursive_mutex> __guard(this->mutex_);
+  auto stream = streams_.find(stream_id);
+  if (stream == streams_.end()) {
+    return false;
+  }
+  auto const& retained_chunks = stream->second->retained_chunks_;
+  return retained_chunks.find(chunk) != retained_chunks.end();
+}
+
 Status StreamStore::Stop(ObjectID const stream_id, bool failed) {
   std::lock_guard<std::recursive_mutex> __guard(this->mutex_);
   if (streams_.find(stream_id) == streams_.end()) {
@@ -317,6 +334,7 @@ Status StreamStore::Drop(ObjectID const stream_id) {
           });
     }
     VINEYARD_DISCARD(status);
+    stream->retained_chunks_.erase(target);
     stream->ready_chunks_.pop();
   }
   {
@@ -20,6 +20,7 @@ limitations under the License.
 #include <mutex>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "boost/optional/optional.hpp"
@@ -42,6 +43,8 @@ class VineyardServer;
 struct StreamHolder {
   boost::optional<ObjectID> current_writing_, current_reading_;
   std::queue<ObjectID> ready_chunks_;
+  // the blob chunks that may outlive the next pull, see `StreamStore::Push`
+  std::unordered_set<ObjectID> retained_chunks_;
   boost::optional<callback_t<ObjectID>> reader_;
   boost::optional<std::pair<size_t, callback_t<ObjectID>>> writer_;
   bool drained{false}, failed{false};
@@ -74,9 +77,13 @@ class StreamStore {
   /**
    * @brief This is called by the producer of the stream to emplace a chunk to
    * the ready queue.
+   *
+   * A chunk is deleted once the consumer pulls the next one, unless it is a
+   * retained blob chunk, whose deletion is deferred until the consumer
+   * releases it.
    */
   Status Push(ObjectID const stream_id, ObjectID const chunk,
-              callback_t<const ObjectID> callback);
+              bool const retained, callback_t<const ObjectID> callback);
 
   /**
    * @brief The consumer invokes this function to read current chunk
@@ -84,6 +91,12 @@ class StreamStore {
    */
   Status Pull(ObjectID const stream_id, callback_t<const ObjectID> callback);
 
+  /**
+   * @brief Whether the chunk has been pushed to the stream as a retained
+   * chunk.
+   */
+  bool IsRetained(ObjectID const stream_id, ObjectID const chunk);
+
   /**
    * @brief Function stop is called by the vineyard clients.
    *
@@ -41,6 +41,47 @@ namespace vineyard {
 
 namespace detail {
 
+/**
+ * @brief The bytes of cold objects to spill before retrying an allocation of
+ * `size` bytes that failed: the shortage below the footprint limit, at least
+ * `size` when no free extent is large enough (i.e., the heap is fragmented
+ * and the freed chunks need to coalesce), and at least down to the lower
+ * watermark.
+ */
+inline int64_t SpillSizeForAllocation(const int64_t size,
+                                      const int64_t allocated,
+                                      const int64_t footprint_limit,
+                                      const int64_t largest_free_extent,
+                                      const int64_t lower_bound) {
+  int64_t spill_size =
+      std::max<int64_t>(0, size - (footprint_limit - allocated));
+  if (largest_free_extent < size) {
+    spill_size = std::max(spill_size, size);
+  }
+  if (allocated > lower_bound) {
+    spill_size = std::max(spill_size, allocated - lower_bound);
+  }
+  return spill_size;
+}
+
+/**
+ * @brief Whether to spill another round after the allocation of `size` bytes
+ * still fails: only when the last round enlarged the largest free extent
+ * (the freed chunks are coalescing toward the request), and the total
+ * spilled bytes stay within `kMaxSpillRatio` times the request, otherwise
+ * the spilling would evict every cold object without ever satisfying the
+ * request.
+ */
+constexpr int64_t kMaxSpillRatio = 4;
+
+inline bool ShouldSpillMoreForAllocation(const int64_t size,
+                                         const int64_t spilled_size,
+                                         const int64_t last_largest_free_extent,
+                                         const int64_t largest_free_extent) {
+  return largest_free_extent > last_largest_free_extent &&
+         spilled_size < size * kMaxSpillRatio;
+}
+
 /**
  * @brief DependencyTracker is a CRTP class provides the dependency tracking for
  * its derived classes. It record which blobs is been used by each
@@ -518,26 +559,73 @@ class ColdObjectTracker
         BulkAllocator::Allocated() >= self().mem_spill_upper_bound_) {
       std::unique_lock<std::mutex> locked(spill_mu_);
 
-      int64_t min_spill_size = 0;
+      // spilling never satisfies a request that exceeds the footprint limit
+      if (pointer == nullptr &&
+          static_cast<int64_t>(size) > BulkAllocator::GetFootprintLimit()) {
+        return nullptr;
+      }
+
       if (pointer == nullptr) {
-        min_spill_size = size - (BulkAllocator::GetFootprintLimit() -
-                                 BulkAllocator::Allocated());
+        return allocateBySpilling(size, fd, map_size, offset);
       }
+
+      // above the upper watermark: spill down to the lower watermark
+      int64_t min_spill_size = 0;
       if (BulkAllocator::Allocated() > self().mem_spill_lower_bound_) {
         min_spill_size =
-            std::max(min_spill_size, BulkAllocator::Allocated() -
-                                         self().mem_spill_lower_bound_);
+            BulkAllocator::Allocated() - self().mem_spill_lower_bound_;
       }
-
       auto s = SpillColdObjectFor(min_spill_size);
       if (!s.ok()) {
         DLOG(ERROR) << "Error during spilling cold object: " << s.ToString();
       }
+    }
+    return pointer;
+  }
 
-      // try to allocate again if needed
-      if (pointer == nullptr) {
-        pointer = self().AllocateMemory(size, fd, map_size, offset);
+ private:
+  /**
+   * @brief Spill cold objects to satisfy a failed allocation, the allocator
+   * is only walked (for the largest free extent) on this slow path, and the
+   * rounds of spilling stop once they no longer help the request.
+   */
+  uint8_t* allocateBySpilling(const size_t size, int* fd, int64_t* map_size,
+                              ptrdiff_t* offset) {
+    const int64_t request = static_cast<int64_t>(size);
+    AllocatorStats stats;
+    BulkAllocator::GetStats(stats);
+    int64_t spill_size = SpillSizeForAllocation(
+        request, BulkAllocator::Allocated(), BulkAllocator::GetFootprintLimit(),
+        static_cast<int64_t>(stats.largest_free_extent),
+        self().mem_spill_lower_bound_);
+
+    uint8_t* pointer = nullptr;
+    int64_t spilled_size = 0;
+    while (true) {
+      int64_t allocated = BulkAllocator::Allocated();
+      auto s = SpillColdObjectFor(spill_size);
+      spilled_size += allocated - BulkAllocator::Allocated();
+      if (!s.ok()) {
+        DLOG(ERROR) << "Error during spilling cold object: " << s.ToString();
       }
+      pointer = self().AllocateMemory(size, fd, map_size, offset);
+      if (pointer != nullptr || !s.ok()) {
+        break;
+      }
+      int64_t last_largest_free_extent =
+          static_cast<int64_t>(stats.largest_free_extent);
+      BulkAllocator::GetStats(stats);
+      if (!ShouldSpillMoreForAllocation(
+              request, spilled_size, last_largest_free_extent,
+              static_cast<int64_t>(stats.largest_free_extent))) {
+        break;
+      }
+      spill_size = request;
+    }
+    if (pointer == nullptr) {
+      DLOG(WARNING) << "Failed to allocate " << size << " bytes after spilling "
+                    << spilled_size << " bytes, allocator: "
+                    << stats.ToJSON().dump();
     }
     return pointer;
   }
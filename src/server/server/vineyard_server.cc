@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "server/server/vineyard_server.h"
 
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -151,6 +152,13 @@ Status VineyardServer::Serve(StoreType const& bulk_store_type) {
 
   BulkReady();
 
+  // the allocator is shared by all sessions, report in the root session only
+  int64_t allocator_stats_interval = spec_["bulkstore_spec"].value(
+      "allocator_stats_interval", static_cast<int64_t>(0));
+  if (session_id_ == RootSessionID() && allocator_stats_interval > 0) {
+    reportAllocatorStats(allocator_stats_interval);
+  }
+
   serve_status_ = Status::OK();
   return serve_status_;
 }
@@ -1246,6 +1254,9 @@ Status VineyardServer::InstanceStatus(callback_t<const json&> callback) {
   status["deployment"] = GetDeployment();
   status["memory_usage"] = bulk_store_->Footprint();
   status["memory_limit"] = bulk_store_->FootprintLimit();
+  AllocatorStats allocator_stats;
+  BulkAllocator::GetStats(allocator_stats);
+  status["allocator_stats"] = allocator_stats.ToJSON();
   status["deferred_requests"] = deferred_.size();
   if (ipc_server_ptr_) {
     status["ipc_connections"] = ipc_server_ptr_->AliveConnections();
@@ -1336,6 +1347,9 @@ void VineyardServer::Stop() {
     return;
   }
 
+  if (this->allocator_stats_timer_) {
+    this->allocator_stats_timer_->cancel();
+  }
   if (this->ipc_server_ptr_) {
     this->ipc_server_ptr_->Stop();
   }
@@ -1357,6 +1371,27 @@ void VineyardServer::Stop() {
 
 bool VineyardServer::Running() const { return !stopped_.load(); }
 
+void VineyardServer::reportAllocatorStats(const int64_t interval) {
+  auto self(shared_from_this());
+  allocator_stats_timer_.reset(
+      new asio::steady_timer(context_, std::chrono::seconds(interval)));
+  allocator_stats_timer_->async_wait(
+      [self, interval](const boost::system::error_code& error) {
+        if (error || self->stopped_.load()) {
+          return;
+        }
+        // reuses the walk of a spilling or status query in this interval
+        AllocatorStats stats;
+        BulkAllocator::GetCachedStats(stats, interval);
+        LOG(INFO) << "Allocator statistics: " << stats.ToJSON().dump();
+        LOG_SUMMARY("instances_memory_largest_free_extent_bytes",
+                    self->instance_id(), stats.largest_free_extent);
+        LOG_SUMMARY("instances_memory_fragmentation", self->instance_id(),
+                    stats.Fragmentation());
+        self->reportAllocatorStats(interval);
+      });
+}
+
 VineyardServer::~VineyardServer() { this->Stop(); }
 
 }  // namespace vineyard
@@ -229,6 +229,11 @@ class VineyardServer : public std::enable_shared_from_this<VineyardServer> {
   ~VineyardServer();
 
  private:
+  /**
+   * @brief Report the allocator statistics every `interval` seconds.
+   */
+  void reportAllocatorStats(const int64_t interval);
+
   json spec_;
   SessionID session_id_;
 
@@ -251,6 +256,8 @@ class VineyardServer : public std::enable_shared_from_this<VineyardServer> {
 
   Status serve_status_;
 
+  std::unique_ptr<asio::steady_timer> allocator_stats_timer_;
+
   enum ready_t {
     kMeta = 0b1,
     kBulk = 0b10,
@@ -13,7 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <chrono>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <thread>
@@ -21,6 +26,8 @@ limitations under the License.
 #include <vector>
 
 #include "common/compression/compressor.h"
+#include "common/memory/fling.h"
+#include "common/memory/memcpy.h"
 #include "common/util/asio.h"
 #include "common/util/protocols.h"
 #include "server/server/vineyard_server.h"
@@ -33,11 +40,22 @@ RemoteClient::RemoteClient(const std::shared_ptr<VineyardServer> server_ptr)
       context_(server_ptr->GetIOContext()),
       remote_tcp_socket_(context_),
       socket_(context_),
-      connected_(false) {}
+      connected_(false),
+      ipc_socket_(context_),
+      local_(false) {}
 
 RemoteClient::~RemoteClient() {
   boost::system::error_code ec;
   ec = socket_.close(ec);
+  ec = ipc_socket_.close(ec);
+  for (auto const& item : peer_segments_) {
+    if (item.second.pointer != nullptr) {
+      munmap(item.second.pointer, item.second.length);
+    }
+    if (item.second.fd != -1) {
+      close(item.second.fd);
+    }
+  }
 }
 
 Status RemoteClient::Connect(const std::string& rpc_endpoint,
@@ -99,6 +117,56 @@ Status RemoteClient::Connect(const std::string& host, const uint32_t port,
       message_in, ipc_socket_value, rpc_endpoint_value, remote_instance_id_,
       session_id_, server_version_, store_match, support_rpc_compression));
   this->connected_ = true;
+
+  if (server_ptr_->GetSpec().value("local_migration", true)) {
+    auto status =
+        connectLocally(ipc_socket_value, rpc_endpoint_value, session_id);
+    if (!status.ok()) {
+      DLOG(INFO) << "Cannot reach the peer " << rpc_endpoint_value
+                 << " through IPC socket '" << ipc_socket_value
+                 << "', fallback to TCP: " << status.ToString();
+    }
+  }
+  return Status::OK();
+}
+
+Status RemoteClient::connectLocally(const std::string& ipc_socket,
+                                    const std::string& rpc_endpoint,
+                                    const SessionID session_id) {
+  // connecting to the server itself would block the io context
+  RETURN_ON_ASSERT(
+      !ipc_socket.empty() && ipc_socket != server_ptr_->IPCSocket(),
+      "The IPC socket is not a peer's");
+  if (access(ipc_socket.c_str(), F_OK) != 0) {
+    return Status::IOError("The IPC socket doesn't exist on this host");
+  }
+
+  asio::local::stream_protocol::socket socket(context_);
+  boost::system::error_code ec;
+  socket.connect(asio::local::stream_protocol::endpoint(ipc_socket), ec);
+  RETURN_ON_ASIO_ERROR(ec);
+  asio::generic::stream_protocol::socket ipc_socket_conn(std::move(socket));
+
+  std::string message_out;
+  WriteRegisterRequest(message_out, StoreType::kDefault, session_id);
+  RETURN_ON_ERROR(doWrite(ipc_socket_conn, message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(ipc_socket_conn, message_in));
+  std::string ipc_socket_value, rpc_endpoint_value;
+  InstanceID instance_id;
+  bool store_match, support_rpc_compression;
+  SessionID session_id_;
+  std::string server_version_;
+  RETURN_ON_ERROR(ReadRegisterReply(
+      message_in, ipc_socket_value, rpc_endpoint_value, instance_id,
+      session_id_, server_version_, store_match, support_rpc_compression));
+
+  // the same path may point to another instance in a different container
+  RETURN_ON_ASSERT(
+      instance_id == remote_instance_id_ && rpc_endpoint_value == rpc_endpoint,
+      "The IPC socket belongs to another instance");
+  ipc_socket_ = std::move(ipc_socket_conn);
+  local_ = true;
   return Status::OK();
 }
 
@@ -135,7 +203,9 @@ Status RemoteClient::MigrateObject(const ObjectID object_id, const json& meta,
 
   // migrate all the blobs from remote server
   auto self(shared_from_this());
-  RETURN_ON_ERROR(this->migrateBuffers(
+  auto migrate = local_ ? &RemoteClient::migrateBuffersLocally
+                        : &RemoteClient::migrateBuffers;
+  RETURN_ON_ERROR((this->*migrate)(
       blobs,
       [self, callback, meta](const Status& status,
                              std::map<ObjectID, ObjectID> const& result_blobs) {
@@ -285,37 +355,162 @@ Status RemoteClient::migrateBuffers(
   return Status::OK();
 }
 
+Status RemoteClient::migrateBuffersLocally(
+    const std::set<ObjectID> blobs,
+    callback_t<const std::map<ObjectID, ObjectID>&> callback) {
+  std::vector<Payload> payloads;
+  std::vector<int> fd_sent;
+
+  std::string message_out;
+  WriteGetBuffersRequest(blobs, false, message_out);
+  RETURN_ON_ERROR(doWrite(ipc_socket_, message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(ipc_socket_, message_in));
+  RETURN_ON_ERROR(ReadGetBuffersReply(message_in, payloads, fd_sent));
+  RETURN_ON_ASSERT(payloads.size() == blobs.size(),
+                   "The result size doesn't match with the requested sizes: " +
+                       std::to_string(payloads.size()) + " vs. " +
+                       std::to_string(blobs.size()));
+
+  // the peer sends the fds right after the reply, in order
+  for (int store_fd : fd_sent) {
+    int fd = recv_fd(ipc_socket_.native_handle());
+    if (fd <= 0) {
+      return Status::IOError(
+          "Failed to receive file descriptor from the socket");
+    }
+    auto& segment = peer_segments_[store_fd];
+    if (segment.fd != -1) {
+      close(fd);
+    } else {
+      segment.fd = fd;
+    }
+  }
+
+  std::vector<std::shared_ptr<Payload>> results;
+  Status status = Status::OK();
+  for (auto const& payload : payloads) {
+    if (payload.data_size == 0) {
+      results.emplace_back(Payload::MakeEmpty());
+      continue;
+    }
+    const uint8_t* pointer = nullptr;
+    ObjectID object_id;
+    std::shared_ptr<Payload> object;
+    status = mapPeerSegment(payload, pointer);
+    if (status.ok()) {
+      status = this->server_ptr_->GetBulkStore()->Create(payload.data_size,
+                                                         object_id, object);
+    }
+    if (!status.ok()) {
+      break;
+    }
+    memory::concurrent_memcpy(object->pointer, pointer + payload.data_offset,
+                              payload.data_size);
+    results.emplace_back(object);
+  }
+
+  // drop the references that the peer holds for this connection, the copies
+  // are not affected if it fails
+  for (auto const& payload : payloads) {
+    WriteReleaseRequest(payload.object_id, message_out);
+    Status s = doWrite(ipc_socket_, message_out);
+    if (s.ok()) {
+      s = doRead(ipc_socket_, message_in);
+    }
+    if (s.ok()) {
+      s = ReadReleaseReply(message_in);
+    }
+    if (!s.ok()) {
+      DLOG(WARNING) << "Failed to release blob "
+                    << ObjectIDToString(payload.object_id)
+                    << " on the peer: " << s.ToString();
+    }
+  }
+
+  std::map<ObjectID, ObjectID> result_blobs;
+  if (!status.ok()) {
+    for (auto const& object : results) {
+      if (object && object->data_size > 0) {
+        VINEYARD_DISCARD(
+            this->server_ptr_->GetBulkStore()->Delete(object->object_id));
+      }
+    }
+    return callback(status, result_blobs);
+  }
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    VINEYARD_DISCARD(
+        this->server_ptr_->GetBulkStore()->Seal(results[i]->object_id));
+    result_blobs.emplace(payloads[i].object_id, results[i]->object_id);
+  }
+  return callback(status, result_blobs);
+}
+
+Status RemoteClient::mapPeerSegment(Payload const& payload,
+                                    const uint8_t*& pointer) {
+  auto iter = peer_segments_.find(payload.store_fd);
+  RETURN_ON_ASSERT(iter != peer_segments_.end() && iter->second.fd != -1,
+                   "The file descriptor of the peer's segment is not received");
+  auto& segment = iter->second;
+  if (segment.pointer == nullptr) {
+    // see also `MmapEntry`, the segment is mapped without the trailing gap
+    size_t length = payload.map_size - sizeof(size_t);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, segment.fd, 0);
+    if (mapped == MAP_FAILED) {
+      return Status::IOError("Failed to mmap the peer's segment: errno = " +
+                             std::to_string(errno) + ": " + strerror(errno));
+    }
+    segment.pointer = static_cast<uint8_t*>(mapped);
+    segment.length = length;
+  }
+  pointer = segment.pointer;
+  return Status::OK();
+}
+
 Status RemoteClient::doWrite(const std::string& message_out) {
+  return doWrite(socket_, message_out);
+}
+
+Status RemoteClient::doRead(std::string& message_in) {
+  return doRead(socket_, message_in);
+}
+
+Status RemoteClient::doRead(json& root) { return doRead(socket_, root); }
+
+Status RemoteClient::doWrite(asio::generic::stream_protocol::socket& socket,
+                             const std::string& message_out) {
   boost::system::error_code ec;
   size_t length = message_out.length();
-  asio::write(socket_, asio::const_buffer(&length, sizeof(size_t)), ec);
+  asio::write(socket, asio::const_buffer(&length, sizeof(size_t)), ec);
   RETURN_ON_ASIO_ERROR(ec);
-  asio::write(socket_,
+  asio::write(socket,
               asio::const_buffer(message_out.data(), message_out.length()), ec);
   RETURN_ON_ASIO_ERROR(ec);
   return Status::OK();
 }
 
-Status RemoteClient::doRead(std::string& message_in) {
+Status RemoteClient::doRead(asio::generic::stream_protocol::socket& socket,
+                            std::string& message_in) {
   boost::system::error_code ec;
   size_t length = std::numeric_limits<size_t>::max();
-  asio::read(socket_, asio::buffer(&length, sizeof(size_t)), ec);
+  asio::read(socket, asio::buffer(&length, sizeof(size_t)), ec);
   RETURN_ON_ASIO_ERROR(ec);
   if (length > 64 * 1024 * 1024) {  // 64M bytes
     return Status::IOError("Invalid message header value: " +
                            std::to_string(length));
   }
   message_in.resize(length);
-  asio::read(socket_,
+  asio::read(socket,
              asio::mutable_buffer(const_cast<char*>(message_in.data()), length),
              ec);
   RETURN_ON_ASIO_ERROR(ec);
   return Status::OK();
 }
 
-Status RemoteClient::doRead(json& root) {
+Status RemoteClient::doRead(asio::generic::stream_protocol::socket& socket,
+                            json& root) {
   std::string message_in;
-  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(doRead(socket, message_in));
   Status status;
   CATCH_JSON_ERROR(root, status, json::parse(message_in));
   return status;
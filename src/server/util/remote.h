@@ -45,11 +45,27 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
   Status MigrateObject(const ObjectID object_id, const json& meta,
                        callback_t<const ObjectID> callback);
 
+  /**
+   * @brief Whether the peer runs on the same host and the blobs are
+   * transferred through its IPC socket, see also [Transferring local blobs].
+   */
+  bool local() const { return local_; }
+
  private:
+  Status connectLocally(const std::string& ipc_socket,
+                        const std::string& rpc_endpoint,
+                        const SessionID session_id);
+
   Status migrateBuffers(
       const std::set<ObjectID> blobs,
       callback_t<const std::map<ObjectID, ObjectID>&> results);
 
+  Status migrateBuffersLocally(
+      const std::set<ObjectID> blobs,
+      callback_t<const std::map<ObjectID, ObjectID>&> results);
+
+  Status mapPeerSegment(Payload const& payload, const uint8_t*& pointer);
+
   Status collectRemoteBlobs(const json& tree, std::set<ObjectID>& blobs);
 
   Status recreateMetadata(json const& metadata, json& target,
@@ -61,6 +77,15 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
   Status doRead(std::string& message_in);
 
   Status doRead(json& root);
+
+  Status doWrite(asio::generic::stream_protocol::socket& socket,
+                 const std::string& message_out);
+
+  Status doRead(asio::generic::stream_protocol::socket& socket,
+                std::string& message_in);
+
+  Status doRead(asio::generic::stream_protocol::socket& socket, json& root);
+
   InstanceID remote_instance_id_;
 
   std::shared_ptr<VineyardServer> server_ptr_;
@@ -68,6 +93,18 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
   asio::ip::tcp::socket remote_tcp_socket_;
   asio::generic::stream_protocol::socket socket_;
   bool connected_;
+
+  // the IPC connection to the peer on the same host
+  asio::generic::stream_protocol::socket ipc_socket_;
+  bool local_;
+
+  struct PeerSegment {
+    int fd = -1;
+    uint8_t* pointer = nullptr;
+    size_t length = 0;
+  };
+  // the peer's store fd -> the received fd and its readonly mapping
+  std::map<int, PeerSegment> peer_segments_;
 };
 
 /**
@@ -83,6 +120,23 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
  *    the chunk_size is a `size_t`.
  */
 
+/**
+ * Notes on [Transferring local blobs]
+ *
+ * When the peer runs on the same host (i.e., its IPC socket is reachable and
+ * registers as the same instance as the RPC endpoint), the blobs are not sent
+ * through TCP:
+ *
+ *  - the blobs are requested on the IPC socket like a normal IPC client, and
+ *    the peer passes the fds of its shared memory segments over the UNIX
+ *    domain socket.
+ *
+ *  - the segments are mapped as readonly, and the blobs are copied into the
+ *    local store in parallel, without serialization and compression.
+ *
+ *  - the blobs are released on the peer once copied.
+ */
+
 void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                        std::vector<std::shared_ptr<Payload>> const& objects,
                        size_t index, const bool compress,
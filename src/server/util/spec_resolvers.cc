@@ -84,6 +84,11 @@ DEFINE_double(spill_lower_rate, 0.3,
 DEFINE_double(spill_upper_rate, 0.8,
               "high watermark of triggering memory spilling");
 
+// allocator introspection
+DEFINE_int64(allocator_stats_interval, 0,
+             "interval (in seconds) of reporting the allocator statistics, "
+             "0 means disabled");
+
 // ipc
 DEFINE_string(
     socket, "",
@@ -99,6 +104,9 @@ DEFINE_bool(sync_crds, false, "Synchronize CRDs when persisting objects");
 
 // IO: spill and migration
 DEFINE_bool(compression, true, "Compress before migration or spilling");
+DEFINE_bool(local_migration, true,
+            "Migrate objects from the instances on the same host through the "
+            "shared memory rather than TCP");
 
 // metrics and prometheus
 DEFINE_bool(prometheus, false,
@@ -166,6 +174,7 @@ json BulkstoreSpecResolver::resolve() const {
   spec["spill_path"] = FLAGS_spill_path;
   spec["spill_lower_bound_rate"] = FLAGS_spill_lower_rate;
   spec["spill_upper_bound_rate"] = FLAGS_spill_upper_rate;
+  spec["allocator_stats_interval"] = FLAGS_allocator_stats_interval;
   return spec;
 }
 
@@ -216,6 +225,7 @@ json ServerSpecResolver::resolve() const {
   json spec;
   spec["deployment"] = FLAGS_deployment;
   spec["compression"] = FLAGS_compression;
+  spec["local_migration"] = FLAGS_local_migration;
   spec["sync_crds"] =
       FLAGS_sync_crds || (read_env("VINEYARD_SYNC_CRDS") == "1");
   spec["metastore_spec"] = Resolver::get("metastore").resolve();
@@ -0,0 +1,133 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client/client.h"
+#include "common/util/json.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr size_t kBlobSize = 1024 * 1024;
+constexpr size_t kBlobNum = 64;
+
+json GetAllocatorStats(Client& client) {
+  std::shared_ptr<InstanceStatus> status;
+  VINEYARD_CHECK_OK(client.InstanceStatus(status));
+  return status->allocator_stats;
+}
+
+void CheckConsistency(const json& stats) {
+  CHECK(stats.contains("allocator"));
+  CHECK_LE(stats["used_bytes"].get<size_t>(),
+           stats["mapped_bytes"].get<size_t>());
+  CHECK_LE(stats["largest_free_extent"].get<size_t>(),
+           stats["free_bytes"].get<size_t>());
+  size_t free_extents = 0;
+  for (auto const& item : stats["free_extents_histogram"].items()) {
+    free_extents += item.value().get<size_t>();
+  }
+  CHECK_EQ(free_extents, stats["free_extents"].get<size_t>());
+}
+
+std::vector<ObjectID> CreateBlobs(Client& client, const size_t num) {
+  std::vector<ObjectID> blobs;
+  for (size_t i = 0; i < num; ++i) {
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(client.CreateBlob(kBlobSize, writer));
+    std::shared_ptr<Object> blob;
+    VINEYARD_CHECK_OK(writer->Seal(client, blob));
+    blobs.emplace_back(blob->id());
+  }
+  return blobs;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./allocator_stats_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  json baseline = GetAllocatorStats(client);
+  CheckConsistency(baseline);
+  std::string allocator = baseline["allocator"].get<std::string>();
+  LOG(INFO) << "Allocator statistics before allocation: " << baseline.dump();
+
+  // allocate a contiguous run of blobs
+  auto blobs = CreateBlobs(client, kBlobNum);
+  json allocated = GetAllocatorStats(client);
+  CheckConsistency(allocated);
+  CHECK_GE(allocated["used_bytes"].get<size_t>(),
+           baseline["used_bytes"].get<size_t>() + kBlobNum * kBlobSize);
+
+  // free every other blob: a checkerboard of holes that cannot coalesce
+  std::vector<ObjectID> holes, survivors;
+  for (size_t i = 0; i < blobs.size(); ++i) {
+    (i % 2 == 0 ? holes : survivors).emplace_back(blobs[i]);
+  }
+  VINEYARD_CHECK_OK(client.DelData(holes, true, true));
+  json fragmented = GetAllocatorStats(client);
+  CheckConsistency(fragmented);
+  LOG(INFO) << "Allocator statistics after fragmentation: "
+            << fragmented.dump();
+  CHECK_LT(fragmented["used_bytes"].get<size_t>(),
+           allocated["used_bytes"].get<size_t>());
+  if (allocator == "dlmalloc") {
+    // each hole is a free extent of its own, and sits in the bucket of the
+    // blob size
+    CHECK_GE(fragmented["free_extents"].get<size_t>(),
+             allocated["free_extents"].get<size_t>() + kBlobNum / 4);
+    size_t bucket = 1;
+    while (bucket < kBlobSize) {
+      bucket <<= 1;
+    }
+    size_t holes_in_bucket = 0;
+    for (auto const& item : fragmented["size_classes"].items()) {
+      size_t size_class = std::stoull(item.key());
+      if (size_class == bucket || size_class == bucket * 2) {
+        holes_in_bucket += item.value()["free_blocks"].get<size_t>();
+      }
+    }
+    CHECK_GE(holes_in_bucket, kBlobNum / 4);
+    CHECK_GT(fragmented["fragmentation"].get<double>(), 0.0);
+  }
+
+  // free the survivors as well, the holes coalesce back
+  VINEYARD_CHECK_OK(client.DelData(survivors, true, true));
+  json released = GetAllocatorStats(client);
+  CheckConsistency(released);
+  CHECK_LE(released["used_bytes"].get<size_t>(),
+           fragmented["used_bytes"].get<size_t>());
+  if (allocator == "dlmalloc") {
+    CHECK_LT(released["free_extents"].get<size_t>(),
+             fragmented["free_extents"].get<size_t>());
+    CHECK_GE(released["largest_free_extent"].get<size_t>(),
+             kBlobNum * kBlobSize);
+  }
+
+  LOG(INFO) << "Passed allocator stats tests...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "basic/ds/sequence.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "client/ds/object_meta.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+std::shared_ptr<Object> CreateBlob(Client& client, const size_t size,
+                                   const bool compressible) {
+  std::unique_ptr<BlobWriter> writer;
+  VINEYARD_CHECK_OK(client.CreateBlob(size, writer));
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  for (size_t index = 0; index < size; ++index) {
+    if (compressible) {
+      writer->data()[index] = static_cast<char>(index / 4096);
+    } else {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      writer->data()[index] = static_cast<char>(state >> 56);
+    }
+  }
+  std::shared_ptr<Object> blob;
+  VINEYARD_CHECK_OK(writer->Seal(client, blob));
+  return blob;
+}
+
+void CheckRestored(Client& client, ObjectID const origin,
+                   ObjectID const restored) {
+  ObjectMeta origin_meta, restored_meta;
+  VINEYARD_CHECK_OK(client.GetMetaData(origin, origin_meta));
+  VINEYARD_CHECK_OK(client.GetMetaData(restored, restored_meta));
+  CHECK_NE(origin, restored);
+  CHECK_EQ(origin_meta.GetTypeName(), restored_meta.GetTypeName());
+  CHECK_EQ(origin_meta.GetKeyValue<size_t>("size_"),
+           restored_meta.GetKeyValue<size_t>("size_"));
+
+  size_t size = origin_meta.GetKeyValue<size_t>("size_");
+  for (size_t index = 0; index < size; ++index) {
+    std::string name = "__elements_-" + std::to_string(index);
+    auto origin_blob = std::dynamic_pointer_cast<Blob>(
+        client.GetObject(origin_meta.GetMemberMeta(name).GetId()));
+    auto restored_blob = std::dynamic_pointer_cast<Blob>(
+        client.GetObject(restored_meta.GetMemberMeta(name).GetId()));
+    CHECK_EQ(origin_blob->size(), restored_blob->size());
+    if (origin_blob->size() > 0) {
+      CHECK_NE(origin_blob->id(), restored_blob->id());
+      CHECK_EQ(memcmp(origin_blob->data(), restored_blob->data(),
+                      origin_blob->size()),
+               0);
+    }
+  }
+}
+
+/**
+ * Writes a checkpoint file of the header, the `footer`, and a trailer that
+ * locates the footer at (`footer_offset`, `footer_size`).
+ */
+void WriteCheckpoint(std::string const& path, std::string const& footer,
+                     const uint64_t footer_offset, const uint64_t footer_size) {
+  const char magic[8] = {'V', '6', 'D', 'C', 'K', 'P', 'T', '1'};
+  std::string content(4096, '\0');
+  memcpy(&content[0], magic, sizeof(magic));
+  content += footer;
+  content.append(reinterpret_cast<const char*>(&footer_offset),
+                 sizeof(footer_offset));
+  content.append(reinterpret_cast<const char*>(&footer_size),
+                 sizeof(footer_size));
+  content.append(magic, sizeof(magic));
+  FILE* fp = fopen(path.c_str(), "w");
+  fwrite(content.data(), 1, content.size(), fp);
+  fclose(fp);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./checkpoint_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // small, empty, and blobs that span several extents
+  std::vector<std::shared_ptr<Object>> blobs = {
+      CreateBlob(client, 1024, true),
+      CreateBlob(client, 0, true),
+      CreateBlob(client, 96 * 1024 * 1024 + 17, true),
+      CreateBlob(client, 72 * 1024 * 1024, false),
+  };
+  SequenceBuilder builder(client, blobs.size());
+  for (size_t index = 0; index < blobs.size(); ++index) {
+    builder.SetValue(index, blobs[index]);
+  }
+  auto sequence = builder.Seal(client);
+
+  std::string path = "/tmp/vineyard-checkpoint-test-" +
+                     std::to_string(getpid()) + ".ckpt";
+  for (bool compress : {false, true}) {
+    VINEYARD_CHECK_OK(client.Checkpoint(sequence->id(), path, compress, 4));
+    ObjectID restored = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.Restore(path, restored, 4));
+    CheckRestored(client, sequence->id(), restored);
+    VINEYARD_CHECK_OK(client.DelData(restored, true, true));
+    LOG(INFO) << "Passed checkpoint/restore with compress = " << compress;
+  }
+
+  // not a checkpoint file
+  {
+    FILE* fp = fopen(path.c_str(), "w");
+    fputs("not a checkpoint", fp);
+    fclose(fp);
+    ObjectID restored = InvalidObjectID();
+    CHECK(client.Restore(path, restored).IsInvalid());
+  }
+
+  // the footer location that overflows
+  {
+    std::string footer = "{}";
+    WriteCheckpoint(path, footer, 4096 + (1ULL << 63),
+                    footer.size() - (1ULL << 63));
+    ObjectID restored = InvalidObjectID();
+    CHECK(client.Restore(path, restored).IsInvalid());
+  }
+
+  // the malformed footers
+  for (std::string const& footer :
+       {"[]", R"({"root": {}, "blobs": []})",
+        R"({"root": {}, "blobs": {"o0": {"size": "1"}}})",
+        R"({"root": {}, "blobs": {"o0": {"size": 1, "extents": [[0, 1]]}}})",
+        R"({"root": {}, "blobs": {"o0": {"size": 1,
+                                 "extents": [[0, 1, 65536, 1, false]]}}})",
+        R"({"root": {"id": "o1"}, "blobs": {}})"}) {
+    WriteCheckpoint(path, footer, 4096, footer.size());
+    ObjectID restored = InvalidObjectID();
+    auto status = client.Restore(path, restored);
+    CHECK(!status.ok());
+    LOG(INFO) << "Rejected the malformed footer: " << status.ToString();
+  }
+  unlink(path.c_str());
+
+  VINEYARD_CHECK_OK(client.DelData(sequence->id(), true, true));
+  LOG(INFO) << "Passed checkpoint tests...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+#include "arrow/util/compression.h"
+
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+#include "common/util/uuid.h"
+#include "io/io/io_factory.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr int64_t kRows = 200000;
+constexpr size_t kMemberSize = 32 * 1024;
+constexpr int kTotalParts = 4;
+
+void WriteFile(std::string const& path, std::string const& content) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(content.data(), content.size());
+  CHECK(file.good());
+}
+
+/**
+ * Compresses every `kMemberSize` bytes of the content as an independent
+ * member, the (compressed, decompressed) offsets of members are returned
+ * in `offsets`.
+ */
+std::string Compress(const arrow::Compression::type compression,
+                     std::string const& content,
+                     std::vector<std::pair<uint64_t, uint64_t>>& offsets) {
+  std::unique_ptr<arrow::util::Codec> codec;
+  CHECK_ARROW_ERROR_AND_ASSIGN(codec, arrow::util::Codec::Create(compression));
+  std::string compressed;
+  for (size_t offset = 0; offset < content.size(); offset += kMemberSize) {
+    std::shared_ptr<arrow::io::BufferOutputStream> sink;
+    CHECK_ARROW_ERROR_AND_ASSIGN(sink, arrow::io::BufferOutputStream::Create());
+    std::shared_ptr<arrow::io::CompressedOutputStream> stream;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        stream, arrow::io::CompressedOutputStream::Make(codec.get(), sink));
+    CHECK_ARROW_ERROR(
+        stream->Write(content.data() + offset,
+                      std::min(kMemberSize, content.size() - offset)));
+    CHECK_ARROW_ERROR(stream->Close());
+    std::shared_ptr<arrow::Buffer> member;
+    CHECK_ARROW_ERROR_AND_ASSIGN(member, sink->Finish());
+    offsets.emplace_back(compressed.size(), offset);
+    compressed.append(reinterpret_cast<const char*>(member->data()),
+                      member->size());
+  }
+  return compressed;
+}
+
+/**
+ * Rewrites the gzip members as BGZF blocks by adding the "BC" extra subfield
+ * that records the block size, and appends the (empty) EOF block.
+ */
+std::string ToBGZF(std::string const& compressed,
+                   std::vector<std::pair<uint64_t, uint64_t>> const& offsets) {
+  static const char eof_block[] =
+      "\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff\x06\x00\x42\x43\x02\x00\x1b"
+      "\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00";
+  std::string blocks;
+  for (size_t index = 0; index < offsets.size(); ++index) {
+    size_t begin = offsets[index].first;
+    size_t end = index + 1 < offsets.size() ? offsets[index + 1].first
+                                            : compressed.size();
+    std::string member = compressed.substr(begin, end - begin);
+    // no optional fields in the header written by zlib
+    CHECK_EQ(member[3], 0);
+    size_t bsize = member.size() + 8 - 1;
+    CHECK_LT(bsize, 65536UL);
+    std::string header = member.substr(0, 10);
+    header[3] = 0x04;
+    header += std::string("\x06\x00\x42\x43\x02\x00", 6);
+    header += static_cast<char>(bsize & 0xff);
+    header += static_cast<char>(bsize >> 8);
+    blocks += header + member.substr(10);
+  }
+  return blocks + std::string(eof_block, sizeof(eof_block) - 1);
+}
+
+/**
+ * The index side-file of `bgzip -i`.
+ */
+std::string ToGzipIndex(
+    std::vector<std::pair<uint64_t, uint64_t>> const& offsets) {
+  std::string index;
+  auto append = [&](uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      index += static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+  };
+  append(offsets.size() - 1);
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    append(offsets[i].first);
+    append(offsets[i].second);
+  }
+  return index;
+}
+
+std::vector<std::string> ReadLines(std::string const& location,
+                                   const int index, const int total_parts) {
+  auto io = IOFactory::CreateIOAdaptor(location, nullptr);
+  if (total_parts > 0) {
+    VINEYARD_CHECK_OK(io->SetPartialRead(index, total_parts));
+  }
+  VINEYARD_CHECK_OK(io->Open());
+  std::vector<std::string> lines;
+  std::string line;
+  while (io->ReadLine(line).ok()) {
+    lines.push_back(line);
+  }
+  VINEYARD_CHECK_OK(io->Close());
+  return lines;
+}
+
+void CheckCompressedInput(std::string const& path,
+                          std::vector<std::string> const& expected) {
+  std::string location = path + "#header_row=true";
+
+  // the whole input
+  {
+    auto lines = ReadLines(location, 0, 0);
+    CHECK(lines == expected);
+  }
+
+  // the lines of all parts
+  {
+    std::vector<std::string> lines;
+    for (int index = 0; index < kTotalParts; ++index) {
+      auto part = ReadLines(location, index, kTotalParts);
+      CHECK(!part.empty());
+      lines.insert(lines.end(), part.begin(), part.end());
+    }
+    CHECK(lines == expected);
+  }
+
+  // the tables of all parts
+  {
+    int64_t rows = 0, sum = 0;
+    for (int index = 0; index < kTotalParts; ++index) {
+      auto io = IOFactory::CreateIOAdaptor(location, nullptr);
+      VINEYARD_CHECK_OK(io->SetPartialRead(index, kTotalParts));
+      VINEYARD_CHECK_OK(io->Open());
+      std::shared_ptr<arrow::Table> table;
+      VINEYARD_CHECK_OK(io->ReadTable(&table));
+      VINEYARD_CHECK_OK(io->Close());
+      CHECK(table != nullptr);
+      rows += table->num_rows();
+      auto column = table->GetColumnByName("id");
+      CHECK(column != nullptr);
+      for (auto const& chunk : column->chunks()) {
+        auto ids = std::dynamic_pointer_cast<arrow::Int64Array>(chunk);
+        CHECK(ids != nullptr);
+        for (int64_t i = 0; i < ids->length(); ++i) {
+          sum += ids->Value(i);
+        }
+      }
+    }
+    CHECK_EQ(rows, kRows);
+    CHECK_EQ(sum, kRows * (kRows - 1) / 2);
+  }
+  LOG(INFO) << "Passed compressed input: " << path;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./compressed_io_test <ipc_socket>");
+    return 1;
+  }
+
+  std::string prefix = "/tmp/compressed_io_test_" +
+                       ObjectIDToString(GenerateObjectID()) + "_";
+  std::vector<std::string> expected;
+  std::string content = "id,name,value\n";
+  for (int64_t i = 0; i < kRows; ++i) {
+    expected.push_back(std::to_string(i) + ",name_" + std::to_string(i) +
+                       "," + std::to_string(i * 0.5));
+    content += expected.back() + "\n";
+  }
+  std::vector<std::string> paths;
+
+  if (arrow::util::Codec::IsAvailable(arrow::Compression::GZIP)) {
+    std::vector<std::pair<uint64_t, uint64_t>> offsets;
+    std::string members = Compress(arrow::Compression::GZIP, content, offsets);
+
+    // BGZF, split by the block headers
+    paths.push_back(prefix + "bgzf.csv.gz");
+    WriteFile(paths.back(), ToBGZF(members, offsets));
+    // multi-member gzip, split by the index side-file
+    paths.push_back(prefix + "indexed.csv.gz");
+    WriteFile(paths.back(), members);
+    WriteFile(paths.back() + ".gzi", ToGzipIndex(offsets));
+    // multi-member gzip without index, decompressed sequentially
+    paths.push_back(prefix + "members.csv.gz");
+    WriteFile(paths.back(), members);
+  }
+  if (arrow::util::Codec::IsAvailable(arrow::Compression::ZSTD)) {
+    std::vector<std::pair<uint64_t, uint64_t>> offsets;
+    paths.push_back(prefix + "frames.csv.zst");
+    WriteFile(paths.back(),
+              Compress(arrow::Compression::ZSTD, content, offsets));
+  }
+  if (arrow::util::Codec::IsAvailable(arrow::Compression::BZ2)) {
+    std::vector<std::pair<uint64_t, uint64_t>> offsets;
+    paths.push_back(prefix + "streams.csv.bz2");
+    WriteFile(paths.back(),
+              Compress(arrow::Compression::BZ2, content, offsets));
+  }
+
+  for (auto const& path : paths) {
+    CheckCompressedInput(path, expected);
+  }
+  // the options without values are ignored
+  if (!paths.empty()) {
+    auto lines = ReadLines(
+        paths.front() + "#header_row=true&compression&decompression_threads",
+        0, 0);
+    CHECK(lines == expected);
+  }
+  for (auto const& path : paths) {
+    std::remove(path.c_str());
+    std::remove((path + ".gzi").c_str());
+  }
+
+  LOG(INFO) << "Passed compressed io tests...";
+  return 0;
+}
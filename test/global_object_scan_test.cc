@@ -0,0 +1,174 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic/ds/tensor.h"
+#include "client/client.h"
+#include "client/ds/object_meta.h"
+#include "client/rpc_client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr size_t kPartitions = 64;
+constexpr int64_t kPartitionSize = 256 * 1024;
+
+double partition_sum(std::shared_ptr<ITensor> const& partition) {
+  auto tensor = std::dynamic_pointer_cast<Tensor<double>>(partition);
+  CHECK(tensor != nullptr);
+  const double* data = tensor->data();
+  double sum = 0;
+  for (int64_t i = 0; i < kPartitionSize; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+double expected_sum(const size_t index) {
+  return static_cast<double>(index) * kPartitionSize;
+}
+
+ObjectID MakeGlobalTensor(Client& client) {
+  GlobalTensorBuilder builder(client);
+  builder.set_partition_shape({kPartitionSize});
+  builder.set_shape({static_cast<int64_t>(kPartitions) * kPartitionSize});
+  for (size_t index = 0; index < kPartitions; ++index) {
+    TensorBuilder<double> tensor_builder(client, {kPartitionSize});
+    double* data = tensor_builder.data();
+    for (int64_t i = 0; i < kPartitionSize; ++i) {
+      data[i] = index;
+    }
+    std::shared_ptr<Object> sealed;
+    VINEYARD_CHECK_OK(tensor_builder.Seal(client, sealed));
+    builder.AddMember(sealed->id());
+  }
+  builder.SetGlobal(true);
+  std::shared_ptr<Object> sealed;
+  VINEYARD_CHECK_OK(builder.Seal(client, sealed));
+  return sealed->id();
+}
+
+/**
+ * Scan the global tensor with the iterator, returns the elapsed time.
+ */
+double ScanByIterator(std::shared_ptr<GlobalTensor> const& tensor,
+                      const size_t prefetch) {
+  double start = GetCurrentTime();
+  size_t index = 0;
+  for (auto iter = tensor->Begin(prefetch); iter != tensor->End();
+       iter.Next()) {
+    CHECK_EQ(partition_sum(*iter), expected_sum(index++));
+  }
+  CHECK_EQ(index, kPartitions);
+  return GetCurrentTime() - start;
+}
+
+/**
+ * Scan the global tensor with the visitor, returns the elapsed time.
+ */
+double ScanByVisitor(std::shared_ptr<GlobalTensor> const& tensor,
+                     const size_t concurrency, const size_t prefetch) {
+  double start = GetCurrentTime();
+  std::atomic<size_t> visited(0);
+  VINEYARD_CHECK_OK(tensor->ForEach(
+      [&](const size_t index, std::shared_ptr<ITensor> const& partition) {
+        RETURN_ON_ASSERT(partition_sum(partition) == expected_sum(index),
+                         "unexpected partition content");
+        visited += 1;
+        return Status::OK();
+      },
+      concurrency, prefetch));
+  CHECK_EQ(visited.load(), kPartitions);
+  return GetCurrentTime() - start;
+}
+
+template <typename Getter>
+void Benchmark(std::string const& name, Getter getter) {
+  const size_t concurrency = std::thread::hardware_concurrency();
+  double sequential = ScanByIterator(getter(), 0);
+  double prefetching = ScanByIterator(getter(), 8);
+  double visiting = ScanByVisitor(getter(), 1, 0);
+  double parallel = ScanByVisitor(getter(), concurrency, 8);
+  LOG(INFO) << "Scanned " << kPartitions << " partitions (" << name
+            << "): sequential " << sequential << "s, prefetching "
+            << prefetching << "s, visiting " << visiting << "s, parallel ("
+            << concurrency << " threads) " << parallel << "s";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    printf("usage ./global_object_scan_test <ipc_socket> <rpc_endpoint>");
+    return 1;
+  }
+  std::string ipc_socket(argv[1]);
+  std::string rpc_endpoint(argv[2]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  RPCClient rpc_client;
+  VINEYARD_CHECK_OK(rpc_client.Connect(rpc_endpoint));
+  LOG(INFO) << "Connected to RPCServer: " << rpc_endpoint;
+
+  ObjectID id = MakeGlobalTensor(client);
+
+  Benchmark("ipc", [&]() {
+    std::shared_ptr<GlobalTensor> tensor;
+    VINEYARD_CHECK_OK(client.GetObject(id, tensor));
+    return tensor;
+  });
+
+  Benchmark("rpc, lazy", [&]() {
+    std::shared_ptr<Object> object;
+    VINEYARD_CHECK_OK(rpc_client.GetObject(id, object, true));
+    auto tensor = std::dynamic_pointer_cast<GlobalTensor>(object);
+    CHECK(tensor != nullptr);
+    return tensor;
+  });
+
+  // the failure of the visitor stops the visiting
+  {
+    std::shared_ptr<GlobalTensor> tensor;
+    VINEYARD_CHECK_OK(client.GetObject(id, tensor));
+    std::atomic<size_t> visited(0);
+    auto status = tensor->ForEach(
+        [&](const size_t index, std::shared_ptr<ITensor> const& partition) {
+          visited += 1;
+          if (index == 1) {
+            return Status::Invalid("stop");
+          }
+          return Status::OK();
+        },
+        1, 4);
+    CHECK(status.IsInvalid());
+    CHECK_EQ(visited.load(), 2UL);
+  }
+
+  VINEYARD_CHECK_OK(client.DelData(id, false, true));
+
+  LOG(INFO) << "Passed global object scan test...";
+
+  client.Disconnect();
+  rpc_client.Disconnect();
+
+  return 0;
+}
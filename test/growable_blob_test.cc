@@ -0,0 +1,201 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr size_t kChunkSize = 4096;
+constexpr size_t kChunks = 4096;
+
+void fill(char* data, size_t offset, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>((offset + i) % 251);
+  }
+}
+
+void check(const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    CHECK_EQ(data[i], static_cast<char>(i % 251));
+  }
+}
+
+/**
+ * Append the chunks to a growable blob, returns the elapsed time.
+ */
+double BuildByExtending(Client& client, size_t capacity, size_t& relocations,
+                        ObjectID& id) {
+  double start = GetCurrentTime();
+  std::unique_ptr<BlobWriter> writer;
+  VINEYARD_CHECK_OK(client.CreateBlob(kChunkSize, capacity, writer));
+  fill(writer->data(), 0, kChunkSize);
+  relocations = 0;
+  for (size_t i = 1; i < kChunks; ++i) {
+    ObjectID last = writer->id();
+    VINEYARD_CHECK_OK(writer->Extend(client, (i + 1) * kChunkSize));
+    if (writer->id() != last) {
+      relocations += 1;
+    }
+    fill(writer->data() + i * kChunkSize, i * kChunkSize, kChunkSize);
+  }
+  double elapsed = GetCurrentTime() - start;
+  id = writer->Seal(client)->id();
+  return elapsed;
+}
+
+/**
+ * Append the chunks by copying into a new blob of doubled size on overflow,
+ * then copying into a blob of the final size, returns the elapsed time.
+ */
+double BuildByCopying(Client& client, ObjectID& id) {
+  double start = GetCurrentTime();
+  std::unique_ptr<BlobWriter> writer;
+  VINEYARD_CHECK_OK(client.CreateBlob(kChunkSize, writer));
+  size_t size = 0;
+  for (size_t i = 0; i < kChunks; ++i) {
+    if (size + kChunkSize > writer->size()) {
+      std::unique_ptr<BlobWriter> bigger;
+      VINEYARD_CHECK_OK(client.CreateBlob(writer->size() * 2, bigger));
+      memcpy(bigger->data(), writer->data(), size);
+      VINEYARD_CHECK_OK(writer->Abort(client));
+      writer = std::move(bigger);
+    }
+    fill(writer->data() + size, size, kChunkSize);
+    size += kChunkSize;
+  }
+  std::unique_ptr<BlobWriter> result;
+  VINEYARD_CHECK_OK(client.CreateBlob(size, result));
+  memcpy(result->data(), writer->data(), size);
+  VINEYARD_CHECK_OK(writer->Abort(client));
+  double elapsed = GetCurrentTime() - start;
+  id = result->Seal(client)->id();
+  return elapsed;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./growable_blob_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // extends in place inside the reserved capacity
+  {
+    std::shared_ptr<InstanceStatus> status_before, status_reserved,
+        status_after;
+    VINEYARD_CHECK_OK(client.InstanceStatus(status_before));
+
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(client.CreateBlob(1024, 8192, writer));
+    CHECK_EQ(writer->size(), 1024UL);
+    // the whole capacity is accounted
+    VINEYARD_CHECK_OK(client.InstanceStatus(status_reserved));
+    CHECK_GE(status_reserved->memory_usage,
+             status_before->memory_usage + 8192);
+    ObjectID id = writer->id();
+    fill(writer->data(), 0, 1024);
+    VINEYARD_CHECK_OK(writer->Extend(client, 4096));
+    CHECK_EQ(writer->id(), id);
+    CHECK_EQ(writer->size(), 4096UL);
+    CHECK_EQ(writer->Buffer()->size(), 4096);
+    fill(writer->data() + 1024, 1024, 3072);
+    check(writer->data(), 4096);
+
+    // cannot extend to a smaller size
+    CHECK(writer->Extend(client, 1024).IsInvalid());
+
+    auto blob = std::dynamic_pointer_cast<Blob>(writer->Seal(client));
+    CHECK_EQ(blob->id(), id);
+    CHECK_EQ(blob->size(), 4096UL);
+    check(blob->data(), 4096);
+
+    // cannot extend once sealed
+    CHECK(writer->Extend(client, 8192).IsObjectSealed());
+    VINEYARD_CHECK_OK(client.DelData(id));
+
+    VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+    CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+  }
+
+  // relocates when the space after the blob is in use, and the content is
+  // kept
+  {
+    std::unique_ptr<BlobWriter> writer, neighbour;
+    VINEYARD_CHECK_OK(client.CreateBlob(1024, writer));
+    VINEYARD_CHECK_OK(client.CreateBlob(1024, neighbour));
+    ObjectID id = writer->id();
+    fill(writer->data(), 0, 1024);
+    VINEYARD_CHECK_OK(writer->Extend(client, 1024 * 1024));
+    CHECK_NE(writer->id(), id);
+    CHECK_EQ(writer->size(), 1024UL * 1024);
+    fill(writer->data() + 1024, 1024, 1024 * 1024 - 1024);
+    check(writer->data(), 1024 * 1024);
+    auto blob = std::dynamic_pointer_cast<Blob>(writer->Seal(client));
+    check(blob->data(), 1024 * 1024);
+    VINEYARD_CHECK_OK(client.DelData(blob->id()));
+    VINEYARD_CHECK_OK(neighbour->Abort(client));
+  }
+
+  // builder throughput with unknown sizes
+  {
+    size_t total = kChunkSize * kChunks;
+    ObjectID id = InvalidObjectID();
+    std::shared_ptr<Blob> blob;
+
+    double copy_time = BuildByCopying(client, id);
+    VINEYARD_CHECK_OK(client.GetBlob(id, blob));
+    check(blob->data(), total);
+    VINEYARD_CHECK_OK(client.DelData(id));
+
+    size_t relocations = 0;
+    double grow_time = BuildByExtending(client, kChunkSize, relocations, id);
+    VINEYARD_CHECK_OK(client.GetBlob(id, blob));
+    check(blob->data(), total);
+    VINEYARD_CHECK_OK(client.DelData(id));
+
+    size_t reserved_relocations = 0;
+    double reserved_time =
+        BuildByExtending(client, total, reserved_relocations, id);
+    CHECK_EQ(reserved_relocations, 0UL);
+    VINEYARD_CHECK_OK(client.GetBlob(id, blob));
+    check(blob->data(), total);
+    VINEYARD_CHECK_OK(client.DelData(id));
+
+    LOG(INFO) << "Built " << total << " bytes in " << kChunks
+              << " chunks: copying " << copy_time << "s, extending "
+              << grow_time << "s (" << relocations
+              << " relocations), extending with reservation " << reserved_time
+              << "s";
+  }
+
+  LOG(INFO) << "Passed growable blob test ...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -15,7 +15,11 @@ limitations under the License.
 
 #include <bitset>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "common/util/functions.h"
 #include "common/util/logging.h"
 #include "common/util/uuid.h"
 #include "io/io/io_factory.h"
@@ -76,9 +80,24 @@ void ReadTable(std::string const& path_to_read) {
   }
 }
 
+// compare the read throughput of, e.g., "a.csv", "a.csv.gz" and "a.csv.zst"
+void BenchmarkReadTable(std::vector<std::string> const& paths_to_read) {
+  for (auto const& path : paths_to_read) {
+    double start = vineyard::GetCurrentTime();
+    auto io = vineyard::IOFactory::CreateIOAdaptor(path, nullptr);
+    VINEYARD_CHECK_OK(io->Open());
+    std::shared_ptr<arrow::Table> table;
+    VINEYARD_CHECK_OK(io->ReadTable(&table));
+    double elapsed = vineyard::GetCurrentTime() - start;
+    int64_t rows = table ? table->num_rows() : 0;
+    LOG(INFO) << "read table from '" << path << "': " << rows << " rows, "
+              << elapsed << " seconds, " << (rows / elapsed) << " rows/s";
+  }
+}
+
 int main(int argc, char** argv) {
   if (argc < 3) {
-    printf("usage ./io_test <lines or table> <path to read>");
+    printf("usage ./io_test <lines, table or bench> <path to read>...");
     return 1;
   }
 
@@ -91,6 +110,9 @@ int main(int argc, char** argv) {
   if (mode == "table") {
     ReadTable(path_to_read);
   }
+  if (mode == "bench") {
+    BenchmarkReadTable(std::vector<std::string>(argv + 2, argv + argc));
+  }
 
   LOG(INFO) << "Passed double array tests...";
 
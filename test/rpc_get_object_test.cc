@@ -14,8 +14,10 @@ limitations under the License.
 */
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -24,6 +26,7 @@ limitations under the License.
 #include "client/client.h"
 #include "client/ds/object_meta.h"
 #include "client/rpc_client.h"
+#include "common/util/functions.h"
 #include "common/util/logging.h"
 
 using namespace vineyard;  // NOLINT(build/namespaces)
@@ -103,6 +106,104 @@ int main(int argc, char** argv) {
     CHECK(!targets3.empty());
   }
 
+  // projected, lazy and byte-range reads of an object with large members
+  {
+    std::vector<double> values(1 << 20);
+    ObjectMeta meta;
+    meta.SetTypeName("vineyard::test::Projection");
+    for (size_t index = 0; index < 4; ++index) {
+      for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = index * values.size() + i;
+      }
+      ArrayBuilder<double> member_builder(client, values);
+      meta.AddMember("member_-" + std::to_string(index),
+                     member_builder.Seal(client));
+    }
+    meta.SetNBytes(4 * values.size() * sizeof(double));
+    ObjectID projection_id = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.CreateMetaData(meta, projection_id));
+
+    double start = GetCurrentTime();
+    std::shared_ptr<Object> object;
+    VINEYARD_CHECK_OK(rpc_client.GetObject(projection_id, object));
+    double full_time = GetCurrentTime() - start;
+    size_t full_bytes = object->meta().MemoryUsage();
+    CHECK_EQ(full_bytes, 4 * values.size() * sizeof(double));
+
+    start = GetCurrentTime();
+    std::vector<std::shared_ptr<Object>> members;
+    VINEYARD_CHECK_OK(rpc_client.GetObjectMembers(
+        projection_id, {"member_-2", "member_-3/buffer_"}, members));
+    double projected_time = GetCurrentTime() - start;
+    CHECK_EQ(members.size(), 2);
+    auto member = std::dynamic_pointer_cast<Array<double>>(members[0]);
+    CHECK(member != nullptr);
+    CHECK_EQ(member->size(), values.size());
+    CHECK_EQ((*member)[0], 2 * values.size());
+    auto blob = std::dynamic_pointer_cast<Blob>(members[1]);
+    CHECK(blob != nullptr);
+    CHECK_EQ(reinterpret_cast<const double*>(blob->data())[1],
+             3 * values.size() + 1);
+    size_t projected_bytes =
+        members[0]->meta().MemoryUsage() + members[1]->meta().MemoryUsage();
+    CHECK_EQ(projected_bytes, 2 * values.size() * sizeof(double));
+
+    start = GetCurrentTime();
+    VINEYARD_CHECK_OK(rpc_client.GetObject(projection_id, object, true));
+    CHECK_EQ(object->meta().MemoryUsage(), 0);
+    auto lazy_member = std::dynamic_pointer_cast<Array<double>>(
+        object->meta().GetMember("member_-1"));
+    CHECK(lazy_member != nullptr);
+    CHECK_EQ((*lazy_member)[values.size() - 1], 2 * values.size() - 1);
+    double lazy_time = GetCurrentTime() - start;
+
+    ObjectID blob_id = object->meta()
+                           .GetMemberMeta("member_-1")
+                           .GetMemberMeta("buffer_")
+                           .GetId();
+    std::shared_ptr<RemoteBlob> range;
+    start = GetCurrentTime();
+    VINEYARD_CHECK_OK(rpc_client.GetRemoteBlob(blob_id, 8 * sizeof(double),
+                                               4 * sizeof(double), range));
+    double range_time = GetCurrentTime() - start;
+    size_t range_bytes = range->allocated_size();
+    CHECK_EQ(range_bytes, 4 * sizeof(double));
+    CHECK_EQ(reinterpret_cast<const double*>(range->data())[0],
+             values.size() + 8);
+    // clipped at the end of the blob
+    VINEYARD_CHECK_OK(rpc_client.GetRemoteBlob(
+        blob_id, (values.size() - 2) * sizeof(double), 1024, range));
+    CHECK_EQ(range->allocated_size(), 2 * sizeof(double));
+    CHECK(!rpc_client.GetRemoteBlob(blob_id, 1 << 30, 8, range).ok());
+
+    // lazy blobs fail cleanly once the rpc client has been destroyed
+    {
+      std::shared_ptr<Object> detached;
+      {
+        RPCClient temporary_client;
+        VINEYARD_CHECK_OK(temporary_client.Connect(rpc_endpoint));
+        VINEYARD_CHECK_OK(
+            temporary_client.GetObject(projection_id, detached, true));
+      }
+      auto detached_blob = std::dynamic_pointer_cast<Blob>(
+          detached->meta().GetMemberMeta("member_-0").GetMember("buffer_"));
+      CHECK(detached_blob != nullptr);
+      bool failed = false;
+      try {
+        CHECK(detached_blob->data() == nullptr);
+      } catch (std::runtime_error const& e) {
+        failed = true;
+      }
+      CHECK(failed);
+    }
+
+    LOG(INFO) << "Full get: " << full_bytes << " bytes in " << full_time
+              << "s, projected get: " << projected_bytes << " bytes in "
+              << projected_time << "s, lazy get of one member: " << lazy_time
+              << "s, range get: " << range_bytes << " bytes in "
+              << range_time << "s";
+  }
+
   LOG(INFO) << "Passed various ways to get object with rpc tests...";
 
   client.Disconnect();
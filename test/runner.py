@@ -427,12 +427,15 @@ def run_vineyard_cpp_tests(meta, allocator, endpoints, tests):
         # test invalid inputs from client
         run_invalid_client_test(tests, '127.0.0.1', rpc_socket_port)
 
+        run_test(tests, 'allocator_stats_test')
         run_test(tests, 'array_test')
         run_test(tests, 'array_two_clients_test')
         # FIXME: cannot be safely dtor after #350 and #354.
         # run_test('allocator_test')
         run_test(tests, 'arrow_data_structure_test')
+        run_test(tests, 'checkpoint_test')
         run_test(tests, 'clear_test')
+        run_test(tests, 'compressed_io_test')
         run_test(tests, 'concurrent_memcpy_test')
         run_test(tests, 'custom_vector_test')
         run_test(tests, 'dataframe_test')
@@ -442,8 +445,12 @@ def run_vineyard_cpp_tests(meta, allocator, endpoints, tests):
         run_test(tests, 'get_blob_disk_test')
         run_test(tests, 'get_object_test')
         run_test(tests, 'global_object_test')
+        run_test(
+            tests, 'global_object_scan_test', '127.0.0.1:%d' % rpc_socket_port
+        )
         # enable when USE_GPU is defined
         # run_test(tests, 'gpumalloc_test')
+        run_test(tests, 'growable_blob_test')
         run_test(tests, 'hashmap_test')
         run_test(tests, 'hashmap_mvcc_test')
         # run_test(tests, 'hosseinmoein_dataframe_test')
@@ -486,6 +493,7 @@ def run_vineyard_spill_tests(meta, allocator, endpoints, tests):
         default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
         spill_path='/tmp/spill_path',
     ):
+        run_test(tests, 'spill_policy_test')
         run_test(tests, 'spill_test')
 
 
@@ -524,6 +532,47 @@ def run_graph_tests(meta, allocator, endpoints, tests):
     ) as (_, rpc_socket_port):
         run_test(tests, 'arrow_fragment_test')
         run_graph_extend_test(tests)
+        run_test(tests, 'table_shuffler_test', nproc=4)
+        run_test(
+            tests,
+            'arrow_fragment_mirror_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+            nproc=4,
+        )
+        run_test(
+            tests,
+            'arrow_local_vertex_map_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+            nproc=4,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_single_label_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+        )
+        run_test(
+            tests,
+            'arrow_fragment_tombstone_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+            nproc=4,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_triangle_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+        )
+        run_test(
+            tests,
+            'arrow_fragment_temporal_test',
+            '$VINEYARD_DATA_DIR/p2p_v',
+            '$VINEYARD_DATA_DIR/p2p_e',
+        )
+        run_test(tests, 'arrow_fragment_transform_test')
         run_test(
             tests,
             'arrow_fragment_gar_test',
@@ -687,15 +736,35 @@ def run_python_deploy_tests(meta, allocator, endpoints, test_args, with_migratio
 
     instance_size = 2
     extra_args = []
-    if with_migration:
-        extra_args.append('--with-migration')
-    with start_multiple_vineyardd(
-        metadata_settings,
-        ['--allocator', allocator],
-        default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
-        instance_size=instance_size,
-        nowait=True,
-    ) as instances:  # noqa: F841, pylint: disable=unused-variable
+    with contextlib.ExitStack() as stack:
+        if with_migration:
+            extra_args.append('--with-migration')
+            # a second cluster that migrates through TCP even on the same host
+            tcp_ipc_socket = VINEYARD_CI_IPC_SOCKET + '.tcp'
+            stack.enter_context(
+                start_multiple_vineyardd(
+                    make_metadata_settings(meta, endpoints, meta_prefix + '_tcp'),
+                    ['--allocator', allocator, '--local_migration=false'],
+                    default_ipc_socket=tcp_ipc_socket,
+                    instance_size=instance_size,
+                    nowait=True,
+                )
+            )
+            extra_args.append(
+                '--vineyard-tcp-ipc-sockets=%s'
+                % ','.join(
+                    ['%s.%d' % (tcp_ipc_socket, i) for i in range(instance_size)]
+                )
+            )
+        instances = stack.enter_context(
+            start_multiple_vineyardd(
+                metadata_settings,
+                ['--allocator', allocator],
+                default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+                instance_size=instance_size,
+                nowait=True,
+            )
+        )
         vineyard_ipc_sockets = ','.join(
             ['%s.%d' % (VINEYARD_CI_IPC_SOCKET, i) for i in range(instance_size)]
         )
@@ -0,0 +1,63 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+
+#include "common/util/logging.h"
+#include "server/memory/usage.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr int64_t MB = 1024 * 1024;
+
+void SpillSizeTest() {
+  // the shortage below the footprint limit
+  CHECK_EQ(detail::SpillSizeForAllocation(64 * MB, 1000 * MB, 1024 * MB,
+                                          128 * MB, 1000 * MB),
+           40 * MB);
+  // enough space in total but fragmented: spill at least the request
+  CHECK_EQ(detail::SpillSizeForAllocation(64 * MB, 512 * MB, 1024 * MB,
+                                          16 * MB, 1000 * MB),
+           64 * MB);
+  // a free extent fits, only spill down to the lower watermark
+  CHECK_EQ(detail::SpillSizeForAllocation(64 * MB, 512 * MB, 1024 * MB,
+                                          128 * MB, 1000 * MB),
+           0);
+  CHECK_EQ(detail::SpillSizeForAllocation(64 * MB, 900 * MB, 1024 * MB,
+                                          128 * MB, 300 * MB),
+           600 * MB);
+}
+
+void SpillMoreTest() {
+  // the freed chunks coalesce toward the request
+  CHECK(detail::ShouldSpillMoreForAllocation(64 * MB, 64 * MB, 16 * MB,
+                                             32 * MB));
+  // spilling doesn't enlarge the largest free extent, stop early rather
+  // than spilling every cold object
+  CHECK(!detail::ShouldSpillMoreForAllocation(64 * MB, 64 * MB, 16 * MB,
+                                              16 * MB));
+  // bounded by the spilled bytes, even if the free extent is still growing
+  CHECK(detail::ShouldSpillMoreForAllocation(
+      64 * MB, (detail::kMaxSpillRatio * 64 - 1) * MB, 16 * MB, 32 * MB));
+  CHECK(!detail::ShouldSpillMoreForAllocation(
+      64 * MB, detail::kMaxSpillRatio * 64 * MB, 16 * MB, 32 * MB));
+}
+
+int main(int argc, char** argv) {
+  SpillSizeTest();
+  SpillMoreTest();
+  LOG(INFO) << "Passed spill policy tests...";
+  return 0;
+}
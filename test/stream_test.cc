@@ -13,19 +13,26 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <cstring>
+#include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
 
+#include "basic/ds/arrow_utils.h"
+#include "basic/stream/batch_encoding.h"
 #include "basic/stream/byte_stream.h"
 #include "basic/stream/dataframe_stream.h"
 #include "basic/stream/recordbatch_stream.h"
 #include "client/client.h"
 #include "client/ds/object_meta.h"
+#include "common/util/functions.h"
 #include "common/util/logging.h"
 
 using namespace vineyard;  // NOLINT(build/namespaces)
@@ -159,6 +166,137 @@ void testEmptyStream(Client& client, std::string const& ipc_socket) {
   }
 }
 
+void testByteStreamLines(Client& client, std::string const& ipc_socket) {
+  ObjectID stream_id = InvalidObjectID();
+  {
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "test"}, {"test_name", "stream_test"}};
+    stream_id = StreamBuilder<ByteStream>::Make(client, params);
+    CHECK(stream_id != InvalidObjectID());
+  }
+
+  // lines of various length, a small chunk size makes many of them span
+  // the chunk boundaries.
+  std::vector<std::string> lines;
+  for (size_t idx = 0; idx < 1000; ++idx) {
+    lines.emplace_back(std::string(idx % 97, 'a' + idx % 26));
+  }
+
+  std::thread send_thrd([&]() {
+    Client writer_client;
+    VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+    auto byte_stream = writer_client.GetObject<ByteStream>(stream_id);
+    VINEYARD_CHECK_OK(byte_stream->OpenWriter(&writer_client));
+    byte_stream->SetBufferSizeLimit(61);
+    for (size_t idx = 0; idx < lines.size(); ++idx) {
+      if (idx % 2 == 0) {
+        VINEYARD_CHECK_OK(byte_stream->WriteLine(lines[idx] + "\n"));
+      } else {
+        // fill in place
+        char* data = nullptr;
+        VINEYARD_CHECK_OK(byte_stream->Reserve(lines[idx].size() + 1, data));
+        memcpy(data, lines[idx].data(), lines[idx].size());
+        data[lines[idx].size()] = '\n';
+        VINEYARD_CHECK_OK(byte_stream->Commit(lines[idx].size() + 1));
+      }
+    }
+    // the last line is not terminated
+    VINEYARD_CHECK_OK(byte_stream->WriteBytes("tail", 4));
+    VINEYARD_CHECK_OK(byte_stream->FlushBuffer());
+    VINEYARD_CHECK_OK(byte_stream->Finish());
+  });
+
+  std::thread recv_thrd([&]() {
+    Client reader_client;
+    VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+
+    auto byte_stream = reader_client.GetObject<ByteStream>(stream_id);
+    VINEYARD_CHECK_OK(byte_stream->OpenReader(&reader_client));
+    for (size_t idx = 0; idx < lines.size(); ++idx) {
+      arrow_string_view line;
+      VINEYARD_CHECK_OK(byte_stream->ReadLine(line));
+      CHECK_EQ(std::string(line.data(), line.size()), lines[idx]);
+    }
+    std::string tail;
+    VINEYARD_CHECK_OK(byte_stream->ReadLine(tail));
+    CHECK_EQ(tail, "tail");
+    CHECK(byte_stream->ReadLine(tail).IsEndOfFile());
+  });
+
+  send_thrd.join();
+  recv_thrd.join();
+}
+
+void testByteStreamPendingChunk(Client& client, std::string const& ipc_socket) {
+  // the partially filled chunk is flushed by `Finish`
+  {
+    ObjectID stream_id = InvalidObjectID();
+    {
+      std::unordered_map<std::string, std::string> params{
+          {"kind", "test"}, {"test_name", "stream_test"}};
+      stream_id = StreamBuilder<ByteStream>::Make(client, params);
+      CHECK(stream_id != InvalidObjectID());
+    }
+
+    std::thread send_thrd([&]() {
+      Client writer_client;
+      VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+      auto byte_stream = writer_client.GetObject<ByteStream>(stream_id);
+      VINEYARD_CHECK_OK(byte_stream->OpenWriter(&writer_client));
+      VINEYARD_CHECK_OK(byte_stream->WriteLine("head\n"));
+      VINEYARD_CHECK_OK(byte_stream->WriteBytes("tail", 4));
+      VINEYARD_CHECK_OK(byte_stream->Finish());
+    });
+
+    std::thread recv_thrd([&]() {
+      Client reader_client;
+      VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+
+      auto byte_stream = reader_client.GetObject<ByteStream>(stream_id);
+      VINEYARD_CHECK_OK(byte_stream->OpenReader(&reader_client));
+      std::string line;
+      VINEYARD_CHECK_OK(byte_stream->ReadLine(line));
+      CHECK_EQ(line, "head");
+      VINEYARD_CHECK_OK(byte_stream->ReadLine(line));
+      CHECK_EQ(line, "tail");
+      CHECK(byte_stream->ReadLine(line).IsEndOfFile());
+    });
+
+    send_thrd.join();
+    recv_thrd.join();
+  }
+
+  // the chunk that is never flushed is aborted when the writer goes away
+  {
+    ObjectID stream_id = InvalidObjectID();
+    {
+      std::unordered_map<std::string, std::string> params{
+          {"kind", "test"}, {"test_name", "stream_test"}};
+      stream_id = StreamBuilder<ByteStream>::Make(client, params);
+      CHECK(stream_id != InvalidObjectID());
+    }
+
+    Client writer_client;
+    VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+    std::shared_ptr<InstanceStatus> status_before, status_writing,
+        status_after;
+    VINEYARD_CHECK_OK(writer_client.InstanceStatus(status_before));
+    {
+      auto byte_stream = writer_client.GetObject<ByteStream>(stream_id);
+      VINEYARD_CHECK_OK(byte_stream->OpenWriter(&writer_client));
+      byte_stream->SetBufferSizeLimit(1024 * 1024);
+      VINEYARD_CHECK_OK(byte_stream->WriteLine("pending\n"));
+      VINEYARD_CHECK_OK(writer_client.InstanceStatus(status_writing));
+      CHECK_GT(status_writing->memory_usage, status_before->memory_usage);
+    }
+    VINEYARD_CHECK_OK(writer_client.InstanceStatus(status_after));
+    CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+  }
+}
+
 void testRecordBatchStream(Client& client, std::string const& ipc_socket) {
   ObjectID stream_id = InvalidObjectID();
   {
@@ -261,6 +399,258 @@ void testRecordBatchStream(Client& client, std::string const& ipc_socket) {
   CHECK_EQ(send_chunks, recv_chunks);
 }
 
+std::shared_ptr<arrow::RecordBatch> makeEncodableBatch(int64_t num_rows) {
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int64_t> dist(0, 1 << 30);
+
+  arrow::StringBuilder category_builder;   // low cardinality strings
+  arrow::Int64Builder sorted_builder;      // long runs
+  arrow::Int32Builder small_builder;       // small range, with nulls
+  arrow::LargeStringBuilder text_builder;  // distinct strings
+  arrow::DoubleBuilder double_builder;
+  arrow::TimestampBuilder ts_builder(arrow::timestamp(arrow::TimeUnit::MILLI),
+                                     arrow::default_memory_pool());
+  const char* categories[] = {"alpha", "beta", "gamma", "delta"};
+  for (int64_t i = 0; i < num_rows; ++i) {
+    CHECK_ARROW_ERROR(category_builder.Append(categories[dist(gen) % 4]));
+    CHECK_ARROW_ERROR(sorted_builder.Append(i / 1000 - 3));
+    if (i % 7 == 0) {
+      CHECK_ARROW_ERROR(small_builder.AppendNull());
+    } else {
+      CHECK_ARROW_ERROR(small_builder.Append(-100 + dist(gen) % 200));
+    }
+    CHECK_ARROW_ERROR(text_builder.Append("text-" + std::to_string(dist(gen))));
+    CHECK_ARROW_ERROR(double_builder.Append(dist(gen) / 3.0));
+    CHECK_ARROW_ERROR(ts_builder.Append(1600000000000 + i * 10));
+  }
+  std::vector<std::shared_ptr<arrow::Array>> columns(6);
+  CHECK_ARROW_ERROR(category_builder.Finish(&columns[0]));
+  CHECK_ARROW_ERROR(sorted_builder.Finish(&columns[1]));
+  CHECK_ARROW_ERROR(small_builder.Finish(&columns[2]));
+  CHECK_ARROW_ERROR(text_builder.Finish(&columns[3]));
+  CHECK_ARROW_ERROR(double_builder.Finish(&columns[4]));
+  CHECK_ARROW_ERROR(ts_builder.Finish(&columns[5]));
+
+  auto schema = arrow::schema(
+      {arrow::field("category", arrow::utf8()),
+       arrow::field("sorted", arrow::int64()),
+       arrow::field("small", arrow::int32()),
+       arrow::field("text", arrow::large_utf8()),
+       arrow::field("double", arrow::float64()),
+       arrow::field("ts", arrow::timestamp(arrow::TimeUnit::MILLI))});
+  return arrow::RecordBatch::Make(schema, num_rows, columns);
+}
+
+void testBatchEncodings(Client& client,
+                        std::shared_ptr<arrow::RecordBatch> const& batch) {
+  size_t ipc_size = 0;
+  VINEYARD_CHECK_OK(GetRecordBatchStreamSize(*batch, &ipc_size));
+
+  std::map<std::string, ColumnEncoding> encodings{
+      {"auto", ColumnEncoding::kAuto},
+      {"plain", ColumnEncoding::kPlain},
+      {"dictionary", ColumnEncoding::kDictionary},
+      {"rle", ColumnEncoding::kRunLength},
+      {"for", ColumnEncoding::kFrameOfReference},
+      {"lz4", ColumnEncoding::kLZ4}};
+  for (auto const& item : encodings) {
+    BatchEncodingOptions options;
+    options.encoding = item.second;
+
+    std::shared_ptr<Object> chunk;
+    double start = GetCurrentTime();
+    VINEYARD_CHECK_OK(EncodeRecordBatch(client, batch, options, chunk));
+    double encode_time = GetCurrentTime() - start;
+
+    auto buffer = std::dynamic_pointer_cast<Blob>(chunk)->ArrowBuffer();
+    CHECK(IsEncodedRecordBatch(buffer));
+    {
+      std::shared_ptr<EncodedRecordBatch> encoded;
+      std::shared_ptr<arrow::RecordBatch> decoded;
+      start = GetCurrentTime();
+      VINEYARD_CHECK_OK(EncodedRecordBatch::Make(buffer, encoded));
+      VINEYARD_CHECK_OK(encoded->ToRecordBatch(decoded, 4));
+      double decode_time = GetCurrentTime() - start;
+      CHECK(decoded->Equals(*batch));
+
+      std::string layout;
+      for (int i = 0; i < encoded->num_columns(); ++i) {
+        layout += " " + encoded->schema()->field(i)->name() + ":" +
+                  column_encoding_name(encoded->encoding(i));
+      }
+      double mb = static_cast<double>(ipc_size) / 1024 / 1024;
+      LOG(INFO) << "Encoding '" << item.first << "':" << layout << ", "
+                << static_cast<double>(encoded->encoded_size()) /
+                       batch->num_rows()
+                << " bytes/row (ipc: "
+                << static_cast<double>(ipc_size) / batch->num_rows()
+                << "), encode " << mb / encode_time << " MB/s, decode "
+                << mb / decode_time << " MB/s";
+    }
+    buffer.reset();
+    VINEYARD_CHECK_OK(client.DelData(chunk->id()));
+  }
+}
+
+void testEncodedRecordBatchStream(Client& client,
+                                  std::string const& ipc_socket) {
+  ObjectID stream_id = InvalidObjectID();
+  {
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "test"}, {"test_name", "stream_test"}};
+    stream_id = StreamBuilder<RecordBatchStream>::Make(client, params);
+    CHECK(stream_id != InvalidObjectID());
+  }
+
+  auto batch = makeEncodableBatch(100000);
+  testBatchEncodings(client, batch);
+
+  // auto, forced per-column encodings, the arrow IPC message, and the
+  // encoded batch that is read lazily
+  std::vector<BatchEncodingOptions> options(2);
+  options[1].encoding = ColumnEncoding::kPlain;
+  options[1].column_encodings["category"] = ColumnEncoding::kDictionary;
+  options[1].column_encodings["text"] = ColumnEncoding::kLZ4;
+  options[1].column_encodings["sorted"] = ColumnEncoding::kRunLength;
+  options[1].column_encodings["small"] = ColumnEncoding::kFrameOfReference;
+  const size_t rounds = 4;
+
+  size_t send_chunks = 0, recv_chunks = 0;
+
+  std::thread recv_thrd([&]() {
+    Client reader_client;
+    VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+
+    auto recordbatch_stream =
+        reader_client.GetObject<RecordBatchStream>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+    VINEYARD_CHECK_OK(recordbatch_stream->OpenReader(&reader_client));
+
+    // the encoded batches outlive the following pulls without being copied,
+    // while the record batch object needs to be copied
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    std::vector<std::shared_ptr<EncodedRecordBatch>> encoded_batches;
+    for (size_t idx = 0; idx < rounds; ++idx) {
+      for (size_t k = 0; k < options.size() + 1; ++k) {
+        std::shared_ptr<arrow::RecordBatch> load_batch;
+        VINEYARD_CHECK_OK(
+            recordbatch_stream->ReadBatch(load_batch, k == options.size()));
+        batches.emplace_back(load_batch);
+        recv_chunks += 1;
+      }
+      std::shared_ptr<EncodedRecordBatch> encoded;
+      VINEYARD_CHECK_OK(recordbatch_stream->ReadEncodedBatch(encoded));
+      encoded_batches.emplace_back(encoded);
+      recv_chunks += 1;
+    }
+    std::shared_ptr<arrow::RecordBatch> drained;
+    CHECK(recordbatch_stream->ReadBatch(drained, false).IsStreamDrained());
+
+    for (auto const& load_batch : batches) {
+      CHECK(load_batch->Equals(*batch));
+    }
+    for (auto const& encoded : encoded_batches) {
+      CHECK_EQ(encoded->num_rows(), batch->num_rows());
+      for (int i = encoded->num_columns() - 1; i >= 0; --i) {
+        std::shared_ptr<arrow::Array> column;
+        VINEYARD_CHECK_OK(encoded->column(i, column));
+        CHECK(column->Equals(batch->column(i)));
+      }
+    }
+    batches.clear();
+    encoded_batches.clear();
+  });
+
+  std::thread send_thrd([&]() {
+    Client writer_client;
+    VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+    auto recordbatch_stream =
+        writer_client.GetObject<RecordBatchStream>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+    VINEYARD_CHECK_OK(recordbatch_stream->OpenWriter(&writer_client));
+
+    double start = GetCurrentTime();
+    for (size_t idx = 0; idx < rounds; ++idx) {
+      for (auto const& option : options) {
+        VINEYARD_CHECK_OK(recordbatch_stream->WriteBatch(batch, option));
+        send_chunks += 1;
+      }
+      VINEYARD_CHECK_OK(recordbatch_stream->WriteBatch(batch));
+      VINEYARD_CHECK_OK(recordbatch_stream->WriteBatch(batch, options[0]));
+      send_chunks += 2;
+    }
+    VINEYARD_CHECK_OK(recordbatch_stream->Finish());
+    LOG(INFO) << "Pushed " << send_chunks << " batches in "
+              << GetCurrentTime() - start << "s";
+  });
+
+  send_thrd.join();
+  recv_thrd.join();
+
+  CHECK_EQ(send_chunks, recv_chunks);
+}
+
+void testRetainedChunksReclaimed(Client& client,
+                                 std::string const& ipc_socket) {
+  const size_t chunks = 8;
+  auto batch = makeEncodableBatch(10000);
+
+  ObjectID stream_id = InvalidObjectID();
+  {
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "test"}, {"test_name", "stream_test"}};
+    stream_id = StreamBuilder<RecordBatchStream>::Make(client, params);
+    CHECK(stream_id != InvalidObjectID());
+  }
+
+  std::shared_ptr<InstanceStatus> status_before, status_holding,
+      status_after;
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_before));
+
+  Client writer_client;
+  VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+  {
+    auto recordbatch_stream =
+        writer_client.GetObject<RecordBatchStream>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+    VINEYARD_CHECK_OK(recordbatch_stream->OpenWriter(&writer_client));
+    for (size_t idx = 0; idx < chunks; ++idx) {
+      VINEYARD_CHECK_OK(
+          recordbatch_stream->WriteBatch(batch, BatchEncodingOptions{}));
+    }
+    VINEYARD_CHECK_OK(recordbatch_stream->Finish());
+  }
+
+  // both clients stay connected: the chunks are reclaimed once the reader
+  // drops the batches, rather than when the clients disconnect
+  Client reader_client;
+  VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+  {
+    auto recordbatch_stream =
+        reader_client.GetObject<RecordBatchStream>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+    VINEYARD_CHECK_OK(recordbatch_stream->OpenReader(&reader_client));
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches(chunks);
+    for (size_t idx = 0; idx < chunks; ++idx) {
+      VINEYARD_CHECK_OK(recordbatch_stream->ReadBatch(batches[idx], false));
+    }
+    VINEYARD_CHECK_OK(client.InstanceStatus(status_holding));
+    CHECK_GT(status_holding->memory_usage, status_before->memory_usage);
+    for (auto const& load_batch : batches) {
+      CHECK(load_batch->Equals(*batch));
+    }
+
+    batches.clear();
+    std::shared_ptr<arrow::RecordBatch> drained;
+    CHECK(recordbatch_stream->ReadBatch(drained, false).IsStreamDrained());
+    VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+    CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+  }
+  reader_client.Disconnect();
+  writer_client.Disconnect();
+}
+
 int main(int argc, char** argv) {
   if (argc < 2) {
     printf("usage ./stream_test <ipc_socket>");
@@ -297,6 +687,20 @@ int main(int argc, char** argv) {
   CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
   CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
 
+  testByteStreamLines(client, ipc_socket);
+  LOG(INFO) << "Passed bytestream lines test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
+  testByteStreamPendingChunk(client, ipc_socket);
+  LOG(INFO) << "Passed bytestream pending chunk test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
   testRecordBatchStream(client, ipc_socket);
   LOG(INFO) << "Passed recordbatch test...";
 
@@ -304,6 +708,20 @@ int main(int argc, char** argv) {
   CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
   CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
 
+  testEncodedRecordBatchStream(client, ipc_socket);
+  LOG(INFO) << "Passed encoded recordbatch test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
+  testRetainedChunksReclaimed(client, ipc_socket);
+  LOG(INFO) << "Passed retained chunks test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
   LOG(INFO) << "Passed stream tests...";
 
   client.Disconnect();